@@ -7,23 +7,33 @@
 #ifndef BACKUP_H
 #define BACKUP_H
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <unistd.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * Start a dump of the external flash memory content via xmodem transfer,
- * blocking function.
+ * Dump the content of the external flash memory over the USB serial port,
+ * blocking function. The data is sent with the streaming protocol defined in
+ * core/backup_stream.h, the transfer begins when the host is ready.
+ *
+ * @param skipErased: send the erased areas of the memory without their content.
+ * @return number of bytes sent or a negative error code on failure.
  */
-void eflash_dump();
+ssize_t eflash_dump(const bool skipErased);
 
 /**
- * Start a restore of the external flash memory content via xmodem transfer,
- * blocking function.
+ * Restore the content of the external flash memory from the USB serial port,
+ * blocking function. The data is received with the streaming protocol defined
+ * in core/backup_stream.h: the flash sectors are erased and programmed in
+ * background while the next blocks are being received.
+ *
+ * @return number of bytes restored or a negative error code on failure.
  */
-void eflash_restore();
+ssize_t eflash_restore();
 
 #ifdef __cplusplus
 }
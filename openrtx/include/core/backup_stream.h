@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef BACKUP_STREAM_H
+#define BACKUP_STREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Streaming protocol for the transfer of large memory images over a serial
+ * link, used for the backup and restore of the external flash memory.
+ *
+ * Data is transferred in frames of up to BSTREAM_FRAME_SIZE bytes, each one
+ * protected by a CRC-32. The sender keeps up to BSTREAM_WINDOW frames in
+ * flight without waiting for their acknowledgement (go-back-N): the receiver
+ * acknowledges the frames received in order with a cumulative ACK and
+ * requests the retransmission of the first missing one with a NAK. Frames
+ * whose content is all 0xFF can optionally be sent as a short "erased" frame,
+ * reducing the size of the dumps of partially used memories.
+ *
+ * Every frame begins with a 12-byte header, followed by the payload and by the
+ * CRC-32 of header and payload. All the fields are little endian.
+ *
+ * | Offset | Size | Content                                              |
+ * |--------|------|------------------------------------------------------|
+ * | 0      | 1    | Sync byte, 0xB5                                      |
+ * | 1      | 1    | Frame type                                           |
+ * | 2      | 2    | Payload length                                       |
+ * | 4      | 4    | Sequence number                                      |
+ * | 8      | 4    | Memory offset of the payload                         |
+ *
+ * The transfer is started by the receiver, sending START frames until the
+ * first frame from the sender arrives, and is terminated by an END frame
+ * carrying the total size of the transfer in the offset field.
+ */
+
+#define BSTREAM_FRAME_SIZE    4096    ///< Maximum frame payload size, in bytes
+#define BSTREAM_WINDOW        8       ///< Number of unacknowledged frames
+#define BSTREAM_TIMEOUT       500     ///< Acknowledgement timeout, in ms
+#define BSTREAM_MAX_RETRIES   10      ///< Retransmissions before giving up
+#define BSTREAM_START_TIMEOUT 60000   ///< Timeout for transfer start, in ms
+
+/**
+ * Serial link used for the transfer.
+ */
+typedef struct
+{
+    /**
+     * Read data from the link, returning the number of bytes read or a
+     * negative value on failure. The function may return zero bytes when no
+     * data is available, but it should block for at most a few milliseconds.
+     */
+    ssize_t (*read)(void *ctx, void *buf, size_t len);
+
+    /**
+     * Write data to the link, blocking until all the data has been queued.
+     * Returns the number of bytes written or a negative value on failure.
+     */
+    ssize_t (*write)(void *ctx, const void *buf, size_t len);
+
+    void *ctx;    ///< Context pointer passed to the link functions
+}
+bsLink_t;
+
+/**
+ * Memory being transferred. All the functions return zero on success and a
+ * negative error code on failure.
+ */
+typedef struct
+{
+    /**
+     * Read a block of data from the memory.
+     */
+    int (*read)(void *ctx, uint32_t offset, void *buf, size_t len);
+
+    /**
+     * Write a block of data to the memory. Blocks are written in increasing
+     * order of offset and each one starts on a frame boundary. A NULL buffer
+     * pointer means that the block content is all 0xFF. The function may
+     * return before the data has been actually written.
+     */
+    int (*write)(void *ctx, uint32_t offset, const void *buf, size_t len);
+
+    /**
+     * Complete all the pending writes, called at the end of the transfer.
+     */
+    int (*flush)(void *ctx);
+
+    void *ctx;    ///< Context pointer passed to the memory functions
+}
+bsStorage_t;
+
+/**
+ * Send the content of a memory, blocking function. The transfer begins when a
+ * START frame is received from the other end.
+ *
+ * @param link: serial link.
+ * @param storage: memory to be sent, only the read function is used.
+ * @param size: number of bytes to be sent, starting from offset zero.
+ * @param skipErased: send the blocks having all the bytes set to 0xFF as
+ * "erased" frames, without their content.
+ * @return number of bytes sent or a negative error code on failure.
+ */
+ssize_t bstream_send(const bsLink_t *link, const bsStorage_t *storage,
+                     const size_t size, const bool skipErased);
+
+/**
+ * Receive the content of a memory, blocking function.
+ *
+ * @param link: serial link.
+ * @param storage: memory where to store the received data, the read function
+ * is not used.
+ * @param maxSize: memory size, in bytes.
+ * @return number of bytes received or a negative error code on failure.
+ */
+ssize_t bstream_receive(const bsLink_t *link, const bsStorage_t *storage,
+                        const size_t maxSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BACKUP_STREAM_H */
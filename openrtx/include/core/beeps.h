@@ -6,7 +6,7 @@
 
 #ifndef BEEPS_H_INCLUDED
 #define BEEPS_H_INCLUDED
-// Duration in tenths of a second.
+// Duration in units of 25ms.
 #define SHORT_BEEP 3
 #define LONG_BEEP 7
 
@@ -41,6 +41,17 @@ uint16_t crc_m17(const void *data, const size_t len);
  */
 uint16_t crc_ccitt(const void *data, const size_t len);
 
+/**
+ * Compute the 32-bit CRC over a given block of data, using the same algorithm
+ * of Ethernet and zlib (reflected polynomial 0xEDB88320, initial value and
+ * final xor 0xFFFFFFFF).
+ *
+ * @param data: input data.
+ * @param len: data length, in bytes.
+ * @return CRC-32 value.
+ */
+uint32_t crc_32(const void *data, const size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -60,6 +60,117 @@ static inline void dsp_removeDcOffset(struct dcBlock *dcb, int16_t *buffer,
         buffer[i] = dsp_dcBlockFilter(dcb, buffer[i]);
 }
 
+/**
+ * Saturate a value to the 16 bit range.
+ *
+ * @param value: value to be saturated.
+ * @return saturated value.
+ */
+static inline int16_t dsp_saturate(const int32_t value)
+{
+    if(value > INT16_MAX)
+        return INT16_MAX;
+
+    if(value < INT16_MIN)
+        return INT16_MIN;
+
+    return (int16_t) value;
+}
+
+/**
+ * Data structure holding the coefficients and the internal state of a second
+ * order IIR filter section. Coefficients are in Q14 format, to represent values
+ * in the [-2, 2) range, and the denominator is normalised to have a0 = 1.
+ */
+struct biquad {
+    int16_t b0, b1, b2;     ///< Numerator coefficients, Q14
+    int16_t a1, a2;         ///< Denominator coefficients, Q14
+    int32_t x1, x2;         ///< Previous input samples
+    int32_t y1, y2;         ///< Previous output samples
+    int32_t err;            ///< Rounding error of the last output sample
+};
+
+/**
+ * Initialise a biquad filter section, clearing its state.
+ *
+ * @param bq: pointer to the biquad filter section.
+ * @param coeffs: filter coefficients in Q14 format, in the b0, b1, b2, a1, a2
+ * order.
+ */
+void dsp_biquadInit(struct biquad *bq, const int16_t coeffs[5]);
+
+/**
+ * Run a single step of a biquad filter section, in direct form I. The rounding
+ * error of each output sample is fed back to the next one, keeping the noise
+ * low also for poles close to the unit circle.
+ *
+ * Samples are on 32 bits to allow cascading sections without saturating the
+ * intermediate signals, which may exceed the 16 bit range during transients.
+ *
+ * @param bq: pointer to the biquad filter section.
+ * @param sample: input sample.
+ * @return filtered sample.
+ */
+int32_t dsp_biquadFilter(struct biquad *bq, int32_t sample);
+
+/**
+ * Data structure holding the internal state of a first order de-emphasis
+ * filter.
+ */
+struct deemphasis {
+    int16_t alpha;          ///< Smoothing factor, Q15
+    int32_t state;          ///< Filter output, with 15 fractional bits
+};
+
+/**
+ * Initialise a de-emphasis filter, clearing its state.
+ *
+ * @param de: pointer to the de-emphasis filter state.
+ * @param tau: time constant of the de-emphasis, in microseconds.
+ * @param sampleRate: sample rate, in Hz.
+ */
+void dsp_deemphasisInit(struct deemphasis *de, const uint16_t tau,
+                        const uint32_t sampleRate);
+
+/**
+ * Run a single step of the de-emphasis filter.
+ *
+ * @param de: pointer to the de-emphasis filter state.
+ * @param sample: input sample.
+ * @return filtered sample.
+ */
+int16_t dsp_deemphasisFilter(struct deemphasis *de, int16_t sample);
+
+/**
+ * Number of taps of the noise reducer predictor.
+ */
+#define DSP_NR_TAPS 32
+
+/**
+ * Data structure holding the internal state of the noise reducer, an adaptive
+ * line enhancer: a linear predictor, adapted with the normalised LMS algorithm,
+ * estimates each sample from the previous ones. The correlated components of
+ * the signal, like voiced speech, are predicted while the wideband noise is
+ * not, and the prediction is taken as output.
+ */
+struct noiseReducer {
+    int32_t  weights[DSP_NR_TAPS];      ///< Predictor coefficients, Q29
+    int16_t  history[2 * DSP_NR_TAPS];  ///< Previous samples, stored twice
+    uint32_t power;                     ///< Power of the previous samples
+    uint8_t  pos;                       ///< Position of the newest sample
+};
+
+/**
+ * Run a single step of the noise reducer.
+ *
+ * The state has to be cleared with dsp_resetState() before the first use.
+ *
+ * @param nr: pointer to the noise reducer state.
+ * @param sample: input sample.
+ * @return filtered sample.
+ */
+int16_t dsp_noiseReduction(struct noiseReducer *nr, int16_t sample);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -7,6 +7,13 @@
 #ifndef EVENT_H
 #define EVENT_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * This enum describes the event message type:
  * - EVENT_KBD is used to send a keypress
@@ -38,4 +45,43 @@ typedef union
     uint32_t value;
 }event_t;
 
+/**
+ * Signal the availability of a new event to the thread waiting for it in
+ * event_wait(). Each call to this function wakes up the waiting thread once,
+ * no signal is lost if the thread is not waiting at the time of the call.
+ */
+void event_signal();
+
+/**
+ * Block the calling thread until an event is signalled or until a timeout
+ * expires. Only one thread at a time can wait for events.
+ *
+ * The timeout is checked by event_checkTimeout(), thus its resolution is
+ * given by the period of the thread calling that function.
+ *
+ * @param timeout: absolute timeout, in ms, zero to wait without timeout.
+ * @return true if an event has been signalled, false on timeout.
+ */
+bool event_wait(const long long timeout);
+
+/**
+ * Non-blocking version of event_wait(): consume a pending event signal, if
+ * any, and return immediately.
+ *
+ * @return true if an event has been signalled, false otherwise.
+ */
+bool event_tryWait();
+
+/**
+ * Wake up the thread waiting in event_wait() if its timeout is expired. To be
+ * called periodically.
+ *
+ * @param now: current time, in ms.
+ */
+void event_checkTimeout(const long long now);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* EVENT_H */
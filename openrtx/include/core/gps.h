@@ -8,9 +8,13 @@
 #define GPS_H
 
 #include "core/datetime.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#define GPS_LOG_MAX_INTERVAL 3600   // Maximum track log interval, in seconds
+#define GPS_LOG_MAX_DISTANCE 1000   // Maximum track log distance, in meters
+
 /**
  * Enumeration type for GPS fix quality, according to the quality
  * indicator field of NMEA GGA sentence
@@ -121,5 +125,30 @@ static inline int gps_getSentence(const struct gpsDevice *dev, char *buf, const
  */
 void gps_task(const struct gpsDevice *dev);
 
+/**
+ * Start or stop the GPS track logger according to the current settings and
+ * update its thresholds. The log is stored in the nonvolatile memory area
+ * reserved by the target, if any. Starting the logger scans the log area and
+ * stopping it writes the points still in RAM: this function must not be called
+ * from the main thread loop nor with the state mutex locked.
+ */
+void gps_updateTracklog();
+
+/**
+ * Start the export of the GPS track log in GPX format over the USB serial
+ * port, or to the standard output on linux. The export runs in background.
+ *
+ * @return zero on success, -EBUSY if an export is already in progress or
+ * -ENODEV if the target has no track log.
+ */
+int gps_exportTracklog();
+
+/**
+ * Check if the export of the GPS track log is in progress.
+ *
+ * @return true if the export is in progress.
+ */
+bool gps_exportRunning();
+
 
 #endif /* GPS_H */
@@ -110,7 +110,7 @@ void gfx_terminate();
  * Copy a given section, between two given rows, of framebuffer content to the
  * display.
  * @param startRow: first row of the framebuffer section to be copied
- * @param endRow: last row of the framebuffer section to be copied
+ * @param endRow: end row of the framebuffer section to be copied, excluded
  */
 void gfx_renderRows(uint8_t startRow, uint8_t endRow);
 
@@ -118,6 +118,7 @@ void gfx_renderRows(uint8_t startRow, uint8_t endRow);
  * This function calls the correspondent method of the low level interface display.h
  * Copy framebuffer content to the display internal buffer. To be called
  * whenever there is need to update the display.
+ * Only the rows modified since the last render are sent to the display.
  */
 void gfx_render();
 
@@ -126,7 +127,7 @@ void gfx_render();
  * This results in a black screen on color displays
  * And a white screen on B/W displays
  * @param startRow: first row of the framebuffer section to be cleared
- * @param endRow: last row of the framebuffer section to be cleared
+ * @param endRow: end row of the framebuffer section to be cleared, excluded
  */
 void gfx_clearRows(uint8_t startRow, uint8_t endRow);
 
@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef NMEA_H
+#define NMEA_H
+
+#include "core/gps.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Streaming parser for NMEA 0183 sentences.
+ *
+ * The parser is a state machine consuming the sentence one character at a
+ * time: the checksum is computed on the fly and only the fields used in the
+ * gps_t data structure are decoded, directly to fixed point, while the
+ * characters are received. Sentences of types not used are skipped right after
+ * their address field. The parser does not allocate memory nor call library
+ * functions, so it can be fed also from within an IRQ.
+ *
+ * The decoded fields are applied to the GPS data only when the full sentence
+ * has been received and its checksum verified. Sentences without the optional
+ * checksum are accepted.
+ */
+
+#define NMEA_MAX_LENGTH  83     ///< Maximum sentence length, line terminator included
+#define NMEA_MAX_FIELDS  19     ///< Maximum number of decoded fields
+
+/**
+ * Types of the NMEA sentences decoded by the parser.
+ */
+enum nmeaSentence
+{
+    NMEA_NONE = 0,      ///< No complete sentence available
+    NMEA_RMC,           ///< Recommended minimum data
+    NMEA_GGA,           ///< Fix data
+    NMEA_GSA,           ///< DOP and active satellites
+    NMEA_GSV,           ///< Satellites in view
+    NMEA_VTG,           ///< Track and ground speed
+};
+
+/**
+ * NMEA parser state.
+ */
+struct nmeaParser
+{
+    uint8_t state;                      ///< Parser state
+    uint8_t type;                       ///< Type of the current sentence
+    uint8_t length;                     ///< Length of the current sentence
+    uint8_t field;                      ///< Index of the current field
+    uint8_t kind;                       ///< Decoding rule of the current field
+    uint8_t checksum;                   ///< Checksum of the received characters
+    uint8_t expected;                   ///< Checksum received with the sentence
+    uint8_t digits;                     ///< Digits received in the current field
+    uint8_t decimals;                   ///< Decimal digits of the current field
+    bool    point;                      ///< Decimal point received
+    bool    error;                      ///< Malformed sentence
+    int8_t  sign;                       ///< Sign of the current field
+    int32_t value;                      ///< Integer part of the current field
+    int32_t frac;                       ///< Fractional part of the current field
+    int32_t fields[NMEA_MAX_FIELDS];    ///< Decoded fields
+};
+
+/**
+ * Reset the state of an NMEA parser.
+ *
+ * @param parser: pointer to the parser.
+ */
+void nmea_reset(struct nmeaParser *parser);
+
+/**
+ * Feed a character to an NMEA parser.
+ *
+ * @param parser: pointer to the parser.
+ * @param c: incoming character.
+ * @return the type of the sentence, if the character completes a valid
+ * sentence, or NMEA_NONE.
+ */
+enum nmeaSentence nmea_putChar(struct nmeaParser *parser, const char c);
+
+/**
+ * Feed a block of characters to an NMEA parser, stopping after the first
+ * complete sentence. Equivalent to a sequence of calls to nmea_putChar(), but
+ * faster.
+ *
+ * @param parser: pointer to the parser.
+ * @param data: incoming characters.
+ * @param len: number of characters.
+ * @param type: set to the type of the sentence completed or to NMEA_NONE.
+ * @return number of characters consumed.
+ */
+size_t nmea_putData(struct nmeaParser *parser, const char *data,
+                    const size_t len, enum nmeaSentence *type);
+
+/**
+ * Update the GPS data with the fields of the last complete sentence, the
+ * fields not carried by that sentence type are left untouched. This function
+ * has to be called before feeding the parser with the next sentence.
+ *
+ * @param parser: pointer to the parser.
+ * @param gps: pointer to the GPS data to be updated.
+ */
+void nmea_update(const struct nmeaParser *parser, gps_t *gps);
+
+/**
+ * Check if the last complete sentence is an RMC reporting valid data.
+ *
+ * @param parser: pointer to the parser.
+ * @return true if the date and time of the last sentence are valid.
+ */
+bool nmea_timeValid(const struct nmeaParser *parser);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NMEA_H */
@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef RSSI_H
+#define RSSI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "core/datatypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Common RSSI processing pipeline: conversion of raw ADC counts to input power
+ * and filtering of the resulting values.
+ *
+ * All the computations are done in fixed point math, making the functions
+ * suitable for targets without FPU and for high rate sampling, as in scan or
+ * sweep modes. Power levels are expressed in tenths of dBm.
+ */
+
+/**
+ * RSSI calibration point. The input power is a linear function of the RSSI
+ * voltage, with slope and offset depending from the RX frequency.
+ */
+typedef struct
+{
+    freq_t  freq;       ///< Frequency of the calibration point, in Hz
+    int32_t slope;      ///< Conversion slope, in 10^-6 dB/mV
+    int32_t offset;     ///< Input power for an RSSI voltage of 0V, in 0.1dBm
+}
+rssiCalPoint_t;
+
+/**
+ * RSSI conversion parameters for a given RX frequency, computed from the
+ * calibration points by rssi_computeConversion().
+ */
+typedef struct
+{
+    int32_t gain;       ///< Conversion gain, in 0.1dB per ADC count, Q16.16
+    int32_t offset;     ///< Conversion offset, in 0.1dBm
+}
+rssiConv_t;
+
+/**
+ * Type of RSSI filter.
+ */
+enum rssiFilterType
+{
+    RSSI_FILTER_NONE   = 0,    ///< No filtering
+    RSSI_FILTER_EMA    = 1,    ///< Exponential moving average
+    RSSI_FILTER_MEDIAN = 2     ///< Median of the last N samples
+};
+
+#define RSSI_MEDIAN_MAX_LEN 9  ///< Maximum window length for the median filter
+
+/**
+ * RSSI filter state.
+ */
+typedef struct
+{
+    uint8_t  type;                          ///< Filter type
+    uint8_t  len;                           ///< Median window length
+    uint8_t  pos;                           ///< Median window write position
+    uint8_t  count;                         ///< Number of samples in the window
+    uint32_t alpha;                         ///< EMA weight of new sample, Q16.16
+    int32_t  acc;                           ///< EMA accumulator, Q16.16
+    int16_t  value;                         ///< Last output value
+    int16_t  window[RSSI_MEDIAN_MAX_LEN];   ///< Median window
+}
+rssiFilter_t;
+
+/**
+ * Compute the RSSI conversion parameters for a given RX frequency, linearly
+ * interpolating between the calibration points. Outside of the range covered
+ * by the calibration points, the nearest point is used.
+ *
+ * @param conv: pointer to the destination conversion parameters.
+ * @param cal: calibration points, sorted by increasing frequency.
+ * @param numPoints: number of calibration points.
+ * @param freq: RX frequency, in Hz.
+ * @param countsTouV: conversion factor from ADC counts to uV in Q16.16 format,
+ * as in the ADC device handle.
+ */
+void rssi_computeConversion(rssiConv_t *conv, const rssiCalPoint_t *cal,
+                            const size_t numPoints, const freq_t freq,
+                            const uint32_t countsTouV);
+
+/**
+ * Convert a raw RSSI ADC reading to input power.
+ *
+ * @param conv: conversion parameters.
+ * @param counts: raw ADC reading.
+ * @return input power, in 0.1dBm.
+ */
+static inline int16_t rssi_convert(const rssiConv_t *conv, const uint16_t counts)
+{
+    int32_t power = (int32_t)(((int64_t) counts * conv->gain) >> 16);
+    return (int16_t)(power + conv->offset);
+}
+
+/**
+ * Round a power level from 0.1dBm to dBm.
+ *
+ * @param power: power level, in 0.1dBm.
+ * @return power level, in dBm.
+ */
+static inline rssi_t rssi_toDbm(const int16_t power)
+{
+    if(power < 0)
+        return (power - 5) / 10;
+
+    return (power + 5) / 10;
+}
+
+/**
+ * Initialise an RSSI filter.
+ *
+ * @param filter: pointer to the filter state.
+ * @param type: filter type.
+ * @param param: for the EMA filter, weight of the new sample in Q16.16 format;
+ * for the median filter, window length, limited to RSSI_MEDIAN_MAX_LEN.
+ */
+void rssiFilter_init(rssiFilter_t *filter, const enum rssiFilterType type,
+                     const uint32_t param);
+
+/**
+ * Reset the filter state, the next sample will re-initialise the filter
+ * output.
+ *
+ * @param filter: pointer to the filter state.
+ */
+void rssiFilter_reset(rssiFilter_t *filter);
+
+/**
+ * Push a new sample into the filter.
+ *
+ * @param filter: pointer to the filter state.
+ * @param sample: new RSSI sample, in 0.1dBm.
+ * @return filtered RSSI value, in 0.1dBm.
+ */
+int16_t rssiFilter_update(rssiFilter_t *filter, const int16_t sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSSI_H */
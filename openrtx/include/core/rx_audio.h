@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef RX_AUDIO_H
+#define RX_AUDIO_H
+
+#include "interfaces/audio.h"
+#include "core/dsp.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Processing chain for the received FM audio.
+ *
+ * The chain runs on the MCU, in fixed point, and it is made of the following
+ * optional stages, in processing order:
+ * - a 300Hz high-pass filter, removing the CTCSS subtones: sixth order
+ *   Chebyshev, 0.5dB ripple, more than 35dB of attenuation below 200Hz and
+ *   16dB at 254.1Hz;
+ * - a 50us or 75us de-emphasis, for the radios providing the discriminator
+ *   output without de-emphasis;
+ * - a noise reducer, based on an adaptive line enhancer.
+ *
+ * The RX audio engine runs the chain in a background thread, reading the
+ * demodulated audio through a SOURCE_RTX to SINK_MCU path and sending the
+ * processed one to the speaker through a SOURCE_MCU to SINK_SPK path.
+ */
+
+#define RXAUDIO_SAMPLE_RATE  8000    ///< Sample rate of the audio chain, in Hz
+#define RXAUDIO_BLOCK_SIZE   160     ///< Size of a processing block, 20ms
+
+/**
+ * Enumeration type for the stages of the RX audio chain.
+ */
+enum RxAudioStage
+{
+    RXAUDIO_HPF      = 0x01,    ///< 300Hz high-pass filter
+    RXAUDIO_DEEMPH50 = 0x02,    ///< 50us de-emphasis
+    RXAUDIO_DEEMPH75 = 0x04,    ///< 75us de-emphasis
+    RXAUDIO_NR       = 0x08     ///< Noise reduction
+};
+
+/**
+ * RX audio chain state.
+ */
+struct rxAudioChain
+{
+    uint8_t             stages;     ///< Enabled stages
+    struct biquad       hpf[3];     ///< High-pass filter sections
+    struct deemphasis   deemph;     ///< De-emphasis filter
+    struct noiseReducer nr;         ///< Noise reducer
+};
+
+/**
+ * Initialise an RX audio chain.
+ *
+ * @param chain: pointer to the chain state.
+ * @param stages: enabled stages, as a combination of RxAudioStage flags. When
+ * both the de-emphasis time constants are selected, the 75us one is used.
+ */
+void rxAudio_init(struct rxAudioChain *chain, const uint8_t stages);
+
+/**
+ * Process a block of samples, in place.
+ *
+ * @param chain: pointer to the chain state.
+ * @param samples: samples to be processed.
+ * @param len: number of samples.
+ */
+void rxAudio_process(struct rxAudioChain *chain, stream_sample_t *samples,
+                     const size_t len);
+
+/**
+ * Start the RX audio engine. The audio paths and streams are opened before
+ * returning, so that the caller can fall back to the direct RX audio path on
+ * failure.
+ *
+ * @param stages: enabled stages, as a combination of RxAudioStage flags.
+ * @return zero on success or a negative error code on failure.
+ */
+int rxAudio_start(const uint8_t stages);
+
+/**
+ * Stop the RX audio engine, closing its audio paths.
+ */
+void rxAudio_stop();
+
+/**
+ * Check if the RX audio engine is running.
+ *
+ * @return true if the engine is running.
+ */
+bool rxAudio_running();
+
+/**
+ * Get the CPU load of the RX audio engine, as the time spent in processing
+ * over the audio duration. The value is averaged over the blocks processed
+ * since the engine start.
+ *
+ * @return CPU load, in tenths of percent.
+ */
+uint16_t rxAudio_getLoad();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RX_AUDIO_H */
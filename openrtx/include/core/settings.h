@@ -51,6 +51,9 @@ typedef struct
     bool    showBatteryIcon;      // Battery display true: icon, false: percentage
     bool    gpsSetTime;           // Use GPS to ajust RTC time
     char    M17_meta_text[53];    // M17 Meta Text to send
+    bool    gpsLog;               // GPS track logging enabled
+    uint16_t gpsLogInterval;      // Minimum time between logged points, in s
+    uint16_t gpsLogDistance;      // Minimum distance between logged points, in m
 }
 __attribute__((packed)) settings_t;
 
@@ -79,6 +82,9 @@ static const settings_t default_settings =
     false,                        // Display battery icon
     false,                        // Update RTC with GPS
     "OpenRTX",                    // Default M17 meta text
+    false,                        // GPS track logging disabled
+    10,                           // Log a point at most every 10 seconds
+    20,                           // and every 20 meters
 };
 
 #endif /* SETTINGS_H */
@@ -48,6 +48,12 @@ typedef struct
     bool       restore_eflash;
     bool       txDisable;
     uint8_t    step_index;
+    bool       dual_watch;
+    freq_t     priority_freq;
+    bool       sweep_enabled;
+    freq_t     sweep_start;
+    freq_t     sweep_step;
+    uint8_t    rx_dsp;
 }
 state_t;
 
@@ -12,10 +12,18 @@
 /**
  * Threads' stack sizes
  */
-#define UI_THREAD_STKSIZE     2048
-#define RTX_THREAD_STKSIZE    512
-#define CODEC2_THREAD_STKSIZE 16384
-#define AUDIO_THREAD_STKSIZE  512
+#define UI_THREAD_STKSIZE       2048
+#define RTX_THREAD_STKSIZE      512
+#define CODEC2_THREAD_STKSIZE   16384
+#define AUDIO_THREAD_STKSIZE    512
+#define TONE_THREAD_STKSIZE     1024
+#define DISP_THREAD_STKSIZE     512
+#define VP_THREAD_STKSIZE       1024
+#define BACKUP_THREAD_STKSIZE   1024
+#define TRACKLOG_THREAD_STKSIZE 1024
+#define GPX_THREAD_STKSIZE      2048
+#define VOX_THREAD_STKSIZE      1024
+#define RXAUDIO_THREAD_STKSIZE  1024
 
 /**
  * Thread priority levels, UNIX-like: lower level, higher thread priority
@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef TONE_ENGINE_H
+#define TONE_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "core/audio_path.h"
+#include "interfaces/audio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Tone engine for the beeps.
+ *
+ * Beep sequences are queued and reproduced by a dedicated thread, making their
+ * timing independent from the one of the calling thread. On targets having a
+ * hardware beep generator the thread drives it, and the beeps are mixed to the
+ * speaker audio by the hardware. On the other targets the tones are computed
+ * in software by a table-driven phase accumulator (DDS) and sent to the
+ * speaker through an output audio stream or, when the speaker is already fed
+ * by another stream like the one of the codec, mixed into its samples.
+ *
+ * Software tones are scaled by the volume level, which is clamped to keep the
+ * beeps audible at the minimum volume and not too loud at the maximum one.
+ *
+ * CTCSS tones are not generated by the engine: the FM audio is analog on all
+ * the supported targets and the subtones are still produced by the radio
+ * hardware.
+ */
+
+#define TONE_SAMPLE_RATE  8000    ///< Sample rate of the tone engine, in Hz
+#define TONE_QUEUE_SIZE   16      ///< Maximum number of queued tones
+
+/**
+ * DDS oscillator state.
+ */
+typedef struct
+{
+    uint32_t phase;    ///< Phase accumulator, full scale is one period
+    uint32_t incr;     ///< Phase increment per sample
+}
+dds_t;
+
+/**
+ * Set the frequency of a DDS oscillator. The phase accumulator is not reset,
+ * so that frequency changes do not introduce discontinuities in the output.
+ *
+ * @param dds: pointer to the oscillator state.
+ * @param freq: tone frequency, in tenths of Hz.
+ * @param sampleRate: sample rate, in Hz.
+ */
+static inline void dds_setFrequency(dds_t *dds, const uint32_t freq,
+                                    const uint32_t sampleRate)
+{
+    dds->incr = (uint32_t)((((uint64_t) freq) << 32) / (sampleRate * 10));
+}
+
+/**
+ * Compute the next sample of a DDS oscillator.
+ *
+ * @param dds: pointer to the oscillator state.
+ * @return sine sample, full scale in Q15 format.
+ */
+int16_t dds_nextSample(dds_t *dds);
+
+/**
+ * Queue a tone for reproduction. Tones are reproduced in the same order they
+ * have been queued, with no gaps between them.
+ *
+ * @param freq: tone frequency, in Hz. A frequency of zero gives a silence of
+ * the specified duration.
+ * @param duration: tone duration, in milliseconds.
+ * @return true on success, false if the queue is full.
+ */
+bool toneEngine_queue(const uint16_t freq, const uint16_t duration);
+
+/**
+ * Start the reproduction of the queued tones on a given audio path. The
+ * reproduction stops automatically when the queue becomes empty. Calling this
+ * function while the engine is running switches its output mode, without
+ * interrupting the queued tones.
+ *
+ * @param path: audio path towards the speaker.
+ * @param mix: if true, the speaker is fed by another output stream and the
+ * tones are mixed into its samples through toneEngine_mix(). Not used on the
+ * targets having a hardware beep generator.
+ * @return true if the tone engine is running.
+ */
+bool toneEngine_start(const pathId path, const bool mix);
+
+/**
+ * Mix the queued tones into a block of samples of another output stream, when
+ * the engine has been started in mix mode. The function never blocks: during
+ * a change of the output mode the block is left untouched.
+ *
+ * @param buf: pointer to the sample block.
+ * @param len: number of samples in the block.
+ */
+void toneEngine_mix(stream_sample_t *buf, const size_t len);
+
+/**
+ * Immediately stop the reproduction of tones and clear the queue.
+ */
+void toneEngine_stop();
+
+/**
+ * Check if the tone engine is running.
+ *
+ * @return true if there are tones being reproduced.
+ */
+bool toneEngine_running();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TONE_ENGINE_H */
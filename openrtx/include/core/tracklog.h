@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef TRACKLOG_H
+#define TRACKLOG_H
+
+#include "interfaces/nvmem.h"
+#include "core/gps.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * GPS track logger.
+ *
+ * The positions received from the GPS are stored in a circular log occupying
+ * an area of a nonvolatile memory, split in blocks of TRACKLOG_BLOCK_SIZE
+ * bytes aligned to the erase sectors of the memory. The points are collected
+ * in a RAM buffer and each block is written by a background thread only when
+ * full, or when the logger is stopped, so that the logging never blocks the
+ * caller. When the log area is full, the oldest block is overwritten.
+ *
+ * Every block begins with a 16-byte header, all the fields are little endian:
+ *
+ * | Offset | Size | Content                                              |
+ * |--------|------|------------------------------------------------------|
+ * | 0      | 4    | Magic number, "TRK1"                                 |
+ * | 4      | 4    | Block sequence number                                |
+ * | 8      | 2    | Number of points                                     |
+ * | 10     | 2    | Payload length                                       |
+ * | 12     | 2    | CRC-CCITT of the payload                             |
+ * | 14     | 2    | Reserved                                             |
+ *
+ * Each point is made of time (seconds since 2000-01-01 00:00:00 UTC), latitude
+ * and longitude (millionths of degree), altitude (m) and speed (km/h). The
+ * first point of a block is stored with its absolute values, the following
+ * ones as the difference from the previous point, all the fields are zigzag
+ * encoded and packed as variable length integers.
+ */
+
+#define TRACKLOG_BLOCK_SIZE 4096    ///< Size of a log block, in bytes
+
+/**
+ * Function used for the export of the track log.
+ *
+ * @param ctx: context pointer.
+ * @param buf: data to be written.
+ * @param len: number of bytes to be written.
+ * @return number of bytes written or a negative error code on failure.
+ */
+typedef ssize_t (*tracklog_write_t)(void *ctx, const void *buf, size_t len);
+
+/**
+ * Start the track logger. The content of the log area is scanned and the new
+ * points are appended to the ones already present.
+ *
+ * @param dev: nonvolatile memory device for the log storage.
+ * @param offset: start address of the log area, aligned to a block boundary.
+ * @param size: size of the log area, a multiple of the block size.
+ * @param interval: minimum time between two points, in seconds.
+ * @param distance: minimum distance between two points, in meters.
+ * @return zero on success or a negative error code on failure.
+ */
+int tracklog_start(const struct nvmDevice *dev, const uint32_t offset,
+                   const size_t size, const uint16_t interval,
+                   const uint16_t distance);
+
+/**
+ * Stop the track logger, writing the points still in the RAM buffer.
+ *
+ * @return zero on success or a negative error code on failure.
+ */
+int tracklog_stop();
+
+/**
+ * Change the thresholds of the running track logger, nonblocking function.
+ *
+ * @param interval: minimum time between two points, in seconds.
+ * @param distance: minimum distance between two points, in meters.
+ */
+void tracklog_setThresholds(const uint16_t interval, const uint16_t distance);
+
+/**
+ * Check if the track logger is running.
+ *
+ * @return true if the logger is running.
+ */
+bool tracklog_running();
+
+/**
+ * Add a position to the track log, nonblocking function. The position is
+ * stored only if the GPS has a fix and both the minimum interval and the
+ * minimum distance from the last stored point are exceeded.
+ *
+ * @param gps: GPS data.
+ * @return true if the point has been stored.
+ */
+bool tracklog_addPoint(const gps_t *gps);
+
+/**
+ * Get the number of points stored since the logger has been started.
+ *
+ * @return number of points.
+ */
+uint32_t tracklog_numPoints();
+
+/**
+ * Get the number of points lost because the background writing was lagging
+ * behind or failed.
+ *
+ * @return number of points.
+ */
+uint32_t tracklog_lostPoints();
+
+/**
+ * Export the whole content of the track log in GPX format, from the oldest to
+ * the newest point. The log can be exported also while the logger is running.
+ *
+ * @param dev: nonvolatile memory device for the log storage.
+ * @param offset: start address of the log area.
+ * @param size: size of the log area.
+ * @param write: function for the output of the GPX data, for example towards
+ * the USB serial port.
+ * @param ctx: context pointer passed to the write function.
+ * @return number of points exported or a negative error code on failure.
+ */
+ssize_t tracklog_exportGpx(const struct nvmDevice *dev, const uint32_t offset,
+                           const size_t size, tracklog_write_t write,
+                           void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACKLOG_H */
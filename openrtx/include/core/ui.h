@@ -44,6 +44,17 @@ void ui_updateFSM(bool *sync_rtx);
  */
 bool ui_updateGUI();
 
+/**
+ * Get the time of the next UI update not triggered by an event, such as the
+ * step of a scrolling text or the expiration of the standby timer. When this
+ * time is reached ui_updateFSM() and ui_updateGUI() have to be called, even if
+ * no event is pending.
+ *
+ * @return absolute time of the next update, in ms, or zero if no update is
+ * scheduled.
+ */
+long long ui_getNextUpdate();
+
 /**
  * Push an event to the UI event queue.
  *
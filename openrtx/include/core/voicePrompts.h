@@ -303,6 +303,14 @@ void vp_play();
  */
 void vp_tick();
 
+/**
+ * Check if vp_tick() has some work to do, that is if a voice prompt or a beep
+ * is being played or is about to start.
+ *
+ * @return true if vp_tick() has to be called periodically.
+ */
+bool vp_tickPending();
+
 /**
  * Check if a voice prompt is being played.
  *
@@ -319,12 +327,14 @@ bool vp_sequenceNotEmpty();
 
 /**
  * play a beep at a given frequency for a given duration.
+ * Duration is expressed in units of 25ms, up to a maximum of 20 units.
  */
 void vp_beep(uint16_t freq, uint16_t duration);
 
 /**
  * Play a series of beeps at a given frequency for a given duration.
  * Array is freq, duration, ... 0, 0 to terminate series.
+ * Series longer than 255 beeps are truncated.
  */
 void vp_beepSeries(const uint16_t* beepSeries);
 
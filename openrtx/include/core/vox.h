@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef VOX_H
+#define VOX_H
+
+#include "interfaces/audio.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Voice operated transmission.
+ *
+ * The detector computes the AC power of the microphone signal over blocks of
+ * VOX_BLOCK_SIZE samples, in fixed point. Speech is detected when the power
+ * stays above the opening threshold for VOX_ATTACK_BLOCKS consecutive blocks
+ * and it ends when the power has been below the closing threshold, 6dB lower,
+ * for the whole hang time.
+ *
+ * The samples pass through a delay line of VOX_PREROLL_SAMPLES: when the
+ * transmission starts, the audio sent to the transmitter begins before the
+ * detection instant and the first syllable is not clipped.
+ *
+ * The VOX engine runs the detector in a background thread, reading the
+ * microphone through an input stream. While speech is detected it requests
+ * the transmission and relays the delayed microphone audio to the transceiver
+ * through a SOURCE_MCU to SINK_RTX path.
+ */
+
+#define VOX_SAMPLE_RATE      8000    ///< Sample rate of the microphone stream, in Hz
+#define VOX_BLOCK_SIZE       160     ///< Size of a detection block, 20ms
+#define VOX_ATTACK_BLOCKS    2       ///< Blocks above threshold to detect speech
+#define VOX_HANG_TIME        1000    ///< Default hang time, in ms
+#define VOX_PREROLL_SAMPLES  1600    ///< Length of the pre-roll, 200ms
+#define VOX_MAX_LEVEL        10      ///< Maximum sensitivity level
+
+/**
+ * VOX detector state.
+ */
+struct voxDetector
+{
+    uint32_t        openThr;                        ///< Opening threshold
+    uint32_t        closeThr;                       ///< Closing threshold
+    uint16_t        hangBlocks;                     ///< Hang time, in blocks
+    uint16_t        hangCount;                      ///< Blocks left before closing
+    uint8_t         attackCount;                    ///< Consecutive blocks above threshold
+    bool            active;                         ///< Speech detected
+    uint32_t        power;                          ///< Power of the last block
+    int32_t         sum;                            ///< Sum of the block samples
+    uint64_t        sumSq;                          ///< Sum of the squared block samples
+    uint16_t        blockLen;                       ///< Samples in the current block
+    uint16_t        delayPos;                       ///< Position in the delay line
+    stream_sample_t delay[VOX_PREROLL_SAMPLES];     ///< Pre-roll delay line
+};
+
+/**
+ * Initialize a VOX detector.
+ *
+ * @param det: pointer to the detector.
+ * @param level: sensitivity level, from 1 to VOX_MAX_LEVEL. The opening
+ * threshold is about -15dBFS at level 1 and it drops by 3dB at each level.
+ * @param hangTime: time the speech is still considered active after the signal
+ * dropped below the closing threshold, in ms.
+ */
+void vox_init(struct voxDetector *det, const uint8_t level,
+              const uint16_t hangTime);
+
+/**
+ * Process a group of samples. The samples are replaced in place with the ones
+ * coming out of the delay line, VOX_PREROLL_SAMPLES older.
+ *
+ * @param det: pointer to the detector.
+ * @param samples: samples to be processed.
+ * @param len: number of samples.
+ * @return true if speech is detected.
+ */
+bool vox_process(struct voxDetector *det, stream_sample_t *samples,
+                 const size_t len);
+
+/**
+ * Start the VOX engine.
+ *
+ * @param level: sensitivity level, from 1 to VOX_MAX_LEVEL.
+ * @return zero on success or a negative error code on failure.
+ */
+int vox_start(const uint8_t level);
+
+/**
+ * Stop the VOX engine, terminating the transmission eventually in progress.
+ */
+void vox_stop();
+
+/**
+ * Check if the VOX engine requests the transmission.
+ *
+ * @return true if speech is being detected.
+ */
+bool vox_active();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_H */
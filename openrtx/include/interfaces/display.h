@@ -56,12 +56,43 @@ void display_terminate();
  * Copy a given section, between two given rows, of framebuffer content to the
  * display. This function blocks the caller until render is completed.
  *
+ * Rows are expressed in pixels: displays organised in pages of multiple rows
+ * round the section to the enclosing pages.
+ *
  * @param startRow: first row of the framebuffer section to be copied
- * @param endRow: last row of the framebuffer section to be copied
+ * @param endRow: end row of the framebuffer section to be copied, excluded
  * @param fb: pointer to frameBuffer.
  */
 void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb);
 
+/**
+ * Prototype for the function called at the end of an asynchronous render.
+ * The function may be called from interrupt context and must not block.
+ *
+ * @param arg: user-defined argument, as passed to display_renderRowsAsync().
+ */
+typedef void (*display_done_cb)(void *arg);
+
+/**
+ * Start copying a given section, between two given rows, of framebuffer
+ * content to the display, returning without waiting for the end of the
+ * transfer. The framebuffer section must not be modified until the completion
+ * callback is called.
+ *
+ * Only one render can be in progress at a time: all the rendering functions
+ * wait for the end of a previous asynchronous render before starting a new one.
+ * Drivers not able to perform the transfer in background do the render before
+ * returning, calling the completion callback from the caller context.
+ *
+ * @param startRow: first row of the framebuffer section to be copied
+ * @param endRow: end row of the framebuffer section to be copied, excluded
+ * @param fb: pointer to frameBuffer.
+ * @param cb: function called when the render is completed, can be NULL.
+ * @param arg: argument for the completion callback.
+ */
+void display_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg);
+
 /**
  * Copy framebuffer content to the display internal buffer, to be called
  * whenever there is need to update the display.
@@ -28,6 +28,14 @@ extern "C" {
  * guaranteed that the access is performed in read only mode.
  */
 
+/**
+ * Number of RX frequencies, besides the main one, for which the radio drivers
+ * keep the calibration-derived parameters used by radio_retuneRx(). It must
+ * not be less than the number of bins of a spectrum sweep, so that repeated
+ * sweeps never recompute them.
+ */
+#define RADIO_RETUNE_CACHE_SIZE 64
+
 /**
  * Initialise low-level radio transceiver.
  *
@@ -72,6 +80,21 @@ void radio_disableAfOutput();
  */
 void radio_enableRx();
 
+/**
+ * Quickly retune the RX stage to a different frequency, without going through
+ * the full reconfiguration sequence performed by radio_updateConfiguration().
+ * Only the frequency synthesizer and the frequency-dependent parameters of the
+ * RX front-end are reprogrammed. The calibration-derived values for the main
+ * RX frequency and for the last RADIO_RETUNE_CACHE_SIZE retune frequencies are
+ * cached, allowing to hop between channels or to repeat a sweep without any
+ * recomputation.
+ * After the retune, radio_getRssi() reports the RSSI of the new frequency.
+ * This function has no effect if the RX stage is not enabled.
+ *
+ * @param freq: new RX frequency, in Hz.
+ */
+void radio_retuneRx(const freq_t freq);
+
 /**
  * Enable the TX stage.
  */
@@ -86,8 +86,9 @@ public:
      *
      * @param rawSample: signed 16-bit baseband sample.
      * @param invertPhase: invert the phase of the sample before decoding.
+     * @return true if a new frame has been fully decoded and not yet read.
      */
-    void sample(int16_t rawSample, bool invertPhase = false);
+    bool sample(int16_t rawSample, bool invertPhase = false);
 
     /**
      * @return true if a demodulator is locked on an M17 stream.
@@ -19,6 +19,10 @@
 #include <memory>
 #include <array>
 
+#if defined(PLATFORM_LINUX)
+#include <functional>
+#endif
+
 namespace M17
 {
 
@@ -83,6 +87,19 @@ public:
      */
     void invertPhase(const bool status);
 
+    #if defined(PLATFORM_LINUX)
+    /**
+     * Deliver the generated baseband to a function instead of appending it to
+     * /tmp/m17_output.raw. Samples are generated at 48kHz.
+     *
+     * @param sink: function receiving each block of baseband samples.
+     */
+    void setBasebandSink(std::function< void(const int16_t *, size_t) >&& sink)
+    {
+        basebandSink = sink;
+    }
+    #endif
+
 private:
 
     /**
@@ -113,6 +130,10 @@ private:
     #if defined(PLATFORM_MD3x0) || defined(PLATFORM_MDUV3x0)
     PwmCompensator pwmComp;
     #endif
+
+    #if defined(PLATFORM_LINUX)
+    std::function< void(const int16_t *, size_t) > basebandSink;
+    #endif
 };
 
 } /* M17 */
@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef M17_PACKET_H
+#define M17_PACKET_H
+
+#ifndef __cplusplus
+#error This header is C++ only!
+#endif
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include "PacketFrame.hpp"
+
+namespace M17
+{
+
+/**
+ * Protocol identifiers of M17 packet data, carried in the first byte of the
+ * application data.
+ */
+enum class PacketType : uint8_t
+{
+    RAW     = 0x00,     ///< Raw data, used for file transfers
+    AX25    = 0x01,     ///< AX.25
+    APRS    = 0x02,     ///< APRS
+    LOWPAN  = 0x03,     ///< 6LoWPAN
+    IPV4    = 0x04,     ///< IPv4
+    SMS     = 0x05,     ///< Text message, NULL terminated UTF-8 string
+    WINLINK = 0x06      ///< Winlink
+};
+
+/**
+ * M17 packet segmentation and reassembly.
+ *
+ * A packet is made of the protocol identifier byte, the application data and
+ * a big-endian M17 CRC-16 computed over both. It is carried by up to 33
+ * packet frames of 25 bytes each: the intermediate frames have the counter
+ * field set to their sequence number, while the last one has the EOF flag
+ * set and the counter field indicating the number of valid bytes it carries.
+ *
+ * For transmission, the packet content is set with set() and the frames are
+ * retrieved one by one with getFrame(). For reception, the received frames
+ * are passed to addFrame() until the packet is complete.
+ */
+class Packet
+{
+public:
+
+    static constexpr size_t MAX_FRAMES = 33;    ///< Maximum number of frames
+    static constexpr size_t MAX_SIZE   = MAX_FRAMES * PacketFrame::DATA_SIZE;
+    static constexpr size_t MAX_DATA   = MAX_SIZE - 3;   ///< Max data length
+
+    /**
+     * Reassembly status, returned when adding a received frame.
+     */
+    enum class Status : uint8_t
+    {
+        INCOMPLETE,     ///< Packet reassembly in progress
+        COMPLETE,       ///< Packet complete and with a valid CRC
+        ERROR           ///< Missing frame or bad CRC, packet discarded
+    };
+
+    /**
+     * Constructor.
+     */
+    Packet();
+
+    /**
+     * Destructor.
+     */
+    ~Packet();
+
+    /**
+     * Clear the packet content and the reassembly state.
+     */
+    void clear();
+
+    /**
+     * Set the packet content for transmission, computing its CRC.
+     *
+     * @param type: protocol identifier.
+     * @param data: application data.
+     * @param len: length of the application data, at most MAX_DATA bytes.
+     * @return true on success, false if the data is too long.
+     */
+    bool set(const PacketType type, const void *data, const size_t len);
+
+    /**
+     * Get the number of frames needed to transmit the packet.
+     *
+     * @return number of packet frames.
+     */
+    size_t numFrames() const;
+
+    /**
+     * Build one of the frames carrying the packet.
+     *
+     * @param index: frame index, from zero to numFrames() - 1.
+     * @param frame: packet frame to be filled.
+     */
+    void getFrame(const size_t index, PacketFrame& frame) const;
+
+    /**
+     * Add a received frame to the packet being reassembled. A frame with
+     * sequence number zero always starts a new packet.
+     *
+     * @param frame: received packet frame.
+     * @return reassembly status after adding the frame.
+     */
+    Status addFrame(const PacketFrame& frame);
+
+    /**
+     * Check if the packet is complete, either set for transmission or fully
+     * received with a valid CRC.
+     *
+     * @return true if the packet is complete.
+     */
+    bool isComplete() const
+    {
+        return complete;
+    }
+
+    /**
+     * Get the protocol identifier of a complete packet.
+     *
+     * @return protocol identifier.
+     */
+    PacketType getType() const
+    {
+        return static_cast< PacketType >(buffer[0]);
+    }
+
+    /**
+     * Get the application data of a complete packet.
+     *
+     * @return pointer to the application data.
+     */
+    const uint8_t *getData() const
+    {
+        return &buffer[1];
+    }
+
+    /**
+     * Get the length of the application data of a complete packet.
+     *
+     * @return data length, in bytes.
+     */
+    size_t getDataLength() const
+    {
+        return complete ? (size - 3) : 0;
+    }
+
+private:
+
+    std::array< uint8_t, MAX_SIZE > buffer;  ///< Type, data and CRC
+    size_t  size;                            ///< Bytes in the buffer
+    uint8_t nextFrame;                       ///< Next expected frame number
+    bool    complete;                        ///< Packet is complete
+};
+
+} // namespace M17
+
+#endif // M17_PACKET_H
@@ -77,11 +77,66 @@ public:
 
 private:
 
-    bool   rfSqlOpen;   ///< Flag for RF squelch status (analog squelch).
-    bool   sqlOpen;     ///< Flag for squelch status.
-    bool   enterRx;     ///< Flag for RX management.
-    pathId rxAudioPath; ///< Audio path ID for RX
-    pathId txAudioPath; ///< Audio path ID for TX
+    /**
+     * Dual watch management: periodically hop on the priority frequency to
+     * sample its RSSI and stay there as long as it is active.
+     *
+     * @param status: pointer to the rtxStatus_t structure containing the current
+     * RTX status.
+     * @param squelch: RF squelch opening level, in dBm.
+     */
+    void dualWatch(const rtxStatus_t *const status, const rssi_t squelch);
+
+    /**
+     * Spectrum sweep management: sample a batch of sweep bins, keeping the
+     * audio path closed.
+     *
+     * @param status: pointer to the rtxStatus_t structure containing the current
+     * RTX status.
+     * @param newCfg: flag used inform that a new RTX configuration has been
+     * applied.
+     */
+    void sweep(const rtxStatus_t *const status, const bool newCfg);
+
+    /**
+     * Open the RX audio, either through the RX audio processing chain or
+     * directly from the transceiver to the speaker, and set the squelch as
+     * open on success.
+     *
+     * @param status: pointer to the rtxStatus_t structure containing the current
+     * RTX status.
+     */
+    void openRxAudio(const rtxStatus_t *const status);
+
+    /**
+     * Close the RX audio, stopping the RX audio processing chain if running.
+     */
+    void closeRxAudio();
+
+    /**
+     * VOX management: start, stop or restart the VOX engine following the
+     * sensitivity level in the configuration.
+     *
+     * @param status: pointer to the rtxStatus_t structure containing the current
+     * RTX status.
+     */
+    void updateVox(const rtxStatus_t *const status);
+
+    static constexpr uint8_t   SWEEP_BATCH = 8;  ///< Sweep bins sampled per update.
+    static constexpr long long DW_PERIOD = 1000; ///< Priority check period, in ms.
+    static constexpr long long DW_HOLD   = 2000; ///< Hang time on priority channel, in ms.
+    static constexpr uint32_t  DW_SETTLE = 5;    ///< RSSI settling time after retune, in ms.
+
+    bool      rfSqlOpen;   ///< Flag for RF squelch status (analog squelch).
+    bool      sqlOpen;     ///< Flag for squelch status.
+    bool      enterRx;     ///< Flag for RX management.
+    bool      onPriority;  ///< Flag for RX tuned on the priority frequency.
+    bool      sweeping;    ///< Flag for spectrum sweep in progress.
+    long long dwTimeout;   ///< Timestamp of the next dual watch action.
+    uint8_t   voxLevel;    ///< Sensitivity of the running VOX engine, 0 if off.
+    uint8_t   rxStages;    ///< RX audio processing stages requested on squelch opening.
+    pathId    rxAudioPath; ///< Audio path ID for RX
+    pathId    txAudioPath; ///< Audio path ID for TX
 };
 
 #endif /* OPMODE_FM_H */
@@ -12,8 +12,11 @@
 #include "protocols/M17/Demodulator.hpp"
 #include "protocols/M17/Modulator.hpp"
 #include "protocols/M17/MetaText.hpp"
+#include "protocols/M17/Packet.hpp"
 #include "core/audio_path.h"
 #include "OpMode.hpp"
+#include <pthread.h>
+#include <unistd.h>
 
 /**
  * Specialisation of the OpMode class for the management of M17 operating mode.
@@ -82,6 +85,32 @@ public:
         return dataValid;
     }
 
+    /**
+     * Queue a data packet for transmission. The packet is sent as soon as the
+     * channel is free, without the need of pressing the PTT. This function is
+     * thread-safe.
+     *
+     * @param type: packet protocol identifier.
+     * @param data: packet data.
+     * @param len: length of the packet data.
+     * @return zero on success, -EBUSY if another packet is waiting to be sent,
+     * -EINVAL if the data is too long.
+     */
+    int sendPacket(const M17::PacketType type, const void *data,
+                   const size_t len);
+
+    /**
+     * Get the latest data packet received and addressed to this station. Each
+     * packet is returned only once. This function is thread-safe.
+     *
+     * @param type: packet protocol identifier.
+     * @param buf: destination buffer for the packet data.
+     * @param maxLen: size of the destination buffer.
+     * @return length of the packet data, zero if no new packet has been
+     * received, -ENOSPC if the destination buffer is too small.
+     */
+    ssize_t getPacket(M17::PacketType *type, void *buf, const size_t maxLen);
+
 private:
 
     /**
@@ -108,6 +137,22 @@ private:
      */
     void txState(rtxStatus_t *const status);
 
+    /**
+     * Function handling the TX operating state when transmitting a data
+     * packet. One packet frame is sent on each call.
+     *
+     * @param status: pointer to the rtxStatus_t structure containing the
+     * current RTX status.
+     */
+    void packetTxState(rtxStatus_t *const status);
+
+    /**
+     * Check if a data packet is waiting to be transmitted.
+     *
+     * @return true if a packet is waiting to be transmitted.
+     */
+    bool packetPending();
+
     /**
      * Compare two callsigns in plain text form.
      * The comparison does not take into account the country prefixes (strips
@@ -140,6 +185,13 @@ private:
     M17::FrameEncoder encoder;      ///< M17 frame encoder
     uint16_t gpsTimer;                 ///< GPS data transmission interval timer
     M17::MetaText metaText;            ///< M17 metatext accumulator
+    pthread_mutex_t packetMutex;       ///< Mutex for packet data exchange
+    M17::Packet txPacket;              ///< Packet being transmitted
+    M17::Packet rxPacket;              ///< Packet being received
+    M17::Packet lastRxPacket;          ///< Latest packet received
+    bool txPacketPending;              ///< Packet waiting for transmission
+    bool packetTx;                     ///< Current transmission is a packet
+    uint8_t txPacketFrame;             ///< Next packet frame to be sent
 };
 
 #endif /* OPMODE_M17_H */
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include "core/cps.h"
 #include <pthread.h>
+#include <unistd.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,15 +23,21 @@ typedef struct
 
     uint8_t bandwidth : 2,  /**< Channel bandwidth             */
             txDisable : 1,  /**< Disable TX operation          */
-            scan      : 1,  /**< Scan enabled                  */
+            scan      : 1,  /**< Spectrum sweep enabled        */
             opStatus  : 2,  /**< Operating status (OFF, ...)   */
-            _padding  : 2;  /**< Padding to 8 bits             */
+            dualWatch : 1,  /**< FM dual watch enabled         */
+            _padding  : 1;  /**< Padding to 8 bits             */
 
     freq_t rxFrequency;     /**< RX frequency, in Hz           */
     freq_t txFrequency;     /**< TX frequency, in Hz           */
+    freq_t priorityFreq;    /**< Dual watch priority frequency */
+    freq_t sweepStart;      /**< Spectrum sweep start, in Hz   */
+    freq_t sweepStep;       /**< Spectrum sweep step, in Hz    */
 
     uint32_t txPower;       /**< TX power, in mW               */
     uint8_t  sqlLevel;      /**< Squelch opening level         */
+    uint8_t  voxLevel;      /**< VOX sensitivity, 0 = disabled */
+    uint8_t  rxDsp;         /**< FM RX audio processing stages */
 
     uint16_t rxToneEn : 1,  /**< RX CTC/DCS tone enable        */
              rxTone   : 15; /**< RX CTC/DCS tone               */
@@ -76,6 +83,14 @@ enum opmode
     OPMODE_M17  = 3         /**< M17                */
 };
 
+/**
+ * M17 packet protocol identifiers.
+ */
+#define M17_PACKET_RAW      0x00    /**< Raw data           */
+#define M17_PACKET_SMS      0x05    /**< Text message       */
+
+#define M17_PACKET_MAX_DATA 822     /**< Maximum packet data length */
+
 /**
  * \enum opstatus Enumeration type defining the current rtx operating status.
  */
@@ -126,6 +141,16 @@ void rtx_task();
  */
 rssi_t rtx_getRssi();
 
+/**
+ * Check if the part of the RTX status shown to the user changed since the last
+ * call of this function: operating status, RX squelch state and M17 link
+ * information. This function is thread-safe and is meant to let the UI be
+ * notified as soon as a status transition takes place.
+ *
+ * @return true if the status changed.
+ */
+bool rtx_statusChanged();
+
 /**
  * Get current status of the RX squelch. This function is thread-safe and can
  * be called also from threads other than the one running the RTX task.
@@ -133,6 +158,30 @@ rssi_t rtx_getRssi();
  */
 bool rtx_rxSquelchOpen();
 
+/**
+ * Queue an M17 data packet for transmission, the packet is sent when M17 mode
+ * is active and the channel is free. This function is thread-safe.
+ *
+ * @param type: packet protocol identifier, M17_PACKET_SMS for text messages
+ * or M17_PACKET_RAW for raw data.
+ * @param data: packet data. Text messages must include the NULL terminator.
+ * @param len: length of the packet data, at most M17_PACKET_MAX_DATA bytes.
+ * @return zero on success, a negative error code otherwise.
+ */
+int rtx_sendM17Packet(const uint8_t type, const void *data, const size_t len);
+
+/**
+ * Get the latest M17 data packet received. Each packet is returned only once.
+ * This function is thread-safe.
+ *
+ * @param type: packet protocol identifier.
+ * @param buf: destination buffer for the packet data.
+ * @param maxLen: size of the destination buffer.
+ * @return length of the packet data, zero if no new packet has been received
+ * or a negative error code.
+ */
+ssize_t rtx_getM17Packet(uint8_t *type, void *buf, const size_t maxLen);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "core/datatypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Spectrum sweep engine: the receiver is stepped across a frequency range, the
+ * RSSI is sampled at each step and the results are accumulated in a set of
+ * frequency bins, each one keeping a rolling max-hold and average value.
+ *
+ * Sampling functions are meant to be called from the RTX thread, while the
+ * sweep data can be safely retrieved from any thread.
+ */
+
+#define SWEEP_NUM_BINS  64       ///< Number of frequency bins in a sweep
+#define SWEEP_RSSI_MIN  -127     ///< Minimum RSSI value stored in a bin, in dBm
+
+typedef struct
+{
+    freq_t   start;                     /**< Frequency of the first bin, in Hz  */
+    freq_t   step;                      /**< Frequency step between bins, in Hz */
+    uint32_t sweeps;                    /**< Number of completed sweeps         */
+    int16_t  maxHold[SWEEP_NUM_BINS];   /**< Max-hold RSSI of each bin, in dBm  */
+    int16_t  average[SWEEP_NUM_BINS];   /**< Average RSSI of each bin, in dBm   */
+}
+sweepData_t;
+
+/**
+ * Set a new sweep range and clear all the accumulated data.
+ *
+ * @param start: frequency of the first bin, in Hz.
+ * @param step: frequency step between two consecutive bins, in Hz.
+ */
+void sweep_reset(const freq_t start, const freq_t step);
+
+/**
+ * Sample the next bin of the sweep: the receiver is retuned to the bin
+ * frequency and, after the RSSI settling time, the RSSI is acquired and
+ * accumulated. The radio must be in RX mode.
+ *
+ * @return true if the sampled bin was the last one of a sweep.
+ */
+bool sweep_sampleNext();
+
+/**
+ * Get a copy of the current sweep data.
+ *
+ * @param data: pointer to the destination data structure.
+ */
+void sweep_getData(sweepData_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SWEEP_H */
@@ -95,5 +95,9 @@ const stringsTable_t englishStrings =
     .CAN               = "CAN",
     .canRxCheck        = "CAN RX Check",
     .metaText          = "Meta Txt",
+    .trackLog          = "Track Log",
+    .logInterval       = "Log Interval",
+    .logDistance       = "Log Distance",
+    .exportTrack       = "Export Track",
 };
 #endif  // ENGLISHSTRINGS_H
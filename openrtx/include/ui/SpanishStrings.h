@@ -95,5 +95,9 @@ const stringsTable_t spanishStrings =
     .radio             = "Radio",
     .CAN               = "CAN",
     .canRxCheck        = "CAN RX Check",
+    .trackLog          = "Registro ruta",
+    .logInterval       = "Intervalo reg.",
+    .logDistance       = "Distancia reg.",
+    .exportTrack       = "Exportar ruta",
 };
 #endif  // SPANISHSTRINGS_H
@@ -37,6 +37,7 @@ enum uiScreen
     MENU_CHANNEL,
     MENU_CONTACTS,
     MENU_GPS,
+    MENU_SPECTRUM,
     MENU_SETTINGS,
     MENU_BACKUP_RESTORE,
     MENU_BACKUP,
@@ -71,6 +72,7 @@ enum menuItems
 #ifdef CONFIG_GPS
     M_GPS,
 #endif
+    M_SPECTRUM,
     M_SETTINGS,
     M_INFO,
     M_ABOUT
@@ -118,7 +120,13 @@ enum settingsGPSItems
     G_ENABLED = 0,
 #ifdef CONFIG_RTC
     G_SET_TIME,
-    G_TIMEZONE
+    G_TIMEZONE,
+#endif
+#ifdef CONFIG_TRACKLOG_NVM_AREA
+    G_LOG,
+    G_LOG_INTERVAL,
+    G_LOG_DISTANCE,
+    G_LOG_EXPORT
 #endif
 };
 #endif
@@ -148,7 +156,10 @@ enum settingsM17Items
 enum settingsFMItems
 {
     CTCSS_Tone,
-    CTCSS_Enabled
+    CTCSS_Enabled,
+    FM_DUAL_WATCH,
+    FM_RX_DSP,
+    FM_VOX
 };
 
 /**
@@ -100,6 +100,10 @@ typedef struct
     const char* CAN;
     const char* canRxCheck;
     const char* metaText;
+    const char* trackLog;
+    const char* logInterval;
+    const char* logDistance;
+    const char* exportTrack;
 }
 stringsTable_t;
 
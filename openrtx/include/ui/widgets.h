@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef UI_WIDGETS_H
+#define UI_WIDGETS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "core/graphics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Retained UI widgets.
+ *
+ * A widget is a rectangular area of the screen remembering a hash of the
+ * content it was last rendered with. When a screen is redrawn, each widget is
+ * given the hash of its new content and it is repainted only if the content
+ * changed: the widget area is cleared and the caller draws the new content
+ * inside it. In this way a periodic status update, changing only the clock or
+ * the RSSI level, repaints only the affected widgets instead of the whole
+ * screen.
+ *
+ * When the screen is cleared, all the widgets are invalidated at once by
+ * widget_invalidateAll(), forcing them to be repainted on the next update.
+ */
+
+#define WIDGET_HASH_INIT 2166136261u    ///< Initial value for widget hashes
+
+/**
+ * Retained widget state.
+ */
+typedef struct
+{
+    point_t  pos;       ///< Top left corner of the widget area
+    uint16_t width;     ///< Width of the widget area, in pixels
+    uint16_t height;    ///< Height of the widget area, in pixels
+    uint32_t value;     ///< Hash of the last rendered content
+    uint32_t gen;       ///< Screen generation of the last rendering
+    bool     dirty;     ///< Repaint forced by widget_invalidate()
+}
+widget_t;
+
+/**
+ * Set the area occupied by a widget on the screen.
+ *
+ * @param widget: pointer to the widget.
+ * @param pos: top left corner of the widget area.
+ * @param width: width of the widget area, in pixels.
+ * @param height: height of the widget area, in pixels.
+ */
+void widget_setBounds(widget_t *widget, const point_t pos, const uint16_t width,
+                      const uint16_t height);
+
+/**
+ * Force the repaint of a widget on its next update, regardless of its content.
+ *
+ * @param widget: pointer to the widget.
+ */
+void widget_invalidate(widget_t *widget);
+
+/**
+ * Invalidate all the widgets. To be called after the screen has been cleared:
+ * invalidated widgets are repainted without clearing their area.
+ */
+void widget_invalidateAll();
+
+/**
+ * Update the content of a widget. If the content changed since the last
+ * rendering, the widget area is cleared and the caller has to draw the new
+ * content inside it.
+ *
+ * @param widget: pointer to the widget.
+ * @param value: hash of the new widget content.
+ * @return true if the widget has to be repainted.
+ */
+bool widget_update(widget_t *widget, const uint32_t value);
+
+/**
+ * Accumulate a block of data into a widget hash.
+ *
+ * @param hash: current hash value, WIDGET_HASH_INIT for a new hash.
+ * @param data: pointer to the data.
+ * @param len: data length, in bytes.
+ * @return updated hash value.
+ */
+uint32_t widget_hash(uint32_t hash, const void *data, const size_t len);
+
+/**
+ * Accumulate a string into a widget hash.
+ *
+ * @param hash: current hash value, WIDGET_HASH_INIT for a new hash.
+ * @param str: NULL-terminated string.
+ * @return updated hash value.
+ */
+uint32_t widget_hashStr(uint32_t hash, const char *str);
+
+/**
+ * Text label widget: the text is repainted only if it differs from the one
+ * currently shown.
+ *
+ * @param widget: pointer to the widget.
+ * @param start: text start point, in pixel coordinates.
+ * @param size: text font size.
+ * @param alignment: text alignment.
+ * @param color: text color.
+ * @param text: text to be shown.
+ * @return true if the label has been repainted.
+ */
+bool widget_label(widget_t *widget, point_t start, fontSize_t size,
+                  textAlign_t alignment, color_t color, const char *text);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UI_WIDGETS_H */
@@ -6,6 +6,7 @@
 
 #include "core/audio_stream.h"
 #include "core/audio_codec.h"
+#include "core/tone_engine.h"
 #include <pthread.h>
 #include "core/threads.h"
 // codec2 system library has a weird include prefix
@@ -51,6 +52,7 @@ static void *encodeFunc(void *arg);
 static void *decodeFunc(void *arg);
 static bool startThread(const pathId path, void *(*func) (void *));
 static void stopThread();
+static void setStopped();
 
 
 void codec_init()
@@ -118,13 +120,19 @@ int codec_popFrame(uint8_t *frame, const bool blocking)
     if((numElements == 0) && (blocking == false))
         return -EAGAIN;
 
-    // Blocking call: wait until some data is pushed
+    // Blocking call: wait until some data is pushed or the codec is stopped
     pthread_mutex_lock(&data_mutex);
-    while(numElements == 0)
+    while((numElements == 0) && running)
     {
         pthread_cond_wait(&wakeup_cond, &data_mutex);
     }
 
+    if(numElements == 0)
+    {
+        pthread_mutex_unlock(&data_mutex);
+        return -EPERM;
+    }
+
     element      = dataBuffer[readPos];
     readPos      = (readPos + 1) % BUF_SIZE;
     numElements -= 1;
@@ -152,13 +160,20 @@ int codec_pushFrame(const uint8_t *frame, const bool blocking)
     if((numElements >= BUF_SIZE) && (blocking == false))
         return -EAGAIN;
 
-    // Blocking call: wait until there is some free space
+    // Blocking call: wait until there is some free space or the codec is
+    // stopped
     pthread_mutex_lock(&data_mutex);
-    while(numElements >= BUF_SIZE)
+    while((numElements >= BUF_SIZE) && running)
     {
         pthread_cond_wait(&wakeup_cond, &data_mutex);
     }
 
+    if(running == false)
+    {
+        pthread_mutex_unlock(&data_mutex);
+        return -EPERM;
+    }
+
     // There is free space, push data into the queue
     dataBuffer[writePos] = element;
     writePos = (writePos + 1) % BUF_SIZE;
@@ -185,7 +200,7 @@ static void *encodeFunc(void *arg)
     if(iStream < 0)
     {
         pthread_detach(pthread_self());
-        running = false;
+        setStopped();
         return NULL;
     }
 
@@ -246,7 +261,7 @@ static void *encodeFunc(void *arg)
     if(reqStop == false)
         pthread_detach(pthread_self());
 
-    running = false;
+    setStopped();
     return NULL;
 }
 
@@ -264,7 +279,7 @@ static void *decodeFunc(void *arg)
     if(oStream < 0)
     {
         pthread_detach(pthread_self());
-        running = false;
+        setStopped();
         return NULL;
     }
 
@@ -320,6 +335,9 @@ static void *decodeFunc(void *arg)
             memset(audioBuf, 0x00, 160 * sizeof(stream_sample_t));
         }
 
+        // Beeps requested while decoding share the speaker with the codec
+        toneEngine_mix(audioBuf, 160);
+
         outputStream_sync(oStream, true);
     }
 
@@ -332,7 +350,7 @@ static void *decodeFunc(void *arg)
     if(reqStop == false)
         pthread_detach(pthread_self());
 
-    running = false;
+    setStopped();
     return NULL;
 }
 
@@ -397,7 +415,7 @@ static bool startThread(const pathId path, void *(*func) (void *))
     // Start thread
     int ret = pthread_create(&codecThread, &codecAttr, func, &audioPath);
     if(ret < 0)
-        running = false;
+        setStopped();
 
     return running;
 }
@@ -406,7 +424,7 @@ static void stopThread()
 {
     reqStop = true;
     pthread_join(codecThread, NULL);
-    running = false;
+    setStopped();
 
     #ifdef __ZEPHYR__
     void  *addr;
@@ -416,3 +434,16 @@ static void stopThread()
     free(addr);
     #endif
 }
+
+/**
+ * \internal
+ * Mark the codec as stopped and wake up the threads blocked in pushing or
+ * popping frames.
+ */
+static void setStopped()
+{
+    pthread_mutex_lock(&data_mutex);
+    running = false;
+    pthread_cond_broadcast(&wakeup_cond);
+    pthread_mutex_unlock(&data_mutex);
+}
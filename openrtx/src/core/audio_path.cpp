@@ -1,12 +1,22 @@
 /*
  * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
- * 
+ *
  * SPDX-License-Identifier: GPL-3.0-or-later
  */
 
 #include "core/audio_path.h"
-#include <map>
-#include <set>
+#include <pthread.h>
+
+/**
+ * Maximum number of routes, active or suspended, existing at the same time.
+ * Route sets are handled as bitmasks, one bit per slot of the route table.
+ */
+#define MAX_ROUTES  8
+#define SLOT_BITS   3
+#define SLOT_MASK   ((1 << SLOT_BITS) - 1)
+#define GEN_MASK    (INT32_MAX >> SLOT_BITS)
+
+static_assert(MAX_ROUTES == (1 << SLOT_BITS), "Route table size mismatch");
 
 /**
  * \internal
@@ -19,6 +29,8 @@ struct Path
     int8_t destination = -1;   ///< Destination endpoint of the path.
     int8_t priority    = -1;   ///< Path priority level.
 
+    Path() { }
+
     Path(enum AudioSource src, enum AudioSink sink, enum AudioPriority prio)
     {
         source = static_cast<int8_t>(src);
@@ -67,37 +79,97 @@ struct Path
 
         return audio_checkPathCompatibility(p1Source, p1Sink, p2Source, p2Sink);
     }
-
-    bool operator<(const Path& other) const
-    {
-        if((isValid() == false) || (other.isValid() == false))
-            return false;
-
-        return (source      < other.source) &&
-               (destination < other.destination);
-    }
 };
 
 /**
  * \internal
- * Data structure representing an established audio route.
+ * Data structure representing an entry of the route table.
  */
 struct Route
 {
-    Path path;                    ///< Path associated to this route.
-    std::set< int > suspendList;  ///< Suspended paths with lower priority.
-    std::set< int > suspendedBy;  ///< List of paths which suspended this route.
+    Path    path;                 ///< Path associated to this route.
+    int32_t generation  = 0;      ///< Slot generation, part of the path ID.
+    bool    used        = false;  ///< Slot in use.
+    uint8_t suspendList = 0;      ///< Suspended routes with lower priority.
+    uint8_t suspendedBy = 0;      ///< Routes which suspended this one.
 
     bool isActive() const
     {
-        return suspendedBy.empty();
+        return suspendedBy == 0;
     }
 };
 
 
-static std::set< int >        activePaths;      // IDs of currently active paths.
-static std::map< int, Route > routes;           // Route data of currently active paths.
-static int                    pathCounter = 1;  // Counter for path ID generation.
+static Route   routes[MAX_ROUTES];      // Route table.
+static uint8_t byPriority[MAX_ROUTES];  // Slots in use, by decreasing priority.
+static uint8_t numRoutes  = 0;          // Number of slots in use.
+static uint8_t activeMask = 0;          // Slots of the currently active routes.
+
+// Paths are requested and released by several threads: UI, RTX, voice prompts,
+// tone, VOX and RX audio engines.
+static pthread_mutex_t tableMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+/**
+ * \internal
+ * Find the slot of the route table corresponding to a path ID.
+ *
+ * @param id: path ID.
+ * @return slot index or -1 if the path does not exist.
+ */
+static int findSlot(const pathId id)
+{
+    if(id <= 0)
+        return -1;
+
+    int slot = id & SLOT_MASK;
+    if((routes[slot].used == false) ||
+       (routes[slot].generation != (id >> SLOT_BITS)))
+    {
+        return -1;
+    }
+
+    return slot;
+}
+
+/**
+ * \internal
+ * Remove a slot from the priority ordered list.
+ */
+static void removeFromList(const uint8_t slot)
+{
+    uint8_t pos = 0;
+    while((pos < numRoutes) && (byPriority[pos] != slot))
+        pos++;
+
+    if(pos >= numRoutes)
+        return;
+
+    for(; pos < (numRoutes - 1); pos++)
+        byPriority[pos] = byPriority[pos + 1];
+
+    numRoutes -= 1;
+}
+
+/**
+ * \internal
+ * Insert a slot in the priority ordered list, after the routes with the same
+ * or higher priority.
+ */
+static void insertInList(const uint8_t slot)
+{
+    const int8_t prio = routes[slot].path.priority;
+    uint8_t      pos  = numRoutes;
+
+    while((pos > 0) && (routes[byPriority[pos - 1]].path.priority < prio))
+    {
+        byPriority[pos] = byPriority[pos - 1];
+        pos--;
+    }
+
+    byPriority[pos] = slot;
+    numRoutes += 1;
+}
 
 
 pathId audioPath_request(enum AudioSource source, enum AudioSink sink,
@@ -107,135 +179,194 @@ pathId audioPath_request(enum AudioSource source, enum AudioSink sink,
     if (!path.isValid())
         return -1;
 
-    std::set< int > pathsToSuspend;
+    pthread_mutex_lock(&tableMutex);
+
+    // Look for a free slot
+    int slot = -1;
+    for(int i = 0; i < MAX_ROUTES; i++)
+    {
+        if(routes[i].used == false)
+        {
+            slot = i;
+            break;
+        }
+    }
+
+    if(slot < 0)
+    {
+        pthread_mutex_unlock(&tableMutex);
+        return -1;
+    }
 
-    // Check if this new path can be activated, otherwise return -1
-    for (const auto& id : activePaths)
+    // Check if this new path can be activated, otherwise return -1. Routes
+    // are scanned by decreasing priority: any conflict with an higher or equal
+    // priority route is found before marking a route to be suspended.
+    uint8_t toSuspend = 0;
+    for(uint8_t i = 0; i < numRoutes; i++)
     {
-        const Path& activePath = routes.at(id).path;
+        const uint8_t s = byPriority[i];
+        if((activeMask & (1 << s)) == 0)
+            continue;
+
+        const Path& activePath = routes[s].path;
         if(path.isCompatible(activePath))
             continue;
 
         // Not compatible where active one has higher priority
         if(activePath.priority >= path.priority)
+        {
+            pthread_mutex_unlock(&tableMutex);
             return -1;
+        }
 
         // Active path has lower priority than this new one
-        pathsToSuspend.insert(id);
+        toSuspend |= (1 << s);
     }
 
-    // New path can be activated
-    const int newPathId = pathCounter;
-    pathCounter += 1;
-    const Route newRoute{path, pathsToSuspend, {}};
+    // New path can be activated. The generation of the slot changes at each
+    // use, so that the IDs of released paths do not match the new ones. It is
+    // never zero, to keep the IDs positive.
+    int32_t generation = (routes[slot].generation + 1) & GEN_MASK;
+    if(generation == 0)
+        generation = 1;
+
+    Route& route      = routes[slot];
+    route.path        = path;
+    route.generation  = generation;
+    route.used        = true;
+    route.suspendList = toSuspend;
+    route.suspendedBy = 0;
 
     // Move active paths that should be suspended to the suspend-list and
     // close them to free resources for the new path.
-    for(const auto& id : pathsToSuspend)
+    for(uint8_t s = 0; s < MAX_ROUTES; s++)
     {
-        activePaths.erase(id);
-        routes.at(id).suspendedBy.insert(newPathId);
-        routes.at(id).path.close();
+        if((toSuspend & (1 << s)) == 0)
+            continue;
+
+        activeMask &= ~(1 << s);
+        routes[s].suspendedBy |= (1 << slot);
+        routes[s].path.close();
     }
 
     // Set this new path as active and open it
-    routes.insert(std::make_pair(newPathId, newRoute));
-    activePaths.insert(newPathId);
+    insertInList(slot);
+    activeMask |= (1 << slot);
     path.open();
 
-    return newPathId;
+    pthread_mutex_unlock(&tableMutex);
+
+    return (generation << SLOT_BITS) | slot;
 }
 
 pathInfo_t audioPath_getInfo(const pathId id)
 {
     pathInfo_t info = {0, 0, 0, 0};
 
-    const auto it = routes.find(id);
-    if(it == routes.end())
+    pthread_mutex_lock(&tableMutex);
+
+    int slot = findSlot(id);
+    if(slot < 0)
     {
+        pthread_mutex_unlock(&tableMutex);
         info.status = PATH_CLOSED;
         return info;
     }
 
-    info.source = it->second.path.source;
-    info.sink   = it->second.path.destination;
-    info.prio   = it->second.path.priority;
-    if(it->second.isActive())
+    info.source = routes[slot].path.source;
+    info.sink   = routes[slot].path.destination;
+    info.prio   = routes[slot].path.priority;
+    if(routes[slot].isActive())
         info.status = PATH_OPEN;
     else
         info.status = PATH_SUSPENDED;
 
+    pthread_mutex_unlock(&tableMutex);
+
     return info;
 }
 
 enum PathStatus audioPath_getStatus(const pathId id)
 {
-    const auto it = routes.find(id);
+    enum PathStatus status = PATH_SUSPENDED;
+
+    pthread_mutex_lock(&tableMutex);
 
-    if(it == routes.end())
-        return PATH_CLOSED;
+    int slot = findSlot(id);
+    if(slot < 0)
+        status = PATH_CLOSED;
+    else if(routes[slot].isActive())
+        status = PATH_OPEN;
 
-    if(it->second.isActive())
-        return PATH_OPEN;
+    pthread_mutex_unlock(&tableMutex);
 
-    return PATH_SUSPENDED;
+    return status;
 }
 
 void audioPath_release(const pathId id)
 {
-    auto it = routes.find(id);
-    if(it == routes.end())  // Does not exists
+    pthread_mutex_lock(&tableMutex);
+
+    int slot = findSlot(id);
+    if(slot < 0)    // Does not exists
+    {
+        pthread_mutex_unlock(&tableMutex);
         return;
+    }
 
-    Route routeToRemove = it->second;
-    routes.erase(it);
-    activePaths.erase(id);
+    // Free the slot, keeping its generation for the next ID
+    const Route   routeToRemove = routes[slot];
+    const uint8_t bit           = (1 << slot);
+    routes[slot].path        = Path();
+    routes[slot].used        = false;
+    routes[slot].suspendList = 0;
+    routes[slot].suspendedBy = 0;
+    removeFromList(slot);
+    activeMask &= ~bit;
 
     // If path is active, close it
     if(routeToRemove.isActive())
         routeToRemove.path.close();
 
-    /*
-     * For each path that suspended the one to be removed:
-     * - remove the ID from its suspend list.
-     * - add to its suspend list the paths suspended by the one being removed.
-     */
-    for(const auto& i : routeToRemove.suspendedBy)
+    for(uint8_t i = 0; i < MAX_ROUTES; i++)
     {
-        auto& suspendList = routes.at(i).suspendList;
-        suspendList.erase(id);
-
-        for(const auto& j : routeToRemove.suspendList)
-            suspendList.insert(j);
-    }
-
-    /*
-     * For each path suspended by the one to be removed:
-     * - remove the ID from their suspended-by list.
-     * - add to their suspended-by list the paths which suspended the one being
-     *   removed.
-     * - if the path to be removed was not suspended by any other path, resume
-     *   the path.
-     */
-    for(const auto& i : routeToRemove.suspendList)
-    {
-        auto& suspendedBy = routes.at(i).suspendedBy;
-        suspendedBy.erase(id);
-
-        if(routeToRemove.suspendedBy.empty() == false)
+        const uint8_t iBit = (1 << i);
+
+        /*
+         * For each path that suspended the one to be removed:
+         * - remove the ID from its suspend list.
+         * - add to its suspend list the paths suspended by the one being
+         *   removed.
+         */
+        if(routeToRemove.suspendedBy & iBit)
         {
-            // If I was suspended, propagate who suspended me
-            for(const auto& j : routeToRemove.suspendedBy)
-                suspendedBy.insert(j);
+            routes[i].suspendList &= ~bit;
+            routes[i].suspendList |= routeToRemove.suspendList;
         }
-        else
+
+        /*
+         * For each path suspended by the one to be removed:
+         * - remove the ID from their suspended-by list.
+         * - add to their suspended-by list the paths which suspended the one
+         *   being removed.
+         * - if the path to be removed was not suspended by any other path,
+         *   resume the path.
+         */
+        if(routeToRemove.suspendList & iBit)
         {
+            routes[i].suspendedBy &= ~bit;
+
+            // If I was suspended, propagate who suspended me
+            routes[i].suspendedBy |= routeToRemove.suspendedBy;
+
             // This path can be started again
-            if(suspendedBy.empty())
+            if((routeToRemove.suspendedBy == 0) && routes[i].isActive())
             {
-                activePaths.insert(i);
-                routes.at(i).path.open();
+                activeMask |= iBit;
+                routes[i].path.open();
             }
         }
     }
+
+    pthread_mutex_unlock(&tableMutex);
 }
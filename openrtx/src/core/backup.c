@@ -4,56 +4,242 @@
  * SPDX-License-Identifier: GPL-3.0-or-later
  */
 
+#include "interfaces/nvmem.h"
+#include "interfaces/delays.h"
+#include "drivers/NVM/W25Qx.h"
+#include "drivers/usb_vcom.h"
+#include "core/backup_stream.h"
+#include "core/nvmem_device.h"
+#include "core/threads.h"
 #include "core/backup.h"
-#include "core/xmodem.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
-#include "drivers/NVM/W25Qx.h"
+#include <errno.h>
+
+#define NUM_BLOCKS  3   // Number of received blocks waiting to be written
+
+/*
+ * Block received during a restore, waiting to be written to the flash. Each
+ * block covers a whole number of flash sectors, which are erased before
+ * programming the block content.
+ */
+typedef struct
+{
+    uint32_t offset;
+    size_t   len;
+    bool     erased;
+    uint8_t  data[BSTREAM_FRAME_SIZE];
+}
+block_t;
+
+static const struct nvmDevice *eflash;  // External flash device
 
-#if defined(PLATFORM_GD77) || defined(PLATFORM_DM1801)
-static const size_t EFLASH_SIZE = 1024*1024;    // 1 MB
-#else
-static const size_t EFLASH_SIZE = 16*1024*1024; // 16 MB
-#endif
+static pthread_mutex_t writeMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  writeCond  = PTHREAD_COND_INITIALIZER;
+static block_t        *blocks;          // Queue of blocks to be written
+static uint8_t         blockHead;       // Oldest block in the queue
+static uint8_t         blockCount;      // Number of queued blocks
+static bool            writerStop;
+static int             writeError;      // First error of the writer thread
 
-size_t  memAddr = 0;
 
-static int getDataCallback(uint8_t *ptr, size_t size)
+static ssize_t vcomRead(void *ctx, void *buf, size_t len)
 {
-    if((memAddr + size) > EFLASH_SIZE) return -1;
-    W25Qx_readData(memAddr, ptr, size);
-    memAddr += size;
-    return 0;
+    (void) ctx;
+
+    // Nonblocking read, avoid keeping the CPU busy when there is no data
+    ssize_t ret = vcom_readBlock(buf, len);
+    if(ret == 0)
+        sleepFor(0, 1);
+
+    return ret;
+}
+
+static ssize_t vcomWrite(void *ctx, const void *buf, size_t len)
+{
+    (void) ctx;
+    return vcom_writeBlock(buf, len);
+}
+
+static int flashRead(void *ctx, uint32_t offset, void *buf, size_t len)
+{
+    (void) ctx;
+    return nvm_devRead(eflash, offset, buf, len);
+}
+
+/**
+ * \internal
+ * Queue a received block for writing, waiting for a free slot if the writer
+ * thread is lagging behind.
+ */
+static int flashWrite(void *ctx, uint32_t offset, const void *buf, size_t len)
+{
+    (void) ctx;
+
+    pthread_mutex_lock(&writeMutex);
+
+    while((blockCount >= NUM_BLOCKS) && (writeError == 0))
+        pthread_cond_wait(&writeCond, &writeMutex);
+
+    int ret = writeError;
+    if(ret == 0)
+    {
+        block_t *block = &blocks[(blockHead + blockCount) % NUM_BLOCKS];
+        block->offset  = offset;
+        block->len     = len;
+        block->erased  = (buf == NULL);
+
+        if(buf != NULL)
+            memcpy(block->data, buf, len);
+
+        blockCount += 1;
+        pthread_cond_broadcast(&writeCond);
+    }
+
+    pthread_mutex_unlock(&writeMutex);
+
+    return ret;
+}
+
+/**
+ * \internal
+ * Wait for all the queued blocks to be written.
+ */
+static int flashFlush(void *ctx)
+{
+    (void) ctx;
+
+    pthread_mutex_lock(&writeMutex);
+
+    while((blockCount > 0) && (writeError == 0))
+        pthread_cond_wait(&writeCond, &writeMutex);
+
+    int ret = writeError;
+    pthread_mutex_unlock(&writeMutex);
+
+    return ret;
 }
 
-static void writeDataCallback(uint8_t *ptr, size_t size)
+/**
+ * \internal
+ * Thread erasing and programming the received blocks, overlapping the flash
+ * operations with the reception of the next blocks.
+ */
+static void *writerFunc(void *arg)
 {
-    // Trigger sector erase on each 4kB address boundary
-    if((memAddr % 0x1000) == 0)
+    (void) arg;
+
+    pthread_mutex_lock(&writeMutex);
+
+    while(1)
     {
-        W25Qx_erase(memAddr, 0x1000);
+        while((blockCount == 0) && (writerStop == false))
+            pthread_cond_wait(&writeCond, &writeMutex);
+
+        if(blockCount == 0)
+            break;
+
+        block_t *block = &blocks[blockHead];
+        pthread_mutex_unlock(&writeMutex);
+
+        int ret = nvm_devErase(eflash, block->offset, BSTREAM_FRAME_SIZE);
+        if((ret == 0) && (block->erased == false))
+            ret = nvm_devWrite(eflash, block->offset, block->data, block->len);
+
+        pthread_mutex_lock(&writeMutex);
+
+        if((ret < 0) && (writeError == 0))
+            writeError = ret;
+
+        blockHead   = (blockHead + 1) % NUM_BLOCKS;
+        blockCount -= 1;
+        pthread_cond_broadcast(&writeCond);
     }
 
-    for(size_t written = 0; written < size; )
+    pthread_mutex_unlock(&writeMutex);
+
+    return NULL;
+}
+
+/**
+ * \internal
+ * Get the external flash memory area and wake up the flash chip. On the GDx
+ * radios the USB serial port is not started at boot, it is started here.
+ */
+static const struct nvmDescriptor *openFlash()
+{
+    #if defined(PLATFORM_GD77) || defined(PLATFORM_DM1801)
+    static bool vcomReady = false;
+    if(vcomReady == false)
     {
-        size_t toWrite = size - written;
-        if(toWrite > 256) toWrite = 256;
-        W25Qx_writePage(memAddr, ptr, toWrite);
-        written += toWrite;
-        memAddr += toWrite;
-        ptr     += toWrite;
+        vcom_init();
+        vcomReady = true;
     }
+    #endif
+
+    // External flash is the first memory area on all the supported devices
+    const struct nvmDescriptor *area = &nvmTab.areas[0];
+
+    eflash = area->dev;
+    W25Qx_wakeup(eflash);
+    delayUs(5);
+
+    return area;
 }
 
-void eflash_dump()
+
+ssize_t eflash_dump(const bool skipErased)
 {
-    memAddr = 0;
-    W25Qx_wakeup();
-    xmodem_sendData(EFLASH_SIZE, getDataCallback);
+    const struct nvmDescriptor *area = openFlash();
+
+    const bsLink_t    link    = { vcomRead, vcomWrite, NULL };
+    const bsStorage_t storage = { flashRead, NULL, NULL, NULL };
+
+    return bstream_send(&link, &storage, area->size, skipErased);
 }
 
-void eflash_restore()
+ssize_t eflash_restore()
 {
-    memAddr = 0;
-    W25Qx_wakeup();
-    xmodem_receiveData(EFLASH_SIZE, writeDataCallback);
+    const struct nvmDescriptor *area = openFlash();
+
+    blocks = malloc(NUM_BLOCKS * sizeof(block_t));
+    if(blocks == NULL)
+        return -ENOMEM;
+
+    blockHead  = 0;
+    blockCount = 0;
+    writerStop = false;
+    writeError = 0;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+
+    #ifdef _MIOSIX
+    pthread_attr_setstacksize(&attr, BACKUP_THREAD_STKSIZE);
+    #endif
+
+    pthread_t writer;
+    if(pthread_create(&writer, &attr, writerFunc, NULL) != 0)
+    {
+        free(blocks);
+        return -ENOMEM;
+    }
+
+    const bsLink_t    link    = { vcomRead, vcomWrite, NULL };
+    const bsStorage_t storage = { NULL, flashWrite, flashFlush, NULL };
+
+    ssize_t ret = bstream_receive(&link, &storage, area->size);
+
+    // Let the writer complete the pending blocks, if any, and terminate
+    pthread_mutex_lock(&writeMutex);
+    writerStop = true;
+    pthread_cond_broadcast(&writeCond);
+    pthread_mutex_unlock(&writeMutex);
+
+    pthread_join(writer, NULL);
+    free(blocks);
+
+    return ret;
 }
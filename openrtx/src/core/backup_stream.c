@@ -0,0 +1,588 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "interfaces/delays.h"
+#include "core/backup_stream.h"
+#include "core/crc.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#define SYNC_BYTE   0xB5
+#define HDR_SIZE    12
+#define CRC_SIZE    4
+#define BUF_SIZE    (HDR_SIZE + BSTREAM_FRAME_SIZE + CRC_SIZE)
+
+enum frameType
+{
+    FRAME_START  = 0x01,    // Receiver ready, transfer can begin
+    FRAME_DATA   = 0x02,    // Memory content
+    FRAME_ERASED = 0x03,    // Erased memory block, payload is the block size
+    FRAME_END    = 0x04,    // End of transfer, offset is the total size
+    FRAME_ACK    = 0x05,    // Frames received up to sequence number excluded
+    FRAME_NAK    = 0x06,    // Retransmission request from sequence number
+    FRAME_ABORT  = 0x07     // Transfer aborted
+};
+
+typedef struct
+{
+    uint8_t  type;
+    uint16_t length;
+    uint32_t seq;
+    uint32_t offset;
+    uint8_t *payload;
+}
+frame_t;
+
+typedef struct
+{
+    const bsLink_t *link;
+    uint8_t        *buf;    // Frame being received
+    size_t          len;    // Number of bytes in the buffer
+}
+parser_t;
+
+
+static inline void putU16(uint8_t *ptr, const uint16_t val)
+{
+    ptr[0] = val & 0xFF;
+    ptr[1] = val >> 8;
+}
+
+static inline void putU32(uint8_t *ptr, const uint32_t val)
+{
+    for(uint8_t i = 0; i < 4; i++)
+        ptr[i] = (val >> (8 * i)) & 0xFF;
+}
+
+static inline uint32_t getU32(const uint8_t *ptr)
+{
+    return ((uint32_t) ptr[0])       | ((uint32_t) ptr[1] << 8)
+         | ((uint32_t) ptr[2] << 16) | ((uint32_t) ptr[3] << 24);
+}
+
+/**
+ * \internal
+ * Encode and send a frame. The payload, if any, has to be already placed in
+ * the buffer after the space for the header.
+ *
+ * @param link: serial link.
+ * @param buf: frame buffer.
+ * @param type: frame type.
+ * @param seq: sequence number.
+ * @param offset: memory offset.
+ * @param length: payload length.
+ * @return zero on success, a negative error code otherwise.
+ */
+static int sendFrame(const bsLink_t *link, uint8_t *buf, const uint8_t type,
+                     const uint32_t seq, const uint32_t offset,
+                     const uint16_t length)
+{
+    buf[0] = SYNC_BYTE;
+    buf[1] = type;
+    putU16(&buf[2], length);
+    putU32(&buf[4], seq);
+    putU32(&buf[8], offset);
+    putU32(&buf[HDR_SIZE + length], crc_32(buf, HDR_SIZE + length));
+
+    size_t size = HDR_SIZE + length + CRC_SIZE;
+    if(link->write(link->ctx, buf, size) != (ssize_t) size)
+        return -EIO;
+
+    return 0;
+}
+
+/**
+ * \internal
+ * Send a control frame, without payload.
+ */
+static int sendControl(const bsLink_t *link, const uint8_t type,
+                       const uint32_t seq)
+{
+    uint8_t buf[HDR_SIZE + CRC_SIZE];
+    return sendFrame(link, buf, type, seq, 0, 0);
+}
+
+/**
+ * \internal
+ * Discard the first byte of the receive buffer and move to the beginning of
+ * the buffer the next sync byte, if any.
+ */
+static void resync(parser_t *p)
+{
+    uint8_t *next = memchr(p->buf + 1, SYNC_BYTE, p->len - 1);
+    if(next == NULL)
+    {
+        p->len = 0;
+        return;
+    }
+
+    p->len -= next - p->buf;
+    memmove(p->buf, next, p->len);
+}
+
+/**
+ * \internal
+ * Check the consistency between the type and the payload length of a frame
+ * header. A corrupted length field would otherwise make the parser wait for
+ * a large amount of data not belonging to the frame.
+ */
+static bool validHeader(const uint8_t *hdr)
+{
+    uint16_t length = hdr[2] | (hdr[3] << 8);
+
+    switch(hdr[1])
+    {
+        case FRAME_DATA:
+            return (length > 0) && (length <= BSTREAM_FRAME_SIZE);
+
+        case FRAME_ERASED:
+            return length == 4;
+
+        case FRAME_START:
+        case FRAME_END:
+        case FRAME_ACK:
+        case FRAME_NAK:
+        case FRAME_ABORT:
+            return length == 0;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * \internal
+ * Receive a frame. Data is read from the link only up to the end of the frame
+ * being received, no data belonging to the next frame is buffered.
+ *
+ * @param p: frame parser.
+ * @param frame: received frame, the payload points inside the parser buffer
+ * and is valid until the next call.
+ * @param timeout: maximum waiting time, in ms.
+ * @return 1 if a frame was received, 0 on timeout, -EBADMSG if a corrupted
+ * frame was received, another negative error code on link failure.
+ */
+static int recvFrame(parser_t *p, frame_t *frame, const long long timeout)
+{
+    long long end = getTick() + timeout;
+
+    while(1)
+    {
+        // Hunt for the sync byte at the beginning of a frame
+        if((p->len > 0) && (p->buf[0] != SYNC_BYTE))
+        {
+            resync(p);
+            continue;
+        }
+
+        size_t frameSize = HDR_SIZE;
+        if(p->len >= HDR_SIZE)
+        {
+            // Discard corrupted headers without waiting for the whole frame
+            if(validHeader(p->buf) == false)
+            {
+                resync(p);
+                continue;
+            }
+
+            frameSize += (p->buf[2] | (p->buf[3] << 8)) + CRC_SIZE;
+        }
+
+        if(p->len < frameSize)
+        {
+            ssize_t ret = p->link->read(p->link->ctx, p->buf + p->len,
+                                        frameSize - p->len);
+            if(ret < 0)
+                return -EIO;
+
+            if((ret == 0) && (getTick() >= end))
+                return 0;
+
+            p->len += ret;
+            continue;
+        }
+
+        uint32_t crc = crc_32(p->buf, frameSize - CRC_SIZE);
+        if(crc != getU32(&p->buf[frameSize - CRC_SIZE]))
+        {
+            resync(p);
+            return -EBADMSG;
+        }
+
+        frame->type    = p->buf[1];
+        frame->length  = frameSize - HDR_SIZE - CRC_SIZE;
+        frame->seq     = getU32(&p->buf[4]);
+        frame->offset  = getU32(&p->buf[8]);
+        frame->payload = &p->buf[HDR_SIZE];
+        p->len         = 0;
+
+        return 1;
+    }
+}
+
+/**
+ * \internal
+ * Check if a block of memory is erased, that is if all its bytes are 0xFF.
+ */
+static bool isErased(const uint8_t *data, const size_t len)
+{
+    for(size_t i = 0; i < len; i++)
+    {
+        if(data[i] != 0xFF)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * \internal
+ * Send a frame of the transfer. The frame content depends only on its
+ * sequence number, so retransmitted frames are read again from the memory.
+ */
+static int sendDataFrame(const bsLink_t *link, const bsStorage_t *storage,
+                         uint8_t *buf, const uint32_t seq, const size_t size,
+                         const bool skipErased)
+{
+    uint32_t offset = seq * BSTREAM_FRAME_SIZE;
+
+    if(offset >= size)
+        return sendFrame(link, buf, FRAME_END, seq, size, 0);
+
+    size_t len = size - offset;
+    if(len > BSTREAM_FRAME_SIZE)
+        len = BSTREAM_FRAME_SIZE;
+
+    uint8_t *payload = buf + HDR_SIZE;
+    int ret = storage->read(storage->ctx, offset, payload, len);
+    if(ret < 0)
+        return ret;
+
+    if(skipErased && isErased(payload, len))
+    {
+        putU32(payload, len);
+        return sendFrame(link, buf, FRAME_ERASED, seq, offset, 4);
+    }
+
+    return sendFrame(link, buf, FRAME_DATA, seq, offset, len);
+}
+
+ssize_t bstream_send(const bsLink_t *link, const bsStorage_t *storage,
+                     const size_t size, const bool skipErased)
+{
+    uint8_t *txBuf = malloc(BUF_SIZE);
+    uint8_t *rxBuf = malloc(BUF_SIZE);
+    if((txBuf == NULL) || (rxBuf == NULL))
+    {
+        free(txBuf);
+        free(rxBuf);
+        return -ENOMEM;
+    }
+
+    parser_t parser = { link, rxBuf, 0 };
+    frame_t  frame;
+    ssize_t  result = -ETIMEDOUT;
+
+    // Wait for the receiver to be ready
+    long long start = getTick();
+    while((getTick() - start) < BSTREAM_START_TIMEOUT)
+    {
+        int ret = recvFrame(&parser, &frame, BSTREAM_TIMEOUT);
+        if(ret == -EIO)
+        {
+            result = ret;
+            break;
+        }
+
+        if(ret <= 0)
+            continue;
+
+        if(frame.type == FRAME_START)
+        {
+            result = 0;
+            break;
+        }
+    }
+
+    // Frames from zero to numFrames - 1 carry data, the last one is the END
+    uint32_t  numFrames = (size + BSTREAM_FRAME_SIZE - 1) / BSTREAM_FRAME_SIZE;
+    uint32_t  base      = 0;    // First unacknowledged frame
+    uint32_t  next      = 0;    // Next frame to be sent
+    uint8_t   retries   = 0;
+    long long lastAck   = getTick();
+
+    while((result == 0) && (base <= numFrames))
+    {
+        while((next < (base + BSTREAM_WINDOW)) && (next <= numFrames))
+        {
+            int ret = sendDataFrame(link, storage, txBuf, next, size,
+                                    skipErased);
+            if(ret < 0)
+            {
+                result = ret;
+                break;
+            }
+
+            next += 1;
+        }
+
+        if(result < 0)
+            break;
+
+        long long timeout = lastAck + BSTREAM_TIMEOUT - getTick();
+        if(timeout < 0)
+            timeout = 0;
+
+        int ret = recvFrame(&parser, &frame, timeout);
+        if(ret == -EIO)
+        {
+            result = ret;
+            break;
+        }
+
+        if(ret == 0)
+        {
+            // No acknowledgement, retransmit all the frames in flight
+            retries += 1;
+            if(retries > BSTREAM_MAX_RETRIES)
+            {
+                result = -ETIMEDOUT;
+                break;
+            }
+
+            next    = base;
+            lastAck = getTick();
+            continue;
+        }
+
+        if(ret < 0)
+            continue;
+
+        switch(frame.type)
+        {
+            case FRAME_ACK:
+                if((frame.seq > base) && (frame.seq <= next))
+                {
+                    base    = frame.seq;
+                    retries = 0;
+                    lastAck = getTick();
+                }
+                break;
+
+            case FRAME_NAK:
+                if((frame.seq >= base) && (frame.seq < next))
+                {
+                    retries += 1;
+                    if(retries > BSTREAM_MAX_RETRIES)
+                    {
+                        result = -ETIMEDOUT;
+                        break;
+                    }
+
+                    // Frames before the missing one have been received
+                    base    = frame.seq;
+                    next    = frame.seq;
+                    lastAck = getTick();
+                }
+                break;
+
+            case FRAME_ABORT:
+                result = -ECONNABORTED;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if((result < 0) && (result != -EIO))
+        sendControl(link, FRAME_ABORT, base);
+
+    free(txBuf);
+    free(rxBuf);
+
+    if(result < 0)
+        return result;
+
+    return size;
+}
+
+/**
+ * \internal
+ * Store the content of a frame received in sequence.
+ *
+ * @return zero on success, a negative error code otherwise.
+ */
+static int storeFrame(const bsStorage_t *storage, const frame_t *frame,
+                      const size_t maxSize)
+{
+    const void *data = frame->payload;
+    size_t      len  = frame->length;
+
+    if(frame->type == FRAME_ERASED)
+    {
+        data = NULL;
+        len  = getU32(frame->payload);
+    }
+
+    if((frame->offset != (frame->seq * BSTREAM_FRAME_SIZE)) ||
+       (len > BSTREAM_FRAME_SIZE) || ((frame->offset + len) > maxSize))
+    {
+        return -EINVAL;
+    }
+
+    return storage->write(storage->ctx, frame->offset, data, len);
+}
+
+ssize_t bstream_receive(const bsLink_t *link, const bsStorage_t *storage,
+                        const size_t maxSize)
+{
+    uint8_t *rxBuf = malloc(BUF_SIZE);
+    if(rxBuf == NULL)
+        return -ENOMEM;
+
+    parser_t  parser    = { link, rxBuf, 0 };
+    frame_t   frame;
+    ssize_t   result    = -EINPROGRESS;
+    uint32_t  expected  = 0;        // Next frame expected
+    bool      started   = false;    // At least one frame was received
+    bool      nakSent   = false;    // Retransmission already requested
+    long long startTime = getTick();
+    long long lastRx    = startTime;
+
+    while(result == -EINPROGRESS)
+    {
+        // Keep announcing the start of the transfer until the sender responds
+        if(started == false)
+        {
+            if((getTick() - startTime) >= BSTREAM_START_TIMEOUT)
+            {
+                result = -ETIMEDOUT;
+                break;
+            }
+
+            if(sendControl(link, FRAME_START, 0) < 0)
+            {
+                result = -EIO;
+                break;
+            }
+        }
+
+        int ret = recvFrame(&parser, &frame, BSTREAM_TIMEOUT);
+        if(ret == -EIO)
+        {
+            result = ret;
+            break;
+        }
+
+        if(ret == 0)
+        {
+            if(started &&
+               ((getTick() - lastRx) > (BSTREAM_TIMEOUT * BSTREAM_MAX_RETRIES)))
+            {
+                result = -ETIMEDOUT;
+            }
+
+            continue;
+        }
+
+        if(ret < 0)
+        {
+            // Corrupted frame, request the retransmission only once
+            if(started && (nakSent == false))
+            {
+                sendControl(link, FRAME_NAK, expected);
+                nakSent = true;
+            }
+
+            continue;
+        }
+
+        if((frame.type == FRAME_START) || (frame.type == FRAME_ACK) ||
+           (frame.type == FRAME_NAK))
+            continue;
+
+        if(frame.type == FRAME_ABORT)
+        {
+            result = -ECONNABORTED;
+            break;
+        }
+
+        started = true;
+        lastRx  = getTick();
+
+        if(frame.seq < expected)
+        {
+            // Duplicate frame, the previous acknowledgement got lost
+            sendControl(link, FRAME_ACK, expected);
+            continue;
+        }
+
+        if(frame.seq > expected)
+        {
+            if(nakSent == false)
+            {
+                sendControl(link, FRAME_NAK, expected);
+                nakSent = true;
+            }
+
+            continue;
+        }
+
+        nakSent = false;
+
+        if(frame.type == FRAME_END)
+        {
+            if(frame.offset > maxSize)
+                ret = -EINVAL;
+            else
+                ret = storage->flush(storage->ctx);
+
+            if(ret < 0)
+            {
+                result = ret;
+                break;
+            }
+
+            result = frame.offset;
+        }
+        else
+        {
+            ret = storeFrame(storage, &frame, maxSize);
+            if(ret < 0)
+            {
+                result = ret;
+                break;
+            }
+        }
+
+        expected += 1;
+        sendControl(link, FRAME_ACK, expected);
+    }
+
+    if(result >= 0)
+    {
+        // Acknowledge again the END frame if the first ACK gets lost
+        long long end = getTick() + (2 * BSTREAM_TIMEOUT);
+        while(getTick() < end)
+        {
+            int ret = recvFrame(&parser, &frame, end - getTick());
+            if(ret == -EIO)
+                break;
+
+            if((ret > 0) && (frame.type == FRAME_END))
+                sendControl(link, FRAME_ACK, expected);
+        }
+    }
+    else if(result != -EIO)
+    {
+        sendControl(link, FRAME_ABORT, expected);
+    }
+
+    free(rxBuf);
+    return result;
+}
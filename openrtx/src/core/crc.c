@@ -6,6 +6,26 @@
 
 #include "core/crc.h"
 
+/*
+ * Number of bytes processed per iteration by the table-driven CRC functions,
+ * set per target to trade flash space for speed:
+ *
+ *  - 0: nibble tables and bitwise arithmetic, less than 150 bytes of tables
+ *  - 1: one 256-entry table per CRC, 2kB of tables
+ *  - 4: slice-by-4, 8kB of tables
+ *  - 8: slice-by-8, 16kB of tables
+ */
+#ifndef CONFIG_CRC_SLICES
+#define CONFIG_CRC_SLICES 1
+#endif
+
+#if (CONFIG_CRC_SLICES != 0) && (CONFIG_CRC_SLICES != 1) && \
+    (CONFIG_CRC_SLICES != 4) && (CONFIG_CRC_SLICES != 8)
+#error "CONFIG_CRC_SLICES must be 0, 1, 4 or 8"
+#endif
+
+#if CONFIG_CRC_SLICES == 0
+
 uint16_t crc_m17(const void *data, const size_t len)
 {
     static const uint16_t CRC_M17_TABLE[] = { 0x0000, 0x5935, 0xb26a, 0xeb5f,
@@ -38,3 +58,132 @@ uint16_t crc_ccitt(const void *data, const size_t len)
 
     return crc;
 }
+
+uint32_t crc_32(const void *data, const size_t len)
+{
+    static const uint32_t CRC_32_TABLE[] = { 0x00000000, 0x1db71064,
+                                             0x3b6e20c8, 0x26d930ac,
+                                             0x76dc4190, 0x6b6b51f4,
+                                             0x4db26158, 0x5005713c,
+                                             0xedb88320, 0xf00f9344,
+                                             0xd6d6a3e8, 0xcb61b38c,
+                                             0x9b64c2b0, 0x86d3d2d4,
+                                             0xa00ae278, 0xbdbdf21c };
+    uint32_t crc = 0xFFFFFFFF;
+    const uint8_t *d = (const uint8_t *)data;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= d[i];
+        crc = CRC_32_TABLE[crc & 0x0f] ^ (crc >> 4);
+        crc = CRC_32_TABLE[crc & 0x0f] ^ (crc >> 4);
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+#else
+
+#define CRC_TABLE_SLICES CONFIG_CRC_SLICES
+#include "crc_tables.h"
+
+/**
+ * \internal
+ * Update a non reflected 16-bit CRC with a block of data.
+ *
+ * @param table: lookup tables of the CRC polynomial.
+ * @param crc: current CRC value.
+ * @param d: input data.
+ * @param len: data length, in bytes.
+ * @return updated CRC value.
+ */
+static inline uint16_t crc16(const uint16_t table[][256], uint16_t crc,
+                             const uint8_t *d, size_t len)
+{
+    /*
+     * Slicing: the two bytes of the CRC register are combined with the first
+     * two data bytes, each byte is then looked up in the table accounting for
+     * the number of bytes following it in the block.
+     */
+    #if CRC_TABLE_SLICES == 8
+    while(len >= 8)
+    {
+        crc = table[7][(crc >> 8) ^ d[0]]   ^ table[6][(crc & 0xFF) ^ d[1]]
+            ^ table[5][d[2]] ^ table[4][d[3]] ^ table[3][d[4]]
+            ^ table[2][d[5]] ^ table[1][d[6]] ^ table[0][d[7]];
+        d   += 8;
+        len -= 8;
+    }
+    #elif CRC_TABLE_SLICES == 4
+    while(len >= 4)
+    {
+        crc = table[3][(crc >> 8) ^ d[0]]   ^ table[2][(crc & 0xFF) ^ d[1]]
+            ^ table[1][d[2]] ^ table[0][d[3]];
+        d   += 4;
+        len -= 4;
+    }
+    #endif
+
+    while(len > 0)
+    {
+        crc = (crc << 8) ^ table[0][(crc >> 8) ^ *d];
+        d   += 1;
+        len -= 1;
+    }
+
+    return crc;
+}
+
+uint16_t crc_m17(const void *data, const size_t len)
+{
+    return crc16(CRC_M17_TABLE, 0xFFFF, (const uint8_t *) data, len);
+}
+
+uint16_t crc_ccitt(const void *data, const size_t len)
+{
+    return crc16(CRC_CCITT_TABLE, 0x0000, (const uint8_t *) data, len);
+}
+
+uint32_t crc_32(const void *data, const size_t len)
+{
+    const uint32_t (*table)[256] = CRC_32_TABLE;
+    const uint8_t  *d   = (const uint8_t *) data;
+    size_t          n   = len;
+    uint32_t        crc = 0xFFFFFFFF;
+
+    // Words are assembled byte by byte: no alignment or endianness constraint
+    #if CRC_TABLE_SLICES == 8
+    while(n >= 8)
+    {
+        uint32_t lo = crc ^ (d[0] | (d[1] << 8) | (d[2] << 16) | ((uint32_t) d[3] << 24));
+        uint32_t hi =        d[4] | (d[5] << 8) | (d[6] << 16) | ((uint32_t) d[7] << 24);
+
+        crc = table[7][lo & 0xFF] ^ table[6][(lo >> 8) & 0xFF]
+            ^ table[5][(lo >> 16) & 0xFF] ^ table[4][lo >> 24]
+            ^ table[3][hi & 0xFF] ^ table[2][(hi >> 8) & 0xFF]
+            ^ table[1][(hi >> 16) & 0xFF] ^ table[0][hi >> 24];
+        d += 8;
+        n -= 8;
+    }
+    #elif CRC_TABLE_SLICES == 4
+    while(n >= 4)
+    {
+        crc ^= d[0] | (d[1] << 8) | (d[2] << 16) | ((uint32_t) d[3] << 24);
+
+        crc = table[3][crc & 0xFF] ^ table[2][(crc >> 8) & 0xFF]
+            ^ table[1][(crc >> 16) & 0xFF] ^ table[0][crc >> 24];
+        d += 4;
+        n -= 4;
+    }
+    #endif
+
+    while(n > 0)
+    {
+        crc = (crc >> 8) ^ table[0][(crc ^ *d) & 0xFF];
+        d += 1;
+        n -= 1;
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+#endif
@@ -5,6 +5,7 @@
  */
 
 #include "core/dsp.h"
+#include <cmath>
 
 int16_t dsp_dcBlockFilter(struct dcBlock *dcb, int16_t sample)
 {
@@ -23,3 +24,94 @@ int16_t dsp_dcBlockFilter(struct dcBlock *dcb, int16_t sample)
 
     return static_cast<int16_t>(dcb->prevOut);
 }
+
+void dsp_biquadInit(struct biquad *bq, const int16_t coeffs[5])
+{
+    memset(bq, 0x00, sizeof(struct biquad));
+
+    bq->b0 = coeffs[0];
+    bq->b1 = coeffs[1];
+    bq->b2 = coeffs[2];
+    bq->a1 = coeffs[3];
+    bq->a2 = coeffs[4];
+}
+
+int32_t dsp_biquadFilter(struct biquad *bq, int32_t sample)
+{
+    // Products accumulated on 64 bits, single cycle operations on Cortex-M4
+    int64_t acc = bq->err;
+    acc += static_cast<int64_t>(bq->b0) * sample;
+    acc += static_cast<int64_t>(bq->b1) * bq->x1;
+    acc += static_cast<int64_t>(bq->b2) * bq->x2;
+    acc -= static_cast<int64_t>(bq->a1) * bq->y1;
+    acc -= static_cast<int64_t>(bq->a2) * bq->y2;
+
+    int32_t out = static_cast<int32_t>(acc >> 14);
+    bq->err     = static_cast<int32_t>(acc - (static_cast<int64_t>(out) * (1 << 14)));
+
+    bq->x2 = bq->x1;
+    bq->x1 = sample;
+    bq->y2 = bq->y1;
+    bq->y1 = out;
+
+    return out;
+}
+
+void dsp_deemphasisInit(struct deemphasis *de, const uint16_t tau,
+                        const uint32_t sampleRate)
+{
+    // Impulse invariant transform of the analog RC network
+    float alpha = 1.0f - expf(-1000000.0f / (static_cast<float>(tau) * sampleRate));
+
+    de->alpha = dsp_saturate(static_cast<int32_t>(alpha * 32768.0f + 0.5f));
+    de->state = 0;
+}
+
+int16_t dsp_deemphasisFilter(struct deemphasis *de, int16_t sample)
+{
+    int64_t diff = (static_cast<int64_t>(sample) * (1 << 15)) - de->state;
+    de->state   += static_cast<int32_t>((de->alpha * diff) >> 15);
+
+    return static_cast<int16_t>(de->state >> 15);
+}
+
+int16_t dsp_noiseReduction(struct noiseReducer *nr, int16_t sample)
+{
+    static constexpr int32_t  STEP  = 2048;      // Adaptation step, 1/16 in Q15
+    static constexpr uint8_t  LEAK  = 10;        // Coefficient leakage, 2^-10
+    static constexpr uint32_t FLOOR = 1 << 12;   // Power floor, about -50dBFS
+
+    // Prediction of the current sample from the previous ones
+    const int16_t *hist = &nr->history[nr->pos];
+    int64_t acc = 0;
+    for(size_t i = 0; i < DSP_NR_TAPS; i++)
+        acc += static_cast<int64_t>(nr->weights[i]) * hist[i];
+
+    int32_t pred  = static_cast<int32_t>(acc >> 29);
+    int32_t error = sample - pred;
+
+    // Normalised LMS update, the division by the input power is done through
+    // its reciprocal to avoid a 64 bit division for each sample.
+    uint32_t inv  = UINT32_MAX / (nr->power + FLOOR);
+    int64_t  gain = (static_cast<int64_t>(STEP * error) * inv) >> 16;
+    if(gain > INT32_MAX) gain = INT32_MAX;
+    if(gain < INT32_MIN) gain = INT32_MIN;
+
+    for(size_t i = 0; i < DSP_NR_TAPS; i++)
+    {
+        int32_t delta = static_cast<int32_t>((gain * hist[i]) >> 8);
+        nr->weights[i] += delta - (nr->weights[i] >> LEAK);
+    }
+
+    // Insert the new sample in the history. Samples are stored twice, so that
+    // the most recent DSP_NR_TAPS are always contiguous.
+    int32_t oldest = nr->history[nr->pos + DSP_NR_TAPS - 1];
+    nr->power -= static_cast<uint32_t>(oldest * oldest) >> 6;
+    nr->power += static_cast<uint32_t>(sample * sample) >> 6;
+
+    nr->pos = (nr->pos == 0) ? (DSP_NR_TAPS - 1) : (nr->pos - 1);
+    nr->history[nr->pos]               = sample;
+    nr->history[nr->pos + DSP_NR_TAPS] = sample;
+
+    return dsp_saturate(pred);
+}
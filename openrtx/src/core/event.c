@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <pthread.h>
+#include "core/event.h"
+
+static pthread_mutex_t evMutex  = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  evCond   = PTHREAD_COND_INITIALIZER;
+static uint16_t        evCount  = 0;      // Number of pending signals
+static long long       deadline = 0;      // Timeout of the waiting thread
+static bool            expired  = false;  // Timeout expired
+
+void event_signal()
+{
+    pthread_mutex_lock(&evMutex);
+
+    if(evCount < UINT16_MAX)
+        evCount += 1;
+
+    pthread_cond_signal(&evCond);
+    pthread_mutex_unlock(&evMutex);
+}
+
+bool event_wait(const long long timeout)
+{
+    pthread_mutex_lock(&evMutex);
+
+    deadline = timeout;
+    expired  = false;
+
+    while((evCount == 0) && (expired == false))
+        pthread_cond_wait(&evCond, &evMutex);
+
+    bool signalled = (evCount > 0);
+    if(signalled)
+        evCount -= 1;
+
+    deadline = 0;
+    pthread_mutex_unlock(&evMutex);
+
+    return signalled;
+}
+
+bool event_tryWait()
+{
+    pthread_mutex_lock(&evMutex);
+
+    bool signalled = (evCount > 0);
+    if(signalled)
+        evCount -= 1;
+
+    pthread_mutex_unlock(&evMutex);
+
+    return signalled;
+}
+
+void event_checkTimeout(const long long now)
+{
+    pthread_mutex_lock(&evMutex);
+
+    if((deadline != 0) && (now >= deadline))
+    {
+        deadline = 0;
+        expired  = true;
+        pthread_cond_signal(&evCond);
+    }
+
+    pthread_mutex_unlock(&evMutex);
+}
@@ -6,15 +6,84 @@
 
 #include "interfaces/platform.h"
 #include "core/gps.h"
-#include <minmea.h>
+#include "core/tracklog.h"
+#include "core/nmea.h"
 #include <stdio.h>
 #include "core/state.h"
 #include <string.h>
 #include <stdbool.h>
-
-#define KNOTS2KMH(x) ((((int) x) * 1852) / 1000)
+#include <errno.h>
+#ifdef CONFIG_TRACKLOG_NVM_AREA
+#include "core/nvmem_access.h"
+#include "core/threads.h"
+#include <pthread.h>
+#ifndef PLATFORM_LINUX
+#include "drivers/usb_vcom.h"
+#endif
+#endif
 
 static bool gpsEnabled = false;
+static struct nmeaParser parser;
+
+#ifdef CONFIG_TRACKLOG_NVM_AREA
+static bool exporting = false;  // Track log export in progress
+
+/**
+ * \internal
+ * Get the memory device and the start address of the track log area.
+ *
+ * @return the memory device or NULL if the area is not valid.
+ */
+static const struct nvmDevice *tracklogArea(uint32_t *offset)
+{
+    const struct nvmDescriptor *desc = nvm_getDesc(CONFIG_TRACKLOG_NVM_AREA);
+    struct nvmPartition part;
+
+    if(desc == NULL)
+        return NULL;
+
+    if(nvm_getPart(CONFIG_TRACKLOG_NVM_AREA, CONFIG_TRACKLOG_NVM_PART, &part) < 0)
+        return NULL;
+
+    if(part.size < CONFIG_TRACKLOG_SIZE)
+        return NULL;
+
+    *offset = desc->baseAddr + part.offset;
+
+    return desc->dev;
+}
+
+static ssize_t exportWrite(void *ctx, const void *buf, size_t len)
+{
+    (void) ctx;
+
+    #ifdef PLATFORM_LINUX
+    return fwrite(buf, 1, len, stdout);
+    #else
+    return vcom_writeBlock(buf, len);
+    #endif
+}
+
+static void *exportFunc(void *arg)
+{
+    (void) arg;
+
+    uint32_t offset;
+    const struct nvmDevice *dev = tracklogArea(&offset);
+
+    if(dev != NULL)
+        tracklog_exportGpx(dev, offset, CONFIG_TRACKLOG_SIZE, exportWrite, NULL);
+
+    #ifdef PLATFORM_LINUX
+    fflush(stdout);
+    #endif
+
+    pthread_detach(pthread_self());
+    __atomic_store_n(&exporting, false, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+#endif
 
 #ifdef CONFIG_RTC
 static bool rtcSyncDone = false;
@@ -35,7 +104,7 @@ static void syncRtc(datetime_t timestamp)
 
 void gps_task(const struct gpsDevice *dev)
 {
-    char sentence[2*MINMEA_MAX_LENGTH];
+    char sentence[2*NMEA_MAX_LENGTH];
     int ret;
 
     // No GPS, return
@@ -62,121 +131,111 @@ void gps_task(const struct gpsDevice *dev)
     if(ret <= 0)
         return;
 
-    // Parse the sentence. Work on a local state copy to minimize the time
-    // spent with the state mutex locked
+    // Feed the sentence to the parser, in a single pass. The sentences are
+    // always complete, add the line terminator if missing
+    enum nmeaSentence type;
+    nmea_putData(&parser, sentence, ret, &type);
+
+    if(sentence[ret - 1] != '\n')
+        type = nmea_putChar(&parser, '\n');
+
+    // Invalid sentence or not used, nothing to update
+    if(type == NMEA_NONE)
+        return;
+
+    // Work on a local state copy to minimize the time spent with the state
+    // mutex locked
     gps_t gps_data;
     pthread_mutex_lock(&state_mutex);
     gps_data = state.gps_data;
     pthread_mutex_unlock(&state_mutex);
 
-    int32_t sId = minmea_sentence_id(sentence, false);
-    switch(sId)
-    {
-        case MINMEA_SENTENCE_RMC:
-        {
-            struct minmea_sentence_rmc frame;
-            if (minmea_parse_rmc(&frame, sentence))
-            {
-                gps_data.timestamp.hour = frame.time.hours;
-                gps_data.timestamp.minute = frame.time.minutes;
-                gps_data.timestamp.second = frame.time.seconds;
-                gps_data.timestamp.day = 0;
-                gps_data.timestamp.date = frame.date.day;
-                gps_data.timestamp.month = frame.date.month;
-                gps_data.timestamp.year = frame.date.year;
-                gps_data.speed = KNOTS2KMH(minmea_toint(&frame.speed));
-                #ifdef CONFIG_RTC
-                if(frame.valid)
-                    syncRtc(gps_data.timestamp);
-                #endif
-            }
-        }
-        break;
-
-        case MINMEA_SENTENCE_GGA:
-        {
-            struct minmea_sentence_gga frame;
-            if (minmea_parse_gga(&frame, sentence))
-            {
-                gps_data.latitude = minmea_tofixedpoint(&frame.latitude);
-                gps_data.longitude = minmea_tofixedpoint(&frame.longitude);
-                gps_data.fix_quality = frame.fix_quality;
-                gps_data.satellites_tracked = frame.satellites_tracked;
-                gps_data.altitude = minmea_toint(&frame.altitude);
-            }
-        }
-        break;
-
-        case MINMEA_SENTENCE_GSA:
-        {
-            gps_data.active_sats = 0;
-            struct minmea_sentence_gsa frame;
-            if (minmea_parse_gsa(&frame, sentence))
-            {
-                gps_data.hdop = minmea_toscaledint(&frame.hdop, 100);
-                gps_data.fix_type = frame.fix_type;
-                for (int i = 0; i < 12; i++)
-                {
-                    if (frame.sats[i] != 0 && frame.sats[i] < 31)
-                    {
-                        gps_data.active_sats |= 1 << (frame.sats[i] - 1);
-                    }
-                }
-            }
-        }
-        break;
-
-        case MINMEA_SENTENCE_GSV:
-        {
-            // Parse only sentences 1 - 3, maximum 12 satellites
-            struct minmea_sentence_gsv frame;
-            if (minmea_parse_gsv(&frame, sentence) && (frame.msg_nr < 3))
-            {
-                // When the first sentence arrives, clear all the old data
-                if (frame.msg_nr == 1)
-                {
-                    memset(&gps_data.satellites[0], 0x00, 12 * sizeof(gpssat_t));
-                }
-
-                gps_data.satellites_in_view = frame.total_sats;
-                for (int i = 0; i < 4; i++)
-                {
-                    int index = 4 * (frame.msg_nr - 1) + i;
-                    gps_data.satellites[index].id = frame.sats[i].nr;
-                    gps_data.satellites[index].elevation = frame.sats[i].elevation;
-                    gps_data.satellites[index].azimuth = frame.sats[i].azimuth;
-                    gps_data.satellites[index].snr = frame.sats[i].snr;
-                }
-            }
-        }
-        break;
-
-        case MINMEA_SENTENCE_VTG:
-        {
-            struct minmea_sentence_vtg frame;
-            if (minmea_parse_vtg(&frame, sentence))
-            {
-                gps_data.speed = minmea_toint(&frame.speed_kph);
-                gps_data.tmg_mag = minmea_toint(&frame.magnetic_track_degrees);
-                gps_data.tmg_true = minmea_toint(&frame.true_track_degrees);
-            }
-        }
-        break;
-
-        // Ignore this message as we take data from RMC
-        case MINMEA_SENTENCE_GLL: break;
-
-        // These messages are never sent by the Jumpstar JS-M710 Module
-        case MINMEA_SENTENCE_GST: break;
-        case MINMEA_SENTENCE_ZDA: break;
-
-        // Error handling
-        case MINMEA_INVALID: break;
-        case MINMEA_UNKNOWN: break;
-    }
+    nmea_update(&parser, &gps_data);
+
+    #ifdef CONFIG_RTC
+    if(nmea_timeValid(&parser))
+        syncRtc(gps_data.timestamp);
+    #endif
 
     // Update GPS data inside radio state
     pthread_mutex_lock(&state_mutex);
     state.gps_data = gps_data;
     pthread_mutex_unlock(&state_mutex);
+
+    // Log the new position, if the track logger is running
+    if(type == NMEA_GGA)
+        tracklog_addPoint(&gps_data);
+}
+
+void gps_updateTracklog()
+{
+    #ifdef CONFIG_TRACKLOG_NVM_AREA
+    static bool logEnabled = false;
+
+    bool     enable   = state.settings.gpsLog && (state.devStatus == RUNNING);
+    uint16_t interval = state.settings.gpsLogInterval;
+    uint16_t distance = state.settings.gpsLogDistance;
+
+    // Settings saved by an older firmware version
+    if((interval == 0) || (interval > GPS_LOG_MAX_INTERVAL))
+        interval = default_settings.gpsLogInterval;
+
+    if(distance > GPS_LOG_MAX_DISTANCE)
+        distance = default_settings.gpsLogDistance;
+
+    if(enable == logEnabled)
+    {
+        if(logEnabled)
+            tracklog_setThresholds(interval, distance);
+
+        return;
+    }
+
+    logEnabled = enable;
+    if(enable == false)
+    {
+        tracklog_stop();
+        return;
+    }
+
+    uint32_t offset;
+    const struct nvmDevice *dev = tracklogArea(&offset);
+    if(dev != NULL)
+        tracklog_start(dev, offset, CONFIG_TRACKLOG_SIZE, interval, distance);
+    #endif
+}
+
+int gps_exportTracklog()
+{
+    #ifdef CONFIG_TRACKLOG_NVM_AREA
+    if(__atomic_exchange_n(&exporting, true, __ATOMIC_ACQUIRE))
+        return -EBUSY;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+
+    #ifdef _MIOSIX
+    pthread_attr_setstacksize(&attr, GPX_THREAD_STKSIZE);
+    #endif
+
+    pthread_t thread;
+    if(pthread_create(&thread, &attr, exportFunc, NULL) != 0)
+    {
+        __atomic_store_n(&exporting, false, __ATOMIC_RELEASE);
+        return -ENOMEM;
+    }
+
+    return 0;
+    #else
+    return -ENODEV;
+    #endif
+}
+
+bool gps_exportRunning()
+{
+    #ifdef CONFIG_TRACKLOG_NVM_AREA
+    return __atomic_load_n(&exporting, __ATOMIC_ACQUIRE);
+    #else
+    return false;
+    #endif
 }
@@ -10,6 +10,7 @@
  */
 
 #include "interfaces/display.h"
+#include "interfaces/delays.h"
 #include "hwconfig.h"
 #include "core/graphics.h"
 #include <string.h>
@@ -50,6 +51,15 @@
 #define SIN(x) sinf((x) * DEG_RAD)
 #define COS(x) cosf((x) * DEG_RAD)
 #define MIN(X, Y) (((X) < (Y)) ? (X) : (Y))
+#define MAX(X, Y) (((X) > (Y)) ? (X) : (Y))
+
+/*
+ * Number of entries of the rendered text cache, set to zero to disable it.
+ * Each entry takes about 300 bytes of RAM.
+ */
+#ifndef CONFIG_GFX_TEXT_CACHE_SIZE
+#define CONFIG_GFX_TEXT_CACHE_SIZE 12
+#endif
 
 /**
  * Fonts, ordered by the fontSize_t enum.
@@ -114,10 +124,20 @@ static rgb565_t _true2highColor(color_t true_color)
  * This specialization is meant for black and white pixel format.
  * It is suitable for monochromatic displays with 1 bit per pixel,
  * it will have RGB and grayscale counterparts
+ *
+ * By default pixels are stored row by row, eight horizontal pixels per byte.
+ * When CONFIG_PIX_FMT_BW_PAGED is defined, pixels are stored in the native
+ * order of monochrome display controllers: the screen is divided in pages of
+ * eight rows and each byte holds eight vertical pixels of a page column, LSB
+ * on top. The framebuffer can then be sent to the display as-is.
  */
 
 #define PIXEL_T uint8_t
+#ifdef CONFIG_PIX_FMT_BW_PAGED
+#define FB_SIZE (((CONFIG_SCREEN_HEIGHT + 7) / 8) * CONFIG_SCREEN_WIDTH)
+#else
 #define FB_SIZE (((CONFIG_SCREEN_HEIGHT * CONFIG_SCREEN_WIDTH) / 8 ) + 1)
+#endif
 
 typedef enum
 {
@@ -140,6 +160,10 @@ static bw_t _color2bw(color_t true_color)
 #error Please define a pixel format type into hwconfig.h or meson.build
 #endif
 
+#if defined(CONFIG_PIX_FMT_BW_PAGED) && !defined(CONFIG_PIX_FMT_BW)
+#error Page-ordered framebuffer layout is available only for black and white pixel format
+#endif
+
 #if defined(PLATFORM_LINUX)
 static PIXEL_T framebuffer[FB_SIZE];
 #else
@@ -147,6 +171,326 @@ static PIXEL_T __attribute__((section(".bss.fb"))) framebuffer[FB_SIZE];
 #endif
 static char text[32];
 
+/*
+ * Double buffering: drawing functions operate on the framebuffer while the
+ * display driver sends the front buffer, which gets a copy of the changed
+ * rows at each render. The UI can then draw the next frame while the previous
+ * one is still being transferred.
+ */
+#ifdef CONFIG_GFX_DOUBLE_BUFFER
+#if defined(PLATFORM_LINUX)
+static PIXEL_T frontBuffer[FB_SIZE];
+#else
+static PIXEL_T __attribute__((section(".bss.fb"))) frontBuffer[FB_SIZE];
+#endif
+static volatile bool renderBusy = false;    // Front buffer in use by the display
+#endif
+
+#if CONFIG_GFX_TEXT_CACHE_SIZE > 0
+
+#define GFX_TEXT_RUN_BITMAP_SIZE 256    // Bitmap size of a cached text run, in bytes
+#define TEXT_RUN_EMPTY           0xFF   // Font value marking an empty cache entry
+
+/*
+ * Cache of rendered text runs: single lines of text rasterized in a packed
+ * 1-bpp bitmap, MSB first, and blitted with the requested color.
+ */
+typedef struct
+{
+    uint32_t hash;                                // Hash of font and text
+    uint32_t lastUse;                             // Usage counter value at last hit
+    uint8_t  font;                                // Font of the text
+    uint8_t  width;                               // Bitmap width, in pixels
+    uint8_t  height;                              // Bitmap height, in pixels
+    int8_t   xOffset;                             // Bitmap offset from start point
+    int8_t   yOffset;
+    uint8_t  advance;                             // Line width, in pixels
+    uint8_t  lastH;                               // Height of the last glyph
+    char     text[sizeof(text)];                  // Rendered text
+    uint8_t  bitmap[GFX_TEXT_RUN_BITMAP_SIZE];    // Packed text bitmap
+}
+textRun_t;
+
+static textRun_t textCache[CONFIG_GFX_TEXT_CACHE_SIZE];
+static uint32_t  textCacheUse;
+
+#endif
+
+/*
+ * Dirty row tracking: every write to the framebuffer flags the corresponding
+ * row and, when rendering, only the flagged rows whose content effectively
+ * changed since the last render are sent to the display.
+ */
+#define DIRTY_MAP_SIZE ((CONFIG_SCREEN_HEIGHT + 7) / 8)
+
+static uint8_t  dirtyRows[DIRTY_MAP_SIZE];      // Rows written since last render
+static uint32_t rowHash[CONFIG_SCREEN_HEIGHT];  // Row content hash at last render
+static bool     fullRender;                     // Render the whole framebuffer
+
+static inline void markRow(const uint16_t row)
+{
+    dirtyRows[row >> 3] |= (1 << (row & 0x07));
+}
+
+static inline void unmarkRow(const uint16_t row)
+{
+    dirtyRows[row >> 3] &= ~(1 << (row & 0x07));
+}
+
+static inline bool rowDirty(const uint16_t row)
+{
+    return (dirtyRows[row >> 3] & (1 << (row & 0x07))) != 0;
+}
+
+static void markRows(uint16_t startRow, uint16_t endRow)
+{
+    if(endRow > CONFIG_SCREEN_HEIGHT)
+        endRow = CONFIG_SCREEN_HEIGHT;
+
+    for(uint16_t row = startRow; row < endRow; row++)
+        markRow(row);
+}
+
+/**
+ * \internal
+ * Compute the FNV-1a hash of the framebuffer content of a given row.
+ *
+ * @param row: framebuffer row.
+ * @return hash of the row content.
+ */
+static uint32_t hashRow(const uint16_t row)
+{
+    uint32_t hash = 2166136261u;
+
+    #ifdef CONFIG_PIX_FMT_BW_PAGED
+    // Each byte of the page holds one pixel of the row
+    const uint8_t *ptr  = &framebuffer[(row / 8) * CONFIG_SCREEN_WIDTH];
+    const uint8_t  mask = 1 << (row % 8);
+    for(size_t i = 0; i < CONFIG_SCREEN_WIDTH; i++)
+    {
+        hash ^= (ptr[i] & mask);
+        hash *= 16777619u;
+    }
+
+    return hash;
+    #else
+    #ifdef CONFIG_PIX_FMT_RGB565
+    const uint8_t *ptr = (const uint8_t *) &framebuffer[row * CONFIG_SCREEN_WIDTH];
+    size_t len = CONFIG_SCREEN_WIDTH * sizeof(PIXEL_T);
+    #else
+    size_t first = (row * CONFIG_SCREEN_WIDTH) / 8;
+    size_t last  = (((row + 1) * CONFIG_SCREEN_WIDTH) - 1) / 8;
+    const uint8_t *ptr = &framebuffer[first];
+    size_t len = last - first + 1;
+    #endif
+
+    for(size_t i = 0; i < len; i++)
+    {
+        hash ^= ptr[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+    #endif
+}
+
+/**
+ * \internal
+ * Update the hash of the dirty rows, clearing the dirty flag of the ones whose
+ * content did not change since the last render. This has to be done before
+ * rendering, since some display drivers modify the framebuffer content.
+ *
+ * @param startRow: first row to be checked.
+ * @param endRow: end of the row range, excluded.
+ */
+static void updateDirtyRows(const uint16_t startRow, const uint16_t endRow)
+{
+    for(uint16_t row = startRow; row < endRow; row++)
+    {
+        if((fullRender == false) && (rowDirty(row) == false))
+            continue;
+
+        uint32_t hash = hashRow(row);
+        if((fullRender == false) && (hash == rowHash[row]))
+        {
+            unmarkRow(row);
+            continue;
+        }
+
+        rowHash[row] = hash;
+        markRow(row);
+    }
+}
+
+/**
+ * \internal
+ * Set a contiguous range of framebuffer pixels to a given value, without any
+ * bounds check. Pixels are addressed linearly, row after row, and the range
+ * must not cross the end of a row.
+ *
+ * @param index: index of the first pixel.
+ * @param len: number of pixels.
+ * @param color: pixel color.
+ */
+static void fillPixels(size_t index, size_t len, color_t color)
+{
+    #ifdef CONFIG_PIX_FMT_RGB565
+    rgb565_t pixel = _true2highColor(color);
+    uint16_t value;
+    memcpy(&value, &pixel, sizeof(uint16_t));
+
+    // Align to a word boundary, then write two pixels per store
+    if(((index & 0x01) != 0) && (len > 0))
+    {
+        framebuffer[index++] = pixel;
+        len--;
+    }
+
+    uint32_t  word = ((uint32_t) value << 16) | value;
+    uint8_t  *ptr  = (uint8_t *) &framebuffer[index];
+    for(size_t i = 0; i < (len / 2); i++)
+        memcpy(ptr + (i * sizeof(uint32_t)), &word, sizeof(uint32_t));
+
+    if((len & 0x01) != 0)
+        framebuffer[index + len - 1] = pixel;
+    #elif defined CONFIG_PIX_FMT_BW_PAGED
+    // Pixels of a row are spread over the bytes of a page, one bit each
+    size_t   row  = index / CONFIG_SCREEN_WIDTH;
+    size_t   col  = index % CONFIG_SCREEN_WIDTH;
+    uint8_t *ptr  = &framebuffer[((row / 8) * CONFIG_SCREEN_WIDTH) + col];
+    uint8_t  mask = 1 << (row % 8);
+
+    if(_color2bw(color) == BLACK)
+    {
+        for(size_t i = 0; i < len; i++)
+            ptr[i] |= mask;
+    }
+    else
+    {
+        for(size_t i = 0; i < len; i++)
+            ptr[i] &= ~mask;
+    }
+    #elif defined CONFIG_PIX_FMT_BW
+    uint8_t value = (_color2bw(color) == BLACK) ? 0xFF : 0x00;
+
+    // Leading partial byte
+    size_t cell = index / 8;
+    size_t elem = index % 8;
+    if(elem != 0)
+    {
+        size_t  count = MIN(len, 8 - elem);
+        uint8_t mask  = ((1 << count) - 1) << elem;
+        framebuffer[cell] = (framebuffer[cell] & ~mask) | (value & mask);
+        len  -= count;
+        cell += 1;
+    }
+
+    // Whole bytes
+    memset(&framebuffer[cell], value, len / 8);
+    cell += len / 8;
+
+    // Trailing partial byte
+    if((len % 8) != 0)
+    {
+        uint8_t mask = (1 << (len % 8)) - 1;
+        framebuffer[cell] = (framebuffer[cell] & ~mask) | (value & mask);
+    }
+    #endif
+}
+
+/**
+ * \internal
+ * Draw a horizontal span of pixels, clipped to the screen boundaries.
+ *
+ * @param x: horizontal coordinate of the first pixel.
+ * @param y: vertical coordinate of the span.
+ * @param len: span length, in pixels.
+ * @param color: span color.
+ */
+static void fillSpan(int16_t x, const int16_t y, int16_t len, color_t color)
+{
+    if((y < 0) || (y >= CONFIG_SCREEN_HEIGHT))
+        return;
+
+    if(x < 0)
+    {
+        len += x;
+        x    = 0;
+    }
+
+    if((x + len) > CONFIG_SCREEN_WIDTH)
+        len = CONFIG_SCREEN_WIDTH - x;
+
+    if(len <= 0)
+        return;
+
+    #ifdef CONFIG_PIX_FMT_RGB565
+    // Blending requires a read-modify-write of each pixel
+    if(color.alpha < 255)
+    {
+        for(int16_t i = 0; i < len; i++)
+        {
+            point_t pos = {x + i, y};
+            gfx_setPixel(pos, color);
+        }
+
+        return;
+    }
+    #elif defined CONFIG_PIX_FMT_BW
+    // Ignore more than half transparent pixels
+    if(color.alpha < 128)
+        return;
+    #endif
+
+    markRow(y);
+    fillPixels((y * CONFIG_SCREEN_WIDTH) + x, len, color);
+}
+
+
+#ifdef CONFIG_GFX_DOUBLE_BUFFER
+static void renderDone(void *arg)
+{
+    (void) arg;
+    renderBusy = false;
+}
+
+static void waitRender()
+{
+    while(renderBusy)
+        sleepFor(0, 1);
+}
+#endif
+
+/**
+ * \internal
+ * Send a section of the framebuffer to the display.
+ *
+ * @param startRow: first row of the section.
+ * @param endRow: end row of the section, excluded.
+ */
+static void flushRows(const uint8_t startRow, const uint8_t endRow)
+{
+    #ifdef CONFIG_GFX_DOUBLE_BUFFER
+    #ifdef CONFIG_PIX_FMT_RGB565
+    size_t start = startRow * CONFIG_SCREEN_WIDTH;
+    size_t len   = (endRow - startRow) * CONFIG_SCREEN_WIDTH * sizeof(PIXEL_T);
+    #elif defined CONFIG_PIX_FMT_BW_PAGED
+    size_t start = (startRow / 8) * CONFIG_SCREEN_WIDTH;
+    size_t len   = (((endRow + 7) / 8) * CONFIG_SCREEN_WIDTH) - start;
+    #else
+    size_t start = (startRow * CONFIG_SCREEN_WIDTH) / 8;
+    size_t len   = (((endRow * CONFIG_SCREEN_WIDTH) + 7) / 8) - start;
+    #endif
+
+    waitRender();
+    memcpy(frontBuffer + start, framebuffer + start, len);
+
+    renderBusy = true;
+    display_renderRowsAsync(startRow, endRow, frontBuffer, renderDone, NULL);
+    #else
+    display_renderRows(startRow, endRow, framebuffer);
+    #endif
+}
 
 void gfx_init()
 {
@@ -154,50 +498,149 @@ void gfx_init()
 
     // Clear text buffer
     memset(text, 0x00, 32);
+
+    #if CONFIG_GFX_TEXT_CACHE_SIZE > 0
+    for(size_t i = 0; i < CONFIG_GFX_TEXT_CACHE_SIZE; i++)
+    {
+        textCache[i].font    = TEXT_RUN_EMPTY;
+        textCache[i].lastUse = 0;
+    }
+    #endif
+
+    // Display content is unknown, first render has to refresh everything
+    memset(dirtyRows, 0x00, sizeof(dirtyRows));
+    fullRender = true;
 }
 
 void gfx_terminate()
 {
+    #ifdef CONFIG_GFX_DOUBLE_BUFFER
+    waitRender();
+    #endif
+
     display_terminate();
 }
 
 void gfx_renderRows(uint8_t startRow, uint8_t endRow)
 {
-    display_renderRows(startRow, endRow, framebuffer);
+    if(endRow > CONFIG_SCREEN_HEIGHT)
+        endRow = CONFIG_SCREEN_HEIGHT;
+
+    if(endRow <= startRow)
+        return;
+
+    // Keep the row hashes in sync with the display content
+    for(uint16_t row = startRow; row < endRow; row++)
+    {
+        rowHash[row] = hashRow(row);
+        unmarkRow(row);
+    }
+
+    flushRows(startRow, endRow);
 }
 
 void gfx_render()
 {
-    display_render(framebuffer);
+    updateDirtyRows(0, CONFIG_SCREEN_HEIGHT);
+
+    #ifdef CONFIG_GFX_DOUBLE_BUFFER
+    // Only one transfer at a time can run in background: send a single span
+    // covering all the changed rows
+    int16_t first = -1;
+    int16_t last  = -1;
+    for(int16_t row = 0; row < CONFIG_SCREEN_HEIGHT; row++)
+    {
+        if(rowDirty(row) == false)
+            continue;
+
+        if(first < 0)
+            first = row;
+
+        last = row;
+    }
+
+    if(first >= 0)
+        flushRows(first, last + 1);
+    #else
+    // Send each contiguous span of changed rows
+    int16_t start = -1;
+    for(int16_t row = 0; row <= CONFIG_SCREEN_HEIGHT; row++)
+    {
+        bool dirty = (row < CONFIG_SCREEN_HEIGHT) && rowDirty(row);
+
+        if(dirty && (start < 0))
+            start = row;
+
+        if((dirty == false) && (start >= 0))
+        {
+            flushRows(start, row);
+            start = -1;
+        }
+    }
+    #endif
+
+    memset(dirtyRows, 0x00, sizeof(dirtyRows));
+    fullRender = false;
 }
 
 void gfx_clearRows(uint8_t startRow, uint8_t endRow)
 {
-    if(endRow < startRow)
+    if(endRow > CONFIG_SCREEN_HEIGHT)
+        endRow = CONFIG_SCREEN_HEIGHT;
+
+    if(endRow <= startRow)
         return;
 
-    uint16_t start = startRow * CONFIG_SCREEN_WIDTH * sizeof(PIXEL_T);
-    uint16_t height = endRow - startRow * CONFIG_SCREEN_WIDTH * sizeof(PIXEL_T);
     // Set the specified rows to 0x00 = make the screen black
-    memset(framebuffer + start, 0x00, height);
+    #ifdef CONFIG_PIX_FMT_BW_PAGED
+    uint16_t row = startRow;
+    while(row < endRow)
+    {
+        // Clear the rows falling in the current page
+        uint16_t pageStart = row & ~0x07;
+        uint16_t pageEnd   = MIN(endRow, pageStart + 8);
+        uint8_t  mask      = (uint8_t) ((0xFF << (row - pageStart))
+                                      & (0xFF >> (pageStart + 8 - pageEnd)));
+        uint8_t *page      = &framebuffer[(row / 8) * CONFIG_SCREEN_WIDTH];
+
+        if(mask == 0xFF)
+        {
+            memset(page, 0x00, CONFIG_SCREEN_WIDTH);
+        }
+        else
+        {
+            for(size_t i = 0; i < CONFIG_SCREEN_WIDTH; i++)
+                page[i] &= ~mask;
+        }
+
+        row = pageEnd;
+    }
+    #else
+    #ifdef CONFIG_PIX_FMT_RGB565
+    size_t start = startRow * CONFIG_SCREEN_WIDTH;
+    size_t len   = (endRow - startRow) * CONFIG_SCREEN_WIDTH * sizeof(PIXEL_T);
+    #else
+    size_t start = (startRow * CONFIG_SCREEN_WIDTH) / 8;
+    size_t len   = ((endRow - startRow) * CONFIG_SCREEN_WIDTH) / 8;
+    #endif
+
+    memset(framebuffer + start, 0x00, len);
+    #endif
+
+    markRows(startRow, endRow);
 }
 
 void gfx_clearScreen()
 {
     // Set the whole framebuffer to 0x00 = make the screen black
     memset(framebuffer, 0x00, FB_SIZE * sizeof(PIXEL_T));
+    markRows(0, CONFIG_SCREEN_HEIGHT);
 }
 
 void gfx_fillScreen(color_t color)
 {
     for(int16_t y = 0; y < CONFIG_SCREEN_HEIGHT; y++)
-    {
-        for(int16_t x = 0; x < CONFIG_SCREEN_WIDTH; x++)
-        {
-            point_t pos = {x, y};
-            gfx_setPixel(pos, color);
-        }
-    }
+        fillSpan(0, y, CONFIG_SCREEN_WIDTH, color);
 }
 
 inline void gfx_setPixel(point_t pos, color_t color)
@@ -206,6 +649,8 @@ inline void gfx_setPixel(point_t pos, color_t color)
         pos.x < 0 || pos.y < 0)
         return; // off the screen
 
+    markRow(pos.y);
+
 #ifdef CONFIG_PIX_FMT_RGB565
     // Blend old pixel value and new one
     if (color.alpha < 255)
@@ -223,6 +668,15 @@ inline void gfx_setPixel(point_t pos, color_t color)
     {
         framebuffer[pos.x + pos.y*CONFIG_SCREEN_WIDTH] = _true2highColor(color);
     }
+#elif defined CONFIG_PIX_FMT_BW_PAGED
+    // Ignore more than half transparent pixels
+    if (color.alpha >= 128)
+    {
+        uint16_t cell = pos.x + (pos.y / 8)*CONFIG_SCREEN_WIDTH;
+        uint16_t elem = pos.y % 8;
+        framebuffer[cell] &= ~(1 << elem);
+        framebuffer[cell] |= (_color2bw(color) << elem);
+    }
 #elif defined CONFIG_PIX_FMT_BW
     // Ignore more than half transparent pixels
     if (color.alpha >= 128)
@@ -300,21 +754,23 @@ void gfx_drawRect(point_t start, uint16_t width, uint16_t height, color_t color,
     if(height == 0) return;
     uint16_t x_max = start.x + width - 1;
     uint16_t y_max = start.y + height - 1;
-    bool perimeter = 0;
     if(x_max > (CONFIG_SCREEN_WIDTH - 1)) x_max = CONFIG_SCREEN_WIDTH - 1;
     if(y_max > (CONFIG_SCREEN_HEIGHT - 1)) y_max = CONFIG_SCREEN_HEIGHT - 1;
+    if(start.x > x_max) return;
+    int16_t len = x_max - start.x + 1;
     for(int16_t y = start.y; y <= y_max; y++)
     {
-        for(int16_t x = start.x; x <= x_max; x++)
+        // If fill is false, draw only rectangle perimeter
+        if(fill || y == start.y || y == y_max)
         {
-            if(y == start.y || y == y_max || x == start.x || x == x_max) perimeter = 1;
-            else perimeter = 0;
-            // If fill is false, draw only rectangle perimeter
-            if(fill || perimeter)
-            {
-                point_t pos = {x, y};
-                gfx_setPixel(pos, color);
-            }
+            fillSpan(start.x, y, len, color);
+        }
+        else
+        {
+            point_t left  = {start.x, y};
+            point_t right = {x_max, y};
+            gfx_setPixel(left, color);
+            gfx_setPixel(right, color);
         }
     }
 }
@@ -432,6 +888,205 @@ static inline uint16_t get_reset_x(textAlign_t alignment, uint16_t line_size,
     return 0;
 }
 
+#if CONFIG_GFX_TEXT_CACHE_SIZE > 0
+
+/**
+ * \internal
+ * Compute the FNV-1a hash of a string printed with a given font.
+ */
+static uint32_t hashText(const fontSize_t size, const char *buf)
+{
+    uint32_t hash = (2166136261u ^ size) * 16777619u;
+    for(; *buf != '\0'; buf++)
+    {
+        hash ^= (uint8_t) *buf;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * \internal
+ * Render a single line of text in the packed bitmap of a cache entry.
+ *
+ * @param run: cache entry.
+ * @param size: text font.
+ * @param buf: text to be rendered.
+ * @param len: text length.
+ * @return false if the text cannot be cached.
+ */
+static bool rasterizeText(textRun_t *run, const fontSize_t size, const char *buf,
+                          const size_t len)
+{
+    const GFXfont *f = &fonts[size];
+    int16_t x0 = INT16_MAX, x1 = INT16_MIN;
+    int16_t y0 = INT16_MAX, y1 = INT16_MIN;
+    int16_t pen = 0;
+    uint8_t lastH = 0;
+
+    // Compute bounding box of the rendered text, relative to the start point
+    for(size_t i = 0; i < len; i++)
+    {
+        uint8_t c = (uint8_t) buf[i];
+        if((c < f->first) || (c > f->last))
+            return false;
+
+        const GFXglyph *glyph = &f->glyph[c - f->first];
+        if((glyph->width != 0) && (glyph->height != 0))
+        {
+            x0 = MIN(x0, pen + glyph->xOffset);
+            x1 = MAX(x1, pen + glyph->xOffset + glyph->width);
+            y0 = MIN(y0, glyph->yOffset);
+            y1 = MAX(y1, glyph->yOffset + glyph->height);
+        }
+
+        pen  += glyph->xAdvance;
+        lastH = glyph->height;
+    }
+
+    // Text spanning the whole screen width gets truncated or wrapped
+    if(pen >= CONFIG_SCREEN_WIDTH)
+        return false;
+
+    if(x0 > x1)
+    {
+        x0 = x1 = 0;
+        y0 = y1 = 0;
+    }
+
+    uint16_t width    = x1 - x0;
+    uint16_t height   = y1 - y0;
+    uint16_t rowBytes = (width + 7) / 8;
+    if((rowBytes * height) > GFX_TEXT_RUN_BITMAP_SIZE)
+        return false;
+
+    memset(run->bitmap, 0x00, rowBytes * height);
+
+    pen = 0;
+    for(size_t i = 0; i < len; i++)
+    {
+        const GFXglyph *glyph = &f->glyph[(uint8_t) buf[i] - f->first];
+        uint16_t bo   = glyph->bitmapOffset;
+        uint8_t  bits = 0, bit = 0;
+
+        for(uint8_t yy = 0; yy < glyph->height; yy++)
+        {
+            uint16_t y = glyph->yOffset + yy - y0;
+            for(uint8_t xx = 0; xx < glyph->width; xx++)
+            {
+                if (!(bit++ & 7))
+                    bits = f->bitmap[bo++];
+
+                if (bits & 0x80)
+                {
+                    uint16_t x = pen + glyph->xOffset + xx - x0;
+                    run->bitmap[(y * rowBytes) + (x / 8)] |= (0x80 >> (x % 8));
+                }
+
+                bits <<= 1;
+            }
+        }
+
+        pen += glyph->xAdvance;
+    }
+
+    run->font    = size;
+    run->width   = width;
+    run->height  = height;
+    run->xOffset = x0;
+    run->yOffset = y0;
+    run->advance = pen;
+    run->lastH   = lastH;
+    strcpy(run->text, buf);
+
+    return true;
+}
+
+/**
+ * \internal
+ * Print a single line of text using the text run cache.
+ *
+ * @return false if the text cannot be printed from the cache, the caller has
+ * to fall back to the glyph-by-glyph rendering.
+ */
+static bool printCached(point_t start, fontSize_t size, textAlign_t alignment,
+                        color_t color, const char *buf, point_t *textSize)
+{
+    size_t len = strlen(buf);
+    if((len == 0) || (len >= sizeof(textCache[0].text)))
+        return false;
+
+    if(strpbrk(buf, "\n\r") != NULL)
+        return false;
+
+    uint32_t   hash   = hashText(size, buf);
+    textRun_t *run    = NULL;
+    textRun_t *victim = &textCache[0];
+
+    for(size_t i = 0; i < CONFIG_GFX_TEXT_CACHE_SIZE; i++)
+    {
+        textRun_t *entry = &textCache[i];
+        if((entry->font == size) && (entry->hash == hash) &&
+           (strcmp(entry->text, buf) == 0))
+        {
+            run = entry;
+            break;
+        }
+
+        if(entry->lastUse < victim->lastUse)
+            victim = entry;
+    }
+
+    if(run == NULL)
+    {
+        if(rasterizeText(victim, size, buf, len) == false)
+            return false;
+
+        victim->hash = hash;
+        run = victim;
+    }
+
+    textCacheUse += 1;
+    run->lastUse  = textCacheUse;
+
+    // Text wrapping is handled by the uncached path
+    int16_t x = get_reset_x(alignment, run->advance, start.x);
+    if((x < 0) || ((x + run->advance) > CONFIG_SCREEN_WIDTH))
+        return false;
+
+    // Blit the cached bitmap, one run of consecutive set pixels at a time
+    uint16_t rowBytes = (run->width + 7) / 8;
+    x += run->xOffset;
+    for(uint16_t yy = 0; yy < run->height; yy++)
+    {
+        const uint8_t *row = &run->bitmap[yy * rowBytes];
+        int16_t y     = start.y + run->yOffset + yy;
+        int16_t begin = -1;
+
+        for(uint16_t xx = 0; xx <= run->width; xx++)
+        {
+            bool set = (xx < run->width) && ((row[xx / 8] & (0x80 >> (xx % 8))) != 0);
+
+            if(set && (begin < 0))
+                begin = xx;
+
+            if((set == false) && (begin >= 0))
+            {
+                fillSpan(x + begin, y, xx - begin, color);
+                begin = -1;
+            }
+        }
+    }
+
+    textSize->x = run->advance;
+    textSize->y = run->lastH;
+
+    return true;
+}
+
+#endif
+
 uint8_t gfx_getFontHeight(fontSize_t size)
 {
     GFXfont f = fonts[size];
@@ -442,6 +1097,12 @@ uint8_t gfx_getFontHeight(fontSize_t size)
 point_t gfx_printBuffer(point_t start, fontSize_t size, textAlign_t alignment,
                         color_t color, const char *buf)
 {
+    #if CONFIG_GFX_TEXT_CACHE_SIZE > 0
+    point_t cachedSize;
+    if(printCached(start, size, alignment, color, buf, &cachedSize))
+        return cachedSize;
+    #endif
+
     GFXfont f = fonts[size];
 
     size_t len = strlen(buf);
@@ -498,9 +1159,13 @@ point_t gfx_printBuffer(point_t start, fontSize_t size, textAlign_t alignment,
             start.y += f.yAdvance;
         }
 
-        // Draw bitmap
+        // Draw bitmap, one run of consecutive set pixels at a time
         for (yy = 0; yy < h; yy++)
         {
+            int16_t y   = start.y + yo + yy;
+            int16_t x   = start.x + xo;
+            int16_t run = -1;
+
             for (xx = 0; xx < w; xx++)
             {
                 if (!(bit++ & 7))
@@ -510,21 +1175,20 @@ point_t gfx_printBuffer(point_t start, fontSize_t size, textAlign_t alignment,
 
                 if (bits & 0x80)
                 {
-                    if (start.y + yo + yy < CONFIG_SCREEN_HEIGHT &&
-                        start.x + xo + xx < CONFIG_SCREEN_WIDTH &&
-                        start.y + yo + yy > 0 &&
-                        start.x + xo + xx > 0)
-                    {
-                        point_t pos;
-                        pos.x = start.x + xo + xx;
-                        pos.y = start.y + yo + yy;
-                        gfx_setPixel(pos, color);
-
-                    }
+                    if (run < 0)
+                        run = xx;
+                }
+                else if (run >= 0)
+                {
+                    fillSpan(x + run, y, xx - run, color);
+                    run = -1;
                 }
 
                 bits <<= 1;
             }
+
+            if (run >= 0)
+                fillSpan(x + run, y, w - run, color);
         }
 
         start.x += glyph.xAdvance;
@@ -980,7 +1644,7 @@ void gfx_plotData(point_t start, uint16_t width, uint16_t height,
             break;
         pos.x = horizontal_pos;
         pos.y = start.y + (height / 2)
-              + ((data[i] * 4) / (2 * SHRT_MAX) * height);
+              + (((int32_t) data[i] * 4 * height) / (2 * SHRT_MAX));
         if (pos.y > CONFIG_SCREEN_HEIGHT)
             pos.y = CONFIG_SCREEN_HEIGHT;
         if (!first_iteration)
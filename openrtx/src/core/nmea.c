@@ -0,0 +1,707 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "core/nmea.h"
+#include <string.h>
+
+#define KNOTS2KMH(x) ((((int) x) * 1852) / 1000)
+#define NMEA_MAX_DECIMALS 5
+
+/**
+ * Parser states.
+ */
+enum ParserState
+{
+    ST_IDLE = 0,    // Waiting for the start of a sentence
+    ST_ADDRESS,     // Receiving the address field
+    ST_FIELDS,      // Receiving the data fields
+    ST_CKSUM_HI,    // Receiving the first digit of the checksum
+    ST_CKSUM_LO,    // Receiving the second digit of the checksum
+    ST_EOL          // Waiting for the line terminator
+};
+
+/**
+ * Field decoding rules.
+ */
+enum FieldKind
+{
+    F_SKIP = 0,     // Field not decoded
+    F_INT,          // Integer part of a decimal number
+    F_CENT,         // Decimal number, in hundredths
+    F_COORD,        // Coordinate in ddmm.mmmm format, in millionths of degree
+    F_DIR,          // Direction, +1 for north and east, -1 for south and west
+    F_CHAR,         // Single character
+    F_TIME,         // Time in hhmmss format, -1 if empty
+    F_DATE          // Date in ddmmyy format, -1 if empty
+};
+
+/**
+ * Field layout of a sentence type.
+ */
+struct SentenceDesc
+{
+    char          id[3];        // Sentence identifier, after the talker ID
+    uint8_t       minFields;    // Minimum number of data fields
+    uint8_t       numFields;    // Number of decoded fields
+    const uint8_t *kinds;       // Decoding rule of each field
+};
+
+// Only the fields used in gps_t are decoded, the others are skipped
+static const uint8_t rmcFields[] =
+{
+    F_TIME, F_CHAR, F_SKIP, F_SKIP, F_SKIP, F_SKIP, F_INT, F_SKIP, F_DATE
+};
+
+static const uint8_t ggaFields[] =
+{
+    F_SKIP, F_COORD, F_DIR, F_COORD, F_DIR, F_INT, F_INT, F_SKIP, F_INT
+};
+
+static const uint8_t gsaFields[] =
+{
+    F_SKIP, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT,
+    F_INT,  F_INT, F_INT, F_INT, F_SKIP, F_CENT
+};
+
+static const uint8_t gsvFields[] =
+{
+    F_SKIP, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT,
+    F_INT,  F_INT, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT, F_INT
+};
+
+static const uint8_t vtgFields[] =
+{
+    F_INT, F_CHAR, F_INT, F_CHAR, F_SKIP, F_CHAR, F_INT, F_CHAR
+};
+
+// Indexed by sentence type, minus one
+static const struct SentenceDesc sentences[] =
+{
+    { {'R', 'M', 'C'}, 11, sizeof(rmcFields), rmcFields },
+    { {'G', 'G', 'A'}, 14, sizeof(ggaFields), ggaFields },
+    { {'G', 'S', 'A'}, 17, sizeof(gsaFields), gsaFields },
+    { {'G', 'S', 'V'},  3, sizeof(gsvFields), gsvFields },
+    { {'V', 'T', 'G'},  8, sizeof(vtgFields), vtgFields }
+};
+
+#define NUM_SENTENCES (sizeof(sentences) / sizeof(sentences[0]))
+
+
+/**
+ * \internal
+ * Convert an hexadecimal digit to its value.
+ *
+ * @return digit value or -1 if the character is not an hexadecimal digit.
+ */
+static inline int hexValue(const char c)
+{
+    if((c >= '0') && (c <= '9'))
+        return c - '0';
+
+    if((c >= 'A') && (c <= 'F'))
+        return c - 'A' + 10;
+
+    if((c >= 'a') && (c <= 'f'))
+        return c - 'a' + 10;
+
+    return -1;
+}
+
+/**
+ * \internal
+ * Check if a character can be part of a data field.
+ */
+static inline __attribute__((__always_inline__))
+bool isFieldChar(const char c)
+{
+    return (c >= ' ') && (c <= '~') && (c != ',') && (c != '*') && (c != '$');
+}
+
+/**
+ * \internal
+ * Reset the accumulators of the current field.
+ */
+static inline __attribute__((__always_inline__))
+void resetField(struct nmeaParser *p)
+{
+    p->digits   = 0;
+    p->decimals = 0;
+    p->point    = false;
+    p->sign     = 0;
+    p->value    = 0;
+    p->frac     = 0;
+}
+
+/**
+ * \internal
+ * Accumulate a digit of a decimal number. Only the first NMEA_MAX_DECIMALS
+ * digits of the fractional part are kept.
+ */
+static inline __attribute__((__always_inline__))
+void numberDigit(struct nmeaParser *p, const uint8_t digit)
+{
+    if(p->point)
+    {
+        if(p->decimals < NMEA_MAX_DECIMALS)
+        {
+            p->frac      = (p->frac * 10) + digit;
+            p->decimals += 1;
+        }
+    }
+    else
+    {
+        // Integer parts longer than nine digits are not valid in NMEA
+        if(p->value >= 100000000)
+        {
+            p->error = true;
+            return;
+        }
+
+        p->value = (p->value * 10) + digit;
+    }
+
+    p->digits += 1;
+}
+
+/**
+ * \internal
+ * Accumulate a character of a decimal number.
+ */
+static inline __attribute__((__always_inline__))
+void numberChar(struct nmeaParser *p, const char c)
+{
+    if((c >= '0') && (c <= '9'))
+        numberDigit(p, c - '0');
+    else if((c == '.') && (p->point == false))
+        p->point = true;
+    else if(((c == '-') || (c == '+')) && (p->sign == 0) && (p->digits == 0))
+        p->sign = (c == '-') ? -1 : 1;
+    else
+        p->error = true;
+}
+
+/**
+ * \internal
+ * Accumulate a character of a time or date field, made of six digits
+ * eventually followed by a fractional part.
+ */
+static inline __attribute__((__always_inline__))
+void timeChar(struct nmeaParser *p, const char c)
+{
+    if((c >= '0') && (c <= '9') && (p->point == false))
+    {
+        if(p->digits < 6)
+            p->value = (p->value * 10) + (c - '0');
+
+        p->digits += 1;
+    }
+    else
+    {
+        // End of the leading digits
+        p->point = true;
+    }
+}
+
+/**
+ * \internal
+ * Accumulate a character of the current field, according to its decoding
+ * rule.
+ */
+static inline __attribute__((__always_inline__))
+void fieldChar(struct nmeaParser *p, const char c)
+{
+    switch(p->kind)
+    {
+        case F_INT:
+        case F_CENT:
+        case F_COORD:
+            numberChar(p, c);
+            break;
+
+        case F_TIME:
+        case F_DATE:
+            timeChar(p, c);
+            break;
+
+        case F_CHAR:
+            if(p->digits == 0)
+                p->value = c;
+
+            p->digits += 1;
+            break;
+
+        case F_DIR:
+            if(p->digits == 0)
+            {
+                if((c == 'N') || (c == 'E'))
+                    p->value = 1;
+                else if((c == 'S') || (c == 'W'))
+                    p->value = -1;
+                else
+                    p->error = true;
+            }
+
+            p->digits += 1;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * \internal
+ * Convert the current field to its final value, without divisions by a
+ * variable amount.
+ */
+static inline __attribute__((__always_inline__))
+int32_t fieldValue(struct nmeaParser *p)
+{
+    static const int32_t pow10[] = { 100000, 10000, 1000, 100, 10, 1 };
+
+    // Fractional part, in units of 10^-5
+    int32_t frac = p->frac * pow10[p->decimals];
+    int32_t sign = (p->sign < 0) ? -1 : 1;
+
+    switch(p->kind)
+    {
+        case F_INT:
+        case F_CENT:
+        case F_COORD:
+            // Empty field or sign and decimal point without digits
+            if(p->digits == 0)
+            {
+                if((p->sign != 0) || p->point)
+                    p->error = true;
+
+                return 0;
+            }
+
+            if(p->kind == F_INT)
+                return sign * p->value;
+
+            if(p->kind == F_CENT)
+                return sign * ((p->value * 100) + (frac / 1000));
+
+            // Degrees and minutes to millionths of degree
+            return sign * (((p->value / 100) * 1000000)
+                        + ((((p->value % 100) * 100000) + frac) / 6));
+
+        case F_TIME:
+        case F_DATE:
+            if((p->digits == 0) && (p->point == false))
+                return -1;
+
+            if(p->digits < 6)
+                p->error = true;
+
+            return p->value;
+
+        case F_CHAR:
+        case F_DIR:
+            return p->value;
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * \internal
+ * Store the value of the current field and move to the next one.
+ */
+static inline __attribute__((__always_inline__))
+void endField(struct nmeaParser *p)
+{
+    const struct SentenceDesc *desc = &sentences[p->type - 1];
+
+    if(p->field < desc->numFields)
+        p->fields[p->field] = fieldValue(p);
+
+    if(p->field < UINT8_MAX)
+        p->field += 1;
+
+    p->kind = (p->field < desc->numFields) ? desc->kinds[p->field] : F_SKIP;
+    resetField(p);
+}
+
+/**
+ * \internal
+ * Identify the sentence type from the address field, made of the two
+ * characters of the talker ID and three characters of sentence identifier.
+ */
+static inline __attribute__((__always_inline__))
+uint8_t sentenceType(const struct nmeaParser *p)
+{
+    if(p->digits != 5)
+        return NMEA_NONE;
+
+    for(uint8_t i = 0; i < NUM_SENTENCES; i++)
+    {
+        uint32_t id = ((uint32_t) sentences[i].id[0] << 16)
+                    | ((uint32_t) sentences[i].id[1] << 8)
+                    | sentences[i].id[2];
+
+        if(((uint32_t) p->value & 0xFFFFFF) == id)
+            return i + 1;
+    }
+
+    return NMEA_NONE;
+}
+
+/**
+ * \internal
+ * Final checks on a sentence after the reception of the line terminator.
+ */
+static inline __attribute__((__always_inline__))
+enum nmeaSentence endSentence(struct nmeaParser *p)
+{
+    const struct SentenceDesc *desc = &sentences[p->type - 1];
+
+    p->state = ST_IDLE;
+
+    if(p->error || (p->field < desc->minFields))
+        return NMEA_NONE;
+
+    // Optional fields not received
+    for(uint8_t i = p->field; i < desc->numFields; i++)
+        p->fields[i] = 0;
+
+    // Units of the VTG fields
+    if((p->type == NMEA_VTG) && ((p->fields[1] != 'T') || (p->fields[3] != 'M')
+                             ||  (p->fields[5] != 'N') || (p->fields[7] != 'K')))
+    {
+        return NMEA_NONE;
+    }
+
+    return (enum nmeaSentence) p->type;
+}
+
+
+void nmea_reset(struct nmeaParser *parser)
+{
+    memset(parser, 0x00, sizeof(struct nmeaParser));
+    parser->state = ST_IDLE;
+    parser->type  = NMEA_NONE;
+}
+
+/**
+ * \internal
+ * Process a character of the sentence.
+ *
+ * @return the type of the sentence, if the character completes a valid
+ * sentence, or NMEA_NONE.
+ */
+static inline __attribute__((__always_inline__))
+enum nmeaSentence parseChar(struct nmeaParser *p, const char c)
+{
+    // Start of a new sentence, also in the middle of a broken one
+    if(c == '$')
+    {
+        resetField(p);
+        p->state    = ST_ADDRESS;
+        p->type     = NMEA_NONE;
+        p->kind     = F_SKIP;
+        p->length   = 1;
+        p->field    = 0;
+        p->checksum = 0;
+        p->error    = false;
+
+        return NMEA_NONE;
+    }
+
+    if(p->state == ST_IDLE)
+        return NMEA_NONE;
+
+    p->length += 1;
+    if(p->length > NMEA_MAX_LENGTH)
+    {
+        p->state = ST_IDLE;
+        return NMEA_NONE;
+    }
+
+    // Fast path for the digits of numeric fields, the most frequent case
+    uint8_t digit = (uint8_t) (c - '0');
+    if((digit < 10) && (p->kind >= F_INT) && (p->kind <= F_COORD))
+    {
+        p->checksum ^= c;
+        numberDigit(p, digit);
+        return NMEA_NONE;
+    }
+
+    // Only printable characters are allowed before the line terminator
+    bool eol = (c == '\r') || (c == '\n');
+    if((eol == false) && ((c < ' ') || (c > '~')))
+    {
+        p->state = ST_IDLE;
+        return NMEA_NONE;
+    }
+
+    switch(p->state)
+    {
+        case ST_ADDRESS:
+            if(c == ',')
+            {
+                p->type = sentenceType(p);
+                resetField(p);
+
+                // Sentence not used, skip it
+                if(p->type == NMEA_NONE)
+                {
+                    p->state = ST_IDLE;
+                    break;
+                }
+
+                p->state = ST_FIELDS;
+                p->kind  = sentences[p->type - 1].kinds[0];
+            }
+            else if((c == '*') || eol)
+            {
+                p->state = ST_IDLE;
+                break;
+            }
+            else
+            {
+                p->value   = (int32_t) (((uint32_t) p->value << 8) | (uint8_t) c);
+                p->digits += 1;
+            }
+
+            p->checksum ^= c;
+            break;
+
+        case ST_FIELDS:
+            if(c == ',')
+            {
+                p->checksum ^= c;
+                endField(p);
+            }
+            else if(c == '*')
+            {
+                endField(p);
+                p->state = ST_CKSUM_HI;
+                p->kind  = F_SKIP;
+            }
+            else if(eol)
+            {
+                // Sentence without checksum
+                endField(p);
+                p->state = ST_EOL;
+                p->kind  = F_SKIP;
+                if(c == '\n')
+                    return endSentence(p);
+            }
+            else
+            {
+                p->checksum ^= c;
+                fieldChar(p, c);
+            }
+            break;
+
+        case ST_CKSUM_HI:
+        case ST_CKSUM_LO:
+        {
+            int digit = hexValue(c);
+            if(digit < 0)
+            {
+                p->state = ST_IDLE;
+                break;
+            }
+
+            p->expected = (p->expected << 4) | digit;
+            if(p->state == ST_CKSUM_HI)
+            {
+                p->state = ST_CKSUM_LO;
+                break;
+            }
+
+            if(p->expected != p->checksum)
+                p->error = true;
+
+            p->state = ST_EOL;
+        }
+            break;
+
+        case ST_EOL:
+            if(c == '\n')
+                return endSentence(p);
+
+            if(c != '\r')
+                p->state = ST_IDLE;
+            break;
+
+        default:
+            p->state = ST_IDLE;
+            break;
+    }
+
+    return NMEA_NONE;
+}
+
+enum nmeaSentence nmea_putChar(struct nmeaParser *parser, const char c)
+{
+    return parseChar(parser, c);
+}
+
+size_t nmea_putData(struct nmeaParser *parser, const char *data,
+                    const size_t len, enum nmeaSentence *type)
+{
+    // Work on a local copy, letting the compiler keep the state in registers
+    struct nmeaParser p = *parser;
+    size_t i = 0;
+
+    *type = NMEA_NONE;
+    while(i < len)
+    {
+        // Outside of a sentence, look for the next one
+        if(p.state == ST_IDLE)
+        {
+            const char *next = memchr(&data[i], '$', len - i);
+            if(next == NULL)
+            {
+                i = len;
+                break;
+            }
+
+            i = next - data;
+        }
+
+        // Content of the data fields, consumed in tight loops up to the next
+        // delimiter
+        if(p.state == ST_FIELDS)
+        {
+            size_t start = i;
+
+            if(p.kind == F_SKIP)
+            {
+                while((i < len) && isFieldChar(data[i]))
+                {
+                    p.checksum ^= data[i];
+                    i++;
+                }
+            }
+            else if((p.kind >= F_INT) && (p.kind <= F_COORD))
+            {
+                uint8_t digit;
+                while((i < len) && ((digit = (uint8_t) (data[i] - '0')) < 10))
+                {
+                    p.checksum ^= data[i];
+                    numberDigit(&p, digit);
+                    i++;
+                }
+            }
+
+            if(i > start)
+            {
+                size_t length = p.length + (i - start);
+                if(length > NMEA_MAX_LENGTH)
+                    p.state = ST_IDLE;
+
+                p.length = length;
+                continue;
+            }
+        }
+
+        *type = parseChar(&p, data[i]);
+        i += 1;
+
+        if(*type != NMEA_NONE)
+            break;
+    }
+
+    *parser = p;
+    return i;
+}
+
+void nmea_update(const struct nmeaParser *parser, gps_t *gps)
+{
+    const int32_t *f = parser->fields;
+
+    switch(parser->type)
+    {
+        case NMEA_RMC:
+            gps->timestamp.hour   = f[0] / 10000;
+            gps->timestamp.minute = (f[0] / 100) % 100;
+            gps->timestamp.second = f[0] % 100;
+            gps->timestamp.day    = 0;
+            gps->timestamp.date   = f[8] / 10000;
+            gps->timestamp.month  = (f[8] / 100) % 100;
+            gps->timestamp.year   = f[8] % 100;
+            gps->speed            = KNOTS2KMH(f[6]);
+
+            // Empty time and date fields are reported as -1
+            if(f[0] < 0)
+            {
+                gps->timestamp.hour   = -1;
+                gps->timestamp.minute = -1;
+                gps->timestamp.second = -1;
+            }
+
+            if(f[8] < 0)
+            {
+                gps->timestamp.date  = -1;
+                gps->timestamp.month = -1;
+                gps->timestamp.year  = -1;
+            }
+            break;
+
+        case NMEA_GGA:
+            gps->latitude           = f[1] * f[2];
+            gps->longitude          = f[3] * f[4];
+            gps->fix_quality        = f[5];
+            gps->satellites_tracked = f[6];
+            gps->altitude           = f[8];
+            break;
+
+        case NMEA_GSA:
+            gps->hdop        = f[15];
+            gps->fix_type    = f[1];
+            gps->active_sats = 0;
+            for(int i = 2; i < 14; i++)
+            {
+                if((f[i] > 0) && (f[i] < 31))
+                    gps->active_sats |= 1 << (f[i] - 1);
+            }
+            break;
+
+        case NMEA_GSV:
+        {
+            // Parse only sentences 1 - 3, maximum 12 satellites
+            int32_t msgNr = f[1];
+            if((msgNr < 1) || (msgNr >= 3))
+                break;
+
+            // When the first sentence arrives, clear all the old data
+            if(msgNr == 1)
+                memset(&gps->satellites[0], 0x00, 12 * sizeof(gpssat_t));
+
+            gps->satellites_in_view = f[2];
+            for(int i = 0; i < 4; i++)
+            {
+                int index = 4 * (msgNr - 1) + i;
+                const int32_t *sat = &f[3 + (4 * i)];
+                gps->satellites[index].id        = sat[0];
+                gps->satellites[index].elevation = sat[1];
+                gps->satellites[index].azimuth   = sat[2];
+                gps->satellites[index].snr       = sat[3];
+            }
+        }
+            break;
+
+        case NMEA_VTG:
+            gps->speed    = f[6];
+            gps->tmg_mag  = f[2];
+            gps->tmg_true = f[0];
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool nmea_timeValid(const struct nmeaParser *parser)
+{
+    return (parser->type == NMEA_RMC) && (parser->fields[1] == 'A');
+}
@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "core/rssi.h"
+
+void rssi_computeConversion(rssiConv_t *conv, const rssiCalPoint_t *cal,
+                            const size_t numPoints, const freq_t freq,
+                            const uint32_t countsTouV)
+{
+    int32_t slope  = 0;
+    int32_t offset = 0;
+
+    if(numPoints == 0)
+    {
+        conv->gain   = 0;
+        conv->offset = 0;
+        return;
+    }
+
+    if(freq <= cal[0].freq)
+    {
+        slope  = cal[0].slope;
+        offset = cal[0].offset;
+    }
+    else if(freq >= cal[numPoints - 1].freq)
+    {
+        slope  = cal[numPoints - 1].slope;
+        offset = cal[numPoints - 1].offset;
+    }
+    else
+    {
+        size_t i = 1;
+        while(cal[i].freq < freq)
+            i++;
+
+        const rssiCalPoint_t *lo = &cal[i - 1];
+        const rssiCalPoint_t *hi = &cal[i];
+        int64_t num = freq - lo->freq;
+        int64_t den = hi->freq - lo->freq;
+
+        slope  = lo->slope  + (((int64_t)(hi->slope  - lo->slope)  * num) / den);
+        offset = lo->offset + (((int64_t)(hi->offset - lo->offset) * num) / den);
+    }
+
+    /*
+     * Slope is in 10^-6 dB/mV while the ADC conversion factor is in uV per
+     * count, Q16.16. Gain in 0.1dB per count is then slope * countsTouV * 10^-8,
+     * still in Q16.16 format.
+     */
+    conv->gain   = (int32_t)(((int64_t) slope * countsTouV) / 100000000);
+    conv->offset = offset;
+}
+
+void rssiFilter_init(rssiFilter_t *filter, const enum rssiFilterType type,
+                     const uint32_t param)
+{
+    filter->type  = type;
+    filter->alpha = 0;
+    filter->len   = 1;
+
+    switch(type)
+    {
+        case RSSI_FILTER_EMA:
+            filter->alpha = (param > 0x10000) ? 0x10000 : param;
+            break;
+
+        case RSSI_FILTER_MEDIAN:
+            filter->len = (param > RSSI_MEDIAN_MAX_LEN) ? RSSI_MEDIAN_MAX_LEN
+                                                        : param;
+            if(filter->len == 0)
+                filter->len = 1;
+            break;
+
+        default:
+            break;
+    }
+
+    rssiFilter_reset(filter);
+}
+
+void rssiFilter_reset(rssiFilter_t *filter)
+{
+    filter->pos   = 0;
+    filter->count = 0;
+    filter->acc   = 0;
+    filter->value = 0;
+}
+
+static int16_t median(const int16_t *window, const uint8_t len)
+{
+    int16_t sorted[RSSI_MEDIAN_MAX_LEN];
+
+    // Insertion sort, window is small
+    for(uint8_t i = 0; i < len; i++)
+    {
+        int16_t val = window[i];
+        uint8_t j   = i;
+
+        while((j > 0) && (sorted[j - 1] > val))
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+
+        sorted[j] = val;
+    }
+
+    return sorted[len / 2];
+}
+
+int16_t rssiFilter_update(rssiFilter_t *filter, const int16_t sample)
+{
+    switch(filter->type)
+    {
+        case RSSI_FILTER_EMA:
+        {
+            int32_t value = (int32_t) sample * 65536;
+
+            if(filter->count == 0)
+            {
+                filter->acc   = value;
+                filter->count = 1;
+            }
+            else
+            {
+                int64_t delta = ((int64_t) value - filter->acc) * filter->alpha;
+                filter->acc  += (int32_t)(delta >> 16);
+            }
+
+            filter->value = (int16_t)((filter->acc + 32768) >> 16);
+        }
+            break;
+
+        case RSSI_FILTER_MEDIAN:
+            filter->window[filter->pos] = sample;
+            filter->pos += 1;
+            if(filter->pos >= filter->len)
+                filter->pos = 0;
+
+            if(filter->count < filter->len)
+                filter->count += 1;
+
+            filter->value = median(filter->window, filter->count);
+            break;
+
+        default:
+            filter->value = sample;
+            break;
+    }
+
+    return filter->value;
+}
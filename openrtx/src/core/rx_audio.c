@@ -0,0 +1,336 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "interfaces/delays.h"
+#include "core/audio_stream.h"
+#include "core/audio_path.h"
+#include "core/rx_audio.h"
+#include "core/threads.h"
+#include "hwconfig.h"
+#include <pthread.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef PLATFORM_LINUX
+#include <time.h>
+#endif
+
+#define BLOCK_TIME (RXAUDIO_BLOCK_SIZE * 1000 / RXAUDIO_SAMPLE_RATE)   // Block duration, in ms
+
+/*
+ * Sixth order Chebyshev high-pass filter, 0.5dB ripple, 300Hz passband edge at
+ * 8kHz sample rate, split in three sections of increasing Q. The gain is
+ * distributed among the sections, so that the intermediate signals never
+ * exceed the input level.
+ */
+static const int16_t hpfCoeffs[3][5] =
+{
+    // b0      b1      b2      a1      a2
+    {  10531, -21063,  10531, -19555,   7003 },   // Q = 0.68
+    {  14495, -28990,  14495, -28850,  13869 },   // Q = 1.81
+    {  15579, -31159,  15579, -31327,  15813 }    // Q = 6.51
+};
+
+static pthread_t           rxThread;
+static volatile bool       running  = false;    // Engine thread running
+static volatile bool       reqStop  = false;    // Engine thread stop request
+static pathId              inPath   = -1;       // Demodulated audio path
+static pathId              outPath  = -1;       // Speaker path
+static streamId            inStream = -1;
+static streamId            outStream = -1;
+static uint64_t            busyTime;            // Time spent in processing, in us
+static uint32_t            numBlocks;           // Number of processed blocks
+
+static struct rxAudioChain chain;
+static stream_sample_t     inBuf[2 * RXAUDIO_BLOCK_SIZE];
+static stream_sample_t     outBuf[2 * RXAUDIO_BLOCK_SIZE];
+
+
+/**
+ * \internal
+ * Enable the timestamp counter used to measure the processing time.
+ */
+static void timestampInit()
+{
+    #ifdef DWT
+    // Cycle counter of the Cortex-M debug unit
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    #if (__CORTEX_M == 7)
+    DWT->LAR = 0xC5ACCE55;
+    #endif
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+}
+
+/**
+ * \internal
+ * Get a timestamp for the measurement of the processing time. The processing
+ * of a block takes a few microseconds, well below the resolution of getTick().
+ *
+ * @return timestamp, in CPU cycles when the cycle counter is available and in
+ * nanoseconds otherwise.
+ */
+static inline uint32_t timestamp()
+{
+    #if defined(DWT)
+    return DWT->CYCCNT;
+    #elif defined(PLATFORM_LINUX)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t) ((ts.tv_sec * 1000000000ULL) + ts.tv_nsec);
+    #else
+    return (uint32_t) (getTick() * 1000000ULL);
+    #endif
+}
+
+/**
+ * \internal
+ * Convert the difference between two timestamps to microseconds.
+ */
+static inline uint32_t timestampToUs(const uint32_t delta)
+{
+    #if defined(DWT)
+    return delta / (SystemCoreClock / 1000000);
+    #else
+    return delta / 1000;
+    #endif
+}
+
+/**
+ * \internal
+ * Start the output stream towards the speaker, if its path is open.
+ */
+static void startOutput()
+{
+    if(audioPath_getStatus(outPath) != PATH_OPEN)
+        return;
+
+    memset(outBuf, 0x00, sizeof(outBuf));
+    outStream = audioStream_start(outPath, outBuf, 2 * RXAUDIO_BLOCK_SIZE,
+                                  RXAUDIO_SAMPLE_RATE,
+                                  STREAM_OUTPUT | BUF_CIRC_DOUBLE);
+}
+
+/**
+ * \internal
+ * Terminate the audio streams and release the audio paths.
+ */
+static void closeAudio()
+{
+    if(outStream >= 0)
+        audioStream_terminate(outStream);
+
+    if(inStream >= 0)
+        audioStream_terminate(inStream);
+
+    audioPath_release(outPath);
+    audioPath_release(inPath);
+
+    outStream = -1;
+    inStream  = -1;
+    outPath   = -1;
+    inPath    = -1;
+}
+
+/**
+ * \internal
+ * RX audio engine thread: reads the demodulated audio, runs the processing
+ * chain and sends the result to the speaker.
+ */
+static void *rxAudioFunc(void *arg)
+{
+    (void) arg;
+
+    while(reqStop == false)
+    {
+        // The input stream ends when the RX path gets suspended, wait for it
+        // to be resumed.
+        if(inStream < 0)
+        {
+            if(audioPath_getStatus(inPath) == PATH_OPEN)
+            {
+                inStream = audioStream_start(inPath, inBuf,
+                                             2 * RXAUDIO_BLOCK_SIZE,
+                                             RXAUDIO_SAMPLE_RATE,
+                                             STREAM_INPUT | BUF_CIRC_DOUBLE);
+            }
+
+            if(inStream < 0)
+            {
+                sleepFor(0u, BLOCK_TIME);
+                continue;
+            }
+        }
+
+        dataBlock_t audio = inputStream_getData(inStream);
+        if(audio.data == NULL)
+        {
+            inStream = -1;
+            continue;
+        }
+
+        // The speaker path is suspended by the voice prompts: the audio is
+        // processed anyway, to keep the filters running, and discarded.
+        stream_sample_t *buf = NULL;
+        if(outStream < 0)
+            startOutput();
+
+        if(outStream >= 0)
+        {
+            buf = outputStream_getIdleBuffer(outStream);
+            if(buf == NULL)
+                outStream = -1;
+        }
+
+        size_t len = audio.len;
+        if(len > RXAUDIO_BLOCK_SIZE)
+            len = RXAUDIO_BLOCK_SIZE;
+
+        if(buf != NULL)
+            memcpy(buf, audio.data, len * sizeof(stream_sample_t));
+        else
+            buf = audio.data;
+
+        uint32_t start = timestamp();
+        rxAudio_process(&chain, buf, len);
+        busyTime  += timestampToUs(timestamp() - start);
+        numBlocks += 1;
+
+        if(outStream >= 0)
+            outputStream_sync(outStream, true);
+    }
+
+    closeAudio();
+
+    return NULL;
+}
+
+
+void rxAudio_init(struct rxAudioChain *chain, const uint8_t stages)
+{
+    memset(chain, 0x00, sizeof(struct rxAudioChain));
+    chain->stages = stages;
+
+    for(size_t i = 0; i < 3; i++)
+        dsp_biquadInit(&chain->hpf[i], hpfCoeffs[i]);
+
+    if((stages & RXAUDIO_DEEMPH75) != 0)
+        dsp_deemphasisInit(&chain->deemph, 75, RXAUDIO_SAMPLE_RATE);
+    else
+        dsp_deemphasisInit(&chain->deemph, 50, RXAUDIO_SAMPLE_RATE);
+}
+
+void rxAudio_process(struct rxAudioChain *chain, stream_sample_t *samples,
+                     const size_t len)
+{
+    const uint8_t stages = chain->stages;
+    const bool    deemph = (stages & (RXAUDIO_DEEMPH50 | RXAUDIO_DEEMPH75)) != 0;
+
+    for(size_t i = 0; i < len; i++)
+    {
+        int16_t sample = samples[i];
+
+        if((stages & RXAUDIO_HPF) != 0)
+        {
+            int32_t hp = dsp_biquadFilter(&chain->hpf[0], sample);
+            hp         = dsp_biquadFilter(&chain->hpf[1], hp);
+            hp         = dsp_biquadFilter(&chain->hpf[2], hp);
+            sample     = dsp_saturate(hp);
+        }
+
+        if(deemph)
+            sample = dsp_deemphasisFilter(&chain->deemph, sample);
+
+        if((stages & RXAUDIO_NR) != 0)
+            sample = dsp_noiseReduction(&chain->nr, sample);
+
+        samples[i] = sample;
+    }
+}
+
+int rxAudio_start(const uint8_t stages)
+{
+    if(stages == 0)
+        return -EINVAL;
+
+    if(running)
+        return -EBUSY;
+
+    rxAudio_init(&chain, stages);
+    timestampInit();
+    busyTime  = 0;
+    numBlocks = 0;
+    reqStop   = false;
+
+    inPath  = audioPath_request(SOURCE_RTX, SINK_MCU, PRIO_RX);
+    outPath = audioPath_request(SOURCE_MCU, SINK_SPK, PRIO_RX);
+    if((audioPath_getStatus(inPath)  != PATH_OPEN) ||
+       (audioPath_getStatus(outPath) != PATH_OPEN))
+    {
+        closeAudio();
+        return -EBUSY;
+    }
+
+    // Start the streams here, to let the caller know if the target can route
+    // the RX audio through the MCU.
+    inStream = audioStream_start(inPath, inBuf, 2 * RXAUDIO_BLOCK_SIZE,
+                                 RXAUDIO_SAMPLE_RATE,
+                                 STREAM_INPUT | BUF_CIRC_DOUBLE);
+    startOutput();
+
+    if((inStream < 0) || (outStream < 0))
+    {
+        closeAudio();
+        return -ENODEV;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+
+    #ifdef _MIOSIX
+    pthread_attr_setstacksize(&attr, RXAUDIO_THREAD_STKSIZE);
+
+    // Audio processing has to keep up with the streams
+    struct sched_param param;
+    param.sched_priority = THREAD_PRIO_HIGH;
+    pthread_attr_setschedparam(&attr, &param);
+    #endif
+
+    if(pthread_create(&rxThread, &attr, rxAudioFunc, NULL) != 0)
+    {
+        closeAudio();
+        return -ENOMEM;
+    }
+
+    running = true;
+
+    return 0;
+}
+
+void rxAudio_stop()
+{
+    if(running == false)
+        return;
+
+    reqStop = true;
+    pthread_join(rxThread, NULL);
+
+    running = false;
+}
+
+bool rxAudio_running()
+{
+    return running;
+}
+
+uint16_t rxAudio_getLoad()
+{
+    if(numBlocks == 0)
+        return 0;
+
+    // Busy time in microseconds, block duration in milliseconds
+    return (uint16_t) (busyTime / ((uint64_t) numBlocks * BLOCK_TIME));
+}
@@ -20,6 +20,24 @@ state_t state;
 pthread_mutex_t state_mutex;
 static long long int lastUpdate = 0;
 
+/*
+ * Copy of the state fields shown by the UI, to notify it only when one of them
+ * changes. Battery voltage is kept with the 50mV resolution needed by both
+ * its truncated and rounded representations.
+ */
+typedef struct
+{
+    datetime_t time;
+    uint16_t   v_bat;
+    uint8_t    charge;
+    rssi_t     rssi;
+    uint8_t    volume;
+    gps_t      gps_data;
+}
+shownState_t;
+
+static shownState_t shown;
+
 // Commonly used frequency steps, expressed in Hz
 const uint32_t freq_steps[] = { 1000, 5000, 6250, 10000, 12500, 15000,
                                 20000, 25000, 50000, 100000 };
@@ -83,18 +101,21 @@ void state_terminate()
         state.settings.brightness = 5;
     }
 
-    nvm_writeSettingsAndVfo(&state.settings, &state.channel);
+    // Do not overwrite the settings restored from a flash backup
+    if(state.restore_eflash == false)
+        nvm_writeSettingsAndVfo(&state.settings, &state.channel);
+
     pthread_mutex_destroy(&state_mutex);
 }
 
-void state_task()
+/**
+ * \internal
+ * Update the radio state.
+ *
+ * @return true if any of the state fields shown by the UI changed.
+ */
+static bool updateState()
 {
-    // Update radio state once every 100ms
-    if((getTick() - lastUpdate) < 100)
-        return;
-
-    lastUpdate = getTick();
-
     pthread_mutex_lock(&state_mutex);
 
     /*
@@ -129,9 +150,39 @@ void state_task()
     state.time = platform_getCurrentTime();
     #endif
 
+    shownState_t curr;
+    memset(&curr, 0x00, sizeof(curr));
+    curr.time     = state.time;
+    curr.v_bat    = state.v_bat / 50;
+    curr.charge   = state.charge;
+    curr.rssi     = state.rssi;
+    curr.volume   = state.volume;
+    curr.gps_data = state.gps_data;
+
     pthread_mutex_unlock(&state_mutex);
 
-    ui_pushEvent(EVENT_STATUS, 0);
+    if(memcmp(&curr, &shown, sizeof(curr)) == 0)
+        return false;
+
+    shown = curr;
+    return true;
+}
+
+void state_task()
+{
+    // RTX status transitions are notified right away, the other fields are
+    // updated once every 100ms
+    bool changed = rtx_statusChanged();
+
+    if((getTick() - lastUpdate) >= 100)
+    {
+        lastUpdate = getTick();
+        changed   |= updateState();
+    }
+
+    // Wake up the UI only when there is something new to show
+    if(changed)
+        ui_pushEvent(EVENT_STATUS, 0);
 }
 
 void state_resetSettingsAndVfo()
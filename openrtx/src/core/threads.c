@@ -29,6 +29,13 @@
 /* Mutex for concurrent access to RTX state variable */
 pthread_mutex_t rtx_mutex;
 
+/*
+ * Mutex for concurrent access to the display. On some devices keyboard and
+ * display share the same lines, thus the keyboard scan must not take place
+ * while the framebuffer is being sent to the screen.
+ */
+static pthread_mutex_t display_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /**
  * \internal Thread managing user input and UI
  */
@@ -36,10 +43,9 @@ void *ui_threadFunc(void *arg)
 {
     (void) arg;
 
-    kbd_msg_t   kbd_msg;
-    rtxStatus_t rtx_cfg = { 0 };
+    rtxStatus_t rtx_cfg  = { 0 };
     bool        sync_rtx = true;
-    long long   time     = 0;
+    long long   timeout  = 0;
 
     // Load initial state and update the UI
     ui_saveState();
@@ -47,22 +53,23 @@ void *ui_threadFunc(void *arg)
 
     // Keep the splash screen for one second  before rendering the new UI screen
     sleepFor(1u, 0u);
+    pthread_mutex_lock(&display_mutex);
     gfx_render();
+    pthread_mutex_unlock(&display_mutex);
 
     while(state.devStatus != SHUTDOWN)
     {
-        time = getTick();
-
-        if(input_scanKeyboard(&kbd_msg))
-        {
-            ui_pushEvent(EVENT_KBD, kbd_msg.value);
-        }
-
         pthread_mutex_lock(&state_mutex);   // Lock r/w access to radio state
         ui_updateFSM(&sync_rtx);            // Update UI FSM
         ui_saveState();                     // Save local state copy
         pthread_mutex_unlock(&state_mutex); // Unlock r/w access to radio state
 
+        // Apply the track log settings, starting or stopping the logger takes
+        // a while and it is done here, without the state mutex locked
+        #if defined(CONFIG_GPS)
+        gps_updateTracklog();
+        #endif
+
         vp_tick();                           // continue playing voice prompts in progress if any.
 
         // If synchronization needed take mutex and update RTX configuration
@@ -75,12 +82,24 @@ void *ui_threadFunc(void *arg)
             rtx_cfg.txFrequency = state.channel.tx_frequency;
             rtx_cfg.txPower     = state.channel.power;
             rtx_cfg.sqlLevel    = state.settings.sqlLevel;
+            rtx_cfg.voxLevel    = state.settings.voxLevel;
+            rtx_cfg.rxDsp       = state.rx_dsp;
             rtx_cfg.rxToneEn    = state.channel.fm.rxToneEn;
             rtx_cfg.rxTone      = ctcss_tone[state.channel.fm.rxTone];
             rtx_cfg.txToneEn    = state.channel.fm.txToneEn;
             rtx_cfg.txTone      = ctcss_tone[state.channel.fm.txTone];
             rtx_cfg.toneEn      = state.tone_enabled;
 
+            // Dual watch of priority channel, only when not already tuned on it
+            rtx_cfg.priorityFreq = state.priority_freq;
+            rtx_cfg.dualWatch    = state.dual_watch &&
+                                   (state.priority_freq != state.channel.rx_frequency);
+
+            // Spectrum sweep
+            rtx_cfg.scan       = state.sweep_enabled;
+            rtx_cfg.sweepStart = state.sweep_start;
+            rtx_cfg.sweepStep  = state.sweep_step;
+
             // Enable Tx if channel allows it and we are in UI main screen
             rtx_cfg.txDisable = state.channel.rx_only || state.txDisable;
 
@@ -99,12 +118,23 @@ void *ui_threadFunc(void *arg)
         // Update UI and render on screen, if necessary
         if(ui_updateGUI() == true)
         {
+            pthread_mutex_lock(&display_mutex);
             gfx_render();
+            pthread_mutex_unlock(&display_mutex);
         }
 
-        // 40Hz update rate for keyboard and UI
-        time += 25;
-        sleepUntil(time);
+        // Sleep until a new event comes or until the next update scheduled by
+        // the UI. Voice prompts need to be updated at 40Hz until their
+        // playback ends, without waiting for other events.
+        timeout = ui_getNextUpdate();
+        if(vp_tickPending())
+        {
+            long long vpTime = getTick() + 25;
+            if((timeout == 0) || (vpTime < timeout))
+                timeout = vpTime;
+        }
+
+        event_wait(timeout);
     }
 
     ui_terminate();
@@ -113,6 +143,28 @@ void *ui_threadFunc(void *arg)
     return NULL;
 }
 
+#ifdef CONFIG_FLASH_BACKUP
+/**
+ * \internal
+ * Run the external flash backup or restore requested from the UI, blocking
+ * until the end of the transfer. The RTX thread terminates when leaving the
+ * RUNNING status, thus the radio is powered off afterwards. After a restore
+ * the settings are not saved at power off, to keep the restored ones.
+ */
+static void flashTransfer()
+{
+    if(state.restore_eflash)
+        eflash_restore();
+    else
+        eflash_dump(true);
+
+    pthread_mutex_lock(&state_mutex);
+    state.backup_eflash = false;
+    state.devStatus     = SHUTDOWN;
+    pthread_mutex_unlock(&state_mutex);
+}
+#endif
+
 /**
  * \internal Thread managing the device and update the global state variable.
  */
@@ -120,7 +172,9 @@ void *main_thread(void *arg)
 {
     (void) arg;
 
-    long long time = 0;
+    kbd_msg_t kbd_msg;
+    long long time     = 0;
+    long long kbd_time = 0;
 
     #if defined(CONFIG_GPS)
     const struct gpsDevice *gps = platform_initGps();
@@ -150,11 +204,43 @@ void *main_thread(void *arg)
         // Run state update task
         state_task();
 
+        // Flash backup or restore started from the UI
+        #ifdef CONFIG_FLASH_BACKUP
+        if(state.backup_eflash || state.restore_eflash)
+            flashTransfer();
+        #endif
+
+        // Scan the keyboard at 40Hz and send the key events to the UI. If the
+        // display is being rendered the scan is retried at the next iteration,
+        // this loop never waits for the UI thread.
+        if(((time - kbd_time) >= 25) &&
+           (pthread_mutex_trylock(&display_mutex) == 0))
+        {
+            bool event = input_scanKeyboard(&kbd_msg);
+            pthread_mutex_unlock(&display_mutex);
+
+            if(event)
+                ui_pushEvent(EVENT_KBD, kbd_msg.value);
+
+            kbd_time = time;
+        }
+
+        // Wake up the UI thread if its timeout is expired
+        event_checkTimeout(time);
+
         // Run this loop once every 5ms
         time += 5;
         sleepUntil(time);
     }
 
+    // Stop the track logger, writing its last points
+    #if defined(CONFIG_GPS)
+    gps_updateTracklog();
+    #endif
+
+    // Wake up the UI thread, letting it terminate
+    event_signal();
+
     return NULL;
 }
 
@@ -0,0 +1,494 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "interfaces/platform.h"
+#include "interfaces/delays.h"
+#include "core/audio_stream.h"
+#include "core/tone_engine.h"
+#include "core/threads.h"
+#include "hwconfig.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TONE_BLOCK_SIZE 160      // Samples per half buffer, 20ms
+#define TONE_RAMP_LEN   40       // Length of attack and release ramps, 5ms
+#define TONE_AMPLITUDE  16384    // Tone amplitude at max volume, Q15 format (-6dBFS)
+#define TONE_MIN_VOLUME 5        // Volume level of the beeps at low volume
+#define TONE_MAX_VOLUME 176      // Maximum volume level of the beeps
+
+typedef struct
+{
+    uint16_t freq;
+    uint32_t length;
+}
+tone_t;
+
+/*
+ * Sine table, 256 samples over one period in Q15 format. The last element is
+ * a copy of the first one, to allow linear interpolation without wrapping.
+ */
+static const int16_t sineTable[257] =
+{
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512,
+    10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279,
+    24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268,
+    29621, 29956, 30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137,
+    32285, 32412, 32521, 32609, 32678, 32728, 32757, 32767, 32757, 32728, 32678,
+    32609, 32521, 32412, 32285, 32137, 31971, 31785, 31580, 31356, 31113, 30852,
+    30571, 30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683, 27245, 26790,
+    26319, 25832, 25329, 24811, 24279, 23731, 23170, 22594, 22005, 21403, 20787,
+    20159, 19519, 18868, 18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+    12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179, 6393, 5602, 4808, 4011,
+    3212, 2410, 1608, 804, 0, -804, -1608, -2410, -3212, -4011, -4808, -5602,
+    -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793, -12539, -13279,
+    -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519,
+    -20159, -20787, -21403, -22005, -22594, -23170, -23731, -24279, -24811,
+    -25329, -25832, -26319, -26790, -27245, -27683, -28105, -28510, -28898,
+    -29268, -29621, -29956, -30273, -30571, -30852, -31113, -31356, -31580,
+    -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728,
+    -32757, -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+    -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571, -30273,
+    -29956, -29621, -29268, -28898, -28510, -28105, -27683, -27245, -26790,
+    -26319, -25832, -25329, -24811, -24279, -23731, -23170, -22594, -22005,
+    -21403, -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151,
+    -15446, -14732, -14010, -13279, -12539, -11793, -11039, -10278, -9512,
+    -8739, -7962, -7179, -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804,
+    0
+};
+
+static pathId           audioPath;
+static bool             running;
+static bool             mixing;
+static bool             draining;
+static bool             reqStop;
+static bool             threadValid;
+static pthread_t        toneThread;
+static pthread_attr_t   toneAttr;
+static pthread_mutex_t  queue_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t  init_mutex  = PTHREAD_MUTEX_INITIALIZER;
+
+static tone_t           queue[TONE_QUEUE_SIZE];
+static uint8_t          readPos;
+static uint8_t          writePos;
+static uint8_t          numElements;
+
+static dds_t            osc;            // Oscillator for the current tone
+static uint16_t         toneFreq;       // Frequency of the current tone
+static uint32_t         toneLen;        // Length of the current tone, in samples
+static uint32_t         tonePos;        // Position inside the current tone
+
+#ifndef CONFIG_BEEP_HW
+static int32_t          toneAmpl;       // Amplitude of the current tone, Q15
+static stream_sample_t  audioBuf[2 * TONE_BLOCK_SIZE];
+static stream_sample_t  mixBuf[TONE_BLOCK_SIZE];
+#endif
+
+static void *toneFunc(void *arg);
+static void stopThread();
+
+
+int16_t dds_nextSample(dds_t *dds)
+{
+    // Upper eight bits index the table, the next 16 bits interpolate
+    uint32_t idx  = dds->phase >> 24;
+    int32_t  frac = (dds->phase >> 8) & 0xFFFF;
+    int32_t  s0   = sineTable[idx];
+    int32_t  s1   = sineTable[idx + 1];
+
+    dds->phase += dds->incr;
+
+    return (int16_t)(s0 + (((s1 - s0) * frac) >> 16));
+}
+
+bool toneEngine_queue(const uint16_t freq, const uint16_t duration)
+{
+    bool ret = false;
+
+    pthread_mutex_lock(&queue_mutex);
+
+    if(numElements < TONE_QUEUE_SIZE)
+    {
+        queue[writePos].freq   = freq;
+        queue[writePos].length = ((uint32_t) duration * TONE_SAMPLE_RATE) / 1000;
+        writePos     = (writePos + 1) % TONE_QUEUE_SIZE;
+        numElements += 1;
+        ret          = true;
+    }
+
+    pthread_mutex_unlock(&queue_mutex);
+
+    return ret;
+}
+
+bool toneEngine_start(const pathId path, const bool mix)
+{
+    if(audioPath_getStatus(path) != PATH_OPEN)
+        return false;
+
+    pthread_mutex_lock(&init_mutex);
+
+    #ifdef CONFIG_BEEP_HW
+    // The hardware beep generator is always mixed to the speaker audio
+    (void) mix;
+    #else
+    // Tones mixed into another stream: the current one, if any, is stopped
+    // and the reproduction continues from the samples of the new stream.
+    if(mix)
+    {
+        if(threadValid)
+            stopThread();
+
+        audioPath = path;
+        mixing    = true;
+        running   = true;
+
+        pthread_mutex_unlock(&init_mutex);
+        return true;
+    }
+    #endif
+
+    // Already running on the same path, new tones are picked up automatically
+    if(running && threadValid && (draining == false) && (path == audioPath))
+    {
+        pthread_mutex_unlock(&init_mutex);
+        return true;
+    }
+
+    // Thread either terminating or running on a different path
+    if(threadValid)
+        stopThread();
+
+    audioPath = path;
+    running   = true;
+    mixing    = false;
+    draining  = false;
+    reqStop   = false;
+
+    pthread_attr_init(&toneAttr);
+
+    #if defined(_MIOSIX)
+    // Tone generation is lightweight but has to keep up with the stream
+    pthread_attr_setstacksize(&toneAttr, TONE_THREAD_STKSIZE);
+
+    struct sched_param param;
+    param.sched_priority = THREAD_PRIO_HIGH;
+    pthread_attr_setschedparam(&toneAttr, &param);
+    #elif defined(__ZEPHYR__)
+    void *tone_thread_stack = malloc(TONE_THREAD_STKSIZE * sizeof(uint8_t));
+    pthread_attr_setstack(&toneAttr, tone_thread_stack, TONE_THREAD_STKSIZE);
+    #endif
+
+    int ret = pthread_create(&toneThread, &toneAttr, toneFunc, &audioPath);
+    if(ret == 0)
+        threadValid = true;
+    else
+        running = false;
+
+    pthread_mutex_unlock(&init_mutex);
+
+    return running;
+}
+
+void toneEngine_stop()
+{
+    pthread_mutex_lock(&init_mutex);
+
+    if(threadValid)
+        stopThread();
+
+    mixing  = false;
+    running = false;
+
+    pthread_mutex_lock(&queue_mutex);
+    readPos     = 0;
+    writePos    = 0;
+    numElements = 0;
+    toneLen     = 0;
+    tonePos     = 0;
+    pthread_mutex_unlock(&queue_mutex);
+
+    pthread_mutex_unlock(&init_mutex);
+}
+
+bool toneEngine_running()
+{
+    return running;
+}
+
+/**
+ * \internal
+ * Load the next tone from the queue.
+ *
+ * @return false if the queue is empty.
+ */
+static bool popTone()
+{
+    pthread_mutex_lock(&queue_mutex);
+
+    if(numElements == 0)
+    {
+        pthread_mutex_unlock(&queue_mutex);
+        return false;
+    }
+
+    toneFreq     = queue[readPos].freq;
+    toneLen      = queue[readPos].length;
+    tonePos      = 0;
+    readPos      = (readPos + 1) % TONE_QUEUE_SIZE;
+    numElements -= 1;
+
+    pthread_mutex_unlock(&queue_mutex);
+
+    osc.phase = 0;
+    dds_setFrequency(&osc, toneFreq * 10, TONE_SAMPLE_RATE);
+
+    return true;
+}
+
+#ifdef CONFIG_BEEP_HW
+
+void toneEngine_mix(stream_sample_t *buf, const size_t len)
+{
+    // Beeps are mixed by the hardware generator
+    (void) buf;
+    (void) len;
+}
+
+/**
+ * \internal
+ * Tone engine thread, driving the hardware beep generator.
+ */
+static void *toneFunc(void *arg)
+{
+    (void) arg;
+
+    long long toneEnd = getTick();
+
+    while(reqStop == false)
+    {
+        long long now = getTick();
+        if(now < toneEnd)
+        {
+            // Sleep in short slices, to promptly react to a stop request
+            long long wait = toneEnd - now;
+            if(wait > 10)
+                wait = 10;
+
+            sleepFor(0u, (unsigned int) wait);
+            continue;
+        }
+
+        pthread_mutex_lock(&queue_mutex);
+        if(numElements == 0)
+            draining = true;
+        pthread_mutex_unlock(&queue_mutex);
+
+        if(draining)
+            break;
+
+        popTone();
+
+        if(toneFreq == 0)
+            platform_beepStop();
+        else
+            platform_beepStart(toneFreq);
+
+        toneEnd += (toneLen * 1000) / TONE_SAMPLE_RATE;
+    }
+
+    platform_beepStop();
+
+    running = false;
+    return NULL;
+}
+
+#else
+
+/**
+ * \internal
+ * Compute the amplitude of the tones from the current volume level, clamped
+ * to keep the beeps audible at the minimum volume.
+ *
+ * @return tone amplitude, in Q15 format.
+ */
+static int32_t toneAmplitude()
+{
+    int32_t vol = platform_getVolumeLevel();
+
+    if(vol < 10)
+        vol = TONE_MIN_VOLUME;
+    if(vol > TONE_MAX_VOLUME)
+        vol = TONE_MAX_VOLUME;
+
+    return (TONE_AMPLITUDE * vol) / TONE_MAX_VOLUME;
+}
+
+/**
+ * \internal
+ * Fill a block of samples with the queued tones. Each tone starts and ends with
+ * a short linear ramp to avoid clicks at the transitions.
+ *
+ * @param buf: pointer to the sample block.
+ * @param len: number of samples in the block.
+ * @return number of samples containing tone data, the remaining ones are set
+ * to zero.
+ */
+static size_t fillBlock(stream_sample_t *buf, const size_t len)
+{
+    size_t i;
+
+    for(i = 0; i < len; i++)
+    {
+        if(tonePos >= toneLen)
+        {
+            if(popTone() == false)
+                break;
+
+            toneAmpl = toneAmplitude();
+        }
+
+        uint32_t toEnd = toneLen - tonePos;
+        int32_t  gain  = toneAmpl;
+
+        if(tonePos < TONE_RAMP_LEN)
+            gain = (gain * (int32_t) tonePos) / TONE_RAMP_LEN;
+        else if(toEnd < TONE_RAMP_LEN)
+            gain = (gain * (int32_t) toEnd) / TONE_RAMP_LEN;
+
+        if(toneFreq == 0)
+            buf[i] = 0;
+        else
+            buf[i] = (stream_sample_t)((dds_nextSample(&osc) * gain) >> 15);
+
+        tonePos++;
+    }
+
+    memset(&buf[i], 0x00, (len - i) * sizeof(stream_sample_t));
+
+    return i;
+}
+
+void toneEngine_mix(stream_sample_t *buf, const size_t len)
+{
+    // Never block the caller stream
+    if(pthread_mutex_trylock(&init_mutex) != 0)
+        return;
+
+    if((mixing == false) || (running == false))
+    {
+        pthread_mutex_unlock(&init_mutex);
+        return;
+    }
+
+    for(size_t pos = 0; pos < len; pos += TONE_BLOCK_SIZE)
+    {
+        size_t blkLen = len - pos;
+        if(blkLen > TONE_BLOCK_SIZE)
+            blkLen = TONE_BLOCK_SIZE;
+
+        size_t numTone = fillBlock(mixBuf, blkLen);
+        for(size_t i = 0; i < numTone; i++)
+        {
+            int32_t val = buf[pos + i] + mixBuf[i];
+
+            if(val > INT16_MAX) val = INT16_MAX;
+            if(val < INT16_MIN) val = INT16_MIN;
+
+            buf[pos + i] = (stream_sample_t) val;
+        }
+
+        // Queue exhausted, the last tone has been fully mixed
+        if(numTone < blkLen)
+        {
+            mixing  = false;
+            running = false;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&init_mutex);
+}
+
+/**
+ * \internal
+ * Tone engine thread, sending the tones to the speaker through an output
+ * audio stream.
+ */
+static void *toneFunc(void *arg)
+{
+    pathId   path = *((pathId *) arg);
+    uint8_t  idle = 0;
+    streamId stream;
+
+    memset(audioBuf, 0x00, sizeof(audioBuf));
+    stream = audioStream_start(path, audioBuf, 2 * TONE_BLOCK_SIZE,
+                               TONE_SAMPLE_RATE, STREAM_OUTPUT | BUF_CIRC_DOUBLE);
+    if(stream < 0)
+    {
+        running = false;
+        return NULL;
+    }
+
+    // Synchronise with the stream before writing the first block of samples
+    outputStream_sync(stream, false);
+
+    while(reqStop == false)
+    {
+        if(audioPath_getStatus(path) != PATH_OPEN)
+            break;
+
+        stream_sample_t *block = outputStream_getIdleBuffer(stream);
+        if(block == NULL)
+            break;
+
+        if(fillBlock(block, TONE_BLOCK_SIZE) == 0)
+            idle += 1;
+        else
+            idle = 0;
+
+        outputStream_sync(stream, true);
+
+        /*
+         * Terminate when the queue is empty and two blocks of silence have
+         * been sent, ensuring that the last tone has been fully played.
+         */
+        pthread_mutex_lock(&queue_mutex);
+        if((idle >= 2) && (numElements == 0))
+            draining = true;
+        pthread_mutex_unlock(&queue_mutex);
+
+        if(draining)
+            break;
+    }
+
+    if(reqStop)
+        audioStream_terminate(stream);
+    else
+        audioStream_stop(stream);
+
+    running = false;
+    return NULL;
+}
+
+#endif
+
+static void stopThread()
+{
+    reqStop = true;
+    pthread_join(toneThread, NULL);
+    threadValid = false;
+    running     = false;
+
+    #ifdef __ZEPHYR__
+    void  *addr;
+    size_t size;
+
+    pthread_attr_getstack(&toneAttr, &addr, &size);
+    free(addr);
+    #endif
+}
@@ -0,0 +1,741 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "core/nvmem_device.h"
+#include "core/tracklog.h"
+#include "core/threads.h"
+#include "core/crc.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <math.h>
+
+#define BLOCK_MAGIC   0x314B5254    // "TRK1"
+#define HEADER_SIZE   16
+#define PAYLOAD_SIZE  (TRACKLOG_BLOCK_SIZE - HEADER_SIZE)
+#define MAX_POINT_LEN 25            // Five fields of up to five bytes each
+#define NO_BLOCK      0xFF
+
+/*
+ * Track point, all the fields are signed to allow for the computation of the
+ * differences between consecutive points.
+ */
+typedef struct
+{
+    int32_t time;       // Seconds since 2000-01-01 00:00:00 UTC
+    int32_t latitude;   // Millionths of degree
+    int32_t longitude;  // Millionths of degree
+    int32_t altitude;   // Meters
+    int32_t speed;      // km/h
+}
+point_t;
+
+/*
+ * Block of the log being filled or waiting to be written.
+ */
+typedef struct
+{
+    uint32_t address;   // Address of the block in the memory
+    uint32_t seq;       // Sequence number
+    uint16_t count;     // Number of points
+    uint16_t len;       // Payload length
+    point_t  last;      // Last point, for the delta encoding
+    uint8_t  data[TRACKLOG_BLOCK_SIZE];
+}
+block_t;
+
+static pthread_mutex_t logMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  logCond  = PTHREAD_COND_INITIALIZER;
+static pthread_t       writer;
+
+static const struct nvmDevice *logDev;  // Memory device for the log storage
+static uint32_t  logStart;              // Start address of the log area
+static uint32_t  numBlocks;             // Number of blocks in the log area
+static uint32_t  nextBlock;             // Next block to be written
+static uint32_t  nextSeq;               // Sequence number of the next block
+static uint16_t  minInterval;           // Minimum time between two points
+static uint16_t  minDistance;           // Minimum distance between two points
+
+static block_t  *blocks;                // Active and pending blocks
+static uint8_t   active;                // Block being filled
+static uint8_t   pending;               // Block waiting to be written
+static bool      running    = false;
+static bool      writerStop;
+static int       writeError;
+static point_t   lastPoint;             // Last point stored
+static bool      havePoint;
+static uint32_t  numPoints;
+static uint32_t  lostPoints;
+
+
+/**
+ * \internal
+ * Convert a date to the number of days since 2000-01-01.
+ */
+static int32_t daysFromDate(int32_t year, const int32_t month, const int32_t day)
+{
+    // Count the years from March, leaving February as the last month
+    if(month <= 2)
+        year -= 1;
+
+    int32_t era = year / 400;
+    int32_t yoe = year - (era * 400);
+    int32_t doy = ((153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5) + day - 1;
+    int32_t doe = (yoe * 365) + (yoe / 4) - (yoe / 100) + doy;
+
+    return (era * 146097) + doe - 730425;
+}
+
+/**
+ * \internal
+ * Convert a number of days since 2000-01-01 to a date.
+ */
+static void dateFromDays(int32_t days, int32_t *year, int32_t *month,
+                         int32_t *day)
+{
+    days += 730425;
+
+    int32_t era = days / 146097;
+    int32_t doe = days - (era * 146097);
+    int32_t yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+    int32_t doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100));
+    int32_t mp  = ((5 * doy) + 2) / 153;
+
+    *day   = doy - (((153 * mp) + 2) / 5) + 1;
+    *month = (mp < 10) ? (mp + 3) : (mp - 9);
+    *year  = yoe + (era * 400) + ((*month <= 2) ? 1 : 0);
+}
+
+static inline uint32_t zigzag(const int32_t value)
+{
+    return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+}
+
+static inline int32_t unzigzag(const uint32_t value)
+{
+    return (int32_t) (value >> 1) ^ -((int32_t) (value & 1));
+}
+
+/**
+ * \internal
+ * Append a signed value to a buffer as a zigzag encoded varint.
+ *
+ * @return number of bytes written.
+ */
+static size_t putVarint(uint8_t *buf, const int32_t value)
+{
+    uint32_t val = zigzag(value);
+    size_t   len = 0;
+
+    while(val >= 0x80)
+    {
+        buf[len++] = (val & 0x7F) | 0x80;
+        val >>= 7;
+    }
+
+    buf[len++] = val;
+    return len;
+}
+
+/**
+ * \internal
+ * Read a zigzag encoded varint from a buffer.
+ *
+ * @return false if the buffer ends before the end of the value.
+ */
+static bool getVarint(const uint8_t *buf, const size_t len, size_t *pos,
+                      int32_t *value)
+{
+    uint32_t val   = 0;
+    uint8_t  shift = 0;
+
+    while((*pos < len) && (shift < 35))
+    {
+        uint8_t byte = buf[*pos];
+        *pos += 1;
+
+        val |= (uint32_t) (byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+        {
+            *value = unzigzag(val);
+            return true;
+        }
+
+        shift += 7;
+    }
+
+    return false;
+}
+
+/**
+ * \internal
+ * Encode a point, as difference from a reference one.
+ *
+ * @return number of bytes written.
+ */
+static size_t encodePoint(uint8_t *buf, const point_t *point, const point_t *ref)
+{
+    size_t len = 0;
+
+    len += putVarint(&buf[len], point->time      - ref->time);
+    len += putVarint(&buf[len], point->latitude  - ref->latitude);
+    len += putVarint(&buf[len], point->longitude - ref->longitude);
+    len += putVarint(&buf[len], point->altitude  - ref->altitude);
+    len += putVarint(&buf[len], point->speed     - ref->speed);
+
+    return len;
+}
+
+/**
+ * \internal
+ * Decode a point, adding the decoded differences to the previous one.
+ *
+ * @return false if the payload ends before the end of the point.
+ */
+static bool decodePoint(const uint8_t *buf, const size_t len, size_t *pos,
+                        point_t *point)
+{
+    int32_t delta[5];
+
+    for(size_t i = 0; i < 5; i++)
+    {
+        if(getVarint(buf, len, pos, &delta[i]) == false)
+            return false;
+    }
+
+    point->time      += delta[0];
+    point->latitude  += delta[1];
+    point->longitude += delta[2];
+    point->altitude  += delta[3];
+    point->speed     += delta[4];
+
+    return true;
+}
+
+static inline void putU16(uint8_t *buf, const uint16_t value)
+{
+    buf[0] = value & 0xFF;
+    buf[1] = value >> 8;
+}
+
+static inline void putU32(uint8_t *buf, const uint32_t value)
+{
+    putU16(&buf[0], value & 0xFFFF);
+    putU16(&buf[2], value >> 16);
+}
+
+static inline uint16_t getU16(const uint8_t *buf)
+{
+    return buf[0] | (buf[1] << 8);
+}
+
+static inline uint32_t getU32(const uint8_t *buf)
+{
+    return getU16(&buf[0]) | ((uint32_t) getU16(&buf[2]) << 16);
+}
+
+/**
+ * \internal
+ * Approximate distance between two points, in meters. The equirectangular
+ * projection is accurate enough for the short distances between consecutive
+ * points.
+ */
+static float pointDistance(const point_t *a, const point_t *b)
+{
+    // Meters per millionth of degree along a meridian
+    static const float scale = 0.111195f;
+
+    float lat = (float) a->latitude * (3.14159265f / 180e6f);
+    float dx  = (float) (b->longitude - a->longitude) * scale * cosf(lat);
+    float dy  = (float) (b->latitude  - a->latitude)  * scale;
+
+    return sqrtf((dx * dx) + (dy * dy));
+}
+
+/**
+ * \internal
+ * Read and validate the header of a log block.
+ *
+ * @return true if the block contains valid log data.
+ */
+static bool readHeader(const struct nvmDevice *dev, const uint32_t address,
+                       uint32_t *seq, uint16_t *len)
+{
+    uint8_t header[HEADER_SIZE];
+
+    if(nvm_devRead(dev, address, header, HEADER_SIZE) < 0)
+        return false;
+
+    if(getU32(&header[0]) != BLOCK_MAGIC)
+        return false;
+
+    *seq = getU32(&header[4]);
+    *len = getU16(&header[10]);
+
+    return (*len <= PAYLOAD_SIZE);
+}
+
+/**
+ * \internal
+ * Find the newest block of a log area.
+ *
+ * @return index of the newest block or -1 if the log is empty.
+ */
+static int32_t findNewest(const struct nvmDevice *dev, const uint32_t start,
+                          const uint32_t count, uint32_t *seq)
+{
+    int32_t newest = -1;
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+        uint32_t blockSeq;
+        uint16_t len;
+
+        if(readHeader(dev, start + (i * TRACKLOG_BLOCK_SIZE), &blockSeq, &len) == false)
+            continue;
+
+        if((newest < 0) || ((int32_t) (blockSeq - *seq) > 0))
+        {
+            newest = i;
+            *seq   = blockSeq;
+        }
+    }
+
+    return newest;
+}
+
+/**
+ * \internal
+ * Complete the header of the active block and queue it for writing, the
+ * next block becomes the active one. To be called with the mutex locked and
+ * no block pending.
+ */
+static void queueActive()
+{
+    block_t *block = &blocks[active];
+    uint8_t *hdr   = block->data;
+
+    putU32(&hdr[0],  BLOCK_MAGIC);
+    putU32(&hdr[4],  block->seq);
+    putU16(&hdr[8],  block->count);
+    putU16(&hdr[10], block->len);
+    putU16(&hdr[12], crc_ccitt(&block->data[HEADER_SIZE], block->len));
+    putU16(&hdr[14], 0xFFFF);
+
+    // Unused space is left as erased
+    memset(&block->data[HEADER_SIZE + block->len], 0xFF,
+           PAYLOAD_SIZE - block->len);
+
+    pending = active;
+    active  = (active + 1) % 2;
+
+    block_t *next = &blocks[active];
+    next->address = logStart + (nextBlock * TRACKLOG_BLOCK_SIZE);
+    next->seq     = nextSeq;
+    next->count   = 0;
+    next->len     = 0;
+    nextBlock     = (nextBlock + 1) % numBlocks;
+    nextSeq      += 1;
+
+    pthread_cond_broadcast(&logCond);
+}
+
+/**
+ * \internal
+ * Thread writing the full blocks to the memory, the log area is erased
+ * one block at a time just before being written.
+ */
+static void *writerFunc(void *arg)
+{
+    (void) arg;
+
+    pthread_mutex_lock(&logMutex);
+
+    while(1)
+    {
+        while((pending == NO_BLOCK) && (writerStop == false))
+            pthread_cond_wait(&logCond, &logMutex);
+
+        if(pending == NO_BLOCK)
+            break;
+
+        block_t *block = &blocks[pending];
+        pthread_mutex_unlock(&logMutex);
+
+        // Memories not needing an erase, like files, do not support it
+        int ret = nvm_devErase(logDev, block->address, TRACKLOG_BLOCK_SIZE);
+        if((ret >= 0) || (ret == -ENOTSUP))
+            ret = nvm_devWrite(logDev, block->address, block->data,
+                               TRACKLOG_BLOCK_SIZE);
+
+        pthread_mutex_lock(&logMutex);
+
+        if(ret < 0)
+        {
+            writeError  = ret;
+            lostPoints += block->count;
+        }
+
+        pending = NO_BLOCK;
+        pthread_cond_broadcast(&logCond);
+    }
+
+    pthread_mutex_unlock(&logMutex);
+
+    return NULL;
+}
+
+/**
+ * \internal
+ * Write a string to the export output.
+ */
+static int writeStr(tracklog_write_t write, void *ctx, const char *str)
+{
+    size_t len = strlen(str);
+    if(write(ctx, str, len) != (ssize_t) len)
+        return -EIO;
+
+    return 0;
+}
+
+/**
+ * \internal
+ * Export the points of a log block in GPX format.
+ *
+ * @return number of points exported or a negative error code.
+ */
+static ssize_t exportBlock(const uint8_t *payload, const uint16_t len,
+                           tracklog_write_t write, void *ctx)
+{
+    point_t point;
+    size_t  pos   = 0;
+    ssize_t count = 0;
+
+    memset(&point, 0x00, sizeof(point_t));
+
+    while(decodePoint(payload, len, &pos, &point))
+    {
+        char    line[192];
+        int32_t year, month, day;
+
+        int32_t days = point.time / 86400;
+        int32_t secs = point.time % 86400;
+        dateFromDays(days, &year, &month, &day);
+
+        int32_t lat   = abs(point.latitude);
+        int32_t lon   = abs(point.longitude);
+        int32_t speed = (point.speed * 100) / 36;   // Tenths of m/s
+
+        snprintf(line, sizeof(line),
+                 "<trkpt lat=\"%s%ld.%06ld\" lon=\"%s%ld.%06ld\">"
+                 "<ele>%ld</ele>"
+                 "<time>%04ld-%02ld-%02ldT%02ld:%02ld:%02ldZ</time>"
+                 "<speed>%ld.%ld</speed></trkpt>\n",
+                 (point.latitude < 0) ? "-" : "", (long) (lat / 1000000),
+                 (long) (lat % 1000000),
+                 (point.longitude < 0) ? "-" : "", (long) (lon / 1000000),
+                 (long) (lon % 1000000),
+                 (long) point.altitude,
+                 (long) year, (long) month, (long) day, (long) (secs / 3600),
+                 (long) ((secs / 60) % 60), (long) (secs % 60),
+                 (long) (speed / 10), (long) (speed % 10));
+
+        if(writeStr(write, ctx, line) < 0)
+            return -EIO;
+
+        count += 1;
+    }
+
+    return count;
+}
+
+
+int tracklog_start(const struct nvmDevice *dev, const uint32_t offset,
+                   const size_t size, const uint16_t interval,
+                   const uint16_t distance)
+{
+    if(running)
+        return -EBUSY;
+
+    if(((offset % TRACKLOG_BLOCK_SIZE) != 0) || (size < TRACKLOG_BLOCK_SIZE))
+        return -EINVAL;
+
+    blocks = malloc(2 * sizeof(block_t));
+    if(blocks == NULL)
+        return -ENOMEM;
+
+    logDev      = dev;
+    logStart    = offset;
+    numBlocks   = size / TRACKLOG_BLOCK_SIZE;
+    minInterval = interval;
+    minDistance = distance;
+    nextBlock   = 0;
+    nextSeq     = 0;
+
+    // Continue after the newest block already present
+    int32_t newest = findNewest(dev, offset, numBlocks, &nextSeq);
+    if(newest >= 0)
+    {
+        nextBlock = (newest + 1) % numBlocks;
+        nextSeq  += 1;
+    }
+
+    // First active block
+    blocks[0].address = logStart + (nextBlock * TRACKLOG_BLOCK_SIZE);
+    blocks[0].seq     = nextSeq;
+    blocks[0].count   = 0;
+    blocks[0].len     = 0;
+    nextBlock         = (nextBlock + 1) % numBlocks;
+    nextSeq          += 1;
+
+    active     = 0;
+    pending    = NO_BLOCK;
+    writerStop = false;
+    writeError = 0;
+    havePoint  = false;
+    numPoints  = 0;
+    lostPoints = 0;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+
+    #ifdef _MIOSIX
+    pthread_attr_setstacksize(&attr, TRACKLOG_THREAD_STKSIZE);
+    #endif
+
+    if(pthread_create(&writer, &attr, writerFunc, NULL) != 0)
+    {
+        free(blocks);
+        return -ENOMEM;
+    }
+
+    running = true;
+
+    return 0;
+}
+
+int tracklog_stop()
+{
+    // Checked with the mutex locked, the UI and the main thread can both stop
+    // the logger at shutdown
+    pthread_mutex_lock(&logMutex);
+
+    if(running == false)
+    {
+        pthread_mutex_unlock(&logMutex);
+        return 0;
+    }
+
+    running = false;
+
+    // Write the partially filled block
+    while(pending != NO_BLOCK)
+        pthread_cond_wait(&logCond, &logMutex);
+
+    if(blocks[active].count > 0)
+        queueActive();
+
+    writerStop = true;
+    pthread_cond_broadcast(&logCond);
+    pthread_mutex_unlock(&logMutex);
+
+    pthread_join(writer, NULL);
+    free(blocks);
+    blocks = NULL;
+
+    return writeError;
+}
+
+void tracklog_setThresholds(const uint16_t interval, const uint16_t distance)
+{
+    minInterval = interval;
+    minDistance = distance;
+}
+
+bool tracklog_running()
+{
+    return running;
+}
+
+bool tracklog_addPoint(const gps_t *gps)
+{
+    if((running == false) || (gps->fix_quality == FIX_QUALITY_NO_FIX))
+        return false;
+
+    point_t point;
+    point.time      = (daysFromDate(2000 + gps->timestamp.year,
+                                    gps->timestamp.month,
+                                    gps->timestamp.date) * 86400)
+                    + (gps->timestamp.hour * 3600)
+                    + (gps->timestamp.minute * 60)
+                    + gps->timestamp.second;
+    point.latitude  = gps->latitude;
+    point.longitude = gps->longitude;
+    point.altitude  = gps->altitude;
+    point.speed     = gps->speed;
+
+    if(havePoint)
+    {
+        // A time going backwards restarts the interval count
+        int32_t elapsed = point.time - lastPoint.time;
+        if((elapsed >= 0) && (elapsed < minInterval))
+            return false;
+
+        if(pointDistance(&lastPoint, &point) < minDistance)
+            return false;
+    }
+
+    pthread_mutex_lock(&logMutex);
+
+    // Logger stopped by another thread in the meantime
+    if(running == false)
+    {
+        pthread_mutex_unlock(&logMutex);
+        return false;
+    }
+
+    block_t *block = &blocks[active];
+    if((block->len + MAX_POINT_LEN) > PAYLOAD_SIZE)
+    {
+        // Writer still busy with the previous block, drop the point
+        if(pending != NO_BLOCK)
+        {
+            lostPoints += 1;
+            pthread_mutex_unlock(&logMutex);
+            return false;
+        }
+
+        queueActive();
+        block = &blocks[active];
+    }
+
+    // The first point of a block is stored with its absolute values
+    if(block->count == 0)
+        memset(&block->last, 0x00, sizeof(point_t));
+
+    block->len   += encodePoint(&block->data[HEADER_SIZE + block->len], &point,
+                                &block->last);
+    block->last   = point;
+    block->count += 1;
+    numPoints    += 1;
+
+    pthread_mutex_unlock(&logMutex);
+
+    lastPoint = point;
+    havePoint = true;
+
+    return true;
+}
+
+uint32_t tracklog_numPoints()
+{
+    return numPoints;
+}
+
+uint32_t tracklog_lostPoints()
+{
+    return lostPoints;
+}
+
+ssize_t tracklog_exportGpx(const struct nvmDevice *dev, const uint32_t offset,
+                           const size_t size, tracklog_write_t write,
+                           void *ctx)
+{
+    const uint32_t count = size / TRACKLOG_BLOCK_SIZE;
+    uint8_t       *data  = malloc(TRACKLOG_BLOCK_SIZE);
+    uint32_t       limit = 0;
+    uint16_t       len   = 0;
+    bool           live  = false;
+    ssize_t        total = 0;
+
+    if(data == NULL)
+        return -ENOMEM;
+
+    /*
+     * When exporting the log being recorded, wait for the pending block to be
+     * written and take a copy of the active one. Blocks written after the copy
+     * are excluded from the export.
+     */
+    pthread_mutex_lock(&logMutex);
+    if(running && (dev == logDev) && (offset == logStart))
+    {
+        while(pending != NO_BLOCK)
+            pthread_cond_wait(&logCond, &logMutex);
+
+        block_t *block = &blocks[active];
+        memcpy(data, &block->data[HEADER_SIZE], block->len);
+        len   = block->len;
+        limit = block->seq;
+        live  = true;
+    }
+    pthread_mutex_unlock(&logMutex);
+
+    uint8_t *payload = live ? malloc(TRACKLOG_BLOCK_SIZE) : data;
+    if(payload == NULL)
+    {
+        free(data);
+        return -ENOMEM;
+    }
+
+    int ret = writeStr(write, ctx,
+                       "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                       "<gpx version=\"1.0\" creator=\"OpenRTX\" "
+                       "xmlns=\"http://www.topografix.com/GPX/1/0\">\n"
+                       "<trk><name>OpenRTX track</name><trkseg>\n");
+
+    // Blocks are written in circular order, the oldest follows the newest
+    uint32_t newestSeq = 0;
+    int32_t  newest    = findNewest(dev, offset, count, &newestSeq);
+
+    for(uint32_t i = 1; (i <= count) && (newest >= 0) && (ret >= 0); i++)
+    {
+        uint32_t address = offset + (((newest + i) % count) * TRACKLOG_BLOCK_SIZE);
+        uint32_t seq;
+        uint16_t blockLen;
+
+        if(readHeader(dev, address, &seq, &blockLen) == false)
+            continue;
+
+        if(live && ((int32_t) (seq - limit) >= 0))
+            continue;
+
+        if(nvm_devRead(dev, address, payload, HEADER_SIZE + blockLen) < 0)
+        {
+            ret = -EIO;
+            break;
+        }
+
+        if(crc_ccitt(&payload[HEADER_SIZE], blockLen) != getU16(&payload[12]))
+            continue;
+
+        ssize_t num = exportBlock(&payload[HEADER_SIZE], blockLen, write, ctx);
+        if(num < 0)
+            ret = num;
+        else
+            total += num;
+    }
+
+    if(live && (ret >= 0))
+    {
+        ssize_t num = exportBlock(data, len, write, ctx);
+        if(num < 0)
+            ret = num;
+        else
+            total += num;
+    }
+
+    if(ret >= 0)
+        ret = writeStr(write, ctx, "</trkseg></trk>\n</gpx>\n");
+
+    if(live)
+        free(payload);
+
+    free(data);
+
+    return (ret < 0) ? ret : total;
+}
@@ -12,6 +12,9 @@
 #include "core/voicePrompts.h"
 #include "core/audio_codec.h"
 #include "core/audio_path.h"
+#include "core/tone_engine.h"
+#include "core/threads.h"
+#include <pthread.h>
 #include <strings.h>    // For strncasecmp
 #include <ctype.h>
 #include "core/state.h"
@@ -28,6 +31,13 @@ static const uint32_t VOICE_PROMPTS_DATA_VERSION = 0x1000;  // v1000 OpenRTX
 #define CODEC2_HEADER_SIZE     7
 #define VP_SEQUENCE_BUF_SIZE   128
 #define BEEP_SEQ_BUF_SIZE      256
+#define BEEP_TIME_UNIT         25     // Beep duration unit, in ms
+#define FEED_RETRY_TIME        20     // Feeder retry period, in ms
+
+#ifdef VP_USE_FILESYSTEM
+#define VP_CACHE_SIZE          32768  // Size of the prompt cache, in bytes
+#define VP_CACHE_ENTRIES       64     // Maximum number of cached prompts
+#endif
 
 typedef struct
 {
@@ -54,12 +64,16 @@ typedef struct
 }
 vpSequence_t;
 
+#ifdef VP_USE_FILESYSTEM
 typedef struct
 {
-    uint16_t freq;
-    uint16_t duration;
+    uint16_t prompt;                        // Prompt index
+    uint16_t offset;                        // Data offset inside the cache
+    uint16_t length;                        // Data length, in bytes
+    uint32_t lastUse;                       // Time of last use, for LRU
 }
-beepData_t;
+vpCacheEntry_t;
+#endif
 
 
 static const userDictEntry_t userDictionary[] =
@@ -90,16 +104,40 @@ static uint32_t tableOfContents[VOICE_PROMPTS_TOC_SIZE];
 static bool     vpDataLoaded      = false;
 static bool     voicePromptActive = false;
 
+typedef struct
+{
+    uint16_t freq;
+    uint16_t duration;
+}
+beepData_t;
+
 static beepData_t beepSeriesBuffer[BEEP_SEQ_BUF_SIZE];
-static uint16_t   currentBeepDuration = 0;
-static uint8_t    beepSeriesIndex     = 0;
-static bool       delayBeepUntilTick  = false;
+static uint16_t   beepSeriesIndex = 0;     // Next beep to be queued
+static bool       beepActive      = false;
 
 static pathId     vpAudioPath;
 static long long  vpStartTime;
 
+static pthread_t       feederThread;
+static pthread_attr_t  feederAttr;
+static bool            feederValid   = false;
+static bool            feederRunning = false;
+static bool            feederStop    = false;
+
 #ifdef VP_USE_FILESYSTEM
 static FILE *vpFile = NULL;
+
+/*
+ * Cache of the codec2 data of the most recently queued prompts. The data of
+ * each prompt is stored contiguously and the entries are kept packed at the
+ * beginning of the cache, in order of increasing offset.
+ */
+static pthread_mutex_t vpCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+static uint8_t         vpCache[VP_CACHE_SIZE];
+static vpCacheEntry_t  vpCacheEntries[VP_CACHE_ENTRIES];
+static uint8_t         vpCacheCount = 0;
+static uint16_t        vpCacheUsed  = 0;
+static uint32_t        vpCacheClock = 0;
 #else
 extern unsigned char _vpdata_start;
 extern unsigned char _vpdata_end;
@@ -145,10 +183,12 @@ static void loadVpToC()
  * \internal
  * Load Codec2 data for a voice prompt.
  *
+ * @param data: destination buffer.
  * @param offset: offset relative to the start of the voice prompt data.
  * @param length: data length in bytes.
  */
-static void fetchCodec2Data(uint8_t *data, const size_t offset)
+static void fetchCodec2Data(uint8_t *data, const size_t offset,
+                            const size_t length)
 {
     if (vpDataLoaded == false)
         return;
@@ -162,20 +202,155 @@ static void fetchCodec2Data(uint8_t *data, const size_t offset)
                  + CODEC2_HEADER_SIZE;
 
     fseek(vpFile, start + offset, SEEK_SET);
-    fread(data, 8, 1, vpFile);
+    fread(data, length, 1, vpFile);
     #else
     uint8_t *dataPtr = vpData
                      + sizeof(vpHeader_t)
                      + sizeof(tableOfContents)
                      + CODEC2_HEADER_SIZE;
 
-    if((dataPtr + 8) >= &_vpdata_end)
+    if((dataPtr + offset + length) > &_vpdata_end)
+    {
+        memset(data, 0x00, length);
+        return;
+    }
+
+    memcpy(data, dataPtr + offset, length);
+    #endif
+}
+
+/**
+ * \internal
+ * Get the length of the Codec2 data of a voice prompt, rounded down to a
+ * whole number of frames.
+ *
+ * @param prompt: prompt index.
+ * @return data length in bytes.
+ */
+static inline uint32_t promptLength(const uint16_t prompt)
+{
+    return ((tableOfContents[prompt + 1] - tableOfContents[prompt]) / 8) * 8;
+}
+
+#ifdef VP_USE_FILESYSTEM
+/**
+ * \internal
+ * Search a prompt in the cache, updating its time of last use. To be called
+ * with the cache mutex locked.
+ *
+ * @param prompt: prompt index.
+ * @return pointer to the cache entry or NULL if the prompt is not cached.
+ */
+static vpCacheEntry_t *cacheLookup(const uint16_t prompt)
+{
+    for(uint8_t i = 0; i < vpCacheCount; i++)
+    {
+        if(vpCacheEntries[i].prompt == prompt)
+        {
+            vpCacheEntries[i].lastUse = ++vpCacheClock;
+            return &vpCacheEntries[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \internal
+ * Remove the least recently used prompt from the cache, compacting the data
+ * of the following ones. To be called with the cache mutex locked.
+ */
+static void cacheEvict()
+{
+    uint8_t lru = 0;
+
+    for(uint8_t i = 1; i < vpCacheCount; i++)
+    {
+        if(vpCacheEntries[i].lastUse < vpCacheEntries[lru].lastUse)
+            lru = i;
+    }
+
+    uint16_t offset = vpCacheEntries[lru].offset;
+    uint16_t length = vpCacheEntries[lru].length;
+
+    memmove(&vpCache[offset], &vpCache[offset + length],
+            vpCacheUsed - (offset + length));
+    vpCacheUsed -= length;
+
+    for(uint8_t i = lru + 1; i < vpCacheCount; i++)
     {
-        memset(data, 0x00, 8);
+        vpCacheEntries[i - 1]         = vpCacheEntries[i];
+        vpCacheEntries[i - 1].offset -= length;
+    }
+
+    vpCacheCount -= 1;
+}
+
+/**
+ * \internal
+ * Load the whole Codec2 data of a prompt into the cache, if not already
+ * present, evicting the least recently used prompts to make room for it.
+ * Prompts longer than the cache are not loaded.
+ *
+ * @param prompt: prompt index.
+ */
+static void cacheLoad(const uint16_t prompt)
+{
+    if((vpDataLoaded == false) || (prompt >= (VOICE_PROMPTS_TOC_SIZE - 1)))
         return;
+
+    uint32_t length = promptLength(prompt);
+    if((length == 0) || (length > VP_CACHE_SIZE))
+        return;
+
+    pthread_mutex_lock(&vpCacheMutex);
+
+    if(cacheLookup(prompt) == NULL)
+    {
+        while((vpCacheCount >= VP_CACHE_ENTRIES) ||
+              ((vpCacheUsed + length) > VP_CACHE_SIZE))
+        {
+            cacheEvict();
+        }
+
+        vpCacheEntry_t *entry = &vpCacheEntries[vpCacheCount];
+        entry->prompt  = prompt;
+        entry->offset  = vpCacheUsed;
+        entry->length  = length;
+        entry->lastUse = ++vpCacheClock;
+
+        fetchCodec2Data(&vpCache[vpCacheUsed], tableOfContents[prompt], length);
+        vpCacheUsed  += length;
+        vpCacheCount += 1;
     }
 
-    memcpy(data, dataPtr + offset, 8);
+    pthread_mutex_unlock(&vpCacheMutex);
+}
+#endif
+
+/**
+ * \internal
+ * Load a Codec2 frame of a voice prompt, from the prompt cache if available.
+ *
+ * @param frame: destination buffer, 8 bytes long.
+ * @param prompt: prompt index.
+ * @param index: offset of the frame relative to the start of the prompt data.
+ */
+static void loadCodec2Frame(uint8_t *frame, const uint16_t prompt,
+                            const uint32_t index)
+{
+    #ifdef VP_USE_FILESYSTEM
+    pthread_mutex_lock(&vpCacheMutex);
+
+    vpCacheEntry_t *entry = cacheLookup(prompt);
+    if(entry != NULL)
+        memcpy(frame, &vpCache[entry->offset + index], 8);
+    else
+        fetchCodec2Data(frame, tableOfContents[prompt] + index, 8);
+
+    pthread_mutex_unlock(&vpCacheMutex);
+    #else
+    fetchCodec2Data(frame, tableOfContents[prompt] + index, 8);
     #endif
 }
 
@@ -274,7 +449,7 @@ static inline void enableSpkOutput()
 static inline void disableSpkOutput()
 {
     // Avoid chomping away a still in-progress beep or voice prompt.
-    if((currentBeepDuration != 0) || (voicePromptActive == true))
+    if((beepActive == true) || (voicePromptActive == true))
         return;
 
     audioPath_release(vpAudioPath);
@@ -282,58 +457,179 @@ static inline void disableSpkOutput()
 
 /**
  * \internal
- * Stop an ongoing beep, if present, and clear all the beep management
- * variables.
+ * Stop an ongoing beep, if present, and release the audio path.
  */
 static void beep_flush()
 {
-    if (currentBeepDuration > 0)
-        platform_beepStop();
+    toneEngine_stop();
 
-    memset(beepSeriesBuffer, 0, sizeof(beepSeriesBuffer));
-    currentBeepDuration = 0;
-    beepSeriesIndex     = 0;
+    beepSeriesBuffer[0].freq     = 0;
+    beepSeriesBuffer[0].duration = 0;
+    beepSeriesIndex              = 0;
+    beepActive                   = false;
     disableSpkOutput();
 }
 
 /**
  * \internal
- * Function managing beep update.
+ * Queue the beeps of the current series to the tone engine, until its queue
+ * is full. The remaining ones are queued by vp_tick() as the queue drains.
+ *
+ * @return true if at least one beep has been queued.
  */
-static bool beep_tick()
+static bool beep_queue()
 {
-    if (currentBeepDuration > 0)
+    bool queued = false;
+
+    while(beepSeriesIndex < BEEP_SEQ_BUF_SIZE)
     {
-        if (delayBeepUntilTick)
+        beepData_t *beep = &beepSeriesBuffer[beepSeriesIndex];
+
+        if((beep->freq == 0) || (beep->duration == 0))
+            break;
+
+        if(toneEngine_queue(beep->freq, beep->duration * BEEP_TIME_UNIT) == false)
+            break;
+
+        beepSeriesIndex++;
+        queued = true;
+    }
+
+    return queued;
+}
+
+/**
+ * \internal
+ * Start the reproduction of the queued beeps. While a voice prompt is playing
+ * the speaker is fed by the codec, and the beeps are mixed into its output.
+ */
+static void beep_start()
+{
+    beepActive = toneEngine_start(vpAudioPath, voicePromptActive);
+
+    // Drop the queued beeps if the audio path is not available
+    if (beepActive == false)
+        beep_flush();
+}
+
+/**
+ * \internal
+ * Feeder thread, pushing the codec2 data of the queued prompts to the codec.
+ * Pushing blocks until there is space in the codec queue, thus the feeding
+ * of the prompts keeps up with their reproduction, independently of the UI
+ * thread. If the codec is stopped while feeding, the queued prompts are dropped.
+ */
+static void *feederFunc(void *arg)
+{
+    (void) arg;
+
+    while((feederStop == false) &&
+          (vpCurrentSequence.pos < vpCurrentSequence.length))
+    {
+        uint16_t prompt = vpCurrentSequence.buffer[vpCurrentSequence.pos];
+
+        // get the codec2 data for the current prompt if needed.
+        if (vpCurrentSequence.c2DataLength == 0)
         {
-            platform_beepStart(beepSeriesBuffer[beepSeriesIndex].freq);
-            delayBeepUntilTick = false;
+            vpCurrentSequence.c2DataIndex  = 0;
+            vpCurrentSequence.c2DataStart  = tableOfContents[prompt];
+            vpCurrentSequence.c2DataLength = promptLength(prompt);
         }
 
-        currentBeepDuration--;
-        if (currentBeepDuration == 0)
+        while ((feederStop == false) &&
+               (vpCurrentSequence.c2DataIndex < vpCurrentSequence.c2DataLength))
         {
-            platform_beepStop();
+            // push the codec2 data in lots of 8 byte frames.
+            uint8_t c2Frame[8] = {0};
+
+            loadCodec2Frame(c2Frame, prompt, vpCurrentSequence.c2DataIndex);
 
-            // see if there are any more in the series to play.
-            if ((beepSeriesBuffer[beepSeriesIndex+1].freq     != 0) &&
-                (beepSeriesBuffer[beepSeriesIndex+1].duration != 0))
+            // Codec stopped by someone else: the remaining prompts can not be
+            // played anymore, drop them and terminate.
+            if(codec_running() == false)
             {
-                beepSeriesIndex++;
-                currentBeepDuration = beepSeriesBuffer[beepSeriesIndex].duration;
-                platform_beepStart(beepSeriesBuffer[beepSeriesIndex].freq);
+                if(feederStop == false)
+                    vpCurrentSequence.length = 0;
+
+                feederStop = true;
+                break;
             }
-            else
+
+            // Do not push codec2 data if audio path is closed or suspended,
+            // retry later.
+            if((audioPath_getStatus(vpAudioPath) != PATH_OPEN) ||
+               (codec_pushFrame(c2Frame, true) < 0))
             {
-                // Clear all variables for beep management
-                beep_flush();
+                sleepFor(0, FEED_RETRY_TIME);
+                continue;
             }
+
+            vpCurrentSequence.c2DataIndex += 8;
         }
 
-        return true;
+        if (feederStop)
+            break;
+
+        vpCurrentSequence.pos++;            // ready for next prompt in sequence.
+        vpCurrentSequence.c2DataLength = 0; // flag that we need to get more data.
+        vpCurrentSequence.c2DataIndex  = 0;
     }
 
-    return false;
+    feederRunning = false;
+    return NULL;
+}
+
+/**
+ * \internal
+ * Start the feeder thread.
+ */
+static void startFeeder()
+{
+    feederStop    = false;
+    feederRunning = true;
+
+    pthread_attr_init(&feederAttr);
+
+    #if defined(_MIOSIX)
+    pthread_attr_setstacksize(&feederAttr, VP_THREAD_STKSIZE);
+
+    struct sched_param param;
+    param.sched_priority = THREAD_PRIO_HIGH;
+    pthread_attr_setschedparam(&feederAttr, &param);
+    #elif defined(__ZEPHYR__)
+    void *vp_thread_stack = malloc(VP_THREAD_STKSIZE * sizeof(uint8_t));
+    pthread_attr_setstack(&feederAttr, vp_thread_stack, VP_THREAD_STKSIZE);
+    #endif
+
+    int ret = pthread_create(&feederThread, &feederAttr, feederFunc, NULL);
+    if(ret == 0)
+        feederValid = true;
+    else
+        feederRunning = false;
+}
+
+/**
+ * \internal
+ * Stop the feeder thread and wait for its termination. A feeder blocked in
+ * pushing data to the codec is woken up by stopping the codec.
+ */
+static void stopFeeder()
+{
+    if(feederValid == false)
+        return;
+
+    feederStop = true;
+    codec_stop(vpAudioPath);
+    pthread_join(feederThread, NULL);
+    feederValid = false;
+
+    #ifdef __ZEPHYR__
+    void  *addr;
+    size_t size;
+
+    pthread_attr_getstack(&feederAttr, &addr, &size);
+    free(addr);
+    #endif
 }
 
 
@@ -386,12 +682,16 @@ void vp_terminate()
 
     #ifdef VP_USE_FILESYSTEM
     fclose(vpFile);
+    vpFile       = NULL;
+    vpCacheCount = 0;
+    vpCacheUsed  = 0;
     #endif
 }
 
 void vp_stop()
 {
     voicePromptActive = false;
+    stopFeeder();
     codec_stop(vpAudioPath);
     disableSpkOutput();
 
@@ -423,6 +723,11 @@ void vp_queuePrompt(const uint16_t prompt)
     {
         vpCurrentSequence.buffer[vpCurrentSequence.length] = prompt;
         vpCurrentSequence.length++;
+
+        #ifdef VP_USE_FILESYSTEM
+        // Load the prompt data now, to be read from RAM while playing
+        cacheLoad(prompt);
+        #endif
     }
 }
 
@@ -549,14 +854,24 @@ void vp_play()
 
 void vp_tick()
 {
-    if (platform_getPttStatus() && (voicePromptActive || (currentBeepDuration > 0)))
+    if (platform_getPttStatus() && (voicePromptActive || beepActive))
     {
         vp_stop();
         return;
     }
 
-    if (beep_tick())
-        return;
+    // Beeps are timed by the tone engine: keep it fed with the rest of the
+    // series and release the audio path when the reproduction is over.
+    if (beepActive)
+    {
+        if (beep_queue())
+            beep_start();
+
+        if (toneEngine_running())
+            return;
+
+        beep_flush();
+    }
 
     // Temporary fix for the following bug: on MD-UV3x0 the configuration of
     // the AT1846S chip may take more than 20ms, making the codec2 thread miss
@@ -571,58 +886,29 @@ void vp_tick()
         voicePromptActive = true;
         enableSpkOutput();
         codec_startDecode(vpAudioPath);
+        startFeeder();
     }
 
     if (voicePromptActive == false)
         return;
 
-    while(vpCurrentSequence.pos < vpCurrentSequence.length)
-    {
-        // get the codec2 data for the current prompt if needed.
-        if (vpCurrentSequence.c2DataLength == 0)
-        {
-            // obtain the data for the prompt.
-            int promptNumber = vpCurrentSequence.buffer[vpCurrentSequence.pos];
-
-            vpCurrentSequence.c2DataIndex  = 0;
-            vpCurrentSequence.c2DataStart  = tableOfContents[promptNumber];
-            vpCurrentSequence.c2DataLength = ((tableOfContents[promptNumber + 1]
-                                           - tableOfContents[promptNumber])/8 * 8);
-        }
-
-        while (vpCurrentSequence.c2DataIndex < vpCurrentSequence.c2DataLength)
-        {
-            // push the codec2 data in lots of 8 byte frames.
-            uint8_t c2Frame[8] = {0};
-
-            fetchCodec2Data(c2Frame, vpCurrentSequence.c2DataStart +
-                                     vpCurrentSequence.c2DataIndex);
-
-            // Do not push codec2 data if audio path is closed or suspended
-            if(audioPath_getStatus(vpAudioPath) != PATH_OPEN)
-                return;
-
-            if(codec_pushFrame(c2Frame, false) < 0)
-                return;
+    // Codec2 data is pushed by the feeder thread, wait for it to finish
+    if (feederRunning)
+        return;
 
-            vpCurrentSequence.c2DataIndex += 8;
-        }
+    stopFeeder();
 
-        vpCurrentSequence.pos++;            // ready for next prompt in sequence.
-        vpCurrentSequence.c2DataLength = 0; // flag that we need to get more data.
-        vpCurrentSequence.c2DataIndex  = 0;
-    }
+    voicePromptActive              = false;
+    vpCurrentSequence.pos          = 0;
+    vpCurrentSequence.c2DataIndex  = 0;
+    vpCurrentSequence.c2DataLength = 0;
+    codec_stop(vpAudioPath);
+    disableSpkOutput();
+}
 
-    // see if we've finished.
-    if(vpCurrentSequence.pos == vpCurrentSequence.length)
-    {
-        voicePromptActive              = false;
-        vpCurrentSequence.pos          = 0;
-        vpCurrentSequence.c2DataIndex  = 0;
-        vpCurrentSequence.c2DataLength = 0;
-        codec_stop(vpAudioPath);
-        disableSpkOutput();
-    }
+bool vp_tickPending()
+{
+    return beepActive || voicePromptActive || (vpStartTime > 0);
 }
 
 bool vp_isPlaying()
@@ -641,21 +927,23 @@ void vp_beep(uint16_t freq, uint16_t duration)
         return;
 
     // Do not play a new one if one is playing.
-    if (currentBeepDuration != 0)
+    if (beepActive)
         return;
 
     // avoid extra long beeps!
     if (duration > 20)
         duration = 20;
 
+    enableSpkOutput();
+
     beepSeriesBuffer[0].freq     = freq;
     beepSeriesBuffer[0].duration = duration;
     beepSeriesBuffer[1].freq     = 0;
     beepSeriesBuffer[1].duration = 0;
-    currentBeepDuration = duration;
-    beepSeriesIndex     = 0;
-    platform_beepStart(freq);
-    enableSpkOutput();
+    beepSeriesIndex              = 0;
+
+    beep_queue();
+    beep_start();
 }
 
 void vp_beepSeries(const uint16_t* beepSeries)
@@ -663,7 +951,7 @@ void vp_beepSeries(const uint16_t* beepSeries)
     if (state.settings.vpLevel < vpBeep)
         return;
 
-    if (currentBeepDuration != 0)
+    if (beepActive)
         return;
 
     enableSpkOutput();
@@ -671,12 +959,26 @@ void vp_beepSeries(const uint16_t* beepSeries)
     if (beepSeries == NULL)
         return;
 
-    memcpy(beepSeriesBuffer, beepSeries, BEEP_SEQ_BUF_SIZE*sizeof(beepData_t));
+    // Copy the series, the array is terminated by a zero entry
+    size_t len = 0;
+    while (len < (BEEP_SEQ_BUF_SIZE - 1))
+    {
+        uint16_t freq     = beepSeries[2 * len];
+        uint16_t duration = beepSeries[(2 * len) + 1];
+
+        if ((freq == 0) || (duration == 0))
+            break;
+
+        beepSeriesBuffer[len].freq     = freq;
+        beepSeriesBuffer[len].duration = duration;
+        len++;
+    }
+
     // Always ensure that the array is terminated!
-    beepSeriesBuffer[BEEP_SEQ_BUF_SIZE-1].freq     = 0;
-    beepSeriesBuffer[BEEP_SEQ_BUF_SIZE-1].duration = 0;
+    beepSeriesBuffer[len].freq     = 0;
+    beepSeriesBuffer[len].duration = 0;
+    beepSeriesIndex                = 0;
 
-    currentBeepDuration = beepSeriesBuffer[0].duration;
-    beepSeriesIndex     = 0;
-    delayBeepUntilTick  = true;
+    beep_queue();
+    beep_start();
 }
@@ -0,0 +1,297 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "interfaces/delays.h"
+#include "core/audio_stream.h"
+#include "core/audio_path.h"
+#include "core/threads.h"
+#include "core/vox.h"
+#include "core/dsp.h"
+#include <pthread.h>
+#include <string.h>
+#include <errno.h>
+
+#define BLOCK_TIME (VOX_BLOCK_SIZE * 1000 / VOX_SAMPLE_RATE)   // Block duration, in ms
+
+static pthread_t       voxThread;
+static volatile bool   running   = false;   // Engine thread running
+static volatile bool   reqStop   = false;   // Engine thread stop request
+static volatile bool   txRequest = false;   // Transmission requested
+static uint8_t         voxLevel;            // Sensitivity level
+
+static struct voxDetector detector;
+static stream_sample_t    micBuf[2 * VOX_BLOCK_SIZE];
+static stream_sample_t    txBuf[2 * VOX_BLOCK_SIZE];
+
+
+/**
+ * \internal
+ * Update the detector state at the end of a block.
+ */
+static void endBlock(struct voxDetector *det)
+{
+    // AC power of the block: the DC component is removed by subtracting the
+    // square of the mean from the mean of the squares.
+    int64_t sum   = det->sum;
+    int64_t acPow = (int64_t) det->sumSq - ((sum * sum) / det->blockLen);
+    det->power    = (uint32_t) (acPow / det->blockLen);
+
+    det->sum      = 0;
+    det->sumSq    = 0;
+    det->blockLen = 0;
+
+    if(det->power >= det->openThr)
+    {
+        if(det->attackCount < VOX_ATTACK_BLOCKS)
+            det->attackCount += 1;
+    }
+    else
+    {
+        det->attackCount = 0;
+    }
+
+    if(det->active == false)
+    {
+        if(det->attackCount >= VOX_ATTACK_BLOCKS)
+        {
+            det->active    = true;
+            det->hangCount = det->hangBlocks;
+        }
+
+        return;
+    }
+
+    // Between the two thresholds the speech is kept active, the hang time
+    // starts only when the power drops below the closing one.
+    if(det->power >= det->closeThr)
+        det->hangCount = det->hangBlocks;
+    else if(det->hangCount > 0)
+        det->hangCount -= 1;
+
+    if(det->hangCount == 0)
+        det->active = false;
+}
+
+/**
+ * \internal
+ * Terminate the relay of the microphone audio to the transceiver.
+ */
+static void stopRelay(pathId *path, streamId *stream)
+{
+    if(*stream >= 0)
+        audioStream_terminate(*stream);
+
+    audioPath_release(*path);
+    *stream   = -1;
+    *path     = -1;
+    txRequest = false;
+}
+
+/**
+ * \internal
+ * VOX engine thread: reads the microphone, runs the detector and, while speech
+ * is detected, relays the delayed audio to the transceiver.
+ */
+static void *voxFunc(void *arg)
+{
+    (void) arg;
+
+    pathId         micPath   = -1;
+    streamId       micStream = -1;
+    pathId         txPath    = -1;
+    streamId       txStream  = -1;
+    struct dcBlock dcBlock;
+
+    vox_init(&detector, voxLevel, VOX_HANG_TIME);
+    dsp_resetState(dcBlock);
+
+    while(reqStop == false)
+    {
+        // Open the microphone stream. The path gets suspended when the PTT is
+        // pressed and resumed when released.
+        if(micStream < 0)
+        {
+            if(audioPath_getStatus(micPath) == PATH_CLOSED)
+                micPath = audioPath_request(SOURCE_MIC, SINK_MCU, PRIO_RX);
+
+            if(audioPath_getStatus(micPath) == PATH_OPEN)
+            {
+                micStream = audioStream_start(micPath, micBuf,
+                                              2 * VOX_BLOCK_SIZE,
+                                              VOX_SAMPLE_RATE,
+                                              STREAM_INPUT | BUF_CIRC_DOUBLE);
+            }
+
+            // Release the path if the stream cannot be started, to not keep
+            // other audio paths incompatible with it from being opened.
+            if(micStream < 0)
+            {
+                if(audioPath_getStatus(micPath) == PATH_OPEN)
+                {
+                    audioPath_release(micPath);
+                    micPath = -1;
+                }
+
+                sleepFor(0u, BLOCK_TIME);
+                continue;
+            }
+        }
+
+        dataBlock_t audio = inputStream_getData(micStream);
+        if(audio.data == NULL)
+        {
+            // Stream terminated, start again from a clean state
+            stopRelay(&txPath, &txStream);
+            vox_init(&detector, voxLevel, VOX_HANG_TIME);
+            micStream = -1;
+            continue;
+        }
+
+        #ifndef PLATFORM_LINUX
+        dsp_removeDcOffset(&dcBlock, audio.data, audio.len);
+        #endif
+
+        bool speech = vox_process(&detector, audio.data, audio.len);
+
+        if(speech && (txStream < 0))
+        {
+            txPath = audioPath_request(SOURCE_MCU, SINK_RTX, PRIO_TX);
+            if(audioPath_getStatus(txPath) == PATH_OPEN)
+            {
+                memset(txBuf, 0x00, sizeof(txBuf));
+                txStream = audioStream_start(txPath, txBuf, 2 * VOX_BLOCK_SIZE,
+                                             VOX_SAMPLE_RATE,
+                                             STREAM_OUTPUT | BUF_CIRC_DOUBLE);
+            }
+
+            // Without the audio relay there is nothing to transmit
+            if(txStream < 0)
+                stopRelay(&txPath, &txStream);
+        }
+
+        if(txStream < 0)
+            continue;
+
+        if((speech == false) || (audioPath_getStatus(txPath) != PATH_OPEN))
+        {
+            stopRelay(&txPath, &txStream);
+            continue;
+        }
+
+        stream_sample_t *buf = outputStream_getIdleBuffer(txStream);
+        if(buf == NULL)
+        {
+            stopRelay(&txPath, &txStream);
+            continue;
+        }
+
+        size_t len = (audio.len < VOX_BLOCK_SIZE) ? audio.len : VOX_BLOCK_SIZE;
+        memcpy(buf, audio.data, len * sizeof(stream_sample_t));
+        outputStream_sync(txStream, true);
+
+        txRequest = true;
+    }
+
+    stopRelay(&txPath, &txStream);
+
+    if(micStream >= 0)
+        audioStream_terminate(micStream);
+
+    audioPath_release(micPath);
+
+    return NULL;
+}
+
+
+void vox_init(struct voxDetector *det, const uint8_t level,
+              const uint16_t hangTime)
+{
+    uint8_t lvl = level;
+    if(lvl < 1)
+        lvl = 1;
+
+    if(lvl > VOX_MAX_LEVEL)
+        lvl = VOX_MAX_LEVEL;
+
+    memset(det, 0x00, sizeof(struct voxDetector));
+
+    // Power relative to a full scale square wave, 2^30: 2^25 is about -15dB
+    // and each level halves the threshold. The closing threshold is 6dB lower.
+    det->openThr    = 1UL << (26 - lvl);
+    det->closeThr   = det->openThr >> 2;
+    det->hangBlocks = (hangTime + BLOCK_TIME - 1) / BLOCK_TIME;
+    if(det->hangBlocks == 0)
+        det->hangBlocks = 1;
+}
+
+bool vox_process(struct voxDetector *det, stream_sample_t *samples,
+                 const size_t len)
+{
+    for(size_t i = 0; i < len; i++)
+    {
+        int32_t sample = samples[i];
+
+        det->sum   += sample;
+        det->sumSq += (uint32_t) (sample * sample);
+
+        samples[i] = det->delay[det->delayPos];
+        det->delay[det->delayPos] = sample;
+
+        det->delayPos += 1;
+        if(det->delayPos >= VOX_PREROLL_SAMPLES)
+            det->delayPos = 0;
+
+        det->blockLen += 1;
+        if(det->blockLen >= VOX_BLOCK_SIZE)
+            endBlock(det);
+    }
+
+    return det->active;
+}
+
+int vox_start(const uint8_t level)
+{
+    if((level == 0) || (level > VOX_MAX_LEVEL))
+        return -EINVAL;
+
+    if(running)
+        return -EBUSY;
+
+    voxLevel  = level;
+    reqStop   = false;
+    txRequest = false;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+
+    #ifdef _MIOSIX
+    pthread_attr_setstacksize(&attr, VOX_THREAD_STKSIZE);
+    #endif
+
+    if(pthread_create(&voxThread, &attr, voxFunc, NULL) != 0)
+        return -ENOMEM;
+
+    running = true;
+
+    return 0;
+}
+
+void vox_stop()
+{
+    if(running == false)
+        return;
+
+    reqStop = true;
+    pthread_join(voxThread, NULL);
+
+    running   = false;
+    txRequest = false;
+}
+
+bool vox_active()
+{
+    return txRequest;
+}
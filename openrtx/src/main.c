@@ -13,6 +13,7 @@
 
 #ifdef PLATFORM_LINUX
 #include "emulator/sdl_engine.h"
+#include <pthread.h>
 #endif
 
 int main(void)
@@ -171,6 +171,12 @@ void Modulator::sendBaseband()
 #else
 void Modulator::sendBaseband()
 {
+    if(basebandSink)
+    {
+        basebandSink(idleBuffer, FRAME_SAMPLES);
+        return;
+    }
+
     FILE *outfile = fopen("/tmp/m17_output.raw", "ab");
 
     for(size_t i = 0; i < FRAME_SAMPLES; i++)
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cstring>
+#include <algorithm>
+#include "core/crc.h"
+#include "protocols/M17/Packet.hpp"
+
+using namespace M17;
+
+Packet::Packet()
+{
+    clear();
+}
+
+Packet::~Packet()
+{
+}
+
+void Packet::clear()
+{
+    size      = 0;
+    nextFrame = 0;
+    complete  = false;
+}
+
+bool Packet::set(const PacketType type, const void *data, const size_t len)
+{
+    clear();
+
+    if(len > MAX_DATA)
+        return false;
+
+    buffer[0] = static_cast< uint8_t >(type);
+    memcpy(&buffer[1], data, len);
+
+    uint16_t crc = crc_m17(buffer.data(), len + 1);
+    buffer[len + 1] = crc >> 8;
+    buffer[len + 2] = crc & 0xFF;
+
+    size     = len + 3;
+    complete = true;
+
+    return true;
+}
+
+size_t Packet::numFrames() const
+{
+    return (size + PacketFrame::DATA_SIZE - 1) / PacketFrame::DATA_SIZE;
+}
+
+void Packet::getFrame(const size_t index, PacketFrame& frame) const
+{
+    size_t offset = index * PacketFrame::DATA_SIZE;
+    size_t len    = std::min(size - offset, PacketFrame::DATA_SIZE);
+
+    frame.clear();
+    memcpy(frame.data(), &buffer[offset], len);
+
+    if(index == (numFrames() - 1))
+    {
+        frame.setEof(true);
+        frame.setCounter(len);
+    }
+    else
+    {
+        frame.setCounter(index);
+    }
+}
+
+Packet::Status Packet::addFrame(const PacketFrame& frame)
+{
+    uint8_t counter = frame.getCounter();
+
+    // A new packet begins after a complete one or with a first frame
+    if(complete || ((frame.isEof() == false) && (counter == 0)))
+        clear();
+
+    if(frame.isEof() == false)
+    {
+        // Frames are sent in order: a gap means that a frame got lost
+        if((counter != nextFrame) || (nextFrame >= (MAX_FRAMES - 1)))
+        {
+            clear();
+            return Status::ERROR;
+        }
+
+        memcpy(&buffer[size], frame.data(), PacketFrame::DATA_SIZE);
+        size      += PacketFrame::DATA_SIZE;
+        nextFrame += 1;
+
+        return Status::INCOMPLETE;
+    }
+
+    // Last frame, the counter is the number of valid bytes
+    if((counter == 0) || (counter > PacketFrame::DATA_SIZE))
+    {
+        clear();
+        return Status::ERROR;
+    }
+
+    memcpy(&buffer[size], frame.data(), counter);
+    size += counter;
+
+    if(size < 3)
+    {
+        clear();
+        return Status::ERROR;
+    }
+
+    uint16_t crc = (buffer[size - 2] << 8) | buffer[size - 1];
+    if(crc_m17(buffer.data(), size - 2) != crc)
+    {
+        clear();
+        return Status::ERROR;
+    }
+
+    complete = true;
+    return Status::COMPLETE;
+}
+
+constexpr size_t Packet::MAX_FRAMES;
+constexpr size_t Packet::MAX_SIZE;
+constexpr size_t Packet::MAX_DATA;
@@ -8,6 +8,9 @@
 #include "interfaces/delays.h"
 #include "interfaces/radio.h"
 #include "rtx/OpMode_FM.hpp"
+#include "core/rx_audio.h"
+#include "core/vox.h"
+#include "rtx/sweep.h"
 #include "rtx/rtx.h"
 
 #if defined(PLATFORM_TTWRPLUS)
@@ -37,7 +40,8 @@ void _setVolume()
 }
 #endif
 
-OpMode_FM::OpMode_FM() : rfSqlOpen(false), sqlOpen(false), enterRx(true)
+OpMode_FM::OpMode_FM() : rfSqlOpen(false), sqlOpen(false), enterRx(true),
+    onPriority(false), sweeping(false), dwTimeout(0), voxLevel(0), rxStages(0)
 {
 }
 
@@ -48,33 +52,56 @@ OpMode_FM::~OpMode_FM()
 void OpMode_FM::enable()
 {
     // When starting, close squelch and prepare for entering in RX mode.
-    rfSqlOpen = false;
-    sqlOpen   = false;
-    enterRx   = true;
+    rfSqlOpen  = false;
+    sqlOpen    = false;
+    enterRx    = true;
+    onPriority = false;
+    sweeping   = false;
+    dwTimeout  = 0;
+    voxLevel   = 0;
+    rxStages   = 0;
 }
 
 void OpMode_FM::disable()
 {
     // Clean shutdown.
+    vox_stop();
+    voxLevel = 0;
     platform_ledOff(GREEN);
     platform_ledOff(RED);
-    audioPath_release(rxAudioPath);
+    closeRxAudio();
     audioPath_release(txAudioPath);
     radio_disableRtx();
-    rfSqlOpen = false;
-    sqlOpen   = false;
-    enterRx   = false;
+    rfSqlOpen  = false;
+    sqlOpen    = false;
+    enterRx    = false;
+    onPriority = false;
+    sweeping   = false;
 }
 
 void OpMode_FM::update(rtxStatus_t *const status, const bool newCfg)
 {
-    (void) newCfg;
+    // A new configuration retunes the radio on the main RX frequency
+    if(newCfg)
+        onPriority = false;
 
     #if defined(PLATFORM_TTWRPLUS)
     // Set output volume by changing the HR_C6000 DAC gain
     _setVolume();
     #endif
 
+    updateVox(status);
+
+    // Spectrum sweep, takes the place of the normal RX logic
+    if((status->scan == 1) && (status->opStatus == RX) &&
+       (platform_getPttStatus() == false))
+    {
+        sweep(status, newCfg);
+        return;
+    }
+
+    sweeping = false;
+
     // RX logic
     if(status->opStatus == RX)
     {
@@ -88,20 +115,28 @@ void OpMode_FM::update(rtxStatus_t *const status, const bool newCfg)
         if((rfSqlOpen == false) && (rssi > (squelch + 1))) rfSqlOpen = true;
         if((rfSqlOpen == true)  && (rssi < (squelch - 1))) rfSqlOpen = false;
 
-        // Local flags for current RF and tone squelch status
-        bool rfSql   = ((status->rxToneEn == 0) && (rfSqlOpen == true));
-        bool toneSql = ((status->rxToneEn == 1) && radio_checkRxDigitalSquelch());
+        dualWatch(status, squelch);
 
-        // Audio control
-        if((sqlOpen == false) && (rfSql || toneSql))
+        // Local flags for current RF and tone squelch status. Priority channel
+        // is monitored using only the RF squelch.
+        bool toneEn  = (status->rxToneEn == 1) && (onPriority == false);
+        bool rfSql   = ((toneEn == false) && (rfSqlOpen == true));
+        bool toneSql = (toneEn && radio_checkRxDigitalSquelch());
+
+        // Changes of the RX audio processing take effect immediately
+        if((sqlOpen == true) && (status->rxDsp != rxStages))
         {
-            rxAudioPath = audioPath_request(SOURCE_RTX, SINK_SPK, PRIO_RX);
-            if(rxAudioPath > 0) sqlOpen = true;
+            closeRxAudio();
+            sqlOpen = false;
         }
 
+        // Audio control
+        if((sqlOpen == false) && (rfSql || toneSql))
+            openRxAudio(status);
+
         if((sqlOpen == true) && (rfSql == false) && (toneSql == false))
         {
-            audioPath_release(rxAudioPath);
+            closeRxAudio();
             sqlOpen = false;
         }
     }
@@ -114,20 +149,36 @@ void OpMode_FM::update(rtxStatus_t *const status, const bool newCfg)
         enterRx = false;
     }
 
-    // TX logic
-    if(platform_getPttStatus() && (status->opStatus != TX) &&
-                                  (status->txDisable == 0))
+    // TX logic, the VOX requests the transmission in the same way as the PTT
+    bool ptt = platform_getPttStatus();
+    bool vox = vox_active();
+
+    if((ptt || vox) && (status->opStatus != TX) && (status->txDisable == 0))
     {
-        audioPath_release(rxAudioPath);
+        closeRxAudio();
         radio_disableRtx();
+        onPriority = false;
+
+        // When keyed by the VOX, the microphone audio is relayed to the
+        // transceiver by the VOX engine itself
+        if(ptt)
+            txAudioPath = audioPath_request(SOURCE_MIC, SINK_RTX, PRIO_TX);
+        else
+            txAudioPath = -1;
 
-        txAudioPath = audioPath_request(SOURCE_MIC, SINK_RTX, PRIO_TX);
         radio_enableTx();
 
         status->opStatus = TX;
     }
 
-    if(!platform_getPttStatus() && (status->opStatus == TX))
+    // PTT pressed during a VOX transmission: take over once the relay ends
+    if(ptt && (status->opStatus == TX) &&
+       (audioPath_getStatus(txAudioPath) == PATH_CLOSED))
+    {
+        txAudioPath = audioPath_request(SOURCE_MIC, SINK_RTX, PRIO_TX);
+    }
+
+    if((ptt == false) && (vox == false) && (status->opStatus == TX))
     {
         audioPath_release(txAudioPath);
         radio_disableRtx();
@@ -178,3 +229,123 @@ bool OpMode_FM::rxSquelchOpen()
 {
     return sqlOpen;
 }
+
+void OpMode_FM::sweep(const rtxStatus_t *const status, const bool newCfg)
+{
+    if(newCfg || (sweeping == false))
+        sweep_reset(status->sweepStart, status->sweepStep);
+
+    sweeping = true;
+
+    if(sqlOpen)
+    {
+        closeRxAudio();
+        sqlOpen = false;
+    }
+
+    rfSqlOpen  = false;
+    onPriority = false;
+    platform_ledOff(GREEN);
+    platform_ledOff(RED);
+
+    // Each sample takes at least the RSSI settling time, no need to sleep
+    for(uint8_t i = 0; i < SWEEP_BATCH; i++)
+    {
+        if(sweep_sampleNext())
+            break;
+    }
+}
+
+void OpMode_FM::openRxAudio(const rtxStatus_t *const status)
+{
+    rxStages = status->rxDsp;
+
+    // Audio processing on the MCU, when enabled and supported by the target,
+    // otherwise direct path from the transceiver to the speaker.
+    if((rxStages != 0) && (rxAudio_start(rxStages) == 0))
+    {
+        sqlOpen = true;
+        return;
+    }
+
+    rxAudioPath = audioPath_request(SOURCE_RTX, SINK_SPK, PRIO_RX);
+    if(rxAudioPath > 0) sqlOpen = true;
+}
+
+void OpMode_FM::closeRxAudio()
+{
+    rxAudio_stop();
+    audioPath_release(rxAudioPath);
+}
+
+void OpMode_FM::updateVox(const rtxStatus_t *const status)
+{
+    uint8_t level = status->voxLevel;
+    if(level > VOX_MAX_LEVEL)
+        level = VOX_MAX_LEVEL;
+
+    // No VOX when the transmission is not allowed or during a sweep
+    if((status->txDisable == 1) || (status->scan == 1))
+        level = 0;
+
+    if(level == voxLevel)
+        return;
+
+    vox_stop();
+    voxLevel = 0;
+
+    if((level > 0) && (vox_start(level) == 0))
+        voxLevel = level;
+}
+
+void OpMode_FM::dualWatch(const rtxStatus_t *const status, const rssi_t squelch)
+{
+    long long now = getTick();
+
+    if(status->dualWatch == 0)
+    {
+        if(onPriority)
+        {
+            radio_retuneRx(status->rxFrequency);
+            onPriority = false;
+        }
+
+        return;
+    }
+
+    // Tuned on the priority channel: go back to the main one only after the
+    // channel has been silent for the whole hang time.
+    if(onPriority)
+    {
+        if(rfSqlOpen)
+            dwTimeout = now + DW_HOLD;
+
+        if(now < dwTimeout)
+            return;
+
+        radio_retuneRx(status->rxFrequency);
+        onPriority = false;
+        rfSqlOpen  = false;
+        dwTimeout  = now + DW_PERIOD;
+        return;
+    }
+
+    if(now < dwTimeout)
+        return;
+
+    // Quick look at the priority channel, done also while receiving on the
+    // main one to let the priority channel take over.
+    radio_retuneRx(status->priorityFreq);
+    sleepFor(0, DW_SETTLE);
+
+    if(radio_getRssi() > (squelch + 1))
+    {
+        onPriority = true;
+        rfSqlOpen  = true;
+        dwTimeout  = now + DW_HOLD;
+        return;
+    }
+
+    radio_retuneRx(status->rxFrequency);
+    dwTimeout = now + DW_PERIOD;
+}
@@ -29,14 +29,17 @@ using namespace M17;
 
 OpMode_M17::OpMode_M17() : startRx(false), startTx(false), locked(false),
                            dataValid(false), extendedCall(false),
-                           invertTxPhase(false), invertRxPhase(false)
+                           invertTxPhase(false), invertRxPhase(false),
+                           txPacketPending(false), packetTx(false),
+                           txPacketFrame(0)
 {
-
+    pthread_mutex_init(&packetMutex, NULL);
 }
 
 OpMode_M17::~OpMode_M17()
 {
     disable();
+    pthread_mutex_destroy(&packetMutex);
 }
 
 void OpMode_M17::enable()
@@ -49,12 +52,19 @@ void OpMode_M17::enable()
     extendedCall = false;
     startRx      = true;
     startTx      = false;
+    packetTx     = false;
+    rxPacket.clear();
 }
 
 void OpMode_M17::disable()
 {
     startRx = false;
     startTx = false;
+
+    // Pending packets are dropped when leaving M17 mode
+    pthread_mutex_lock(&packetMutex);
+    txPacketPending = false;
+    pthread_mutex_unlock(&packetMutex);
     platform_ledOff(GREEN);
     platform_ledOff(RED);
     audioPath_release(rxAudioPath);
@@ -104,7 +114,10 @@ void OpMode_M17::update(rtxStatus_t *const status, const bool newCfg)
             break;
 
         case TX:
-            txState(status);
+            if(packetTx)
+                packetTxState(status);
+            else
+                txState(status);
             break;
 
         default:
@@ -154,6 +167,14 @@ void OpMode_M17::offState(rtxStatus_t *const status)
         return;
     }
 
+    if(packetPending() && (status->txDisable == 0))
+    {
+        startTx  = true;
+        packetTx = true;
+        status->opStatus = TX;
+        return;
+    }
+
     // Sleep for 30ms if there is nothing else to do in order to prevent the
     // rtx thread looping endlessly and locking up all the other tasks
     sleepFor(0, 30);
@@ -250,9 +271,23 @@ void OpMode_M17::rxState(rtxStatus_t *const status)
                 bool callMatch = (Callsign(status->source_address) == dst)
                                || dst.isSpecial();
 
+                // Reassemble data packets addressed to us
+                if((type == FrameType::PACKET) && canMatch && callMatch)
+                {
+                    auto ret = rxPacket.addFrame(decoder.getPacketFrame());
+                    if(ret == Packet::Status::COMPLETE)
+                    {
+                        pthread_mutex_lock(&packetMutex);
+                        lastRxPacket = rxPacket;
+                        pthread_mutex_unlock(&packetMutex);
+                    }
+                }
+
                 // Open audio path only if CAN and callsign match
+                bool isStream  = (streamType.fields.dataMode == DATAMODE_STREAM);
                 uint8_t pthSts = audioPath_getStatus(rxAudioPath);
-                if((pthSts == PATH_CLOSED) && (canMatch == true) && (callMatch == true))
+                if((pthSts == PATH_CLOSED) && (canMatch == true) &&
+                   (callMatch == true) && (isStream == true))
                 {
                     rxAudioPath = audioPath_request(SOURCE_MCU, SINK_SPK, PRIO_RX);
                     pthSts = audioPath_getStatus(rxAudioPath);
@@ -275,7 +310,8 @@ void OpMode_M17::rxState(rtxStatus_t *const status)
 
     locked = lock;
 
-    if(platform_getPttStatus())
+    // Leave RX on PTT press or to send a packet when the channel is free
+    if(platform_getPttStatus() || ((locked == false) && packetPending()))
     {
         demodulator.stopBasebandSampling();
         locked = false;
@@ -293,6 +329,7 @@ void OpMode_M17::rxState(rtxStatus_t *const status)
         status->M17_refl[0] = '\0';
 
         metaText.reset();
+        rxPacket.clear();
         codec_stop(rxAudioPath);
         audioPath_release(rxAudioPath);
     }
@@ -394,6 +431,122 @@ void OpMode_M17::txState(rtxStatus_t *const status)
     }
 }
 
+void OpMode_M17::packetTxState(rtxStatus_t *const status)
+{
+    frame_t m17Frame;
+
+    if(startTx)
+    {
+        startTx       = false;
+        txPacketFrame = 0;
+
+        LinkSetupFrame lsf;
+
+        lsf.clear();
+        lsf.setSource(status->source_address);
+
+        Callsign dst(status->destination_address);
+        if(!dst.isEmpty())
+            lsf.setDestination(dst);
+
+        streamType_t type;
+        type.fields.dataMode = DATAMODE_PACKET;     // Packet
+        type.fields.dataType = DATATYPE_DATA;       // Data
+        type.fields.CAN      = status->can;         // Channel access number
+
+        lsf.setType(type);
+
+        encoder.reset();
+        encoder.encodeLsf(lsf, m17Frame);
+
+        radio_enableTx();
+
+        modulator.invertPhase(invertTxPhase);
+        modulator.start();
+        modulator.sendPreamble();
+        modulator.sendFrame(m17Frame);
+        return;
+    }
+
+    // The packet content does not change until the pending flag is cleared
+    PacketFrame frame;
+    txPacket.getFrame(txPacketFrame, frame);
+    encoder.encodePacketFrame(frame, m17Frame);
+    modulator.sendFrame(m17Frame);
+
+    txPacketFrame += 1;
+    if(txPacketFrame < txPacket.numFrames())
+        return;
+
+    encoder.encodeEotFrame(m17Frame);
+    modulator.sendFrame(m17Frame);
+    modulator.stop();
+
+    pthread_mutex_lock(&packetMutex);
+    txPacketPending = false;
+    pthread_mutex_unlock(&packetMutex);
+
+    packetTx = false;
+    startRx  = true;
+    status->opStatus = OFF;
+}
+
+bool OpMode_M17::packetPending()
+{
+    pthread_mutex_lock(&packetMutex);
+    bool pending = txPacketPending;
+    pthread_mutex_unlock(&packetMutex);
+
+    return pending;
+}
+
+int OpMode_M17::sendPacket(const PacketType type, const void *data,
+                           const size_t len)
+{
+    int ret = 0;
+
+    pthread_mutex_lock(&packetMutex);
+
+    if(txPacketPending)
+        ret = -EBUSY;
+    else if(txPacket.set(type, data, len) == false)
+        ret = -EINVAL;
+    else
+        txPacketPending = true;
+
+    pthread_mutex_unlock(&packetMutex);
+
+    return ret;
+}
+
+ssize_t OpMode_M17::getPacket(PacketType *type, void *buf, const size_t maxLen)
+{
+    ssize_t ret = 0;
+
+    pthread_mutex_lock(&packetMutex);
+
+    if(lastRxPacket.isComplete())
+    {
+        size_t len = lastRxPacket.getDataLength();
+        if(len > maxLen)
+        {
+            ret = -ENOSPC;
+        }
+        else
+        {
+            *type = lastRxPacket.getType();
+            memcpy(buf, lastRxPacket.getData(), len);
+            ret = len;
+        }
+
+        lastRxPacket.clear();
+    }
+
+    pthread_mutex_unlock(&packetMutex);
+
+    return ret;
+}
+
 bool OpMode_M17::compareCallsigns(const std::string& localCs,
                                   const std::string& incomingCs)
 {
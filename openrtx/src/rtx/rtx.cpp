@@ -7,6 +7,8 @@
 #include "interfaces/radio.h"
 #include "hwconfig.h"
 #include <string.h>
+#include <errno.h>
+#include "core/rssi.h"
 #include "rtx/rtx.h"
 #include "rtx/OpMode_FM.hpp"
 #include "rtx/OpMode_M17.hpp"
@@ -16,15 +18,63 @@ static const rtxStatus_t *newCnf;       // Pointer for incoming config messages
 static rtxStatus_t        rtxStatus;    // RTX driver status
 static rssi_t             rssi;         // Current RSSI in dBm
 static bool               reinitFilter; // Flag for RSSI filter re-initialisation
+static rssiFilter_t       rssiFilter;   // RSSI low pass filter
+static bool               changed;      // Status shown to the user changed
+
+/*
+ * Part of the RTX status shown to the user.
+ */
+struct shownStatus
+{
+    uint8_t opStatus;
+    bool    sqlOpen;
+    bool    lsfOk;
+    char    M17_dst[10];
+    char    M17_src[10];
+    char    M17_link[10];
+    char    M17_refl[10];
+    char    M17_meta_text[53];
+};
+
+static struct shownStatus shown;
 
 static OpMode  *currMode;               // Pointer to currently active opMode handler
 static OpMode     noMode;               // Empty opMode handler for opmode::NONE
 static OpMode_FM  fmMode;               // FM mode handler
 #ifdef CONFIG_M17
 static OpMode_M17 m17Mode;              // M17 mode handler
+
+static_assert(M17_PACKET_MAX_DATA == M17::Packet::MAX_DATA,
+              "M17 packet size mismatch");
 #endif
 
 
+/**
+ * \internal
+ * Compare the part of the RTX status shown to the user with the one of the
+ * previous call, flagging any change for rtx_statusChanged().
+ */
+static void checkShownStatus()
+{
+    struct shownStatus curr;
+
+    memset(&curr, 0x00, sizeof(curr));
+    curr.opStatus = rtxStatus.opStatus;
+    curr.sqlOpen  = currMode->rxSquelchOpen();
+    curr.lsfOk    = rtxStatus.lsfOk;
+    memcpy(curr.M17_dst,       rtxStatus.M17_dst,       sizeof(curr.M17_dst));
+    memcpy(curr.M17_src,       rtxStatus.M17_src,       sizeof(curr.M17_src));
+    memcpy(curr.M17_link,      rtxStatus.M17_link,      sizeof(curr.M17_link));
+    memcpy(curr.M17_refl,      rtxStatus.M17_refl,      sizeof(curr.M17_refl));
+    memcpy(curr.M17_meta_text, rtxStatus.M17_meta_text, sizeof(curr.M17_meta_text));
+
+    if(memcmp(&curr, &shown, sizeof(curr)) != 0)
+    {
+        shown = curr;
+        __atomic_store_n(&changed, true, __ATOMIC_RELEASE);
+    }
+}
+
 void rtx_init(pthread_mutex_t *m)
 {
     // Initialise mutex for configuration access
@@ -42,6 +92,8 @@ void rtx_init(pthread_mutex_t *m)
     rtxStatus.txFrequency   = 430000000;
     rtxStatus.txPower       = 0.0f;
     rtxStatus.sqlLevel      = 1;
+    rtxStatus.voxLevel      = 0;
+    rtxStatus.rxDsp         = 0;
     rtxStatus.rxToneEn      = 0;
     rtxStatus.rxTone        = 0;
     rtxStatus.txToneEn      = 0;
@@ -62,9 +114,11 @@ void rtx_init(pthread_mutex_t *m)
     radio_updateConfiguration();
 
     /*
-     * Initial value for RSSI filter
+     * Initialise the RSSI filter: exponential moving average with a weight
+     * of 0.74 for the new sample.
      */
-    rssi         = radio_getRssi();
+    rssiFilter_init(&rssiFilter, RSSI_FILTER_EMA, 0xBD70);
+    rssi         = rssi_toDbm(rssiFilter_update(&rssiFilter, radio_getRssi() * 10));
     reinitFilter = false;
 }
 
@@ -175,21 +229,18 @@ void rtx_task()
 
         if(!reconfigure)
         {
-            if(!reinitFilter)
+            if(reinitFilter)
             {
-                /*
-                 * Filter RSSI value using 15.16 fixed point math. Equivalent
-                 * floating point code is: rssi = 0.74*radio_getRssi() + 0.26*rssi
-                 */
-                int32_t filt_rssi = radio_getRssi() * 0xBD70    // 0.74 * radio_getRssi
-                                  + rssi            * 0x428F;   // 0.26 * rssi
-                rssi = (filt_rssi + 32768) >> 16;               // Round to nearest
-            }
-            else
-            {
-                rssi = radio_getRssi();
+                rssiFilter_reset(&rssiFilter);
                 reinitFilter = false;
             }
+
+            /*
+             * Filtering is done in 0.1dB steps, to avoid the rounding errors
+             * of the integer dBm values accumulating in the filter state.
+             */
+            int16_t power = rssiFilter_update(&rssiFilter, radio_getRssi() * 10);
+            rssi = rssi_toDbm(power);
         }
     }
     else
@@ -204,6 +255,8 @@ void rtx_task()
      * version of the RSSI level.
      */
     currMode->update(&rtxStatus, reconfigure);
+
+    checkShownStatus();
 }
 
 rssi_t rtx_getRssi()
@@ -211,7 +264,41 @@ rssi_t rtx_getRssi()
     return rssi;
 }
 
+bool rtx_statusChanged()
+{
+    return __atomic_exchange_n(&changed, false, __ATOMIC_ACQUIRE);
+}
+
 bool rtx_rxSquelchOpen()
 {
     return currMode->rxSquelchOpen();
 }
+
+int rtx_sendM17Packet(const uint8_t type, const void *data, const size_t len)
+{
+    #ifdef CONFIG_M17
+    return m17Mode.sendPacket(static_cast< M17::PacketType >(type), data, len);
+    #else
+    (void) type;
+    (void) data;
+    (void) len;
+    return -ENOTSUP;
+    #endif
+}
+
+ssize_t rtx_getM17Packet(uint8_t *type, void *buf, const size_t maxLen)
+{
+    #ifdef CONFIG_M17
+    M17::PacketType pktType;
+    ssize_t ret = m17Mode.getPacket(&pktType, buf, maxLen);
+    if(ret > 0)
+        *type = static_cast< uint8_t >(pktType);
+
+    return ret;
+    #else
+    (void) type;
+    (void) buf;
+    (void) maxLen;
+    return -ENOTSUP;
+    #endif
+}
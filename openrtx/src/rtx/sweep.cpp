@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "interfaces/delays.h"
+#include "interfaces/radio.h"
+#include "rtx/sweep.h"
+#include <pthread.h>
+#include <string.h>
+
+static constexpr uint32_t SETTLE_TIME = 3;  // RSSI settling time after retune, in ms
+static constexpr int16_t  AVG_WEIGHT  = 4;  // Averaging weight, new sample is 1/4
+static constexpr int16_t  HOLD_DECAY  = 1;  // Max-hold decay per sweep, in dB
+
+static_assert(RADIO_RETUNE_CACHE_SIZE >= SWEEP_NUM_BINS,
+              "Radio retune cache smaller than a sweep");
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static sweepData_t     data;                    // Sweep data
+static int16_t         avgAcc[SWEEP_NUM_BINS];  // Average accumulators, Q12.4
+static uint8_t         currBin;                 // Next bin to be sampled
+
+
+void sweep_reset(const freq_t start, const freq_t step)
+{
+    pthread_mutex_lock(&mutex);
+
+    data.start  = start;
+    data.step   = step;
+    data.sweeps = 0;
+
+    for(size_t i = 0; i < SWEEP_NUM_BINS; i++)
+    {
+        data.maxHold[i] = SWEEP_RSSI_MIN;
+        data.average[i] = SWEEP_RSSI_MIN;
+        avgAcc[i]       = SWEEP_RSSI_MIN * 16;
+    }
+
+    currBin = 0;
+
+    pthread_mutex_unlock(&mutex);
+}
+
+bool sweep_sampleNext()
+{
+    // Retune and sample outside the critical section, to not block readers
+    // during the settling time.
+    radio_retuneRx(data.start + (currBin * data.step));
+    sleepFor(0, SETTLE_TIME);
+
+    rssi_t rssi = radio_getRssi();
+    if(rssi < SWEEP_RSSI_MIN)
+        rssi = SWEEP_RSSI_MIN;
+
+    pthread_mutex_lock(&mutex);
+
+    // Exponential moving average, the first sample initialises the bin
+    int16_t sample = static_cast< int16_t >(rssi);
+    if(data.sweeps == 0)
+        avgAcc[currBin] = sample * 16;
+    else
+        avgAcc[currBin] += ((sample * 16) - avgAcc[currBin]) / AVG_WEIGHT;
+
+    data.average[currBin] = avgAcc[currBin] / 16;
+
+    // Rolling max-hold: the held value slowly decays at each sweep
+    int16_t hold = data.maxHold[currBin];
+    if(data.sweeps != 0)
+        hold -= HOLD_DECAY;
+
+    data.maxHold[currBin] = (sample > hold) ? sample : hold;
+
+    bool last = false;
+    currBin  += 1;
+    if(currBin >= SWEEP_NUM_BINS)
+    {
+        currBin      = 0;
+        data.sweeps += 1;
+        last         = true;
+    }
+
+    pthread_mutex_unlock(&mutex);
+
+    return last;
+}
+
+void sweep_getData(sweepData_t *dest)
+{
+    pthread_mutex_lock(&mutex);
+    memcpy(dest, &data, sizeof(sweepData_t));
+    pthread_mutex_unlock(&mutex);
+}
@@ -53,6 +53,7 @@
 #include <math.h>
 #include "ui/ui_default.h"
 #include "rtx/rtx.h"
+#include "rtx/sweep.h"
 #include "interfaces/platform.h"
 #include "interfaces/display.h"
 #include "interfaces/cps_io.h"
@@ -65,6 +66,9 @@
 #include "hwconfig.h"
 #include "core/voicePromptUtils.h"
 #include "core/beeps.h"
+#include "core/rx_audio.h"
+#include "core/vox.h"
+#include "ui/widgets.h"
 
 /* UI main screen functions, their implementation is in "ui_main.c" */
 extern void _ui_drawMainBackground();
@@ -81,6 +85,7 @@ extern void _ui_drawMenuTop(ui_state_t* ui_state);
 extern void _ui_drawMenuBank(ui_state_t* ui_state);
 extern void _ui_drawMenuChannel(ui_state_t* ui_state);
 extern void _ui_drawMenuContacts(ui_state_t* ui_state);
+extern void _ui_drawMenuSpectrum();
 #ifdef CONFIG_GPS
 extern void _ui_drawMenuGPS();
 extern void _ui_drawSettingsGPS(ui_state_t* ui_state);
@@ -113,6 +118,7 @@ const char *menu_items[] =
 #ifdef CONFIG_GPS
     "GPS",
 #endif
+    "Spectrum",
     "Settings",
     "Info",
     "About"
@@ -154,7 +160,13 @@ const char *settings_gps_items[] =
     "GPS Enabled",
 #ifdef CONFIG_RTC
     "GPS Set Time",
-    "UTC Timezone"
+    "UTC Timezone",
+#endif
+#ifdef CONFIG_TRACKLOG_NVM_AREA
+    "Track Log",
+    "Log Interval",
+    "Log Distance",
+    "Export Track"
 #endif
 };
 #endif
@@ -177,7 +189,10 @@ const char * settings_m17_items[] =
 const char* settings_fm_items[] =
 {
     "CTCSS Tone",
-    "CTCSS En."
+    "CTCSS En.",
+    "Dual Watch",
+    "RX Filter",
+    "VOX"
 };
 
 const char * settings_accessibility_items[] =
@@ -282,6 +297,8 @@ static ui_state_t ui_state;
 static bool macro_menu = false;
 static bool layout_ready = false;
 static bool redraw_needed = true;
+static bool full_redraw = true;
+static uint8_t last_screen = LOW_BAT;
 
 static bool standby = false;
 static long long last_event_tick = 0;
@@ -824,42 +841,107 @@ static void _ui_changePhoneticSpell(bool newVal)
                                    state.settings.vpPhoneticSpell);
 }
 
-bool _ui_checkStandby(long long time_since_last_event)
+#ifdef CONFIG_TRACKLOG_NVM_AREA
+/**
+ * \internal
+ * Increase or decrease a track log threshold, with a step growing with its
+ * value: 1 up to 10, 5 up to 100 and 50 above.
+ */
+static uint16_t _ui_changeLogThreshold(const uint16_t value, const bool increase,
+                                       const uint16_t min, const uint16_t max)
 {
-    if (standby)
-    {
-        return false;
-    }
+    uint16_t base = increase ? value : (value - 1);
+    uint16_t step = 1;
+
+    if(base >= 100)
+        step = 50;
+    else if(base >= 10)
+        step = 5;
+
+    if(increase)
+        return ((max - value) < step) ? max : (value + step);
+
+    return ((value - min) < step) ? min : (value - step);
+}
+#endif
 
+/**
+ * \internal
+ * Get the inactivity time after which the display enters standby.
+ *
+ * @return standby timeout in ms, zero if the display timer is disabled.
+ */
+static long long _ui_standbyTimeout()
+{
     switch (state.settings.display_timer)
     {
         case TIMER_OFF:
-            return false;
+            return 0;
         case TIMER_5S:
         case TIMER_10S:
         case TIMER_15S:
         case TIMER_20S:
         case TIMER_25S:
         case TIMER_30S:
-            return time_since_last_event >= (5000 * state.settings.display_timer);
+            return 5000 * state.settings.display_timer;
         case TIMER_1M:
         case TIMER_2M:
         case TIMER_3M:
         case TIMER_4M:
         case TIMER_5M:
-            return time_since_last_event >=
-                (60000 * (state.settings.display_timer - (TIMER_1M - 1)));
+            return 60000 * (state.settings.display_timer - (TIMER_1M - 1));
         case TIMER_15M:
         case TIMER_30M:
         case TIMER_45M:
-            return time_since_last_event >=
-                (60000 * 15 * (state.settings.display_timer - (TIMER_15M - 1)));
+            return 60000 * 15 * (state.settings.display_timer - (TIMER_15M - 1));
         case TIMER_1H:
-            return time_since_last_event >= 60 * 60 * 1000;
+            return 60 * 60 * 1000;
     }
 
     // unreachable code
+    return 0;
+}
+
+bool _ui_checkStandby(long long time_since_last_event)
+{
+    if (standby)
+    {
+        return false;
+    }
+
+    long long timeout = _ui_standbyTimeout();
+    if (timeout == 0)
+    {
+        return false;
+    }
+
+    return time_since_last_event >= timeout;
+}
+
+/**
+ * \internal
+ * Check if the main screen is showing a scrolling M17 meta text, which needs
+ * to be redrawn periodically.
+ *
+ * @return true if the meta text is scrolling.
+ */
+static bool _ui_isTextScrolling()
+{
+#ifdef CONFIG_M17
+    if(standby)
+        return false;
+
+    if((last_state.ui_screen != MAIN_VFO) && (last_state.ui_screen != MAIN_MEM))
+        return false;
+
+    if(last_state.channel.mode != OPMODE_M17)
+        return false;
+
+    rtxStatus_t rtxStatus = rtx_getCurrentStatus();
+    return rtxStatus.lsfOk && (rtxStatus.M17_meta_text[0] != '\0');
+#else
     return false;
+#endif
 }
 
 static void _ui_enterStandby()
@@ -881,6 +963,7 @@ static bool _ui_exitStandby(long long now)
 
     standby = false;
     redraw_needed = true;
+    full_redraw = true;
     display_setBacklightLevel(state.settings.brightness);
 
     return true;
@@ -1085,6 +1168,28 @@ static void _ui_menuDown(uint8_t menu_entries)
     vp_playMenuBeepIfNeeded(ui_state.menu_selected==0);
 }
 
+static void _ui_setSweepRange(freq_t center, freq_t step)
+{
+    state.sweep_step  = step;
+    state.sweep_start = center - ((SWEEP_NUM_BINS / 2) * step);
+}
+
+static void _ui_changeSweepStep(bool increase)
+{
+    freq_t center = state.sweep_start + ((SWEEP_NUM_BINS / 2) * state.sweep_step);
+    size_t index  = 0;
+
+    while((index < n_freq_steps - 1) && (freq_steps[index] < state.sweep_step))
+        index++;
+
+    if(increase && (index < n_freq_steps - 1))
+        index++;
+    else if(!increase && (index > 0))
+        index--;
+
+    _ui_setSweepRange(center, freq_steps[index]);
+}
+
 static void _ui_menuBack(uint8_t prev_state)
 {
     if(ui_state.edit_mode)
@@ -1264,6 +1369,9 @@ void ui_init()
 {
     last_event_tick = getTick();
     redraw_needed = true;
+    full_redraw = true;
+    standby = false;
+    macro_menu = false;
     _ui_calculateLayout(&layout);
     layout_ready = true;
     // Initialize struct ui_state to all zeroes
@@ -1364,8 +1472,17 @@ static vpGPSInfoFlags_t GetGPSDirectionOrSpeedChanged()
 
 void ui_updateFSM(bool *sync_rtx)
 {
-    // Check for events
-    if(evQueue_wrPos == evQueue_rdPos) return;
+    // No event pending: update scheduled by ui_getNextUpdate()
+    if(evQueue_wrPos == evQueue_rdPos)
+    {
+        if(_ui_checkStandby(getTick() - last_event_tick))
+            _ui_enterStandby();
+        else if(_ui_isTextScrolling() ||
+                ((last_state.ui_screen == MENU_SPECTRUM) && (standby == false)))
+            redraw_needed = true;
+
+        return;
+    }
 
     // Pop an event from the queue
     uint8_t newTail = (evQueue_rdPos + 1) % MAX_NUM_EVENTS;
@@ -1377,6 +1494,10 @@ void ui_updateFSM(bool *sync_rtx)
     redraw_needed = true;
     if(standby) redraw_needed = false;
 
+    // Status updates only repaint the widgets whose content changed, any
+    // other event requires the screen to be redrawn from scratch.
+    if(event.type != EVENT_STATUS) full_redraw = true;
+
     // Check if battery has enough charge to operate.
     // Check is skipped if there is an ongoing transmission, since the voltage
     // drop caused by the RF PA power absorption causes spurious triggers of
@@ -1814,6 +1935,13 @@ void ui_updateFSM(bool *sync_rtx)
                             state.ui_screen = MENU_GPS;
                             break;
 #endif
+                        case M_SPECTRUM:
+                            state.ui_screen     = MENU_SPECTRUM;
+                            state.sweep_enabled = true;
+                            _ui_setSweepRange(state.channel.rx_frequency,
+                                              freq_steps[state.step_index]);
+                            *sync_rtx = true;
+                            break;
                         case M_SETTINGS:
                             state.ui_screen = MENU_SETTINGS;
                             break;
@@ -1902,6 +2030,35 @@ void ui_updateFSM(bool *sync_rtx)
                 else if(msg.keys & KEY_ESC)
                     _ui_menuBack(MENU_TOP);
                 break;
+            // Spectrum sweep screen
+            case MENU_SPECTRUM:
+                if(msg.keys & KEY_UP || msg.keys & KNOB_RIGHT)
+                {
+                    _ui_changeSweepStep(true);
+                    *sync_rtx = true;
+                }
+                else if(msg.keys & KEY_DOWN || msg.keys & KNOB_LEFT)
+                {
+                    _ui_changeSweepStep(false);
+                    *sync_rtx = true;
+                }
+                else if(msg.keys & KEY_LEFT)
+                {
+                    state.sweep_start -= (SWEEP_NUM_BINS / 2) * state.sweep_step;
+                    *sync_rtx = true;
+                }
+                else if(msg.keys & KEY_RIGHT)
+                {
+                    state.sweep_start += (SWEEP_NUM_BINS / 2) * state.sweep_step;
+                    *sync_rtx = true;
+                }
+                else if(msg.keys & KEY_ESC)
+                {
+                    state.sweep_enabled = false;
+                    *sync_rtx = true;
+                    _ui_menuBack(MENU_TOP);
+                }
+                break;
 #ifdef CONFIG_GPS
             // GPS menu screen
             case MENU_GPS:
@@ -2166,6 +2323,44 @@ void ui_updateFSM(bool *sync_rtx)
                                 state.settings.utc_timezone += 1;
                             vp_announceTimeZone(state.settings.utc_timezone, queueFlags);
                             break;
+#endif
+#ifdef CONFIG_TRACKLOG_NVM_AREA
+                        case G_LOG:
+                            state.settings.gpsLog = !state.settings.gpsLog;
+                            vp_announceSettingsOnOffToggle(&currentLanguage->trackLog,
+                                                           queueFlags,
+                                                           state.settings.gpsLog);
+                            break;
+                        case G_LOG_INTERVAL:
+                        case G_LOG_DISTANCE:
+                        {
+                            bool increase = (msg.keys & KEY_RIGHT || msg.keys & KEY_UP ||
+                                             msg.keys & KNOB_RIGHT);
+
+                            if(ui_state.menu_selected == G_LOG_INTERVAL)
+                            {
+                                state.settings.gpsLogInterval =
+                                    _ui_changeLogThreshold(state.settings.gpsLogInterval,
+                                                           increase, 1,
+                                                           GPS_LOG_MAX_INTERVAL);
+                                vp_announceSettingsInt(&currentLanguage->logInterval,
+                                                       queueFlags,
+                                                       state.settings.gpsLogInterval);
+                            }
+                            else
+                            {
+                                state.settings.gpsLogDistance =
+                                    _ui_changeLogThreshold(state.settings.gpsLogDistance,
+                                                           increase, 0,
+                                                           GPS_LOG_MAX_DISTANCE);
+                                vp_announceSettingsInt(&currentLanguage->logDistance,
+                                                       queueFlags,
+                                                       state.settings.gpsLogDistance);
+                            }
+                        }
+                            break;
+                        case G_LOG_EXPORT:
+                            break;
 #endif
                         default:
                             state.ui_screen = SETTINGS_GPS;
@@ -2175,6 +2370,11 @@ void ui_updateFSM(bool *sync_rtx)
                     _ui_menuUp(settings_gps_num);
                 else if(msg.keys & KEY_DOWN || msg.keys & KNOB_RIGHT)
                     _ui_menuDown(settings_gps_num);
+#ifdef CONFIG_TRACKLOG_NVM_AREA
+                else if((msg.keys & KEY_ENTER) &&
+                        (ui_state.menu_selected == G_LOG_EXPORT))
+                    gps_exportTracklog();
+#endif
                 else if(msg.keys & KEY_ENTER)
                     ui_state.edit_mode = !ui_state.edit_mode;
                 else if(msg.keys & KEY_ESC)
@@ -2464,6 +2664,67 @@ void ui_updateFSM(bool *sync_rtx)
                                 ui_state.edit_mode = false;
                             }
 
+                            *sync_rtx = true;
+                            break;
+                        case FM_DUAL_WATCH:
+                            // Enabling dual watch makes the current channel the
+                            // priority one
+                            if (msg.keys & KEY_LEFT || msg.keys & KEY_DOWN ||
+                                msg.keys & KNOB_LEFT || msg.keys & KEY_RIGHT ||
+                                msg.keys & KEY_UP || msg.keys & KNOB_RIGHT)
+                            {
+                                state.dual_watch = !state.dual_watch;
+                                if (state.dual_watch)
+                                    state.priority_freq = state.channel.rx_frequency;
+                            } else if (msg.keys & KEY_ENTER) {
+                                ui_state.edit_mode = false;
+                            }
+
+                            *sync_rtx = true;
+                            break;
+                        case FM_RX_DSP:
+                            // Cycle through off, subtone filter and subtone
+                            // filter with noise reduction
+                            if (msg.keys & KEY_LEFT || msg.keys & KEY_DOWN ||
+                                msg.keys & KNOB_LEFT)
+                            {
+                                if (state.rx_dsp == 0)
+                                    state.rx_dsp = RXAUDIO_HPF | RXAUDIO_NR;
+                                else if (state.rx_dsp & RXAUDIO_NR)
+                                    state.rx_dsp = RXAUDIO_HPF;
+                                else
+                                    state.rx_dsp = 0;
+                            } else if (msg.keys & KEY_RIGHT || msg.keys & KEY_UP ||
+                                       msg.keys & KNOB_RIGHT)
+                            {
+                                if (state.rx_dsp == 0)
+                                    state.rx_dsp = RXAUDIO_HPF;
+                                else if ((state.rx_dsp & RXAUDIO_NR) == 0)
+                                    state.rx_dsp = RXAUDIO_HPF | RXAUDIO_NR;
+                                else
+                                    state.rx_dsp = 0;
+                            } else if (msg.keys & KEY_ENTER) {
+                                ui_state.edit_mode = false;
+                            }
+
+                            *sync_rtx = true;
+                            break;
+                        case FM_VOX:
+                            // Zero turns the VOX off
+                            if (msg.keys & KEY_LEFT || msg.keys & KEY_DOWN ||
+                                msg.keys & KNOB_LEFT)
+                            {
+                                if (state.settings.voxLevel > 0)
+                                    state.settings.voxLevel--;
+                            } else if (msg.keys & KEY_RIGHT || msg.keys & KEY_UP ||
+                                       msg.keys & KNOB_RIGHT)
+                            {
+                                if (state.settings.voxLevel < VOX_MAX_LEVEL)
+                                    state.settings.voxLevel++;
+                            } else if (msg.keys & KEY_ENTER) {
+                                ui_state.edit_mode = false;
+                            }
+
                             *sync_rtx = true;
                             break;
                     }
@@ -2610,6 +2871,41 @@ void ui_updateFSM(bool *sync_rtx)
     }
 }
 
+/**
+ * \internal
+ * Check if a screen is built only from retained widgets, which can be updated
+ * without redrawing the whole screen.
+ *
+ * @param screen: UI screen.
+ * @return true if the screen supports partial updates.
+ */
+static bool _ui_isRetainedScreen(const uint8_t screen)
+{
+    switch(screen)
+    {
+        case MAIN_VFO:
+        case MAIN_VFO_INPUT:
+        case MAIN_MEM:
+        case MENU_TOP:
+        case MENU_BANK:
+        case MENU_CHANNEL:
+        case MENU_CONTACTS:
+        case MENU_SETTINGS:
+        case MENU_BACKUP_RESTORE:
+        case MENU_INFO:
+        case SETTINGS_DISPLAY:
+        case SETTINGS_GPS:
+        case SETTINGS_RADIO:
+        case SETTINGS_M17:
+        case SETTINGS_FM:
+        case SETTINGS_ACCESSIBILITY:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 bool ui_updateGUI()
 {
     if(redraw_needed == false)
@@ -2620,6 +2916,17 @@ bool ui_updateGUI()
         _ui_calculateLayout(&layout);
         layout_ready = true;
     }
+
+    // Clear the screen and repaint all the widgets when the screen changes,
+    // after an input event or when the macro menu overlay is shown. Screens
+    // not made of retained widgets clear the screen by themselves.
+    if(full_redraw || macro_menu || (last_state.ui_screen != last_screen))
+    {
+        widget_invalidateAll();
+        if(_ui_isRetainedScreen(last_state.ui_screen))
+            gfx_clearScreen();
+    }
+
     // Draw current GUI page
     switch(last_state.ui_screen)
     {
@@ -2651,6 +2958,10 @@ bool ui_updateGUI()
         case MENU_CONTACTS:
             _ui_drawMenuContacts(&ui_state);
             break;
+        // Spectrum sweep screen
+        case MENU_SPECTRUM:
+            _ui_drawMenuSpectrum();
+            break;
 #ifdef CONFIG_GPS
         // GPS menu screen
         case MENU_GPS:
@@ -2735,10 +3046,33 @@ bool ui_updateGUI()
         _ui_drawMacroMenu(&ui_state);
     }
 
+    last_screen   = last_state.ui_screen;
     redraw_needed = false;
+    full_redraw   = false;
     return true;
 }
 
+long long ui_getNextUpdate()
+{
+    long long next = 0;
+
+    // Scrolling text and spectrum plot are refreshed at 10Hz
+    if(_ui_isTextScrolling())
+        next = ui_state.m17_meta_text_last_scroll_tick + 100;
+    else if((last_state.ui_screen == MENU_SPECTRUM) && (standby == false))
+        next = getTick() + 100;
+
+    long long timeout = _ui_standbyTimeout();
+    if((standby == false) && (timeout != 0))
+    {
+        long long expiry = last_event_tick + timeout;
+        if((next == 0) || (expiry < next))
+            next = expiry;
+    }
+
+    return next;
+}
+
 bool ui_pushEvent(const uint8_t type, const uint32_t data)
 {
     uint8_t newHead = (evQueue_wrPos + 1) % MAX_NUM_EVENTS;
@@ -2754,6 +3088,9 @@ bool ui_pushEvent(const uint8_t type, const uint32_t data)
     evQueue[evQueue_wrPos] = event;
     evQueue_wrPos = newHead;
 
+    // Wake up the UI thread
+    event_signal();
+
     return true;
 }
 
@@ -14,6 +14,7 @@
 #include "ui/ui_strings.h"
 #include "core/utils.h"
 #include "ui/utils.h"
+#include "ui/widgets.h"
 
 void _ui_drawMainBackground()
 {
@@ -23,20 +24,141 @@ void _ui_drawMainBackground()
     gfx_drawHLine(CONFIG_SCREEN_HEIGHT - layout.bottom_h - 1, layout.hline_h, color_grey);
 }
 
+/*
+ * Retained widgets of the main screens. The middle area is split in horizontal
+ * bands, one for each text line, whose content depends on the operating mode:
+ * the "body" widget keeps track of the current arrangement of the lines and
+ * clears the whole middle area when it changes.
+ *
+ * On small screens the M17 RF link line overlaps the bottom bar, thus the two
+ * are handled as a single widget.
+ */
+static widget_t topLock;
+static widget_t topClock;
+static widget_t topBattery;
+static widget_t body;
+static widget_t line1;
+static widget_t line2;
+static widget_t line3;
+static widget_t lineFreq;
+static widget_t meter;
+static uint16_t line4_top;
+
+enum bodyLayout
+{
+    BODY_CHANNEL = 0,
+    BODY_INPUT,
+    BODY_M17
+};
+
+/**
+ * \internal
+ * Set the bounds of a text line widget, the line area ends one pixel below
+ * the baseline of the text, limited to the top of the bottom bar.
+ *
+ * @param widget: pointer to the widget.
+ * @param top: first row of the line area.
+ * @param pos: text baseline position.
+ * @return first row below the line area.
+ */
+static uint16_t _ui_setLineBounds(widget_t *widget, uint16_t top, point_t pos)
+{
+    uint16_t limit  = CONFIG_SCREEN_HEIGHT - layout.bottom_h - layout.bottom_pad;
+    uint16_t bottom = pos.y + layout.text_v_offset + 1;
+    if(bottom > limit)
+        bottom = limit;
+
+    if(top > bottom)
+        top = bottom;
+
+    point_t start = {0, top};
+    widget_setBounds(widget, start, CONFIG_SCREEN_WIDTH, bottom - top);
+
+    return bottom;
+}
+
+/**
+ * \internal
+ * Compute the bounds of the main screen widgets from the current layout.
+ */
+static void _ui_setMainWidgetBounds()
+{
+    uint16_t quarter = CONFIG_SCREEN_WIDTH / 4;
+    uint16_t limit   = CONFIG_SCREEN_HEIGHT - layout.bottom_h - layout.bottom_pad;
+
+    // Top bar: lock symbol on the left, clock in the middle, battery on the right
+    widget_setBounds(&topLock,    (point_t){0, 0}, quarter, layout.top_h);
+    widget_setBounds(&topClock,   (point_t){quarter, 0},
+                     CONFIG_SCREEN_WIDTH - (2 * quarter), layout.top_h);
+    widget_setBounds(&topBattery, (point_t){CONFIG_SCREEN_WIDTH - quarter, 0},
+                     quarter, layout.top_h);
+
+    // Middle area, between the top bar and the bottom bar
+    widget_setBounds(&body, (point_t){0, layout.top_h}, CONFIG_SCREEN_WIDTH,
+                     limit - layout.top_h);
+
+    uint16_t top = _ui_setLineBounds(&line1, layout.top_h, layout.line1_pos);
+    top = _ui_setLineBounds(&line2, top, layout.line2_pos);
+    _ui_setLineBounds(&lineFreq, top, layout.line3_large_pos);
+    line4_top = _ui_setLineBounds(&line3, top, layout.line3_pos);
+}
+
+/**
+ * \internal
+ * Select the arrangement of the text lines in the middle area of the main
+ * screen, clearing the whole area when it changes.
+ *
+ * @param bodyLayout: arrangement of the text lines.
+ */
+static void _ui_setBodyLayout(enum bodyLayout bodyLayout)
+{
+    if(widget_update(&body, bodyLayout) == false)
+        return;
+
+    widget_invalidate(&line1);
+    widget_invalidate(&line2);
+    widget_invalidate(&line3);
+    widget_invalidate(&lineFreq);
+    widget_invalidate(&meter);
+}
+
+/**
+ * \internal
+ * Draw a text line prefixed by a symbol, only if its content changed.
+ */
+static void _ui_drawSymbolLine(widget_t *widget, point_t pos,
+                               symbolSize_t symbolSize, symbol_t symbol,
+                               fontSize_t font, const char *text)
+{
+    uint32_t hash = widget_hash(WIDGET_HASH_INIT, &symbol, sizeof(symbol));
+    hash = widget_hashStr(hash, text);
+
+    if(widget_update(widget, hash) == false)
+        return;
+
+    gfx_drawSymbol(pos, symbolSize, TEXT_ALIGN_LEFT, color_white, symbol);
+    gfx_print(pos, font, TEXT_ALIGN_CENTER, color_white, "%s", text);
+}
+
 void _ui_drawMainTop(ui_state_t * ui_state)
 {
+    char buf[16];
+
 #ifdef CONFIG_RTC
     // Print clock on top bar
     datetime_t local_time = utcToLocalTime(last_state.time,
                                            last_state.settings.utc_timezone);
-    gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
-              color_white, "%02d:%02d:%02d", local_time.hour,
+    sniprintf(buf, sizeof(buf), "%02d:%02d:%02d", local_time.hour,
               local_time.minute, local_time.second);
+    widget_label(&topClock, layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
+                 color_white, buf);
 #endif
     // If the radio has no built-in battery, print input voltage
 #ifdef CONFIG_BAT_NONE
-    gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_RIGHT,
-              color_white,"%.1fV", last_state.v_bat);
+    sniprintf(buf, sizeof(buf), "%d.%dV", last_state.v_bat / 1000,
+              (last_state.v_bat % 1000) / 100);
+    widget_label(&topBattery, layout.top_pos, layout.top_font, TEXT_ALIGN_RIGHT,
+                 color_white, buf);
 #else
     if(last_state.settings.showBatteryIcon) {
         // print battery icon on top bar, use 4 px padding
@@ -44,15 +166,17 @@ void _ui_drawMainTop(ui_state_t * ui_state)
         uint16_t bat_height = layout.top_h - (layout.status_v_pad * 2);
         point_t bat_pos = {CONFIG_SCREEN_WIDTH - bat_width - layout.horizontal_pad,
                         layout.status_v_pad};
-        gfx_drawBattery(bat_pos, bat_width, bat_height, last_state.charge);
+        if(widget_update(&topBattery, last_state.charge))
+            gfx_drawBattery(bat_pos, bat_width, bat_height, last_state.charge);
     } else {
         // print the battery percentage
         point_t bat_pos = {layout.top_pos.x, layout.top_pos.y - 2};
-        gfx_print(bat_pos , FONT_SIZE_6PT, TEXT_ALIGN_RIGHT,
-        color_white,"%d%%", last_state.charge);
+        sniprintf(buf, sizeof(buf), "%d%%", last_state.charge);
+        widget_label(&topBattery, bat_pos, FONT_SIZE_6PT, TEXT_ALIGN_RIGHT,
+                     color_white, buf);
     }
 #endif
-    if (ui_state->input_locked == true)
+    if(widget_update(&topLock, ui_state->input_locked) && ui_state->input_locked)
       gfx_drawSymbol(layout.top_pos, layout.top_symbol_size, TEXT_ALIGN_LEFT,
                      color_white, SYMBOL_LOCK);
 }
@@ -60,10 +184,12 @@ void _ui_drawMainTop(ui_state_t * ui_state)
 void _ui_drawBankChannel()
 {
     // Print Bank number, channel number and Channel name
+    char buf[32];
     uint16_t b = (last_state.bank_enabled) ? last_state.bank : 0;
-    gfx_print(layout.line1_pos, layout.line1_font, TEXT_ALIGN_CENTER,
-              color_white, "%01d-%03d: %.12s",
+    sniprintf(buf, sizeof(buf), "%01d-%03d: %.12s",
               b, last_state.channel_index + 1, last_state.channel.name);
+    widget_label(&line1, layout.line1_pos, layout.line1_font, TEXT_ALIGN_CENTER,
+                 color_white, buf);
 }
 
 const char* _ui_getToneEnabledString(bool tone_tx_enable, bool tone_rx_enable,
@@ -91,6 +217,7 @@ const char* _ui_getToneEnabledString(bool tone_tx_enable, bool tone_rx_enable,
 void _ui_drawModeInfo(ui_state_t* ui_state)
 {
     char bw_str[8] = { 0 };
+    char buf[32];
 
     switch(last_state.channel.mode)
     {
@@ -109,21 +236,22 @@ void _ui_drawModeInfo(ui_state_t* ui_state)
             if (tone_tx_enable || tone_rx_enable)
             {
                 uint16_t tone = ctcss_tone[last_state.channel.fm.txTone];
-                gfx_print(layout.line2_pos, layout.line2_font, TEXT_ALIGN_CENTER,
-                          color_white, "%s %d.%d %s", bw_str, (tone / 10),
+                sniprintf(buf, sizeof(buf), "%s %d.%d %s", bw_str, (tone / 10),
                           (tone % 10), _ui_getToneEnabledString(tone_tx_enable, tone_rx_enable, true));
             }
             else
             {
-                gfx_print(layout.line2_pos, layout.line2_font, TEXT_ALIGN_CENTER,
-                          color_white, "%s", bw_str );
+                sniprintf(buf, sizeof(buf), "%s", bw_str);
             }
+
+            widget_label(&line2, layout.line2_pos, layout.line2_font,
+                         TEXT_ALIGN_CENTER, color_white, buf);
             break;
 
         case OPMODE_DMR:
             // Print talkgroup
-            gfx_print(layout.line2_pos, layout.line2_font, TEXT_ALIGN_CENTER,
-                    color_white, "DMR TG%s", "");
+            widget_label(&line2, layout.line2_pos, layout.line2_font,
+                         TEXT_ALIGN_CENTER, color_white, "DMR TG");
             break;
 
         #ifdef CONFIG_M17
@@ -135,28 +263,15 @@ void _ui_drawModeInfo(ui_state_t* ui_state)
             if(rtxStatus.lsfOk)
             {
                 // Destination address
-                gfx_drawSymbol(layout.line2_pos, layout.line2_symbol_size, TEXT_ALIGN_LEFT,
-                               color_white, SYMBOL_CALL_RECEIVED);
-
-                gfx_print(layout.line2_pos, layout.line2_font, TEXT_ALIGN_CENTER,
-                          color_white, "%s", rtxStatus.M17_dst);
+                _ui_drawSymbolLine(&line2, layout.line2_pos,
+                                   layout.line2_symbol_size,
+                                   SYMBOL_CALL_RECEIVED, layout.line2_font,
+                                   rtxStatus.M17_dst);
 
                 // Source address
-                gfx_drawSymbol(layout.line1_pos, layout.line1_symbol_size, TEXT_ALIGN_LEFT,
-                               color_white, SYMBOL_CALL_MADE);
-
-                gfx_print(layout.line1_pos, layout.line2_font, TEXT_ALIGN_CENTER,
-                          color_white, "%s", rtxStatus.M17_src);
-
-                // RF link (if present)
-                if(rtxStatus.M17_link[0] != '\0')
-                {
-                    gfx_drawSymbol(layout.line4_pos, layout.line3_symbol_size, TEXT_ALIGN_LEFT,
-                                   color_white, SYMBOL_ACCESS_POINT);
-
-                    gfx_print(layout.line4_pos, layout.line2_font, TEXT_ALIGN_CENTER,
-                              color_white, "%s", rtxStatus.M17_link);
-                }
+                _ui_drawSymbolLine(&line1, layout.line1_pos,
+                                   layout.line1_symbol_size, SYMBOL_CALL_MADE,
+                                   layout.line2_font, rtxStatus.M17_src);
 
                 // Meta text (if present)
                 if(rtxStatus.M17_meta_text[0] != '\0')
@@ -174,17 +289,20 @@ void _ui_drawModeInfo(ui_state_t* ui_state)
                                           &ui_state->m17_meta_text_scroll_position);
                         ui_state->m17_meta_text_last_scroll_tick = now;
                     }
-                    gfx_print(layout.line3_pos, layout.line2_font, TEXT_ALIGN_CENTER,
-                              color_white, "%s", msg);
+                    widget_label(&line3, layout.line3_pos, layout.line2_font,
+                                 TEXT_ALIGN_CENTER, color_white, msg);
                 }
                 // Reflector (if present)
                 else if(rtxStatus.M17_refl[0] != '\0')
                 {                    
-                    gfx_drawSymbol(layout.line3_pos, layout.line4_symbol_size, TEXT_ALIGN_LEFT,
-                                   color_white, SYMBOL_NETWORK);
-
-                    gfx_print(layout.line3_pos, layout.line2_font, TEXT_ALIGN_CENTER,
-                              color_white, "%s", rtxStatus.M17_refl);
+                    _ui_drawSymbolLine(&line3, layout.line3_pos,
+                                       layout.line4_symbol_size, SYMBOL_NETWORK,
+                                       layout.line2_font, rtxStatus.M17_refl);
+                }
+                else
+                {
+                    widget_label(&line3, layout.line3_pos, layout.line2_font,
+                                 TEXT_ALIGN_CENTER, color_white, "");
                 }
                 
                 // Reset scroll position when meta text becomes empty
@@ -208,8 +326,9 @@ void _ui_drawModeInfo(ui_state_t* ui_state)
                         dst = rtxStatus.destination_address;
                 }
 
-                gfx_print(layout.line2_pos, layout.line2_font, TEXT_ALIGN_CENTER,
-                          color_white, "M17 #%s", dst);
+                sniprintf(buf, sizeof(buf), "M17 #%s", dst);
+                widget_label(&line2, layout.line2_pos, layout.line2_font,
+                             TEXT_ALIGN_CENTER, color_white, buf);
             }
             break;
         }
@@ -227,8 +346,8 @@ void _ui_drawFrequency()
     sniprintf(freq_str, sizeof(freq_str), "%lu.%06lu", (freq / 1000000lu), (freq % 1000000lu));
     stripTrailingZeroes(freq_str);
 
-    gfx_print(layout.line3_large_pos, layout.line3_large_font, TEXT_ALIGN_CENTER,
-              color_white, "%s", freq_str);
+    widget_label(&lineFreq, layout.line3_large_pos, layout.line3_large_font,
+                 TEXT_ALIGN_CENTER, color_white, freq_str);
 }
 
 void _ui_drawVFOMiddleInput(ui_state_t* ui_state)
@@ -237,15 +356,17 @@ void _ui_drawVFOMiddleInput(ui_state_t* ui_state)
     uint8_t insert_pos = ui_state->input_position + 3;
     if(ui_state->input_position > 3) insert_pos += 1;
     char input_char = ui_state->input_number + '0';
+    char buf[16];
 
     if(ui_state->input_set == SET_RX)
     {
         if(ui_state->input_position == 0)
         {
-            gfx_print(layout.line2_pos, layout.input_font, TEXT_ALIGN_CENTER,
-                      color_white, ">Rx:%03lu.%04lu",
+            sniprintf(buf, sizeof(buf), ">Rx:%03lu.%04lu",
                       (unsigned long)ui_state->new_rx_frequency/1000000,
                       (unsigned long)(ui_state->new_rx_frequency%1000000)/100);
+            widget_label(&line2, layout.line2_pos, layout.input_font,
+                         TEXT_ALIGN_CENTER, color_white, buf);
         }
         else
         {
@@ -253,35 +374,40 @@ void _ui_drawVFOMiddleInput(ui_state_t* ui_state)
             if(ui_state->input_position == 1)
                 strcpy(ui_state->new_rx_freq_buf, ">Rx:___.____");
             ui_state->new_rx_freq_buf[insert_pos] = input_char;
-            gfx_print(layout.line2_pos, layout.input_font, TEXT_ALIGN_CENTER,
-                      color_white, ui_state->new_rx_freq_buf);
+            widget_label(&line2, layout.line2_pos, layout.input_font,
+                         TEXT_ALIGN_CENTER, color_white,
+                         ui_state->new_rx_freq_buf);
         }
-        gfx_print(layout.line3_large_pos, layout.input_font, TEXT_ALIGN_CENTER,
-                  color_white, " Tx:%03lu.%04lu",
+        sniprintf(buf, sizeof(buf), " Tx:%03lu.%04lu",
                   (unsigned long)last_state.channel.tx_frequency/1000000,
                   (unsigned long)(last_state.channel.tx_frequency%1000000)/100);
+        widget_label(&lineFreq, layout.line3_large_pos, layout.input_font,
+                     TEXT_ALIGN_CENTER, color_white, buf);
     }
     else if(ui_state->input_set == SET_TX)
     {
-        gfx_print(layout.line2_pos, layout.input_font, TEXT_ALIGN_CENTER,
-                  color_white, " Rx:%03lu.%04lu",
+        sniprintf(buf, sizeof(buf), " Rx:%03lu.%04lu",
                   (unsigned long)ui_state->new_rx_frequency/1000000,
                   (unsigned long)(ui_state->new_rx_frequency%1000000)/100);
+        widget_label(&line2, layout.line2_pos, layout.input_font,
+                     TEXT_ALIGN_CENTER, color_white, buf);
         // Replace Rx frequency with underscorses
         if(ui_state->input_position == 0)
         {
-            gfx_print(layout.line3_large_pos, layout.input_font, TEXT_ALIGN_CENTER,
-                      color_white, ">Tx:%03lu.%04lu",
+            sniprintf(buf, sizeof(buf), ">Tx:%03lu.%04lu",
                       (unsigned long)ui_state->new_rx_frequency/1000000,
                       (unsigned long)(ui_state->new_rx_frequency%1000000)/100);
+            widget_label(&lineFreq, layout.line3_large_pos, layout.input_font,
+                         TEXT_ALIGN_CENTER, color_white, buf);
         }
         else
         {
             if(ui_state->input_position == 1)
                 strcpy(ui_state->new_tx_freq_buf, ">Tx:___.____");
             ui_state->new_tx_freq_buf[insert_pos] = input_char;
-            gfx_print(layout.line3_large_pos, layout.input_font, TEXT_ALIGN_CENTER,
-                      color_white, ui_state->new_tx_freq_buf);
+            widget_label(&lineFreq, layout.line3_large_pos, layout.input_font,
+                         TEXT_ALIGN_CENTER, color_white,
+                         ui_state->new_tx_freq_buf);
         }
     }
 }
@@ -332,45 +458,115 @@ void _ui_drawMainBottom()
     }
 }
 
+/**
+ * \internal
+ * Draw the bottom bar of the main screens, only if its content changed.
+ *
+ * @param link: M17 RF link to be shown above the bottom bar, NULL if the line
+ * is not part of the current layout.
+ */
+static void _ui_drawMainMeter(const char *link)
+{
+    uint16_t top       = CONFIG_SCREEN_HEIGHT - layout.bottom_h - layout.bottom_pad;
+    rssi_t   rssi      = last_state.rssi;
+    uint8_t  mode      = last_state.channel.mode;
+    uint8_t  squelch   = last_state.settings.sqlLevel;
+    uint8_t  volume    = last_state.volume;
+    uint8_t  mic_level = (mode == OPMODE_FM) ? 0 : platform_getMicLevel();
+
+    uint32_t hash = widget_hash(WIDGET_HASH_INIT, &mode, sizeof(mode));
+    hash = widget_hash(hash, &rssi,      sizeof(rssi));
+    hash = widget_hash(hash, &squelch,   sizeof(squelch));
+    hash = widget_hash(hash, &volume,    sizeof(volume));
+    hash = widget_hash(hash, &mic_level, sizeof(mic_level));
+
+    if(link != NULL)
+    {
+        top  = line4_top;
+        hash = widget_hashStr(hash, link);
+    }
+
+    widget_setBounds(&meter, (point_t){0, top}, CONFIG_SCREEN_WIDTH,
+                     CONFIG_SCREEN_HEIGHT - top);
+
+    if(widget_update(&meter, hash) == false)
+        return;
+
+    // RF link (if present)
+    if((link != NULL) && (link[0] != '\0'))
+    {
+        gfx_drawSymbol(layout.line4_pos, layout.line3_symbol_size,
+                       TEXT_ALIGN_LEFT, color_white, SYMBOL_ACCESS_POINT);
+
+        gfx_print(layout.line4_pos, layout.line2_font, TEXT_ALIGN_CENTER,
+                  color_white, "%s", link);
+    }
+
+    _ui_drawMainBottom();
+}
+
 void _ui_drawMainVFO(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
+    _ui_setMainWidgetBounds();
     _ui_drawMainTop(ui_state);
-    _ui_drawModeInfo(ui_state);
+
+    enum bodyLayout bodyLayout = BODY_CHANNEL;
+    const char *link = NULL;
 
     #ifdef CONFIG_M17
     // Show VFO frequency if the OpMode is not M17 or there is no valid LSF data
     rtxStatus_t status = rtx_getCurrentStatus();
-    if((status.opMode != OPMODE_M17) || (status.lsfOk == false))
+    if((status.opMode == OPMODE_M17) && (status.lsfOk == true))
+    {
+        bodyLayout = BODY_M17;
+        link = status.M17_link;
+    }
     #endif
+
+    _ui_setBodyLayout(bodyLayout);
+    _ui_drawModeInfo(ui_state);
+
+    if(bodyLayout == BODY_CHANNEL)
         _ui_drawFrequency();
 
-    _ui_drawMainBottom();
+    _ui_drawMainMeter(link);
 }
 
 void _ui_drawMainVFOInput(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
+    _ui_setMainWidgetBounds();
     _ui_drawMainTop(ui_state);
+    _ui_setBodyLayout(BODY_INPUT);
     _ui_drawVFOMiddleInput(ui_state);
-    _ui_drawMainBottom();
+    _ui_drawMainMeter(NULL);
 }
 
 void _ui_drawMainMEM(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
+    _ui_setMainWidgetBounds();
     _ui_drawMainTop(ui_state);
-    _ui_drawModeInfo(ui_state);
+
+    enum bodyLayout bodyLayout = BODY_CHANNEL;
+    const char *link = NULL;
 
     #ifdef CONFIG_M17
     // Show channel data if the OpMode is not M17 or there is no valid LSF data
     rtxStatus_t status = rtx_getCurrentStatus();
-    if((status.opMode != OPMODE_M17) || (status.lsfOk == false))
+    if((status.opMode == OPMODE_M17) && (status.lsfOk == true))
+    {
+        bodyLayout = BODY_M17;
+        link = status.M17_link;
+    }
     #endif
+
+    _ui_setBodyLayout(bodyLayout);
+    _ui_drawModeInfo(ui_state);
+
+    if(bodyLayout == BODY_CHANNEL)
     {
         _ui_drawBankChannel();
         _ui_drawFrequency();
     }
 
-    _ui_drawMainBottom();
+    _ui_drawMainMeter(link);
 }
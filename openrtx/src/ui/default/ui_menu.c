@@ -8,6 +8,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <inttypes.h>
+#include <limits.h>
 #include "core/utils.h"
 #include "ui/ui_default.h"
 #include "interfaces/nvmem.h"
@@ -15,8 +16,11 @@
 #include "interfaces/platform.h"
 #include "interfaces/delays.h"
 #include "core/memory_profiling.h"
+#include "rtx/sweep.h"
+#include "core/rx_audio.h"
 #include "ui/ui_strings.h"
 #include "core/voicePromptUtils.h"
+#include "ui/widgets.h"
 
 #ifdef PLATFORM_TTWRPLUS
 #include "drivers/baseband/SA8x8.h"
@@ -32,6 +36,10 @@ static char priorSelectedMenuValue[MAX_ENTRY_LEN] = "\0";
 static bool priorEditMode = false;
 static uint32_t lastValueUpdate=0;
 
+// Maximum number of menu rows on the screen, with the smallest row height
+#define MAX_MENU_ROWS ((CONFIG_SCREEN_HEIGHT / 10) + 1)
+static widget_t menuRows[MAX_MENU_ROWS];
+
 const char *display_timer_values[] =
 {
     "OFF",
@@ -143,6 +151,54 @@ static void announceMenuItemIfNeeded(char* name, char* value, bool editMode)
     vp_play();
 }
 
+/**
+ * \internal
+ * Draw a menu list row, only if its content changed.
+ *
+ * @param row: index of the row on the screen.
+ * @param pos: text start position.
+ * @param entry: entry name.
+ * @param value: entry value, NULL if not present.
+ * @param selected: true if the entry is the selected one.
+ * @param editMode: true if the selected entry is being edited.
+ */
+static void _ui_drawMenuRow(uint8_t row, point_t pos, const char *entry,
+                            const char *value, bool selected, bool editMode)
+{
+    if(row >= MAX_MENU_ROWS)
+        return;
+
+    // Row area, compensating for text height
+    point_t rect_pos = {0, pos.y - layout.menu_h + 3};
+    widget_setBounds(&menuRows[row], rect_pos, CONFIG_SCREEN_WIDTH,
+                     layout.menu_h);
+
+    uint8_t flags = (selected ? 0x01 : 0x00) | (editMode ? 0x02 : 0x00);
+    uint32_t hash = widget_hash(WIDGET_HASH_INIT, &flags, sizeof(flags));
+    hash = widget_hashStr(hash, entry);
+    if(value != NULL)
+        hash = widget_hashStr(hash, value);
+
+    if(widget_update(&menuRows[row], hash) == false)
+        return;
+
+    color_t text_color = color_white;
+    if(selected)
+    {
+        // Draw rectangle under selected item, if we are in edit mode draw
+        // a hollow rectangle
+        if(editMode == false)
+            text_color = color_black;
+
+        gfx_drawRect(rect_pos, CONFIG_SCREEN_WIDTH, layout.menu_h, color_white,
+                     !editMode);
+    }
+
+    gfx_print(pos, layout.menu_font, TEXT_ALIGN_LEFT, text_color, entry);
+    if(value != NULL)
+        gfx_print(pos, layout.menu_font, TEXT_ALIGN_RIGHT, text_color, value);
+}
+
 void _ui_drawMenuList(uint8_t selected, int (*getCurrentEntry)(char *buf, uint8_t max_len, uint8_t index))
 {
     point_t pos = layout.line1_pos;
@@ -150,7 +206,6 @@ void _ui_drawMenuList(uint8_t selected, int (*getCurrentEntry)(char *buf, uint8_
     uint8_t entries_in_screen = (CONFIG_SCREEN_HEIGHT - 1 - pos.y) / layout.menu_h + 1;
     uint8_t scroll = 0;
     char entry_buf[MAX_ENTRY_LEN] = "";
-    color_t text_color = color_white;
     for(int item=0, result=0; (result == 0) && (pos.y < CONFIG_SCREEN_HEIGHT); item++)
     {
         // If selection is off the screen, scroll screen
@@ -160,16 +215,11 @@ void _ui_drawMenuList(uint8_t selected, int (*getCurrentEntry)(char *buf, uint8_
         result = (*getCurrentEntry)(entry_buf, sizeof(entry_buf), item+scroll);
         if(result != -1)
         {
-            text_color = color_white;
-            if(item + scroll == selected)
-            {
-                text_color = color_black;
-                // Draw rectangle under selected item, compensating for text height
-                point_t rect_pos = {0, pos.y - layout.menu_h + 3};
-                gfx_drawRect(rect_pos, CONFIG_SCREEN_WIDTH, layout.menu_h, color_white, true);
+            bool isSelected = (item + scroll == selected);
+            if(isSelected)
                 announceMenuItemIfNeeded(entry_buf, NULL, false);
-            }
-            gfx_print(pos, layout.menu_font, TEXT_ALIGN_LEFT, text_color, entry_buf);
+
+            _ui_drawMenuRow(item, pos, entry_buf, NULL, isSelected, false);
             pos.y += layout.menu_h;
         }
     }
@@ -185,7 +235,6 @@ void _ui_drawMenuListValue(ui_state_t* ui_state, uint8_t selected,
     uint8_t scroll = 0;
     char entry_buf[MAX_ENTRY_LEN] = "";
     char value_buf[MAX_ENTRY_LEN] = "";
-    color_t text_color = color_white;
     for(int item=0, result=0; (result == 0) && (pos.y < CONFIG_SCREEN_HEIGHT); item++)
     {
         // If selection is off the screen, scroll screen
@@ -197,20 +246,9 @@ void _ui_drawMenuListValue(ui_state_t* ui_state, uint8_t selected,
         result = (*getCurrentValue)(value_buf, sizeof(value_buf), item+scroll);
         if(result != -1)
         {
-            text_color = color_white;
-            if(item + scroll == selected)
+            bool isSelected = (item + scroll == selected);
+            if(isSelected)
             {
-                // Draw rectangle under selected item, compensating for text height
-                // If we are in edit mode, draw a hollow rectangle
-                text_color = color_black;
-                bool full_rect = true;
-                if(ui_state->edit_mode)
-                {
-                    text_color = color_white;
-                    full_rect = false;
-                }
-                point_t rect_pos = {0, pos.y - layout.menu_h + 3};
-                gfx_drawRect(rect_pos, CONFIG_SCREEN_WIDTH, layout.menu_h, color_white, full_rect);
                 bool editModeChanged = priorEditMode != ui_state->edit_mode;
                 priorEditMode = ui_state->edit_mode;
                 // force the menu item to be spoken  when the edit mode changes.
@@ -224,8 +262,9 @@ void _ui_drawMenuListValue(ui_state_t* ui_state, uint8_t selected,
                                              ui_state->edit_mode);
                 }
             }
-            gfx_print(pos, layout.menu_font, TEXT_ALIGN_LEFT, text_color, entry_buf);
-            gfx_print(pos, layout.menu_font, TEXT_ALIGN_RIGHT, text_color, value_buf);
+
+            _ui_drawMenuRow(item, pos, entry_buf, value_buf, isSelected,
+                            isSelected && ui_state->edit_mode);
             pos.y += layout.menu_h;
         }
     }
@@ -327,6 +366,22 @@ int _ui_getSettingsGPSValueName(char *buf, uint8_t max_len, uint8_t index)
             sniprintf(buf, max_len, "%c%d.%d", sign, tz_hr, tz_mn);
         }
             break;
+#endif
+#ifdef CONFIG_TRACKLOG_NVM_AREA
+        case G_LOG:
+            sniprintf(buf, max_len, "%s", (last_state.settings.gpsLog) ?
+                                               currentLanguage->on :
+                                               currentLanguage->off);
+            break;
+        case G_LOG_INTERVAL:
+            sniprintf(buf, max_len, "%ds", last_state.settings.gpsLogInterval);
+            break;
+        case G_LOG_DISTANCE:
+            sniprintf(buf, max_len, "%dm", last_state.settings.gpsLogDistance);
+            break;
+        case G_LOG_EXPORT:
+            sniprintf(buf, max_len, "%s", gps_exportRunning() ? "..." : "");
+            break;
 #endif
     }
     return 0;
@@ -477,6 +532,35 @@ int _ui_getFMValueName(char* buf, uint8_t max_len, uint8_t index)
                                              last_state.channel.fm.rxToneEn,
                                              false));
             break;
+
+        case FM_DUAL_WATCH:
+        {
+            freq_t freq = last_state.priority_freq;
+
+            if(last_state.dual_watch)
+                sniprintf(buf, max_len, "%lu.%03lu",
+                          (unsigned long) (freq / 1000000),
+                          (unsigned long) ((freq % 1000000) / 1000));
+            else
+                sniprintf(buf, max_len, "%s", currentLanguage->off);
+            break;
+        }
+
+        case FM_RX_DSP:
+            if(last_state.rx_dsp == 0)
+                sniprintf(buf, max_len, "%s", currentLanguage->off);
+            else if(last_state.rx_dsp & RXAUDIO_NR)
+                sniprintf(buf, max_len, "HPF+NR");
+            else
+                sniprintf(buf, max_len, "HPF");
+            break;
+
+        case FM_VOX:
+            if(last_state.settings.voxLevel == 0)
+                sniprintf(buf, max_len, "%s", currentLanguage->off);
+            else
+                sniprintf(buf, max_len, "%d", last_state.settings.voxLevel);
+            break;
     }
 
     return 0;
@@ -632,7 +716,6 @@ int _ui_getContactName(char *buf, uint8_t max_len, uint8_t index)
 
 void _ui_drawMenuTop(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "Menu" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->menu);
@@ -642,7 +725,6 @@ void _ui_drawMenuTop(ui_state_t* ui_state)
 
 void _ui_drawMenuBank(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "Bank" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->banks);
@@ -652,7 +734,6 @@ void _ui_drawMenuBank(ui_state_t* ui_state)
 
 void _ui_drawMenuChannel(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "Channel" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->channels);
@@ -662,7 +743,6 @@ void _ui_drawMenuChannel(ui_state_t* ui_state)
 
 void _ui_drawMenuContacts(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "Contacts" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->contacts);
@@ -670,6 +750,65 @@ void _ui_drawMenuContacts(ui_state_t* ui_state)
     _ui_drawMenuList(ui_state->menu_selected, _ui_getContactName);
 }
 
+void _ui_drawMenuSpectrum()
+{
+    // RSSI range shown in the plot, in dB above the sweep floor
+    static const int16_t range = 80;
+
+    sweepData_t sweep;
+    sweep_getData(&sweep);
+
+    gfx_clearScreen();
+    // Print "Spectrum" on top bar
+    gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
+              color_white, "Spectrum");
+
+    uint16_t plotTop    = layout.top_h + 1;
+    uint16_t plotHeight = CONFIG_SCREEN_HEIGHT - layout.bottom_h - plotTop - 1;
+    uint16_t binWidth   = CONFIG_SCREEN_WIDTH / SWEEP_NUM_BINS;
+    uint16_t plotWidth  = binWidth * SWEEP_NUM_BINS;
+    uint16_t plotStart  = (CONFIG_SCREEN_WIDTH - plotWidth) / 2;
+
+    // Max-hold level as a bar graph, average level as a line plot over it.
+    // The line plot is vertically centered and full scale is SHRT_MAX/4.
+    int16_t trace[CONFIG_SCREEN_WIDTH];
+    for(size_t i = 0; i < SWEEP_NUM_BINS; i++)
+    {
+        int16_t hold = sweep.maxHold[i] - SWEEP_RSSI_MIN;
+        int16_t avg  = sweep.average[i] - SWEEP_RSSI_MIN;
+        hold = (hold > range) ? range : hold;
+        avg  = (avg  > range) ? range : avg;
+
+        uint16_t barHeight = (hold * plotHeight) / range;
+        if(barHeight > 0)
+        {
+            point_t pos = {plotStart + (i * binWidth),
+                           plotTop + plotHeight - barHeight};
+            gfx_drawRect(pos, binWidth, barHeight, yellow_fab413, true);
+        }
+
+        int16_t level = ((int32_t)((range / 2) - avg) * (SHRT_MAX / 4))
+                      / (range / 2);
+        for(size_t j = 0; j < binWidth; j++)
+            trace[(i * binWidth) + j] = level;
+    }
+
+    point_t plotPos = {plotStart - 1, plotTop};
+    gfx_plotData(plotPos, plotWidth, plotHeight, trace, plotWidth);
+
+    // Print sweep limits and step on bottom bar
+    freq_t stop = sweep.start + ((SWEEP_NUM_BINS - 1) * sweep.step);
+    gfx_print(layout.bottom_pos, layout.bottom_font, TEXT_ALIGN_LEFT,
+              color_white, "%lu.%03lu", (unsigned long) (sweep.start / 1000000),
+              (unsigned long) ((sweep.start % 1000000) / 1000));
+    gfx_print(layout.bottom_pos, layout.bottom_font, TEXT_ALIGN_CENTER,
+              color_white, "%lu.%01luk", (unsigned long) (sweep.step / 1000),
+              (unsigned long) ((sweep.step % 1000) / 100));
+    gfx_print(layout.bottom_pos, layout.bottom_font, TEXT_ALIGN_RIGHT,
+              color_white, "%lu.%03lu", (unsigned long) (stop / 1000000),
+              (unsigned long) ((stop % 1000000) / 1000));
+}
+
 #ifdef CONFIG_GPS
 void _ui_drawMenuGPS()
 {
@@ -779,7 +918,6 @@ void _ui_drawMenuGPS()
 
 void _ui_drawMenuSettings(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "Settings" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->settings);
@@ -789,7 +927,6 @@ void _ui_drawMenuSettings(ui_state_t* ui_state)
 
 void _ui_drawMenuBackupRestore(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "Backup & Restore" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->backupAndRestore);
@@ -851,7 +988,6 @@ void _ui_drawMenuRestore(ui_state_t* ui_state)
 
 void _ui_drawMenuInfo(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "Info" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->info);
@@ -897,7 +1033,6 @@ void _ui_drawMenuAbout(ui_state_t* ui_state)
 
 void _ui_drawSettingsDisplay(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "Display" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->display);
@@ -909,7 +1044,6 @@ void _ui_drawSettingsDisplay(ui_state_t* ui_state)
 #ifdef CONFIG_GPS
 void _ui_drawSettingsGPS(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "GPS Settings" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->gpsSettings);
@@ -982,7 +1116,6 @@ void _ui_drawSettingsTimeDateSet(ui_state_t* ui_state)
 #ifdef CONFIG_M17
 void _ui_drawSettingsM17(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "M17 Settings" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->m17settings);
@@ -1024,7 +1157,6 @@ void _ui_drawSettingsM17(ui_state_t* ui_state)
 
 void _ui_drawSettingsFM(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "FM Settings" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER, color_white,
               currentLanguage->fm);
@@ -1035,7 +1167,6 @@ void _ui_drawSettingsFM(ui_state_t* ui_state)
 
 void _ui_drawSettingsAccessibility(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
     // Print "Accessibility" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->accessibility);
@@ -1075,8 +1206,6 @@ void _ui_drawSettingsReset2Defaults(ui_state_t* ui_state)
 
 void _ui_drawSettingsRadio(ui_state_t* ui_state)
 {
-    gfx_clearScreen();
-
     // Print "Radio Settings" on top bar
     gfx_print(layout.top_pos, layout.top_font, TEXT_ALIGN_CENTER,
               color_white, currentLanguage->radioSettings);
@@ -928,6 +928,20 @@ bool ui_updateGUI()
     return true;
 }
 
+long long ui_getNextUpdate()
+{
+    // The M17 meta text on the main screen scrolls at 10Hz
+    if((last_state.ui_screen == MAIN_VFO) &&
+       (last_state.channel.mode == OPMODE_M17))
+    {
+        rtxStatus_t rtxStatus = rtx_getCurrentStatus();
+        if(rtxStatus.lsfOk && (rtxStatus.M17_meta_text[0] != '\0'))
+            return ui_state.m17_meta_text_last_scroll_tick + 100;
+    }
+
+    return 0;
+}
+
 bool ui_pushEvent(const uint8_t type, const uint32_t data)
 {
     uint8_t newHead = (evQueue_wrPos + 1) % MAX_NUM_EVENTS;
@@ -943,6 +957,9 @@ bool ui_pushEvent(const uint8_t type, const uint32_t data)
     evQueue[evQueue_wrPos] = event;
     evQueue_wrPos = newHead;
 
+    // Wake up the UI thread
+    event_signal();
+
     return true;
 }
 
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ui/widgets.h"
+
+static const color_t background = {0, 0, 0, 255};
+
+/*
+ * Current screen generation, incremented each time the screen is cleared.
+ * Starts from one so that zero-initialised widgets are always repainted.
+ */
+static uint32_t generation = 1;
+
+void widget_setBounds(widget_t *widget, const point_t pos, const uint16_t width,
+                      const uint16_t height)
+{
+    if((widget->pos.x  != pos.x)  || (widget->pos.y  != pos.y) ||
+       (widget->width  != width)  || (widget->height != height))
+    {
+        widget->pos    = pos;
+        widget->width  = width;
+        widget->height = height;
+        widget->dirty  = true;
+    }
+}
+
+void widget_invalidate(widget_t *widget)
+{
+    widget->dirty = true;
+}
+
+void widget_invalidateAll()
+{
+    generation++;
+}
+
+bool widget_update(widget_t *widget, const uint32_t value)
+{
+    bool drawn = (widget->gen == generation);
+
+    if(drawn && (widget->dirty == false) && (widget->value == value))
+        return false;
+
+    // Clear the previous content, if any
+    if(drawn && (widget->width > 0) && (widget->height > 0))
+        gfx_drawRect(widget->pos, widget->width, widget->height, background, true);
+
+    widget->value = value;
+    widget->gen   = generation;
+    widget->dirty = false;
+
+    return true;
+}
+
+uint32_t widget_hash(uint32_t hash, const void *data, const size_t len)
+{
+    const uint8_t *ptr = (const uint8_t *) data;
+
+    // FNV-1a
+    for(size_t i = 0; i < len; i++)
+    {
+        hash ^= ptr[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+uint32_t widget_hashStr(uint32_t hash, const char *str)
+{
+    while(*str != '\0')
+    {
+        hash ^= (uint8_t) *str++;
+        hash *= 16777619u;
+    }
+
+    // Terminator, to tell apart consecutive strings
+    hash ^= 0xff;
+    hash *= 16777619u;
+
+    return hash;
+}
+
+bool widget_label(widget_t *widget, point_t start, fontSize_t size,
+                  textAlign_t alignment, color_t color, const char *text)
+{
+    uint32_t hash = widget_hash(WIDGET_HASH_INIT, &color, sizeof(color));
+    hash = widget_hashStr(hash, text);
+
+    if(widget_update(widget, hash) == false)
+        return false;
+
+    gfx_printBuffer(start, size, alignment, color, text);
+    return true;
+}
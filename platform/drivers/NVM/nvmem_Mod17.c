@@ -7,6 +7,7 @@
 #include "interfaces/nvmem.h"
 #include "calibration/calibInfo_Mod17.h"
 #include <string.h>
+#include <stddef.h>
 #include "core/crc.h"
 #include "flash.h"
 
@@ -30,6 +31,21 @@ typedef struct
 }
 __attribute__((packed)) memory_t;
 
+/*
+ * Layout of the data blocks saved by firmware versions preceding the addition
+ * of the GPS track logger fields at the end of settings_t. Blocks in this
+ * format are still accepted when reading and migrated to the current layout.
+ */
+#define LEGACY_SETTINGS_SIZE (offsetof(settings_t, gpsLog))
+
+typedef struct
+{
+    uint16_t     crc;
+    uint8_t      settings[LEGACY_SETTINGS_SIZE];
+    mod17Calib_t calibration;
+}
+__attribute__((packed)) legacyBlock_t;
+
 static const uint32_t MEM_MAGIC   = 0x584E504F;    // "OPNX"
 static const uint32_t baseAddress = 0x080E0000;
 memory_t *memory = ((memory_t *) baseAddress);
@@ -47,10 +63,13 @@ const struct nvmTable nvmTab = {
  * is the one containing the last saved settings. Blocks containing legacy data
  * are marked with numbers starting from 4096.
  *
+ * @param legacy: set to true if the active block uses the legacy data layout.
  * @return number currently active data block or -1 if memory data is invalid.
  */
-static int findActiveBlock()
+static int findActiveBlock(bool *legacy)
 {
+    *legacy = false;
+
     // Check for invalid memory data
     if(memory->magic != MEM_MAGIC)
         return -1;
@@ -82,9 +101,17 @@ static int findActiveBlock()
     // Check data validity
     const size_t crcLen = sizeof(settings_t) + sizeof(mod17Calib_t);
     uint16_t crc = crc_ccitt(&(memory->data[block].settings), crcLen);
-    if(crc != memory->data[block].crc)
+    if(crc == memory->data[block].crc)
+        return block;
+
+    // Check if data was saved using the legacy layout
+    const legacyBlock_t *oldBlk = ((const legacyBlock_t *) memory->data) + block;
+    const size_t oldCrcLen = LEGACY_SETTINGS_SIZE + sizeof(mod17Calib_t);
+    crc = crc_ccitt(oldBlk->settings, oldCrcLen);
+    if(crc != oldBlk->crc)
         return -2;
 
+    *legacy = true;
     return block;
 }
 
@@ -126,11 +153,23 @@ int nvm_readVfoChannelData(channel_t *channel)
 
 int nvm_readSettings(settings_t *settings)
 {
-    int block = findActiveBlock();
+    bool legacy;
+    int  block = findActiveBlock(&legacy);
 
     // Invalid data found
     if(block < 0) return -1;
 
+    if(legacy)
+    {
+        // Fields missing from the legacy layout get their default value
+        const legacyBlock_t *oldBlk = ((const legacyBlock_t *) memory->data) + block;
+        memcpy(settings,      &default_settings,     sizeof(settings_t));
+        memcpy(settings,      oldBlk->settings,      LEGACY_SETTINGS_SIZE);
+        memcpy(&mod17CalData, &(oldBlk->calibration), sizeof(mod17Calib_t));
+
+        return 0;
+    }
+
     memcpy(settings,      &(memory->data[block].settings),    sizeof(settings_t));
     memcpy(&mod17CalData, &(memory->data[block].calibration), sizeof(mod17Calib_t));
 
@@ -140,15 +179,16 @@ int nvm_readSettings(settings_t *settings)
 int nvm_writeSettings(const settings_t *settings)
 {
     uint32_t addr    = 0;
-    int      block   = findActiveBlock();
+    bool     legacy  = false;
+    int      block   = findActiveBlock(&legacy);
     uint16_t prevCrc = 0;
 
     /*
-     * Memory never initialised or save space finished: erase all the sector.
-     * On STM32F405 the settings are saved in sector 11, starting at address
-     * 0x08060000.
+     * Memory never initialised, save space finished or data saved using the
+     * legacy layout: erase all the sector. On STM32F405 the settings are saved
+     * in sector 11, starting at address 0x08060000.
      */
-    if((block < 0) || (block >= 2047))
+    if((block < 0) || (block >= 2047) || legacy)
     {
         flash_eraseSector(11);
         addr = ((uint32_t) &(memory->magic));
@@ -12,10 +12,12 @@
 #include "drivers/NVM/posix_file.h"
 #include "core/nvmem_access.h"
 #include "interfaces/nvmem.h"
+#include "hwconfig.h"
 
 #define NVM_MAX_PATHLEN 256
 
 POSIX_FILE_DEVICE_DEFINE(stateDevice)
+POSIX_FILE_DEVICE_DEFINE(tracklogDevice)
 
 const struct nvmPartition statePartitions[] =
 {
@@ -29,19 +31,29 @@ const struct nvmPartition statePartitions[] =
     }
 };
 
-const struct nvmDescriptor stateNvm =
+const struct nvmDescriptor stateNvm[] =
 {
-    .name       = "Device state NVM area",
-    .dev        = (const struct nvmDevice *) &stateDevice,
-    .baseAddr   = 0x00000000,
-    .size       = 1024,
-    .nbPart     = sizeof(statePartitions) / sizeof(struct nvmPartition),
-    .partitions = statePartitions
+    {
+        .name       = "Device state NVM area",
+        .dev        = (const struct nvmDevice *) &stateDevice,
+        .baseAddr   = 0x00000000,
+        .size       = 1024,
+        .nbPart     = sizeof(statePartitions) / sizeof(struct nvmPartition),
+        .partitions = statePartitions
+    },
+    {
+        .name       = "GPS track log",
+        .dev        = (const struct nvmDevice *) &tracklogDevice,
+        .baseAddr   = 0x00000000,
+        .size       = CONFIG_TRACKLOG_SIZE,
+        .nbPart     = 0,
+        .partitions = NULL
+    }
 };
 
 const struct nvmTable nvmTab = {
-    .areas = &stateNvm,
-    .nbAreas = 1,
+    .areas = stateNvm,
+    .nbAreas = sizeof(stateNvm) / sizeof(struct nvmDescriptor),
 };
 
 /**
@@ -124,12 +136,20 @@ void nvm_init()
     if(create_dir(memory_path) != 0)
         exit(1);
 
+    char *fileName = memory_path + strlen(memory_path);
+
     strcat(memory_path, "state.bin");
 
     int ret = posixFile_init(&stateDevice, memory_path, 1024);
     if(ret < 0)
         printf("Opening of state file failed with status %d\n", ret);
 
+    strcpy(fileName, "tracklog.bin");
+
+    ret = posixFile_init(&tracklogDevice, memory_path, CONFIG_TRACKLOG_SIZE);
+    if(ret < 0)
+        printf("Opening of track log file failed with status %d\n", ret);
+
     return;
 
 toolong:
@@ -140,6 +160,7 @@ toolong:
 void nvm_terminate()
 {
     posixFile_terminate(&stateDevice);
+    posixFile_terminate(&tracklogDevice);
 }
 
 void nvm_readHwInfo(hwInfo_t *info)
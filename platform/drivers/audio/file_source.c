@@ -5,11 +5,24 @@
  */
 
 #include <stdlib.h>
-#include <unistd.h>
 #include <stdio.h>
 #include <errno.h>
+#include "interfaces/delays.h"
 #include "file_source.h"
 
+/*
+ * Private data of the file source. The time at which each new chunk of data is
+ * made available is computed from the number of samples delivered since the
+ * stream start, so that the pacing follows the system clock without drift,
+ * both when running in real time and with a simulated time.
+ */
+struct fileSrc
+{
+    FILE      *fp;
+    long long  startTime;   // Stream start time, in ms
+    uint64_t   samples;     // Samples delivered since the stream start
+};
+
 static int fileSource_start(const uint8_t instance, const void *config,
                             struct streamCtx *ctx)
 {
@@ -23,13 +36,22 @@ static int fileSource_start(const uint8_t instance, const void *config,
 
     ctx->running = 1;
 
-    FILE *fp = fopen(config, "rb");
-    if (fp == NULL) {
+    struct fileSrc *src = malloc(sizeof(struct fileSrc));
+    if (src == NULL) {
+        ctx->running = 0;
+        return -ENOMEM;
+    }
+
+    src->fp = fopen(config, "rb");
+    if (src->fp == NULL) {
+        free(src);
         ctx->running = 0;
         return -EINVAL;
     }
 
-    ctx->priv = fp;
+    src->startTime = getTick();
+    src->samples = 0;
+    ctx->priv = src;
 
     return 0;
 }
@@ -39,7 +61,8 @@ static int fileSource_data(struct streamCtx *ctx, stream_sample_t **buf)
     if (ctx->running == 0)
         return -1;
 
-    FILE *fp = (FILE *)ctx->priv;
+    struct fileSrc *src = (struct fileSrc *)ctx->priv;
+    FILE *fp = src->fp;
     stream_sample_t *dest = ctx->buffer;
     size_t size = ctx->bufSize;
     size_t i = 0;
@@ -64,14 +87,19 @@ static int fileSource_sync(struct streamCtx *ctx, uint8_t dirty)
 {
     (void)dirty;
 
+    if (ctx->running == 0)
+        return -1;
+
+    struct fileSrc *src = (struct fileSrc *)ctx->priv;
     size_t size = ctx->bufSize;
     if (ctx->bufMode == BUF_CIRC_DOUBLE)
         size /= 2;
 
-    // Simulate the time needed to get a new chunck of data from an equivalent
-    // hardware peripheral.
-    uint32_t waitTime = (1000000 * size) / ctx->sampleRate;
-    usleep(waitTime);
+    // Simulate the time needed to get a new chunk of data from an equivalent
+    // hardware peripheral, waiting until the end of its acquisition.
+    src->samples += size;
+    long long elapsed = (src->samples * 1000) / ctx->sampleRate;
+    sleepUntil(src->startTime + elapsed);
 
     return 0;
 }
@@ -81,8 +109,11 @@ static void fileSource_stop(struct streamCtx *ctx)
     if (ctx->running == 0)
         return;
 
-    FILE *fp = (FILE *)ctx->priv;
-    fclose(fp);
+    struct fileSrc *src = (struct fileSrc *)ctx->priv;
+    fclose(src->fp);
+    free(src);
+    ctx->priv = NULL;
+    ctx->running = 0;
 }
 
 static void fileSource_halt(struct streamCtx *ctx)
@@ -90,8 +121,11 @@ static void fileSource_halt(struct streamCtx *ctx)
     if (ctx->running == 0)
         return;
 
-    FILE *fp = (FILE *)ctx->priv;
-    fclose(fp);
+    struct fileSrc *src = (struct fileSrc *)ctx->priv;
+    fclose(src->fp);
+    free(src);
+    ctx->priv = NULL;
+    ctx->running = 0;
 }
 
 #pragma GCC diagnostic ignored "-Wpedantic"
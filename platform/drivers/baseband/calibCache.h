@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CALIB_CACHE_H
+#define CALIB_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "core/datatypes.h"
+
+#ifndef __cplusplus
+#error This header is C++ only!
+#endif
+
+/**
+ * Small cache of interpolated calibration parameters, indexed by frequency.
+ * It allows radio drivers to avoid interpolating the calibration tables each
+ * time they retune to a recently used frequency. When the cache is full, the
+ * least recently used entry is replaced.
+ *
+ * The cache must be invalidated every time the calibration data is reloaded.
+ *
+ * @tparam T: type of the record holding the calibration parameters.
+ * @tparam N: number of cache entries.
+ */
+template < typename T, size_t N >
+class CalibCache
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    CalibCache()
+    {
+        invalidate();
+    }
+
+    /**
+     * Drop all the cached records.
+     */
+    void invalidate()
+    {
+        for(size_t i = 0; i < N; i++)
+            entries[i].valid = false;
+
+        useCount = 0;
+    }
+
+    /**
+     * Get the calibration record for a given frequency. In case of cache miss,
+     * the record is computed by calling the provided function.
+     * The returned reference is valid only until the next call to get().
+     *
+     * @param freq: frequency, in Hz.
+     * @param compute: function computing the record for a given frequency,
+     * with signature void(const freq_t freq, T& record).
+     * @return a reference to the calibration record.
+     */
+    template < typename F >
+    const T& get(const freq_t freq, F compute)
+    {
+        size_t victim = 0;
+
+        for(size_t i = 0; i < N; i++)
+        {
+            Entry& entry = entries[i];
+
+            if(entry.valid && (entry.freq == freq))
+            {
+                entry.lastUse = ++useCount;
+                return entry.data;
+            }
+
+            // Free entries have priority, then the least recently used one
+            if(entries[victim].valid &&
+               ((entry.valid == false) || (entry.lastUse < entries[victim].lastUse)))
+                victim = i;
+        }
+
+        Entry& entry  = entries[victim];
+        entry.freq    = freq;
+        entry.lastUse = ++useCount;
+        entry.valid   = true;
+        compute(freq, entry.data);
+
+        return entry.data;
+    }
+
+private:
+
+    struct Entry
+    {
+        T        data;      ///< Calibration record
+        freq_t   freq;      ///< Frequency of the record
+        uint32_t lastUse;   ///< Value of the use counter at last access
+        bool     valid;     ///< Entry holds a valid record
+    };
+
+    Entry    entries[N];    ///< Cache entries
+    uint32_t useCount;      ///< Access counter, for LRU replacement
+};
+
+#endif /* CALIB_CACHE_H */
@@ -16,9 +16,11 @@
 #include "hwconfig.h"
 #include <algorithm>
 #include "core/utils.h"
+#include "core/rssi.h"
 #include "drivers/baseband/HR_C6000.h"
 #include "drivers/baseband/SKY72310.h"
 #include "drivers/baseband/AK2365A.h"
+#include "calibCache.h"
 
 #ifdef PLATFORM_CS7000P
 #define DAC     DAC1
@@ -29,13 +31,40 @@ static constexpr freq_t IF_FREQ = 49950000;    // Intermediate frequency: 49.95M
 
 static const rtxStatus_t  *config;             // Pointer to data structure with radio configuration
 static struct CS7000Calib calData;             // Calibration data
-static uint8_t vtune_rx  = 0;                  // Tuning voltage for RX input filter
 static uint8_t txpwr_lo  = 0;                  // APC voltage for TX output power control, low power
 static uint8_t txpwr_hi  = 0;                  // APC voltage for TX output power control, high power
-static struct rssiParams rssi;                 // RSSI curve parameters
 
 static enum opstatus radioStatus;               // Current operating status
 
+/*
+ * Calibration parameters interpolated for a given frequency.
+ */
+struct calParams
+{
+    uint8_t    vtune;    // Tuning voltage for RX input filter
+    uint8_t    txpwrLo;  // APC voltage for TX output power control, low power
+    uint8_t    txpwrHi;  // APC voltage for TX output power control, high power
+    uint8_t    qAmp;     // HR_C6000 Mod2 amplitude
+    uint8_t    iAmp;     // HR_C6000 Mod1 amplitude
+    rssiConv_t rssi;     // RSSI conversion parameters
+};
+
+/*
+ * Calibration-derived parameters of the RX stage for a given frequency.
+ */
+struct rxParams
+{
+    freq_t     freq;     // RX frequency
+    uint8_t    vtune;    // Tuning voltage for RX input filter
+    rssiConv_t rssi;     // RSSI conversion parameters
+};
+
+static CalibCache< calParams, 8 > calCache;     // Interpolated calibration parameters
+static CalibCache< rxParams, RADIO_RETUNE_CACHE_SIZE > rxCache; // RX parameters, retune frequencies
+static struct rxParams rxMain;                  // RX parameters, main frequency
+static struct rxParams rxAlt;                   // RX parameters, last retune frequency
+static const struct rxParams *rxCurr = &rxMain; // RX parameters currently in use
+
 static int16_t __attribute__((section(".bss2"))) ctcssSamples[128];
 static streamCtx ctcssCtx;
 static int16_t *prevCtcssBuf;
@@ -47,17 +76,19 @@ static CtcssDetector ctcss(ctcssCoeffs2k, (CTCSS_SAMPLE_RATE / 4), 20.0f);
  * going from -121dBm to -63dBm.
  * Thanks to Wojciech SP5WWP for the measurements!
  *
+ * Slope is expressed in 10^-6 dB/mV, offset in 0.1dBm.
+ *
  * NOTE: there are seven calibration points over eight RX frequencies.
  */
-static const struct rssiParams rssiCal[] =
-{   //  slope        offset     rxFreq
-    {0.0370f, -138.76814f, 400250000 },    // 400.250MHz
-    {0.0371f, -135.07381f, 425050000 },    // 425.050MHz
-    {0.0372f, -136.61596f, 449950000 },    // 449.950MHz
-    {0.0375f, -136.87895f, 460050000 },    // 460.050MHz
-    {0.0374f, -136.56000f, 470050000 },    // 470.050MHz
-    {0.0374f, -136.34097f, 478985000 },    // 478.985MHz
-    {0.0372f, -135.62165f, 479050000 }     // 479.050MHz
+static const rssiCalPoint_t rssiCal[] =
+{   //  rxFreq    slope  offset
+    {400250000, 37000, -1388},     // 400.250MHz
+    {425050000, 37100, -1351},     // 425.050MHz
+    {449950000, 37200, -1366},     // 449.950MHz
+    {460050000, 37500, -1369},     // 460.050MHz
+    {470050000, 37400, -1366},     // 470.050MHz
+    {478985000, 37400, -1363},     // 478.985MHz
+    {479050000, 37200, -1356}      // 479.050MHz
 };
 
 static uint8_t interpParameter(uint32_t freq, uint32_t *calFreq, uint8_t param[8])
@@ -103,34 +134,42 @@ static uint8_t interpParameter(uint32_t freq, uint32_t *calFreq, uint8_t param[8
     return ret;
 }
 
-static struct rssiParams interpRssi(const uint32_t freq, const struct rssiParams cal[7])
+static void computeCalParams(const freq_t freq, struct calParams& params)
 {
-    if(freq < cal[0].rxFreq)
-        return cal[0];
+    params.vtune   = interpParameter(freq, calData.rxCalFreq, calData.rxSensitivity);
+    params.txpwrLo = interpParameter(freq, calData.txCalFreq, calData.txMiddlePwr);
+    params.txpwrHi = interpParameter(freq, calData.txCalFreq, calData.txHighPwr);
+    params.qAmp    = interpParameter(freq, calData.txCalFreq, calData.txDigitalPathQ);
+    params.iAmp    = interpParameter(freq, calData.txCalFreq, calData.txAnalogPathI);
+    rssi_computeConversion(&params.rssi, rssiCal, 7, freq, adc1.countsTouV);
+}
 
-    if(freq > cal[6].rxFreq)
-        return cal[6];
+static void loadRxParams(struct rxParams *params, const freq_t freq)
+{
+    const struct calParams& cal = calCache.get(freq, computeCalParams);
 
-    uint8_t idx;
-    for(idx = 5; idx > 0; idx--)
-    {
-        if(freq >= cal[idx].rxFreq)
-            break;
-    }
+    params->freq  = freq;
+    params->vtune = cal.vtune;
+    params->rssi  = cal.rssi;
+}
 
-    const struct rssiParams *calLo = &cal[idx];
-    const struct rssiParams *calHi = &cal[idx + 1];
+static void computeRxParams(const freq_t freq, struct rxParams& params)
+{
+    params.freq  = freq;
+    params.vtune = interpParameter(freq, calData.rxCalFreq, calData.rxSensitivity);
+    rssi_computeConversion(&params.rssi, rssiCal, 7, freq, adc1.countsTouV);
+}
 
-    float num   = ((float)(freq - calLo->rxFreq));
-    float den   = ((float)(calHi->rxFreq - calLo->rxFreq));
-    float offs  = calHi->offset - calLo->offset;
-    float slope = calHi->slope - calLo->slope;
+static void tuneRx(const struct rxParams *params)
+{
+    // Set PLL frequency
+    uint32_t pllFreq = params->freq - IF_FREQ;
+    SKY73210_setFrequency(&pll, pllFreq, 3);
 
-    struct rssiParams result;
-    result.offset = calLo->offset + ((offs * num) / den);
-    result.slope  = calLo->slope  + ((slope * num) / den);
+    // Set input filter tune voltage
+    DAC->DHR8R1 = params->vtune;
 
-    return result;
+    rxCurr = params;
 }
 
 void radio_init(const rtxStatus_t *rtxState)
@@ -182,6 +221,8 @@ void radio_init(const rtxStatus_t *rtxState)
      * Load calibration data
      */
     nvm_readCalibData(&calData);
+    calCache.invalidate();
+    rxCache.invalidate();
 
     /*
      * Enable and configure PLL, wait 1ms to ensure that VCXO is stable
@@ -276,12 +317,8 @@ void radio_enableRx()
     gpioDev_set(CTCSS_AMP_EN);    // Enable CTCSS filter/amplifier
     gpioDev_set(DET_PDN);         // Enable FM detector
 
-    // Set PLL frequency
-    uint32_t pllFreq = config->rxFrequency - IF_FREQ;
-    SKY73210_setFrequency(&pll, pllFreq, 3);
-
-    // Set input filter tune voltage
-    DAC->DHR8R1  = vtune_rx;
+    // Set PLL frequency and input filter tune voltage
+    tuneRx(&rxMain);
 
     // Enable RX LNA and first IF stage
     gpioDev_set(RX_PWR_EN);
@@ -297,6 +334,23 @@ void radio_enableRx()
     radioStatus = RX;
 }
 
+void radio_retuneRx(const freq_t freq)
+{
+    if(radioStatus != RX)
+        return;
+
+    if(freq == rxMain.freq)
+    {
+        tuneRx(&rxMain);
+        return;
+    }
+
+    if(freq != rxAlt.freq)
+        rxAlt = rxCache.get(freq, computeRxParams);
+
+    tuneRx(&rxAlt);
+}
+
 void radio_enableTx()
 {
     if(config->txDisable == 1)
@@ -374,21 +428,17 @@ void radio_disableRtx()
 
 void radio_updateConfiguration()
 {
-    // Tuning voltage for RX input filter
-    vtune_rx = interpParameter(config->rxFrequency, calData.rxCalFreq, calData.rxSensitivity);
+    // Tuning voltage for RX input filter and RSSI interpolation curve
+    loadRxParams(&rxMain, config->rxFrequency);
 
     // APC voltage for TX output power control
-    txpwr_lo = interpParameter(config->txFrequency, calData.txCalFreq, calData.txMiddlePwr);
-    txpwr_hi = interpParameter(config->txFrequency, calData.txCalFreq, calData.txHighPwr);
+    const struct calParams& txCal = calCache.get(config->txFrequency, computeCalParams);
+    txpwr_lo = txCal.txpwrLo;
+    txpwr_hi = txCal.txpwrHi;
 
     // HR_C6000 modulation amplitude
-    uint8_t qAmp = interpParameter(config->txFrequency, calData.txCalFreq, calData.txDigitalPathQ);
-    uint8_t iAmp = interpParameter(config->txFrequency, calData.txCalFreq, calData.txAnalogPathI);
-    C6000.writeCfgRegister(0x45, qAmp);   // Adjustment of Mod2 amplitude
-    C6000.writeCfgRegister(0x46, iAmp);   // Adjustment of Mod1 amplitude
-
-    // RSSI interpolation curve
-    rssi = interpRssi(config->rxFrequency, rssiCal);
+    C6000.writeCfgRegister(0x45, txCal.qAmp);   // Adjustment of Mod2 amplitude
+    C6000.writeCfgRegister(0x46, txCal.iAmp);   // Adjustment of Mod1 amplitude
 
     /*
      * Update VCO frequency and tuning parameters if current operating status
@@ -407,9 +457,8 @@ rssi_t radio_getRssi()
      * (AK2365 IC). The corresponding power value is obtained through the linear
      * correlation existing between measured voltage in mV and power in dBm.
      */
-    float rssi_mv  = ((float) adc_getVoltage(&adc1, ADC_RSSI_CH)) / 1000.0f;
-    float rssi_dbm = (rssi_mv * rssi.slope) + rssi.offset;
-    return static_cast< rssi_t >(rssi_dbm);
+    uint16_t counts = adc_getRawSample(&adc1, ADC_RSSI_CH);
+    return rssi_toDbm(rssi_convert(&rxCurr->rssi, counts));
 }
 
 enum opstatus radio_getStatus()
@@ -15,6 +15,7 @@
 #include "radioUtils.h"
 #include "drivers/baseband/HR_C6000.h"
 #include "drivers/baseband/AT1846S.h"
+#include "calibCache.h"
 
 static const rtxStatus_t *config;                // Pointer to data structure with radio configuration
 
@@ -25,9 +26,76 @@ static uint16_t apcVoltage = 0;                  // APC voltage for TX output po
 
 static enum opstatus radioStatus;                // Current operating status
 
+/*
+ * Calibration parameters interpolated for a given frequency.
+ */
+struct calParams
+{
+    Band    band;       // Band of the frequency
+    uint8_t sqlTresh;   // Analog squelch threshold
+    uint8_t txpwrLo;    // APC voltage for TX output power control, low power
+    uint8_t txpwrHi;    // APC voltage for TX output power control, high power
+    uint8_t mod1Amp;    // HR_C6000 mod1 amplitude
+};
+
+static CalibCache< calParams, 8 > calCache;      // Interpolated calibration parameters
+
 static HR_C6000 C6000(&c6000_spi, { DMR_CS });   // HR_C6000 driver
 static AT1846S& at1846s = AT1846S::instance();   // AT1846S driver
 
+static void _computeCalParams(const freq_t freq, struct calParams& params)
+{
+    params.band = getBandFromFrequency(freq);
+    if(params.band == BND_NONE)
+        return;
+
+    const bandCalData_t *cal = &(calData.data[params.band]);
+
+    if(params.band == BND_VHF)
+    {
+        params.sqlTresh = interpCalParameter(freq, calData.vhfCalPoints,
+                                             cal->analogSqlThresh, 8);
+        params.txpwrLo  = interpCalParameter(freq, calData.vhfCalPoints,
+                                             cal->txLowPower, 8);
+        params.txpwrHi  = interpCalParameter(freq, calData.vhfCalPoints,
+                                             cal->txHighPower, 8);
+        params.mod1Amp  = interpCalParameter(freq, calData.vhfCalPoints,
+                                             cal->mod1Amplitude, 8);
+    }
+    else
+    {
+        params.sqlTresh = interpCalParameter(freq, calData.uhfCalPoints,
+                                             cal->analogSqlThresh, 8);
+        params.txpwrLo  = interpCalParameter(freq, calData.uhfPwrCalPoints,
+                                             cal->txLowPower, 16);
+        params.txpwrHi  = interpCalParameter(freq, calData.uhfPwrCalPoints,
+                                             cal->txHighPower, 16);
+        params.mod1Amp  = interpCalParameter(freq, calData.uhfCalPoints,
+                                             cal->mod1Amplitude, 8);
+    }
+}
+
+static void _tuneRx(const freq_t freq, const Band band)
+{
+    // Adjust reference oscillator bias and offset.
+    C6000.writeCfgRegister(0x04, calData.data[band].mod2Offset);
+    C6000.setModOffset(calData.data[band].modBias);
+
+    // Set frequency and select the RX LNA
+    at1846s.setFrequency(freq);
+
+    if(band == BND_VHF)
+    {
+        gpio_clearPin(UHF_LNA_EN);
+        gpio_setPin(VHF_LNA_EN);
+    }
+    else
+    {
+        gpio_clearPin(VHF_LNA_EN);
+        gpio_setPin(UHF_LNA_EN);
+    }
+}
+
 void radio_init(const rtxStatus_t *rtxState)
 {
     config      = rtxState;
@@ -69,6 +137,7 @@ void radio_init(const rtxStatus_t *rtxState)
      * Load calibration data
      */
     nvm_readCalibData(&calData);
+    calCache.invalidate();
 
     /*
      * Enable and configure both AT1846S and HR_C6000, keep AF output disabled
@@ -140,24 +209,10 @@ void radio_enableRx()
 
     if(currRxBand == BND_NONE) return;
 
-    // Adjust reference oscillator bias and offset.
-    C6000.writeCfgRegister(0x04, calData.data[currRxBand].mod2Offset);
-    C6000.setModOffset(calData.data[currRxBand].modBias);
-
-    // Set frequency and enable AT1846S RX
-    at1846s.setFrequency(config->rxFrequency);
+    // Set frequency, enable RX LNA and AT1846S RX
+    _tuneRx(config->rxFrequency, currRxBand);
     at1846s.setFuncMode(AT1846S_FuncMode::RX);
 
-    // Enable RX LNA
-    if(currRxBand == BND_VHF)
-    {
-        gpio_setPin(VHF_LNA_EN);
-    }
-    else
-    {
-        gpio_setPin(UHF_LNA_EN);
-    }
-
     radioStatus = RX;
 
     if(config->rxToneEn)
@@ -166,6 +221,23 @@ void radio_enableRx()
     }
 }
 
+void radio_retuneRx(const freq_t freq)
+{
+    if(radioStatus != RX)
+        return;
+
+    // Calibration parameters of the RX stage depend only on the band, no
+    // interpolation is needed
+    Band band = currRxBand;
+    if(freq != config->rxFrequency)
+        band = getBandFromFrequency(freq);
+
+    if(band == BND_NONE)
+        return;
+
+    _tuneRx(freq, band);
+}
+
 void radio_enableTx()
 {
     if(config->txDisable == 1) return;
@@ -261,18 +333,7 @@ void radio_updateConfiguration()
 
     C6000.writeCfgRegister(0x37, cal->digAudioGain);    // DACDATA gain
 
-    uint8_t sqlTresh = 0;
-    if(currRxBand == BND_VHF)
-    {
-        sqlTresh = interpCalParameter(config->rxFrequency, calData.vhfCalPoints,
-                                      cal->analogSqlThresh, 8);
-    }
-    else
-    {
-        sqlTresh = interpCalParameter(config->rxFrequency, calData.uhfCalPoints,
-                                      cal->analogSqlThresh, 8);
-    }
-
+    uint8_t sqlTresh = calCache.get(config->rxFrequency, _computeCalParams).sqlTresh;
     at1846s.setAnalogSqlThresh(sqlTresh);
 
     /*
@@ -283,36 +344,12 @@ void radio_updateConfiguration()
     at1846s.setAgcGain(calData.data[currTxBand].rxAGCgain);
     at1846s.setPaDrive(calData.data[currTxBand].PA_drv);
 
-    uint8_t mod1Amp  = 0;
-    uint8_t txpwr_lo = 0;
-    uint8_t txpwr_hi = 0;
-
-    if(currTxBand == BND_VHF)
-    {
-        /* VHF band */
-        txpwr_lo = interpCalParameter(config->txFrequency, calData.vhfCalPoints,
-                                      calData.data[currTxBand].txLowPower, 8);
-
-        txpwr_hi = interpCalParameter(config->txFrequency, calData.vhfCalPoints,
-                                      calData.data[currTxBand].txHighPower, 8);
-
-        mod1Amp = interpCalParameter(config->txFrequency, calData.vhfCalPoints,
-                                     cal->mod1Amplitude, 8);
-    }
-    else
-    {
-        /* UHF band */
-        txpwr_lo = interpCalParameter(config->txFrequency, calData.uhfPwrCalPoints,
-                                      calData.data[currTxBand].txLowPower, 16);
-
-        txpwr_hi = interpCalParameter(config->txFrequency, calData.uhfPwrCalPoints,
-                                      calData.data[currTxBand].txHighPower, 16);
-
-        mod1Amp = interpCalParameter(config->txFrequency, calData.uhfCalPoints,
-                                     cal->mod1Amplitude, 8);
-    }
+    const struct calParams& txCal = calCache.get(config->txFrequency,
+                                                 _computeCalParams);
+    uint8_t txpwr_lo = txCal.txpwrLo;
+    uint8_t txpwr_hi = txCal.txpwrHi;
 
-    C6000.setModAmplitude(0, mod1Amp);
+    C6000.setModAmplitude(0, txCal.mod1Amp);
 
     // Calculate APC voltage, constraining output power between 1W and 5W.
     float power  = static_cast < float >(config->txPower) / 1000.0f;
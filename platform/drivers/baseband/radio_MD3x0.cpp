@@ -14,8 +14,10 @@
 #include "hwconfig.h"
 #include <algorithm>
 #include "core/utils.h"
+#include "core/rssi.h"
 #include "drivers/baseband/HR_C5000.h"
 #include "drivers/baseband/SKY72310.h"
+#include "calibCache.h"
 
 static const freq_t IF_FREQ = 49950000;         // Intermediate frequency: 49.95MHz
 
@@ -23,24 +25,72 @@ static const rtxStatus_t  *config;              // Pointer to data structure wit
 
 static md3x0Calib_t calData;                    // Calibration data
 static bool    isVhfBand = false;               // True if rtx stage is for VHF band
-static uint8_t vtune_rx  = 0;                   // Tuning voltage for RX input filter
 static uint8_t txpwr_lo  = 0;                   // APC voltage for TX output power control, low power
 static uint8_t txpwr_hi  = 0;                   // APC voltage for TX output power control, high power
 
 static enum opstatus radioStatus;               // Current operating status
 
+/*
+ * Calibration parameters interpolated for a given frequency.
+ */
+struct calParams
+{
+    uint8_t vtune;      // Tuning voltage for RX input filter
+    uint8_t txpwrLo;    // APC voltage for TX output power control, low power
+    uint8_t txpwrHi;    // APC voltage for TX output power control, high power
+    uint8_t modI[2];    // HR_C5000 I modulation amplitude, digital and analog
+    uint8_t modQ[2];    // HR_C5000 Q modulation amplitude, digital and analog
+    rssiConv_t rssi;    // RSSI conversion parameters
+};
+
+/*
+ * Calibration-derived parameters of the RX stage for a given frequency.
+ */
+struct rxParams
+{
+    freq_t  freq;       // RX frequency
+    uint8_t vtune;      // Tuning voltage for RX input filter
+    rssiConv_t rssi;    // RSSI conversion parameters
+};
+
+static CalibCache< calParams, 8 > calCache;     // Interpolated calibration parameters
+static CalibCache< rxParams, RADIO_RETUNE_CACHE_SIZE > rxCache; // RX parameters, retune frequencies
+static struct rxParams rxMain;                  // RX parameters, main frequency
+static struct rxParams rxAlt;                   // RX parameters, last retune frequency
+static const struct rxParams *rxCurr = &rxMain; // RX parameters currently in use
+
 static HR_C5000 C5000((const struct spiDevice *) &c5000_spi, { DMR_CS });
 
 /*
- * Parameters for RSSI voltage (mV) to input power (dBm) conversion.
- * Gain is constant, while offset values are aligned to calibration frequency
- * test points.
+ * Calibration points for RSSI voltage to input power (dBm) conversion, aligned
+ * to the calibration frequency test points. Slope is constant and corresponds
+ * to 22mV/dB, while offset varies with the frequency.
  * Thanks to Wojciech SP5WWP for the measurements!
+ *
+ * Each offset holds over a whole 10MHz band, as in the original conversion:
+ * the offset changes in a single step at the band edges, given by couples of
+ * points 1Hz apart so that the interpolation never blends two bands. The first
+ * offset applies below 410.035MHz and the last one above 479.995MHz.
  */
-const float rssi_gain = 22.0f;
-const float rssi_offset[] = {3277.618f, 3654.755f, 3808.191f,
-                             3811.318f, 3804.936f, 3806.591f,
-                             3723.882f, 3621.373f, 3559.782f};
+static const rssiCalPoint_t rssiCal[] =
+{   //  rxFreq    slope  offset
+    {410034999, 45455, -1490},
+    {410035000, 45455, -1661},     // 410.035MHz
+    {420034999, 45455, -1661},
+    {420035000, 45455, -1731},     // 420.035MHz
+    {430034999, 45455, -1731},
+    {430035000, 45455, -1732},     // 430.035MHz
+    {440034999, 45455, -1732},
+    {440035000, 45455, -1730},     // 440.035MHz
+    {450034999, 45455, -1730},
+    {450035000, 45455, -1730},     // 450.035MHz
+    {460034999, 45455, -1730},
+    {460035000, 45455, -1693},     // 460.035MHz
+    {470034999, 45455, -1693},
+    {470035000, 45455, -1646},     // 470.035MHz
+    {479995000, 45455, -1646},
+    {479995001, 45455, -1618}      // 479.995MHz
+};
 
 
 void _setBandwidth(const enum bandwidth bw)
@@ -66,6 +116,66 @@ void _setBandwidth(const enum bandwidth bw)
     }
 }
 
+static void _computeCalParams(const freq_t freq, struct calParams& params)
+{
+    params.vtune    = interpCalParameter(freq, calData.rxFreq,
+                                         calData.rxSensitivity, 9);
+    params.txpwrLo  = interpCalParameter(freq, calData.txFreq,
+                                         calData.txLowPower, 9);
+    params.txpwrHi  = interpCalParameter(freq, calData.txFreq,
+                                         calData.txHighPower, 9);
+    params.modI[0]  = interpCalParameter(freq, calData.txFreq,
+                                         calData.sendIrange, 9);
+    params.modQ[0]  = interpCalParameter(freq, calData.txFreq,
+                                         calData.sendQrange, 9);
+    params.modI[1]  = interpCalParameter(freq, calData.txFreq,
+                                         calData.analogSendIrange, 9);
+    params.modQ[1]  = interpCalParameter(freq, calData.txFreq,
+                                         calData.analogSendQrange, 9);
+    rssi_computeConversion(&params.rssi, rssiCal,
+                           sizeof(rssiCal) / sizeof(rssiCal[0]), freq,
+                           adc1.countsTouV);
+}
+
+static void _loadRxParams(struct rxParams *params, const freq_t freq)
+{
+    const struct calParams& cal = calCache.get(freq, _computeCalParams);
+
+    params->freq     = freq;
+    params->vtune    = cal.vtune;
+    params->rssi     = cal.rssi;
+}
+
+static void _computeRxParams(const freq_t freq, struct rxParams& params)
+{
+    params.freq  = freq;
+    params.vtune = interpCalParameter(freq, calData.rxFreq,
+                                      calData.rxSensitivity, 9);
+    rssi_computeConversion(&params.rssi, rssiCal,
+                           sizeof(rssiCal) / sizeof(rssiCal[0]), freq,
+                           adc1.countsTouV);
+}
+
+static void _tuneRx(const struct rxParams *params)
+{
+    // Set PLL frequency and filter tuning voltage
+    float pllFreq = static_cast< float >(params->freq);
+    if(isVhfBand)
+    {
+        pllFreq += static_cast< float >(IF_FREQ);
+        pllFreq *= 2.0f;
+    }
+    else
+    {
+        pllFreq -= static_cast< float >(IF_FREQ);
+    }
+
+    SKY73210_setFrequency(&pll, pllFreq, 5);
+    DAC->DHR12L1 = params->vtune * 0xFF;
+
+    rxCurr = params;
+}
+
 void radio_init(const rtxStatus_t *rtxState)
 {
     config      = rtxState;
@@ -113,6 +223,8 @@ void radio_init(const rtxStatus_t *rtxState)
      * Load calibration data
      */
     nvm_readCalibData(&calData);
+    calCache.invalidate();
+    rxCache.invalidate();
 
     /*
      * Enable and configure PLL and HR_C5000
@@ -202,23 +314,27 @@ void radio_enableRx()
     gpio_clearPin(RF_APC_SW);          // APC/TV used for RX filter tuning
     gpio_setPin(VCOVCC_SW);            // Enable RX VCO
 
-    // Set PLL frequency and filter tuning voltage
-    float pllFreq = static_cast< float >(config->rxFrequency);
-    if(isVhfBand)
-    {
-        pllFreq += static_cast< float >(IF_FREQ);
-        pllFreq *= 2.0f;
-    }
-    else
+    _tuneRx(&rxMain);                  // Set PLL frequency and filter tuning
+
+    gpio_setPin(RX_STG_EN);            // Enable RX LNA
+    radioStatus = RX;
+}
+
+void radio_retuneRx(const freq_t freq)
+{
+    if(radioStatus != RX)
+        return;
+
+    if(freq == rxMain.freq)
     {
-        pllFreq -= static_cast< float >(IF_FREQ);
+        _tuneRx(&rxMain);
+        return;
     }
 
-    SKY73210_setFrequency(&pll, pllFreq, 5);
-    DAC->DHR12L1 = vtune_rx * 0xFF;
+    if(freq != rxAlt.freq)
+        rxAlt = rxCache.get(freq, _computeRxParams);
 
-    gpio_setPin(RX_STG_EN);            // Enable RX LNA
-    radioStatus = RX;
+    _tuneRx(&rxAlt);
 }
 
 void radio_enableTx()
@@ -306,31 +422,18 @@ void radio_disableRtx()
 
 void radio_updateConfiguration()
 {
-    // Tuning voltage for RX input filter
-    vtune_rx = interpCalParameter(config->rxFrequency, calData.rxFreq,
-                                  calData.rxSensitivity, 9);
+    // Tuning voltage for RX input filter and RSSI offset
+    _loadRxParams(&rxMain, config->rxFrequency);
 
     // APC voltage for TX output power control
-    txpwr_lo = interpCalParameter(config->txFrequency, calData.txFreq,
-                                  calData.txLowPower, 9);
+    const struct calParams& txCal = calCache.get(config->txFrequency,
+                                                 _computeCalParams);
+    txpwr_lo = txCal.txpwrLo;
+    txpwr_hi = txCal.txpwrHi;
 
-    txpwr_hi = interpCalParameter(config->txFrequency, calData.txFreq,
-                                  calData.txHighPower, 9);
-
-    // HR_C5000 modulation amplitude
-    const uint8_t *Ical = calData.sendIrange;
-    const uint8_t *Qcal = calData.sendQrange;
-
-    if(config->opMode == OPMODE_FM)
-    {
-        Ical = calData.analogSendIrange;
-        Qcal = calData.analogSendQrange;
-    }
-
-    uint8_t I = interpCalParameter(config->txFrequency, calData.txFreq, Ical, 9);
-    uint8_t Q = interpCalParameter(config->txFrequency, calData.txFreq, Qcal, 9);
-
-    C5000.setModAmplitude(I, Q);
+    // HR_C5000 modulation amplitude, analog values for FM mode
+    uint8_t modIdx = (config->opMode == OPMODE_FM) ? 1 : 0;
+    C5000.setModAmplitude(txCal.modI[modIdx], txCal.modQ[modIdx]);
 
     // Set bandwidth, only for analog FM mode
     if(config->opMode == OPMODE_FM)
@@ -359,19 +462,13 @@ rssi_t radio_getRssi()
      * On MD3x0 devices, RSSI value is get by reading the analog RSSI output
      * from second IF stage (GT3136 IC).
      * The corresponding power value is obtained through the linear correlation
-     * existing between measured voltage in mV and power in dBm. While gain is
-     * constant, offset depends from the rx frequency.
+     * existing between measured voltage in mV and power in dBm. The conversion
+     * parameters, depending from the currently tuned rx frequency, are already
+     * scaled to raw ADC counts.
      */
 
-    freq_t rxFreq = config->rxFrequency;
-    uint32_t offset_index = (rxFreq - 400035000)/10000000;
-
-    if(rxFreq < 401035000) offset_index = 0;
-    if(rxFreq > 479995000) offset_index = 8;
-
-    float rssi_mv  = ((float) adc_getVoltage(&adc1, ADC_RSSI_CH)) / 1000.0f;
-    float rssi_dbm = (rssi_mv - rssi_offset[offset_index]) / rssi_gain;
-    return static_cast< rssi_t >(rssi_dbm);
+    uint16_t counts = adc_getRawSample(&adc1, ADC_RSSI_CH);
+    return rssi_toDbm(rssi_convert(&rxCurr->rssi, counts));
 }
 
 enum opstatus radio_getStatus()
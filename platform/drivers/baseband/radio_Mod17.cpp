@@ -65,6 +65,12 @@ void radio_enableRx()
         gpio_clearPin(PTT_OUT);
 }
 
+void radio_retuneRx(const freq_t freq)
+{
+    // No RF stage on Module17
+    (void) freq;
+}
+
 void radio_enableTx()
 {
     radioStatus = TX;
@@ -15,6 +15,7 @@
 #include "radioUtils.h"
 #include "drivers/baseband/HR_C6000.h"
 #include "drivers/baseband/AT1846S.h"
+#include "calibCache.h"
 
 
 static const rtxStatus_t *config;                // Pointer to data structure with radio configuration
@@ -29,9 +30,85 @@ static uint8_t txModBias  = 0;                   // VCXO bias for TX
 
 static enum opstatus radioStatus;                // Current operating status
 
+/*
+ * Calibration parameters interpolated for a given frequency.
+ */
+struct calParams
+{
+    Band    band;       // Band of the frequency
+    uint8_t modBias;    // VCXO bias
+    uint8_t txpwrLo;    // APC voltage for TX output power control, low power
+    uint8_t txpwrHi;    // APC voltage for TX output power control, high power
+    uint8_t modQ[2];    // HR_C6000 Q modulation amplitude, digital and analog
+};
+
+/*
+ * Calibration-derived parameters of the RX stage for a given frequency.
+ */
+struct rxParams
+{
+    freq_t  freq;       // RX frequency
+    Band    band;       // RX band
+    uint8_t modBias;    // VCXO bias for RX
+};
+
+static CalibCache< calParams, 8 > calCache;      // Interpolated calibration parameters
+static struct rxParams rxAlt = {0, BND_NONE, 0}; // RX parameters, last retune frequency
+
 HR_C6000 C6000((const struct spiDevice *) &c6000_spi, { DMR_CS }); // HR_C6000 driver
 static AT1846S& at1846s = AT1846S::instance();   // AT1846S driver
 
+static void _computeCalParams(const freq_t freq, struct calParams& params)
+{
+    params.band = getBandFromFrequency(freq);
+
+    uint8_t calPoints         = 5;
+    const struct CalData *cal = &calData.vhfCal;
+    if(params.band == BND_UHF)
+    {
+        calPoints = 9;
+        cal       = &calData.uhfCal;
+    }
+
+    params.modBias = cal->freqAdjustMid;
+    params.txpwrLo = interpCalParameter(freq, cal->txFreq, cal->txLowPower,
+                                        calPoints);
+    params.txpwrHi = interpCalParameter(freq, cal->txFreq, cal->txHighPower,
+                                        calPoints);
+    params.modQ[0] = interpCalParameter(freq, cal->txFreq, cal->sendQrange,
+                                        calPoints);
+    params.modQ[1] = interpCalParameter(freq, cal->txFreq, cal->analogSendQrange,
+                                        calPoints);
+}
+
+static void _loadRxParams(struct rxParams *params, const freq_t freq)
+{
+    // RX parameters depend only on the band, no interpolation is needed
+    params->freq    = freq;
+    params->band    = getBandFromFrequency(freq);
+    params->modBias = calData.vhfCal.freqAdjustMid;
+
+    if(params->band == BND_UHF)
+        params->modBias = calData.uhfCal.freqAdjustMid;
+}
+
+static void _tuneRx(const freq_t freq, const Band band, const uint8_t modBias)
+{
+    C6000.setModOffset(modBias);
+    at1846s.setFrequency(freq);
+
+    if(band == BND_VHF)
+    {
+        gpio_clearPin(UHF_LNA_EN);
+        gpio_setPin(VHF_LNA_EN);
+    }
+    else
+    {
+        gpio_clearPin(VHF_LNA_EN);
+        gpio_setPin(UHF_LNA_EN);
+    }
+}
+
 void radio_init(const rtxStatus_t *rtxState)
 {
     config      = rtxState;
@@ -71,6 +148,7 @@ void radio_init(const rtxStatus_t *rtxState)
      * Load calibration data
      */
     nvm_readCalibData(&calData);
+    calCache.invalidate();
 
     /*
      * Initialize AT1846S keep AF output disabled at power on.
@@ -152,19 +230,9 @@ void radio_enableRx()
 
     if(currRxBand == BND_NONE) return;
 
-    C6000.setModOffset(rxModBias);
-    at1846s.setFrequency(config->rxFrequency);
+    _tuneRx(config->rxFrequency, currRxBand, rxModBias);
     at1846s.setFuncMode(AT1846S_FuncMode::RX);
 
-    if(currRxBand == BND_VHF)
-    {
-        gpio_setPin(VHF_LNA_EN);
-    }
-    else
-    {
-        gpio_setPin(UHF_LNA_EN);
-    }
-
     if(config->rxToneEn)
     {
         at1846s.enableRxCtcss(config->rxTone);
@@ -173,6 +241,26 @@ void radio_enableRx()
     radioStatus = RX;
 }
 
+void radio_retuneRx(const freq_t freq)
+{
+    if(radioStatus != RX)
+        return;
+
+    if(freq == config->rxFrequency)
+    {
+        _tuneRx(freq, currRxBand, rxModBias);
+        return;
+    }
+
+    if(freq != rxAlt.freq)
+        _loadRxParams(&rxAlt, freq);
+
+    if(rxAlt.band == BND_NONE)
+        return;
+
+    _tuneRx(rxAlt.freq, rxAlt.band, rxAlt.modBias);
+}
+
 void radio_enableTx()
 {
     if(config->txDisable == 1) return;
@@ -277,40 +365,19 @@ void radio_updateConfiguration()
      * VCXO bias voltage, separated values for TX and RX to allow for cross-band
      * operation.
      */
-    txModBias = calData.vhfCal.freqAdjustMid;
-    rxModBias = calData.vhfCal.freqAdjustMid;
-    if(currRxBand == BND_UHF) rxModBias = calData.uhfCal.freqAdjustMid;
-    if(currTxBand == BND_UHF) txModBias = calData.uhfCal.freqAdjustMid;
-
-    uint8_t calPoints    = 5;
-    freq_t  *txCalPoints = calData.vhfCal.txFreq;
-    uint8_t *loPwrCal    = calData.vhfCal.txLowPower;
-    uint8_t *hiPwrCal    = calData.vhfCal.txHighPower;
-    uint8_t *qRangeCal   = (config->opMode == OPMODE_FM)
-                         ? calData.vhfCal.analogSendQrange
-                         : calData.vhfCal.sendQrange;
-
-    if(currTxBand == BND_UHF)
-    {
-        calPoints   = 9;
-        txCalPoints = calData.uhfCal.txFreq;
-        loPwrCal    = calData.uhfCal.txLowPower;
-        hiPwrCal    = calData.uhfCal.txHighPower;
-        qRangeCal   = (config->opMode == OPMODE_FM)
-                    ? calData.uhfCal.analogSendQrange
-                    : calData.uhfCal.sendQrange;
-    }
+    rxModBias = calCache.get(config->rxFrequency, _computeCalParams).modBias;
+
+    const struct calParams& txCal = calCache.get(config->txFrequency,
+                                                 _computeCalParams);
+    txModBias = txCal.modBias;
 
     // APC voltage for TX output power control
-    txpwr_lo = interpCalParameter(config->txFrequency, txCalPoints, loPwrCal,
-                                                                    calPoints);
-    txpwr_hi = interpCalParameter(config->txFrequency, txCalPoints, hiPwrCal,
-                                                                    calPoints);
-
-    // HR_C6000 modulation amplitude
-    uint8_t Q = interpCalParameter(config->txFrequency, txCalPoints, qRangeCal,
-                                                                     calPoints);
-    C6000.setModAmplitude(0, Q);
+    txpwr_lo = txCal.txpwrLo;
+    txpwr_hi = txCal.txpwrHi;
+
+    // HR_C6000 modulation amplitude, analog value for FM mode
+    uint8_t modIdx = (config->opMode == OPMODE_FM) ? 1 : 0;
+    C6000.setModAmplitude(0, txCal.modQ[modIdx]);
 
     // Set bandwidth, only for analog FM mode
     if(config->opMode == OPMODE_FM)
@@ -7,11 +7,16 @@
 #include "emulator/emulator.h"
 #include "interfaces/radio.h"
 #include <cstdio>
+#include <cstdlib>
 #include <string>
 
+static const rtxStatus_t *config;   // Pointer to data structure with radio configuration
+static freq_t tunedFreq;            // Frequency the emulated receiver is tuned to
+
 void radio_init(const rtxStatus_t *rtxState)
 {
-    (void) rtxState;
+    config    = rtxState;
+    tunedFreq = 0;
     puts("radio_linux: init() called");
 }
 
@@ -40,6 +45,13 @@ bool radio_checkRxDigitalSquelch()
 void radio_enableRx()
 {
     puts("radio_linux: enableRx() called");
+    tunedFreq = config->rxFrequency;
+}
+
+void radio_retuneRx(const freq_t freq)
+{
+//     printf("radio_linux: retuneRx(), frequency %u\n", freq);
+    tunedFreq = freq;
 }
 
 void radio_enableTx()
@@ -55,13 +67,30 @@ void radio_disableRtx()
 void radio_updateConfiguration()
 {
     puts("radio_linux: updateConfiguration() called");
+    tunedFreq = config->rxFrequency;
 }
 
 rssi_t radio_getRssi()
 {
     // Commented to reduce verbosity on Linux
     // printf("radio_linux: requested RSSI at freq %d, returning -100dBm\n", rxFreq);
-    return static_cast< rssi_t >(emulator_state.RSSI);
+
+    /*
+     * The emulated signal set by the RSSI knob is present on the configured
+     * RX frequency. When the receiver is tuned elsewhere, as during a spectrum
+     * sweep, its level decreases by 6dB every 12.5kHz of offset down to the
+     * noise floor.
+     */
+    int32_t offset = std::abs(static_cast< int32_t >(tunedFreq - config->rxFrequency));
+    float   rssi   = emulator_state.RSSI;
+    if(offset != 0)
+    {
+        rssi -= 6.0f * (offset / 12500);
+        if(rssi < -127.0f)
+            rssi = -127.0f;
+    }
+
+    return static_cast< rssi_t >(rssi);
 }
 
 enum opstatus radio_getStatus()
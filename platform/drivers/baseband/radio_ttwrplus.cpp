@@ -104,6 +104,14 @@ void radio_enableRx()
     radioStatus = RX;
 }
 
+void radio_retuneRx(const freq_t freq)
+{
+    if(radioStatus != RX) return;
+    if(getBandFromFrequency(freq) == BND_NONE) return;
+
+    at1846s.setFrequency(freq);
+}
+
 void radio_enableTx()
 {
     if(config->txDisable == 1) return;
@@ -78,12 +78,55 @@
 
 using namespace miosix;
 static Thread *lcdWaiting = 0;
+static volatile bool    renderBusy = false;   /* Render in progress           */
+static display_done_cb  doneCb     = NULL;    /* Completion callback          */
+static void            *doneArg    = NULL;    /* Completion callback argument */
+static uint16_t        *swapFb     = NULL;    /* Byte swapped framebuffer     */
+static uint8_t          swapStart  = 0;       /* First byte swapped row       */
+static uint8_t          swapEnd    = 0;       /* End of byte swapped rows     */
+
+/**
+ * \internal
+ * Swap the byte order of the pixels in a section of the framebuffer.
+ *
+ * @param fb: pointer to framebuffer.
+ * @param startRow: first row of the section.
+ * @param endRow: end row of the section, excluded.
+ */
+static void swapRows(uint16_t *fb, uint8_t startRow, uint8_t endRow)
+{
+    size_t start = startRow * CONFIG_SCREEN_WIDTH;
+    size_t end   = endRow   * CONFIG_SCREEN_WIDTH;
+
+    for(size_t pos = start; pos < end; pos++)
+        fb[pos] = __builtin_bswap16(fb[pos]);
+}
 
 void __attribute__((used)) DmaImpl()
 {
     DMA2->HIFCR |= DMA_HIFCR_CTCIF7 | DMA_HIFCR_CTEIF7;    /* Clear flags */
     gpio_setPin(LCD_CS);
 
+    /*
+     * Restore the pixel byte order: the UI keeps drawing on the same
+     * framebuffer and only repaints the widgets that changed, the other
+     * pixels have to be left as they were.
+     */
+    if(swapFb != NULL)
+    {
+        swapRows(swapFb, swapStart, swapEnd);
+        swapFb = NULL;
+    }
+
+    renderBusy = false;
+
+    if(doneCb != NULL)
+    {
+        display_done_cb cb = doneCb;
+        doneCb = NULL;
+        cb(doneArg);
+    }
+
     if(lcdWaiting == 0) return;
     lcdWaiting->IRQwakeup();
     if(lcdWaiting->IRQgetPriority()>Thread::IRQgetCurrentThread()->IRQgetPriority())
@@ -98,6 +141,25 @@ void __attribute__((naked)) DMA2_Stream7_IRQHandler()
     restoreContext();
 }
 
+/**
+ * \internal
+ * Put the calling thread in waiting status until the render in progress, if
+ * any, is completed.
+ */
+static void waitRender()
+{
+    FastInterruptDisableLock dLock;
+    while(renderBusy)
+    {
+        lcdWaiting = Thread::IRQgetCurrentThread();
+        Thread::IRQwait();
+        {
+            FastInterruptEnableLock eLock(dLock);
+            Thread::yield();
+        }
+    }
+}
+
 static inline __attribute__((__always_inline__)) void writeCmd(uint8_t cmd)
 {
     *((volatile uint8_t*) LCD_FSMC_ADDR_COMMAND) = cmd;
@@ -404,12 +466,23 @@ void display_terminate()
     /* Shut down backlight */
     backlight_terminate();
 
+    /* Wait for the end of any render in progress */
+    waitRender();
+
     /* Shut off FSMC and deallocate framebuffer */
     RCC->AHB3ENR &= ~RCC_AHB3ENR_FSMCEN;
     __DSB();
 }
 
-void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
+/**
+ * \internal
+ * Start the DMA transfer of a framebuffer section to the display.
+ *
+ * @param startRow: first row of the framebuffer section to be copied.
+ * @param endRow: end row of the framebuffer section to be copied, excluded.
+ * @param fb: pointer to framebuffer.
+ */
+static void startRender(uint8_t startRow, uint8_t endRow, void *fb)
 {
     /*
      * Put screen data lines back to alternate function mode, since they are in
@@ -424,6 +497,11 @@ void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
     gpio_setMode(LCD_D6, ALTERNATE | ALTERNATE_FUNC(12));
     gpio_setMode(LCD_D7, ALTERNATE | ALTERNATE_FUNC(12));
 
+    /*
+     * Chip select stays low until the end of the DMA transfer: the keyboard
+     * driver checks it before taking over the data lines.
+     */
+    renderBusy = true;
     gpio_clearPin(LCD_CS);
 
     /*
@@ -433,15 +511,10 @@ void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
      * function gets true as return value and does not stomp our work.
      */
     uint16_t *frameBuffer = (uint16_t *) fb;
-    for(uint8_t y = startRow; y < endRow; y++)
-    {
-        for(uint8_t x = 0; x < CONFIG_SCREEN_WIDTH; x++)
-        {
-            size_t pos = x + y * CONFIG_SCREEN_WIDTH;
-            uint16_t pixel = frameBuffer[pos];
-            frameBuffer[pos] = __builtin_bswap16(pixel);
-        }
-    }
+    swapRows(frameBuffer, startRow, endRow);
+    swapFb    = frameBuffer;
+    swapStart = startRow;
+    swapEnd   = endRow;
 
     /* Configure start and end rows in display driver */
     writeCmd(CMD_RASET);
@@ -469,22 +542,23 @@ void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
                      | DMA_SxCR_TCIE          /* Transfer complete interrupt */
                      | DMA_SxCR_TEIE          /* Transfer error interrupt    */
                      | DMA_SxCR_EN;           /* Start transfer              */
+}
 
-    /*
-     * Put the calling thread in waiting status until render completes.
-     */
-    {
-        FastInterruptDisableLock dLock;
-        lcdWaiting = Thread::IRQgetCurrentThread();
-        do
-        {
-            Thread::IRQwait();
-            {
-                FastInterruptEnableLock eLock(dLock);
-                Thread::yield();
-            }
-        } while(lcdWaiting);
-    }
+void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
+{
+    waitRender();
+    startRender(startRow, endRow, fb);
+    waitRender();
+}
+
+void display_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg)
+{
+    waitRender();
+
+    doneCb  = cb;
+    doneArg = arg;
+    startRender(startRow, endRow, fb);
 }
 
 void display_render(void *fb)
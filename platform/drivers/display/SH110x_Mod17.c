@@ -13,9 +13,61 @@
 #include "hwconfig.h"
 #include "drivers/SPI/spi_stm32.h"
 #include "SH110x_Mod17.h"
+#include "display_Mod17.h"
+
+#define NUM_PAGES (CONFIG_SCREEN_WIDTH / 8)
 
 extern const struct spiDevice spi2;
 
+/*
+ * The display is mounted rotated: each byte of a framebuffer row is a
+ * controller page and framebuffer rows are controller columns. Display data is
+ * kept grouped by page, to send each page in a single transfer.
+ */
+static uint8_t pageBuf[NUM_PAGES * CONFIG_SCREEN_HEIGHT];
+static uint8_t         curPage;     // Page being sent
+static uint8_t         startCol;    // First column of the current render
+static uint8_t         numCols;     // Number of columns of the current render
+static display_done_cb doneCb;      // Completion callback of the current render
+static void           *doneArg;     // Completion callback argument
+
+static void sendPage();
+
+static void pageDone()
+{
+    curPage++;
+    if(curPage < NUM_PAGES)
+    {
+        sendPage();
+        return;
+    }
+
+    gpio_setPin(LCD_CS);
+
+    if(doneCb != NULL)
+        doneCb(doneArg);
+}
+
+/**
+ * \internal
+ * Start the transfer of the current page, called also from interrupt context
+ * to chain the transfer of the next page.
+ */
+static void sendPage()
+{
+    uint8_t cmd[3];
+    cmd[0] = (startCol & 0x0F);             /* Set column position    */
+    cmd[1] = (0x10 | ((startCol >> 4) & 0x07));
+    cmd[2] = (0xB0 | curPage);              /* Set page position      */
+
+    gpio_clearPin(LCD_DC);                  /* RS low -> command mode */
+    spi_send(&spi2, cmd, sizeof(cmd));
+    gpio_setPin(LCD_DC);                    /* RS high -> data mode   */
+
+    const uint8_t *data = &pageBuf[(curPage * CONFIG_SCREEN_HEIGHT) + startCol];
+    displayMod17_sendDma(data, numCols, pageDone);
+}
+
 void SH110x_init()
 {
     gpio_setPin(LCD_CS);
@@ -62,6 +114,8 @@ void SH110x_terminate()
 {
     uint8_t dispOff = 0xAE;
 
+    displayMod17_waitDma();
+
     gpio_clearPin(LCD_CS);
     gpio_clearPin(LCD_DC);  /* DC low -> command mode          */
     spi_send(&spi2, &dispOff, 1);
@@ -70,28 +124,45 @@ void SH110x_terminate()
 
 void SH110x_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
 {
-    gpio_clearPin(LCD_CS);
+    SH110x_renderRowsAsync(startRow, endRow, fb, NULL, NULL);
+    displayMod17_waitDma();
+}
 
-    uint8_t *frameBuffer = (uint8_t *) fb;
-    for(uint8_t y = startRow; y < endRow; y++)
+void SH110x_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                            display_done_cb cb, void *arg)
+{
+    displayMod17_waitDma();
+
+    if(endRow > CONFIG_SCREEN_HEIGHT)
+        endRow = CONFIG_SCREEN_HEIGHT;
+
+    if(endRow <= startRow)
     {
-        for(uint8_t x = 0; x < CONFIG_SCREEN_WIDTH/8; x++)
-        {
-            uint8_t cmd[3];
-            cmd[0] = (y & 0x0F);     /* Set Y position         */
-            cmd[1] = (0x10 | ((y >> 4) & 0x07));
-            cmd[2] = (0xB0 | x);     /* Set X position         */
+        if(cb != NULL)
+            cb(arg);
 
-            gpio_clearPin(LCD_DC);              /* RS low -> command mode */
-            spi_send(&spi2, cmd, sizeof(cmd));
-            gpio_setPin(LCD_DC);                /* RS high -> data mode   */
+        return;
+    }
 
+    // Group the framebuffer bytes by page
+    const uint8_t *frameBuffer = (const uint8_t *) fb;
+    for(uint8_t y = startRow; y < endRow; y++)
+    {
+        for(uint8_t x = 0; x < NUM_PAGES; x++)
+        {
             size_t pos = x + y * (CONFIG_SCREEN_WIDTH/8);
-            spi_send(&spi2, &frameBuffer[pos], 1);
+            pageBuf[(x * CONFIG_SCREEN_HEIGHT) + y] = frameBuffer[pos];
         }
     }
 
-    gpio_setPin(LCD_CS);
+    curPage  = 0;
+    startCol = startRow;
+    numCols  = endRow - startRow;
+    doneCb   = cb;
+    doneArg  = arg;
+
+    gpio_clearPin(LCD_CS);
+    sendPage();
 }
 
 void SH110x_render(void *fb)
@@ -105,6 +176,7 @@ void SH110x_setContrast(uint8_t contrast)
     cmd[0] = 0x81;          /* Set Electronic Volume               */
     cmd[0] = contrast;      /* Controller contrast range is 0 - 63 */
 
+    displayMod17_waitDma();
     gpio_clearPin(LCD_CS);
     gpio_clearPin(LCD_DC);  /* RS low -> command mode              */
     spi_send(&spi2, cmd, sizeof(cmd));
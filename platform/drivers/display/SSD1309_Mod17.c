@@ -13,9 +13,63 @@
 #include "hwconfig.h"
 #include "drivers/SPI/spi_stm32.h"
 #include "SSD1309_Mod17.h"
+#include "display_Mod17.h"
+
+#define NUM_PAGES (CONFIG_SCREEN_HEIGHT / 8)
 
 extern const struct spiDevice spi2;
 
+/*
+ * Display data, in the native page order of the controller: each byte holds
+ * eight vertical pixels of a column, LSB on top.
+ */
+static uint8_t pageBuf[NUM_PAGES * CONFIG_SCREEN_WIDTH];
+static display_done_cb doneCb;      // Completion callback of the current render
+static void           *doneArg;     // Completion callback argument
+
+/**
+ * \internal
+ * Convert a range of framebuffer pages to the controller data format.
+ *
+ * @param startPage: first page to be converted.
+ * @param endPage: end page, excluded.
+ * @param fb: pointer to framebuffer.
+ */
+static void packPages(const uint8_t startPage, const uint8_t endPage,
+                      const uint8_t *fb)
+{
+    for(uint8_t page = startPage; page < endPage; page++)
+    {
+        // Eight framebuffer rows, CONFIG_SCREEN_WIDTH/8 bytes each
+        const uint8_t *rows = &fb[page * CONFIG_SCREEN_WIDTH];
+        uint8_t       *dest = &pageBuf[page * CONFIG_SCREEN_WIDTH];
+
+        // Transpose each block of 8x8 pixels
+        for(uint8_t cell = 0; cell < CONFIG_SCREEN_WIDTH / 8; cell++)
+        {
+            for(uint8_t bit = 0; bit < 8; bit++)
+            {
+                uint8_t data = 0;
+                for(uint8_t row = 0; row < 8; row++)
+                {
+                    uint8_t value = rows[row * (CONFIG_SCREEN_WIDTH / 8) + cell];
+                    data |= ((value >> bit) & 0x01) << row;
+                }
+
+                *dest++ = data;
+            }
+        }
+    }
+}
+
+static void renderDone()
+{
+    gpio_setPin(LCD_CS);
+
+    if(doneCb != NULL)
+        doneCb(doneArg);
+}
+
 void SSD1309_init()
 {
     gpio_setPin(LCD_CS);
@@ -52,6 +106,8 @@ void SSD1309_terminate()
 {
     uint8_t dispOff = 0xAE;
 
+    displayMod17_waitDma();
+
     gpio_clearPin(LCD_CS);
     gpio_clearPin(LCD_DC);  /* DC low -> command mode          */
     spi_send(&spi2, &dispOff, 1);
@@ -60,87 +116,60 @@ void SSD1309_terminate()
 
 void SSD1309_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
 {
-    gpio_clearPin(LCD_CS);
+    SSD1309_renderRowsAsync(startRow, endRow, fb, NULL, NULL);
+    displayMod17_waitDma();
+}
+
+void SSD1309_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg)
+{
+    displayMod17_waitDma();
 
     // Convert rows to pages
     uint8_t startPage = startRow / 8;
-    uint8_t endPage = endRow / 8;
-    uint8_t cmd[3];
+    uint8_t endPage   = (endRow + 7) / 8;
+    if(endPage > NUM_PAGES)
+        endPage = NUM_PAGES;
 
-    gpio_clearPin(LCD_DC);
-    cmd[0] = 0x20; // Set page addressing mode
-    cmd[1] = 0x02;
-    spi_send(&spi2, cmd, 2);
-
-    uint8_t *framebuffer = (uint8_t *)fb;
-
-    for(uint8_t page = startPage; page < endPage; page++)
+    if(endPage <= startPage)
     {
-        gpio_clearPin(LCD_DC);
-        cmd[0] = 0xB0 | page;
-        cmd[1] = 0x00;
-        cmd[1] = 0x10;
-        spi_send(&spi2, cmd, 3);
-        gpio_setPin(LCD_DC); // DC high -> data mode
-
-        uint8_t topRow = page * 8;
-        for(uint8_t col = 0; col < CONFIG_SCREEN_WIDTH; col++)
-        {
-            uint8_t data = 0;
-            uint8_t bit_offset = col % 8; // Bit offset in the fb for the column we are refreshing
-            // Gather the 8 rows of data
-            for(uint8_t row = 0; row < 8; row++)
-            {
-                size_t pos = ((topRow + row) * CONFIG_SCREEN_WIDTH + col) / 8;
-                uint8_t cell = framebuffer[pos];
-                data |= ((cell >> bit_offset) & 0x01) << row;
-            }
+        if(cb != NULL)
+            cb(arg);
 
-            spi_send(&spi2, &data, 1);
-        }
+        return;
     }
 
-    gpio_setPin(LCD_CS);
-}
+    packPages(startPage, endPage, (const uint8_t *) fb);
 
-void SSD1309_render(void *fb)
-{
-    static const uint8_t cmd[] =
+    const uint8_t cmd[] =
     {
-        0xB0,
-        0x20, // Set horizontal addressing mode
+        0x20,                       // Set horizontal addressing mode
         0x00,
+        0x21,                       // Set column range
         0x00,
-        0x10
+        CONFIG_SCREEN_WIDTH - 1,
+        0x22,                       // Set page range
+        startPage,
+        endPage - 1
     };
 
+    doneCb  = cb;
+    doneArg = arg;
+
     gpio_clearPin(LCD_CS);
     gpio_clearPin(LCD_DC);
     spi_send(&spi2, cmd, sizeof(cmd));
-    gpio_setPin(LCD_DC); // DC high -> data mode
+    gpio_setPin(LCD_DC);    // DC high -> data mode
 
-    uint8_t *framebuffer = (uint8_t *)fb;
-
-    // Refresh the whole screen 8 rows by 8 rows
-    for(uint8_t topRow = 0; topRow <= 56; topRow += 8)
-    {
-        for(uint8_t col = 0; col < CONFIG_SCREEN_WIDTH; col++)
-        {
-            uint8_t data = 0;
-            uint8_t bit_offset = col % 8; // Bit offset in the fb for the column we are refreshing
-            // Gather the 8 rows of data
-            for(uint8_t subRow = 0; subRow < 8; subRow++)
-            {
-                size_t pos = ((topRow + subRow) * CONFIG_SCREEN_WIDTH + col) / 8;
-                uint8_t cell = framebuffer[pos];
-                data |= ((cell >> bit_offset) & 0x01) << subRow;
-            }
-
-            spi_send(&spi2, &data, 1);
-        }
-    }
+    // Pages are sent in a single transfer, wrapping at the end of each one
+    size_t len = (endPage - startPage) * CONFIG_SCREEN_WIDTH;
+    displayMod17_sendDma(&pageBuf[startPage * CONFIG_SCREEN_WIDTH], len,
+                         renderDone);
+}
 
-    gpio_setPin(LCD_CS);
+void SSD1309_render(void *fb)
+{
+    SSD1309_renderRows(0, CONFIG_SCREEN_HEIGHT, fb);
 }
 
 void SSD1309_setContrast(uint8_t contrast)
@@ -149,6 +178,7 @@ void SSD1309_setContrast(uint8_t contrast)
     cmd[0] = 0x81;          /* Set Electronic Volume               */
     cmd[0] = contrast;      /* Controller contrast range is 0 - 63 */
 
+    displayMod17_waitDma();
     gpio_clearPin(LCD_CS);
     gpio_clearPin(LCD_DC);  /* RS low -> command mode              */
     spi_send(&spi2, cmd, sizeof(cmd));
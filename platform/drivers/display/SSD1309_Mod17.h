@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "interfaces/display.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +34,18 @@ void SSD1309_terminate();
  */
 void SSD1309_renderRows(uint8_t startRow, uint8_t endRow, void *fb);
 
+/**
+ * Start a partial framebuffer render, without waiting for its completion.
+ *
+ * @param startRow: first row of the partial render.
+ * @param endRow: last row of the partial render.
+ * @param fb: pointer to framebuffer.
+ * @param cb: function called when the render is completed, can be NULL.
+ * @param arg: argument for the completion callback.
+ */
+void SSD1309_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg);
+
 /**
  * Render the framebuffer on the screen.
  *
@@ -14,39 +14,9 @@
 #include "interfaces/delays.h"
 #include "hwconfig.h"
 
-
-/**
- * \internal
- * Send one row of pixels to the display.
- * Pixels in framebuffer are stored "by rows", while display needs data to be
- * sent "by columns": this function performs the needed conversion.
- *
- * @param row: pixel row to be be sent.
- */
-static void display_renderRow(uint8_t row, uint8_t *frameBuffer)
-{
-    /* magic stuff */
-    uint8_t *buf = (frameBuffer + 128 * row);
-    for (uint8_t i = 0; i<16; i++)
-    {
-        uint8_t tmp[8] = {0};
-        for (uint8_t j = 0; j < 8; j++)
-        {
-            uint8_t tmp_buf = buf[j*16 + i];
-            int count = __builtin_popcount(tmp_buf);
-            while (count > 0)
-            {
-                int pos = __builtin_ctz(tmp_buf);
-                tmp[pos] |= 1UL << j;
-                tmp_buf &= ~(1 << pos);
-                count--;
-            }
-        }
-
-        spi_send(&spi2, tmp, 8);
-    }
-}
-
+#ifndef CONFIG_PIX_FMT_BW_PAGED
+#error ST7567 driver requires a page-ordered framebuffer
+#endif
 
 void display_init()
 {
@@ -92,26 +62,42 @@ void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
     spi_acquire(&spi2);
     gpio_clearPin(LCD_CS);
 
-    for(uint8_t row = startRow; row < endRow; row++)
+    // Display memory is organised in pages of eight rows
+    uint8_t startPage = startRow / 8;
+    uint8_t endPage   = (endRow + 7) / 8;
+
+    for(uint8_t page = startPage; page < endPage; page++)
     {
         uint8_t command[3];
-        command[0] = 0xB0 | row; /* Set Y position */
-        command[1] = 0x10;       /* Set X position */
+        command[0] = 0xB0 | page; /* Set Y position */
+        command[1] = 0x10;        /* Set X position */
         command[2] = 0x04;
 
         gpio_clearPin(LCD_RS);            /* RS low -> command mode */
         spi_send(&spi2, command, 3);
         gpio_setPin(LCD_RS);              /* RS high -> data mode   */
-        display_renderRow(row, (uint8_t *) fb);
+
+        /* Framebuffer is in display page order, send it as-is */
+        uint8_t *data = ((uint8_t *) fb) + (page * CONFIG_SCREEN_WIDTH);
+        spi_send(&spi2, data, CONFIG_SCREEN_WIDTH);
     }
 
     gpio_setPin(LCD_CS);
     spi_release(&spi2);
 }
 
+void display_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg)
+{
+    display_renderRows(startRow, endRow, fb);
+
+    if(cb != NULL)
+        cb(arg);
+}
+
 void display_render(void *fb)
 {
-    display_renderRows(0, CONFIG_SCREEN_HEIGHT / 8, fb);
+    display_renderRows(0, CONFIG_SCREEN_HEIGHT, fb);
 }
 
 void display_setContrast(uint8_t contrast)
@@ -9,7 +9,9 @@
 #include "interfaces/delays.h"
 #include "interfaces/platform.h"
 #include "drivers/backlight/backlight.h"
+#include "core/threads.h"
 #include "hwconfig.h"
+#include <pthread.h>
 #include <string.h>
 
 enum ST775RCmd
@@ -49,6 +51,20 @@ enum ST775RCmd
     ST775R_CMD_RDID3     = 0xDC
 };
 
+/*
+ * The display bus is driven by the CPU, renders are done by a dedicated thread
+ * to let the caller go on while the framebuffer is being sent.
+ */
+static pthread_t       renderThread;
+static pthread_mutex_t renderMutex;
+static pthread_cond_t  renderCond;
+static bool            renderBusy = false;  // Render requested or in progress
+static uint8_t         reqStart;            // First row of the requested render
+static uint8_t         reqEnd;              // End row of the requested render
+static void           *reqFb;               // Framebuffer to be sent
+static display_done_cb doneCb;              // Completion callback
+static void           *doneArg;             // Completion callback argument
+
 static inline void sendCmd(uint8_t cmd)
 {
     // Set D/C low (command mode), clear WR and data lines
@@ -95,6 +111,95 @@ static inline void sendData(uint8_t val)
     GPIOD->BSRR = (1 << 13);
 }
 
+/**
+ * \internal
+ * Send a section of framebuffer content to the display.
+ *
+ * @param startRow: first row of the framebuffer section to be copied.
+ * @param endRow: end row of the framebuffer section to be copied, excluded.
+ * @param fb: pointer to framebuffer.
+ */
+static void renderRows(uint8_t startRow, uint8_t endRow, void *fb)
+{
+    /*
+     * Put screen data lines back to output mode, since they are in common with
+     * keyboard buttons and the keyboard driver sets them as inputs.
+     */
+    gpio_setMode(LCD_D0, OUTPUT);
+    gpio_setMode(LCD_D1, OUTPUT);
+    gpio_setMode(LCD_D2, OUTPUT);
+    gpio_setMode(LCD_D3, OUTPUT);
+    gpio_setMode(LCD_D4, OUTPUT);
+    gpio_setMode(LCD_D5, OUTPUT);
+    gpio_setMode(LCD_D6, OUTPUT);
+    gpio_setMode(LCD_D7, OUTPUT);
+
+    /*
+     * Configure start and end rows in display driver and write to display
+     * memory.
+     */
+    sendCmd(ST775R_CMD_RASET);
+    sendData(0x00);
+    sendData(startRow);
+    sendData(0x00);
+    sendData(endRow);
+    sendCmd(ST775R_CMD_RAMWR);
+
+    for(uint8_t y = startRow; y < endRow; y++)
+    {
+        for(uint8_t x = 0; x < CONFIG_SCREEN_WIDTH; x++)
+        {
+            size_t pos = x + y * CONFIG_SCREEN_WIDTH;
+            uint16_t pixel = ((uint16_t *) fb)[pos];
+            sendData((pixel >> 8) & 0xff);
+            sendData(pixel & 0xff);
+        }
+    }
+
+    gpio_setPin(LCD_CS);
+}
+
+static void *renderFunc(void *arg)
+{
+    (void) arg;
+
+    while(1)
+    {
+        pthread_mutex_lock(&renderMutex);
+        while(renderBusy == false)
+            pthread_cond_wait(&renderCond, &renderMutex);
+        pthread_mutex_unlock(&renderMutex);
+
+        renderRows(reqStart, reqEnd, reqFb);
+
+        pthread_mutex_lock(&renderMutex);
+        display_done_cb cb    = doneCb;
+        void           *cbArg = doneArg;
+        renderBusy = false;
+        pthread_cond_broadcast(&renderCond);
+        pthread_mutex_unlock(&renderMutex);
+
+        if(cb != NULL)
+            cb(cbArg);
+    }
+
+    return NULL;
+}
+
+/**
+ * \internal
+ * Wait until the render in progress, if any, is completed.
+ */
+static void waitRender()
+{
+    pthread_mutex_lock(&renderMutex);
+
+    while(renderBusy)
+        pthread_cond_wait(&renderCond, &renderMutex);
+
+    pthread_mutex_unlock(&renderMutex);
+}
+
 void display_init()
 {
     backlight_init();
@@ -243,52 +348,56 @@ void display_init()
     sendCmd(ST775R_CMD_DISPON);
 
     gpio_setPin(LCD_CS);
+
+    /* Start the render thread */
+    pthread_attr_t     attr;
+    struct sched_param param;
+
+    pthread_mutex_init(&renderMutex, NULL);
+    pthread_cond_init(&renderCond, NULL);
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, DISP_THREAD_STKSIZE);
+
+    param.sched_priority = THREAD_PRIO_NORMAL;
+    pthread_attr_setschedparam(&attr, &param);
+    pthread_create(&renderThread, &attr, renderFunc, NULL);
 }
 
 void display_terminate()
 {
+    waitRender();
 }
 
 void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
 {
-    /*
-     * Put screen data lines back to output mode, since they are in common with
-     * keyboard buttons and the keyboard driver sets them as inputs.
-     */
-    gpio_setMode(LCD_D0, OUTPUT);
-    gpio_setMode(LCD_D1, OUTPUT);
-    gpio_setMode(LCD_D2, OUTPUT);
-    gpio_setMode(LCD_D3, OUTPUT);
-    gpio_setMode(LCD_D4, OUTPUT);
-    gpio_setMode(LCD_D5, OUTPUT);
-    gpio_setMode(LCD_D6, OUTPUT);
-    gpio_setMode(LCD_D7, OUTPUT);
+    display_renderRowsAsync(startRow, endRow, fb, NULL, NULL);
+    waitRender();
+}
+
+void display_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg)
+{
+    pthread_mutex_lock(&renderMutex);
+
+    while(renderBusy)
+        pthread_cond_wait(&renderCond, &renderMutex);
 
     /*
-     * Select the display, configure start and end rows in display driver and
-     * write to display memory.
+     * Select the display before returning: the keyboard driver checks the
+     * chip select line before taking over the shared data lines.
      */
     gpio_clearPin(LCD_CS);
 
-    sendCmd(ST775R_CMD_RASET);
-    sendData(0x00);
-    sendData(startRow);
-    sendData(0x00);
-    sendData(endRow);
-    sendCmd(ST775R_CMD_RAMWR);
+    reqStart   = startRow;
+    reqEnd     = endRow;
+    reqFb      = fb;
+    doneCb     = cb;
+    doneArg    = arg;
+    renderBusy = true;
 
-    for(uint8_t y = startRow; y < endRow; y++)
-    {
-        for(uint8_t x = 0; x < CONFIG_SCREEN_WIDTH; x++)
-        {
-            size_t pos = x + y * CONFIG_SCREEN_WIDTH;
-            uint16_t pixel = ((uint16_t *) fb)[pos];
-            sendData((pixel >> 8) & 0xff);
-            sendData(pixel & 0xff);
-        }
-    }
-
-    gpio_setPin(LCD_CS);
+    pthread_cond_broadcast(&renderCond);
+    pthread_mutex_unlock(&renderMutex);
 }
 
 void display_render(void *fb)
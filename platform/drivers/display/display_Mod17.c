@@ -11,17 +11,74 @@
 #include "peripherals/gpio.h"
 #include "hwconfig.h"
 #include "interfaces/platform.h"
+#include "interfaces/delays.h"
 #include "drivers/SPI/spi_stm32.h"
 #include "SH110x_Mod17.h"
 #include "SSD1309_Mod17.h"
+#include "display_Mod17.h"
 
 SPI_STM32_DEVICE_DEFINE(spi2, SPI2, NULL)
 
+static void (*volatile dmaDone)(void) = NULL;   // DMA completion function
+static volatile bool   dmaBusy        = false;  // DMA transfer in progress
+
+/* Name of interrupt handler is mangled for C++ compatibility */
+void _Z23DMA1_Stream4_IRQHandlerv()
+{
+    DMA1->HIFCR = DMA_HIFCR_CTCIF4 | DMA_HIFCR_CTEIF4 | DMA_HIFCR_CFEIF4;
+    SPI2->CR2  &= ~SPI_CR2_TXDMAEN;
+
+    /*
+     * DMA transfer ends when the last byte is moved into the SPI data
+     * register: wait for its transmission before releasing the bus. Then,
+     * flush the data received in the meantime to leave the peripheral ready
+     * for the polled transfers.
+     */
+    while((SPI2->SR & SPI_SR_TXE) == 0) ;
+    while((SPI2->SR & SPI_SR_BSY) != 0) ;
+    (void) SPI2->DR;
+    (void) SPI2->SR;
+
+    void (*done)(void) = dmaDone;
+    dmaDone = NULL;
+    dmaBusy = false;
+
+    if(done != NULL)
+        done();
+}
+
+void displayMod17_sendDma(const void *data, const size_t len, void (*done)(void))
+{
+    dmaDone = done;
+    dmaBusy = true;
+
+    DMA1->HIFCR = DMA_HIFCR_CTCIF4  | DMA_HIFCR_CHTIF4 | DMA_HIFCR_CTEIF4
+                | DMA_HIFCR_CDMEIF4 | DMA_HIFCR_CFEIF4;
+
+    DMA1_Stream4->PAR  = (uint32_t) &SPI2->DR;
+    DMA1_Stream4->M0AR = (uint32_t) data;
+    DMA1_Stream4->NDTR = len;
+    DMA1_Stream4->CR   = DMA_SxCR_MINC    // Increment memory pointer, channel 0
+                       | DMA_SxCR_DIR_0   // Memory to peripheral
+                       | DMA_SxCR_TCIE    // Transfer complete interrupt
+                       | DMA_SxCR_TEIE    // Transfer error interrupt
+                       | DMA_SxCR_EN;     // Start transfer
+
+    SPI2->CR2 |= SPI_CR2_TXDMAEN;
+}
+
+void displayMod17_waitDma()
+{
+    while(dmaBusy)
+        sleepFor(0, 1);
+}
+
 struct displayFuncs
 {
     void (*init)(void);
     void (*terminate)(void);
     void (*renderRows)(uint8_t, uint8_t, void *);
+    void (*renderRowsAsync)(uint8_t, uint8_t, void *, display_done_cb, void *);
     void (*render)(void *);
     void (*setContrast)(uint8_t);
     void (*setBacklightLevel)(uint8_t);
@@ -29,11 +86,12 @@ struct displayFuncs
 
 static struct displayFuncs display =
 {
-    .init        = NULL,
-    .terminate   = NULL,
-    .renderRows  = NULL,
-    .render      = NULL,
-    .setContrast = NULL,
+    .init            = NULL,
+    .terminate       = NULL,
+    .renderRows      = NULL,
+    .renderRowsAsync = NULL,
+    .render          = NULL,
+    .setContrast     = NULL,
 };
 
 void display_init()
@@ -42,19 +100,21 @@ void display_init()
     if(((hwinfo->flags & MOD17_FLAGS_HMI_PRESENT) != 0) &&
        ((hwinfo->hw_version >> 8) == MOD17_HMI_V10))
     {
-        display.init        = SSD1309_init;
-        display.renderRows  = SSD1309_renderRows;
-        display.render      = SSD1309_render;
-        display.setContrast = SSD1309_setContrast;
-        display.terminate   = SSD1309_terminate;
+        display.init            = SSD1309_init;
+        display.renderRows      = SSD1309_renderRows;
+        display.renderRowsAsync = SSD1309_renderRowsAsync;
+        display.render          = SSD1309_render;
+        display.setContrast     = SSD1309_setContrast;
+        display.terminate       = SSD1309_terminate;
     }
     else
     {
-        display.init        = SH110x_init;
-        display.renderRows  = SH110x_renderRows;
-        display.render      = SH110x_render;
-        display.setContrast = SH110x_setContrast;
-        display.terminate   = SH110x_terminate;
+        display.init            = SH110x_init;
+        display.renderRows      = SH110x_renderRows;
+        display.renderRowsAsync = SH110x_renderRowsAsync;
+        display.render          = SH110x_render;
+        display.setContrast     = SH110x_setContrast;
+        display.terminate       = SH110x_terminate;
     }
 
     /*
@@ -65,6 +125,17 @@ void display_init()
     gpio_setMode(SPI2_MISO, ALTERNATE | ALTERNATE_FUNC(5));
     spiStm32_init(&spi2, 1300000, 0);
 
+    /*
+     * Turn on DMA1 and configure its interrupt: DMA1 stream 4 is used to send
+     * the display data over SPI2 without using CPU.
+     */
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    __DSB();
+
+    NVIC_ClearPendingIRQ(DMA1_Stream4_IRQn);
+    NVIC_SetPriority(DMA1_Stream4_IRQn, 14);
+    NVIC_EnableIRQ(DMA1_Stream4_IRQn);
+
     /*
      * Initialise GPIOs for LCD control
      */
@@ -78,6 +149,7 @@ void display_init()
 void display_terminate()
 {
     display.terminate();
+    NVIC_DisableIRQ(DMA1_Stream4_IRQn);
     spiStm32_terminate(&spi2);
 }
 
@@ -86,6 +158,12 @@ void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
     display.renderRows(startRow, endRow, fb);
 }
 
+void display_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg)
+{
+    display.renderRowsAsync(startRow, endRow, fb, cb, arg);
+}
+
 void display_render(void *fb)
 {
     display.render(fb);
@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef DISPLAY_MOD17_H
+#define DISPLAY_MOD17_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start sending a block of data to the display through the SPI DMA, returning
+ * without waiting for the end of the transfer. Chip select and data/command
+ * lines have to be managed by the caller.
+ *
+ * A new transfer can be started from the completion function, allowing to
+ * chain multiple transfers.
+ *
+ * @param data: pointer to the data to be sent, must stay valid until the end
+ * of the transfer.
+ * @param len: number of bytes to be sent.
+ * @param done: function called, from interrupt context, at the end of the
+ * transfer.
+ */
+void displayMod17_sendDma(const void *data, const size_t len, void (*done)(void));
+
+/**
+ * Wait for the end of the DMA transfer in progress, if any, including any
+ * other transfer started from its completion function.
+ */
+void displayMod17_waitDma();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DISPLAY_MOD17_H */
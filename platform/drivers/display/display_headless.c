@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+/**
+ * This driver emulates an lcd screen without any graphical output, keeping
+ * the rendered frames in memory. It allows to run the UI in automated tests,
+ * where the screen content is checked by the test itself.
+ */
+
+#include "interfaces/display.h"
+#include "display_headless.h"
+#include <string.h>
+
+static uint32_t screen[CONFIG_SCREEN_WIDTH * CONFIG_SCREEN_HEIGHT];
+static uint32_t frameCount;
+static uint8_t  backlight;
+
+/**
+ * \internal
+ * Fetch the pixel at position (x, y) from the framebuffer and convert it to
+ * ARGB8888 format.
+ */
+static uint32_t fetchPixelFromFb(unsigned int x, unsigned int y, const void *fb)
+{
+    #if defined(CONFIG_PIX_FMT_RGB565)
+    const uint16_t *buf = (const uint16_t *)(fb);
+    uint16_t px = buf[x + y*CONFIG_SCREEN_WIDTH];
+    uint32_t r  = (px >> 11) & 0x1F;
+    uint32_t g  = (px >> 5)  & 0x3F;
+    uint32_t b  =  px        & 0x1F;
+
+    return 0xFF000000 | (((r << 3) | (r >> 2)) << 16)
+                      | (((g << 2) | (g >> 4)) << 8)
+                      |  ((b << 3) | (b >> 2));
+    #elif defined(CONFIG_PIX_FMT_BW_PAGED)
+    const uint8_t *buf = (const uint8_t *)(fb);
+    unsigned int cell  = x + (y / 8)*CONFIG_SCREEN_WIDTH;
+    unsigned int elem  = y % 8;
+    #else
+    const uint8_t *buf = (const uint8_t *)(fb);
+    unsigned int cell  = (x + y*CONFIG_SCREEN_WIDTH) / 8;
+    unsigned int elem  = (x + y*CONFIG_SCREEN_WIDTH) % 8;
+    #endif
+
+    #if !defined(CONFIG_PIX_FMT_RGB565)
+    if(buf[cell] & (1 << elem))
+        return 0xFFFFFFFF;
+
+    return 0xFF000000;
+    #endif
+}
+
+void display_init()
+{
+    memset(screen, 0x00, sizeof(screen));
+    frameCount = 0;
+    backlight  = 0;
+}
+
+void display_terminate()
+{
+
+}
+
+void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
+{
+    if(endRow > CONFIG_SCREEN_HEIGHT)
+        endRow = CONFIG_SCREEN_HEIGHT;
+
+    for(unsigned int y = startRow; y < endRow; y++)
+    {
+        for(unsigned int x = 0; x < CONFIG_SCREEN_WIDTH; x++)
+            screen[x + y*CONFIG_SCREEN_WIDTH] = fetchPixelFromFb(x, y, fb);
+    }
+
+    frameCount += 1;
+}
+
+void display_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg)
+{
+    display_renderRows(startRow, endRow, fb);
+
+    if(cb != NULL)
+        cb(arg);
+}
+
+void display_render(void *fb)
+{
+    display_renderRows(0, CONFIG_SCREEN_HEIGHT, fb);
+}
+
+void display_setContrast(uint8_t contrast)
+{
+    (void) contrast;
+}
+
+void display_setBacklightLevel(uint8_t level)
+{
+    if(level > 100)
+        level = 100;
+
+    backlight = level;
+}
+
+const uint32_t *displayHeadless_getScreen()
+{
+    return screen;
+}
+
+uint32_t displayHeadless_frameCount()
+{
+    return frameCount;
+}
+
+uint8_t displayHeadless_backlightLevel()
+{
+    return backlight;
+}
@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef DISPLAY_HEADLESS_H
+#define DISPLAY_HEADLESS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Get the content of the emulated screen. Pixels are stored row by row in
+ * ARGB8888 format, regardless of the framebuffer pixel format.
+ *
+ * @return pointer to CONFIG_SCREEN_WIDTH * CONFIG_SCREEN_HEIGHT pixels.
+ */
+const uint32_t *displayHeadless_getScreen();
+
+/**
+ * Get the number of renders performed since the display initialisation.
+ *
+ * @return number of renders.
+ */
+uint32_t displayHeadless_frameCount();
+
+/**
+ * Get the current backlight level.
+ *
+ * @return backlight level, normalised value with range 0 - 100.
+ */
+uint8_t displayHeadless_backlightLevel();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DISPLAY_HEADLESS_H */
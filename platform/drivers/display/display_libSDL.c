@@ -14,19 +14,10 @@
 
 #include "interfaces/display.h"
 #include "emulator/sdl_engine.h"
-#include "core/chan.h"
 #include <stdio.h>
 #include <string.h>
 #include "SDL2/SDL.h"
 
-static bool inProgress;             /* Flag to signal when rendering is in progress */
-
-/*
- * SDL main loop syncronization
- */
-bool sdl_ready = false;      /* Flag to signal the sdl main loop is running */
-extern chan_t fb_sync;       /* Shared channel to send a frame buffer update */
-
 /* Custom SDL Event to adjust backlight */
 extern Uint32 SDL_Backlight_Event;
 
@@ -43,7 +34,16 @@ static uint32_t fetchPixelFromFb(unsigned int x, unsigned int y, void *fb)
     (void) fb;
     uint32_t pixel = 0;
 
-    #ifdef CONFIG_PIX_FMT_BW
+    #if defined(CONFIG_PIX_FMT_BW_PAGED)
+    /*
+     * Black and white 1bpp format, in display page order: each cell contains
+     * the values of eight vertical pixels, one per bit, LSB on top.
+     */
+    uint8_t *buf = (uint8_t *)(fb);
+    unsigned int cell = x + (y / 8)*CONFIG_SCREEN_WIDTH;
+    unsigned int elem = y % 8;
+    if(buf[cell] & (1 << elem)) pixel = 0xFFFFFFFF;
+    #elif defined(CONFIG_PIX_FMT_BW)
     /*
      * Black and white 1bpp format: framebuffer is an array of uint8_t, where
      * each cell contains the values of eight pixels, one per bit.
@@ -71,49 +71,48 @@ static uint32_t fetchPixelFromFb(unsigned int x, unsigned int y, void *fb)
 
 void display_init()
 {
-    inProgress = false;
+
 }
 
 void display_terminate()
 {
-    while (inProgress){ }         /* Wait until current render finishes */
-    chan_close(&fb_sync);
-    chan_terminate(&fb_sync);
+
 }
 
 void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
 {
     (void) startRow;
     (void) endRow;
-    inProgress = true;
-    if(!sdl_ready)
-    {
-        sdl_ready = sdlEngine_ready();
-    }
 
-    if(sdl_ready)
+    /*
+     * The buffer obtained from the SDL engine may hold an older frame, thus
+     * the whole frame is always copied. The frame is then handed over to the
+     * SDL main loop without waiting for it to be shown.
+     */
+    PIXEL_SIZE *pixels = sdlEngine_getFrameBuffer();
+
+    #ifdef CONFIG_PIX_FMT_RGB565
+    memcpy(pixels, fb, sizeof(PIXEL_SIZE) * CONFIG_SCREEN_HEIGHT * CONFIG_SCREEN_WIDTH);
+    #else
+    for (unsigned int x = 0; x < CONFIG_SCREEN_WIDTH; x++)
     {
-        // receive a texture pixel map
-        void *pixelMap;
-        chan_recv(&fb_sync, &pixelMap);
-        #ifdef CONFIG_PIX_FMT_RGB565
-        memcpy(pixelMap, fb, sizeof(PIXEL_SIZE) * CONFIG_SCREEN_HEIGHT * CONFIG_SCREEN_WIDTH);
-        #else
-        uint32_t *pixels = (uint32_t *) pixelMap;
-        for (unsigned int x = 0; x < CONFIG_SCREEN_WIDTH; x++)
+        for (unsigned int y = 0; y < CONFIG_SCREEN_HEIGHT; y++)
         {
-            for (unsigned int y = startRow; y < endRow; y++)
-            {
-                pixels[x + y * CONFIG_SCREEN_WIDTH] = fetchPixelFromFb(x, y, fb);
-            }
+            pixels[x + y * CONFIG_SCREEN_WIDTH] = fetchPixelFromFb(x, y, fb);
         }
-        #endif
-        // signal the SDL main loop to proceed with rendering
-        void *done = {0};
-        chan_send(&fb_sync, done);
     }
+    #endif
+
+    sdlEngine_presentFrame();
+}
+
+void display_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg)
+{
+    display_renderRows(startRow, endRow, fb);
 
-    inProgress = false;
+    if(cb != NULL)
+        cb(arg);
 }
 
 void display_render(void *fb)
@@ -32,6 +32,7 @@
 
 static uint8_t knobPrev = 0;
 static uint8_t knobPos = 0;
+static keyboard_t prevKeys = 0;     // Keys found in the last matrix scan
 
 static uint8_t getKnobPos()
 {
@@ -99,6 +100,14 @@ keyboard_t kbd_getKeys()
         knobPrev = knobPos;
     }
 
+    /*
+     * Skip the scan if an asynchronous display render is in progress, since
+     * the display chip select is kept low during the transfer. Report the keys
+     * found in the previous scan, to avoid generating spurious release events.
+     */
+    if(gpio_readPin(LCD_CS) == 0)
+        return keys | prevKeys;
+
     /*
      * Rows and columns lines are in common with the display, so we have to
      * configure them as inputs before scanning. However, before configuring them
@@ -174,6 +183,7 @@ keyboard_t kbd_getKeys()
     if(gpio_readPin(SIDE_KEY3) == 0) keys |= KEY_F2;
     if(gpio_readPin(ALARM_KEY) == 0) keys |= KEY_F3;
 
+    prevKeys = keys & ~(KNOB_LEFT | KNOB_RIGHT);
     return keys;
 }
 
@@ -13,6 +13,7 @@
 #include "hwconfig.h"
 
 static int8_t old_pos = 0;
+static keyboard_t prevKeys = 0;     // Keys found in the last matrix scan
 
 void kbd_init()
 {
@@ -63,6 +64,14 @@ keyboard_t kbd_getKeys()
     }
 
 
+    /*
+     * Skip the scan if an asynchronous display render is in progress, since
+     * the display chip select is kept low during the transfer. Report the keys
+     * found in the previous scan, to avoid generating spurious release events.
+     */
+    if(gpio_readPin(LCD_CS) == 0)
+        return keys | prevKeys;
+
     /*
      * The row lines are in common with the display, so we have to configure
      * them as inputs before scanning. However, before configuring them as inputs,
@@ -147,5 +156,6 @@ keyboard_t kbd_getKeys()
     if(gpio_readPin(LCD_D7)) keys |= KEY_F2;
 
     gpio_clearPin(KB_ROW3);
+    prevKeys = keys & ~(KNOB_LEFT | KNOB_RIGHT);
     return keys;
 }
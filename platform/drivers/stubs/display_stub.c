@@ -25,6 +25,17 @@ void display_renderRows(uint8_t startRow, uint8_t endRow, void *fb)
     (void) fb;
 }
 
+void display_renderRowsAsync(uint8_t startRow, uint8_t endRow, void *fb,
+                             display_done_cb cb, void *arg)
+{
+    (void) startRow;
+    (void) endRow;
+    (void) fb;
+
+    if(cb != NULL)
+        cb(arg);
+}
+
 void display_render(void *fb)
 {
     (void) fb;
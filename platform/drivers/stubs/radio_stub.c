@@ -41,6 +41,11 @@ void radio_enableRx()
 
 }
 
+void radio_retuneRx(const freq_t freq)
+{
+    (void) freq;
+}
+
 void radio_enableTx()
 {
 
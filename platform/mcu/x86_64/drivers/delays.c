@@ -11,8 +11,421 @@
 
 /**
  * Implementation of the delay functions for x86_64.
+ *
+ * When CONFIG_VIRTUAL_TIME is defined, the system time is simulated instead of
+ * following the wall clock: it starts from zero and advances only when all
+ * the threads of the program are blocked, jumping directly to the earliest
+ * wakeup time among the sleeping threads. Delays and sleeps thus take no
+ * actual time, allowing to run simulations as fast as possible and with a
+ * reproducible timing.
  */
 
+#ifdef CONFIG_VIRTUAL_TIME
+
+#include <sys/syscall.h>
+#include <sys/prctl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#define MAX_SLEEPERS  32        // Maximum number of sleeping threads
+#define POLL_MIN      10000     // Minimum idle detection polling period, in ns
+#define POLL_MAX      1000000   // Maximum idle detection polling period, in ns
+
+static pthread_mutex_t clockMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  clockCond  = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  watchCond  = PTHREAD_COND_INITIALIZER;
+
+static long long virtualTime = 0;          // Simulated time, in microseconds
+static long long wakeups[MAX_SLEEPERS];    // Wakeup time of sleeping threads
+static bool      sleeping[MAX_SLEEPERS];   // Slot used by a sleeping thread
+static pid_t     sleepTid[MAX_SLEEPERS];   // Thread ID of sleeping threads
+static unsigned  numSleepers = 0;          // Number of sleeping threads
+static unsigned  sleepGen    = 0;          // Incremented on sleeper changes
+static bool      watcherRunning = false;
+static pid_t     watcherTid     = 0;
+
+/**
+ * \internal
+ * Get the scheduling state of a thread of this process.
+ *
+ * @param tid: thread ID.
+ * @param switches: incremented by the number of voluntary context switches
+ * performed by the thread.
+ * @return state character, as reported in /proc, or zero on error.
+ */
+static char threadState(const pid_t tid, unsigned long *switches)
+{
+    char path[64];
+    char line[128];
+    char state = 0;
+
+    snprintf(path, sizeof(path), "/proc/self/task/%d/status", tid);
+
+    FILE *fp = fopen(path, "r");
+    if(fp == NULL)
+        return 0;
+
+    while(fgets(line, sizeof(line), fp) != NULL)
+    {
+        unsigned long count;
+
+        if(strncmp(line, "State:", 6) == 0)
+            sscanf(line + 6, " %c", &state);
+        else if(sscanf(line, "voluntary_ctxt_switches: %lu", &count) == 1)
+            *switches += count;
+    }
+
+    fclose(fp);
+    return state;
+}
+
+/**
+ * \internal
+ * Check the threads of the program, except the calling one and the idle
+ * watcher.
+ *
+ * @param checkState: if true, check the thread states and stop at the first
+ * thread which is not blocked.
+ * @param skip: threads known to be blocked, whose state is not checked.
+ * @param numSkip: number of elements of the skip array.
+ * @param blocked: set to false if a thread which is not blocked was found.
+ * @param switches: total number of voluntary context switches of the threads.
+ * @return number of threads scanned.
+ */
+static unsigned scanThreads(const bool checkState, const pid_t *skip,
+                            const unsigned numSkip, bool *blocked,
+                            unsigned long *switches)
+{
+    *blocked  = false;
+    *switches = 0;
+
+    DIR *dir = opendir("/proc/self/task");
+    if(dir == NULL)
+        return 0;
+
+    pid_t    self  = syscall(SYS_gettid);
+    unsigned count = 0;
+    *blocked       = true;
+
+    struct dirent *entry;
+    while((entry = readdir(dir)) != NULL)
+    {
+        if(entry->d_name[0] == '.')
+            continue;
+
+        pid_t tid = atoi(entry->d_name);
+        if((tid == self) || (tid == watcherTid))
+            continue;
+
+        count += 1;
+        if(checkState == false)
+            continue;
+
+        bool known = false;
+        for(unsigned i = 0; i < numSkip; i++)
+        {
+            if(skip[i] == tid)
+                known = true;
+        }
+
+        if(known)
+            continue;
+
+        // Zombie threads are already terminated
+        char state = threadState(tid, switches);
+        if((state != 'S') && (state != 'Z'))
+        {
+            *blocked = false;
+            break;
+        }
+    }
+
+    closedir(dir);
+    return count;
+}
+
+/**
+ * \internal
+ * Check if all the threads of the program, except the calling one and the
+ * idle watcher, are blocked.
+ *
+ * The threads are scanned twice: a thread waking up another one and blocking
+ * again while the first scan is in progress is detected by the change in the
+ * number of context switches.
+ *
+ * @param skip: threads known to be blocked, whose state is not checked.
+ * @param numSkip: number of elements of the skip array.
+ * @return true if all the threads are blocked.
+ */
+static bool othersBlocked(const pid_t *skip, const unsigned numSkip)
+{
+    unsigned long first;
+    unsigned long second;
+    bool          blocked;
+
+    scanThreads(true, skip, numSkip, &blocked, &first);
+    if(blocked == false)
+        return false;
+
+    scanThreads(true, skip, numSkip, &blocked, &second);
+
+    return blocked && (first == second);
+}
+
+/**
+ * \internal
+ * Get the number of threads of the program, except the calling one and the
+ * idle watcher.
+ *
+ * @return number of threads.
+ */
+static unsigned otherThreads()
+{
+    unsigned long switches;
+    bool          blocked;
+
+    return scanThreads(false, NULL, 0, &blocked, &switches);
+}
+
+/**
+ * \internal
+ * Check if all the threads of the program, except the calling one and the idle
+ * watcher, are waiting for the simulated time to advance. This check requires
+ * only a listing of the threads, without reading their states. To be called
+ * with the clock mutex locked.
+ *
+ * @return true if all the threads are sleeping.
+ */
+static bool allSleeping()
+{
+    if(numSleepers == 0)
+        return false;
+
+    // Threads already woken up but not yet returned from the sleep
+    for(unsigned i = 0; i < MAX_SLEEPERS; i++)
+    {
+        if(sleeping[i] && (wakeups[i] <= virtualTime))
+            return false;
+    }
+
+    return otherThreads() == numSleepers;
+}
+
+/**
+ * \internal
+ * Advance the simulated time to the earliest wakeup time and wake up the
+ * sleeping threads. To be called with the clock mutex locked.
+ */
+static void advanceTime()
+{
+    long long next = -1;
+
+    for(unsigned i = 0; i < MAX_SLEEPERS; i++)
+    {
+        if(sleeping[i] && ((next < 0) || (wakeups[i] < next)))
+            next = wakeups[i];
+    }
+
+    if(next > virtualTime)
+        __atomic_store_n(&virtualTime, next, __ATOMIC_RELAXED);
+
+    pthread_cond_broadcast(&clockCond);
+}
+
+/**
+ * \internal
+ * Thread advancing the simulated time when the program becomes idle, that is
+ * when all its threads are blocked and at least one is sleeping.
+ *
+ * The watcher blocks while there are no sleeping threads. When all the other
+ * threads are sleeping the time is advanced right away, otherwise their states
+ * are scanned once no thread started a sleep for a polling period. The polling
+ * period doubles, up to POLL_MAX, each time a scan finds a thread still
+ * running, so that long computations between sleeps are not slowed down by the
+ * scans.
+ */
+static void *watcherFunc(void *arg)
+{
+    (void) arg;
+
+    watcherTid = syscall(SYS_gettid);
+
+    // Avoid the default 50us timer slack on the polling period
+    prctl(PR_SET_TIMERSLACK, 1);
+
+    long pollTime = POLL_MIN;
+
+    pthread_mutex_lock(&clockMutex);
+
+    while(1)
+    {
+        // Nothing to do until a thread goes to sleep
+        while(numSleepers == 0)
+        {
+            pthread_cond_wait(&watchCond, &clockMutex);
+            pollTime = POLL_MIN;
+        }
+
+        // Wait for a new sleeping thread or for the polling period to expire
+        struct timespec timeout;
+        clock_gettime(CLOCK_REALTIME, &timeout);
+        timeout.tv_nsec += pollTime;
+        if(timeout.tv_nsec >= 1000000000)
+        {
+            timeout.tv_sec  += 1;
+            timeout.tv_nsec -= 1000000000;
+        }
+
+        int ret = pthread_cond_timedwait(&watchCond, &clockMutex, &timeout);
+
+        if(allSleeping())
+        {
+            advanceTime();
+            pollTime = POLL_MIN;
+            continue;
+        }
+
+        // A thread just went to sleep, wait for the others to settle
+        if(ret != ETIMEDOUT)
+        {
+            pollTime = POLL_MIN;
+            continue;
+        }
+
+        if(numSleepers == 0)
+            continue;
+
+        // Sleeping threads do not need to be checked: any change is signalled
+        // by the sleep generation counter.
+        pid_t    skip[MAX_SLEEPERS];
+        unsigned numSkip = 0;
+        for(unsigned i = 0; i < MAX_SLEEPERS; i++)
+        {
+            if(sleeping[i] && (wakeups[i] > virtualTime))
+                skip[numSkip++] = sleepTid[i];
+        }
+
+        unsigned gen = sleepGen;
+        pthread_mutex_unlock(&clockMutex);
+
+        bool idle = othersBlocked(skip, numSkip);
+
+        // Advance only if no thread started or ended a sleep in the meantime
+        pthread_mutex_lock(&clockMutex);
+        if(idle && (gen == sleepGen))
+        {
+            advanceTime();
+            pollTime = POLL_MIN;
+        }
+        else if(pollTime < POLL_MAX)
+        {
+            pollTime *= 2;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \internal
+ * Put the calling thread to sleep until the simulated time reaches a given
+ * value.
+ *
+ * @param wakeup: wakeup time, in microseconds.
+ */
+static void virtualSleep(const long long wakeup)
+{
+    pthread_mutex_lock(&clockMutex);
+
+    if(wakeup <= virtualTime)
+    {
+        pthread_mutex_unlock(&clockMutex);
+        return;
+    }
+
+    // Single-threaded program, the time can be advanced right now
+    if((numSleepers == 0) && (otherThreads() == 0))
+    {
+        __atomic_store_n(&virtualTime, wakeup, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&clockMutex);
+        return;
+    }
+
+    if(watcherRunning == false)
+    {
+        pthread_t watcher;
+        if(pthread_create(&watcher, NULL, watcherFunc, NULL) == 0)
+        {
+            pthread_detach(watcher);
+            watcherRunning = true;
+        }
+    }
+
+    unsigned slot = 0;
+    while((slot < MAX_SLEEPERS) && sleeping[slot])
+        slot++;
+
+    if(slot >= MAX_SLEEPERS)
+    {
+        printf("Too many sleeping threads\n");
+        abort();
+    }
+
+    sleeping[slot] = true;
+    wakeups[slot]  = wakeup;
+    sleepTid[slot] = syscall(SYS_gettid);
+    numSleepers   += 1;
+    sleepGen      += 1;
+    pthread_cond_signal(&watchCond);
+
+    while(virtualTime < wakeup)
+        pthread_cond_wait(&clockCond, &clockMutex);
+
+    sleeping[slot] = false;
+    numSleepers   -= 1;
+    sleepGen      += 1;
+
+    pthread_mutex_unlock(&clockMutex);
+}
+
+static long long virtualNow()
+{
+    return __atomic_load_n(&virtualTime, __ATOMIC_RELAXED);
+}
+
+void delayUs(unsigned int useconds)
+{
+    virtualSleep(virtualNow() + useconds);
+}
+
+void delayMs(unsigned int mseconds)
+{
+    virtualSleep(virtualNow() + (mseconds * 1000LL));
+}
+
+void sleepFor(unsigned int seconds, unsigned int mseconds)
+{
+    long long time = (seconds * 1000LL) + mseconds;
+    virtualSleep(virtualNow() + (time * 1000LL));
+}
+
+void sleepUntil(long long timestamp)
+{
+    virtualSleep(timestamp * 1000LL);
+}
+
+long long getTick()
+{
+    return virtualNow() / 1000;
+}
+
+#else
+
 void delayUs(unsigned int useconds)
 {
     usleep(useconds);
@@ -48,3 +461,5 @@ long long getTick()
     long long milliseconds = te.tv_sec*1000LL + te.tv_usec/1000;
     return milliseconds;
 }
+
+#endif
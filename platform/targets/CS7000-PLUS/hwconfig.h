@@ -48,6 +48,9 @@ extern const struct gpsDevice gps;
 /* Screen pixel format */
 #define CONFIG_PIX_FMT_RGB565
 
+/* Display rendered in background from a second framebuffer */
+#define CONFIG_GFX_DOUBLE_BUFFER
+
 /* Screen has adjustable brightness */
 #define CONFIG_SCREEN_BRIGHTNESS
 
@@ -58,6 +61,9 @@ extern const struct gpsDevice gps;
 /* Device supports M17 mode */
 #define CONFIG_M17
 
+/* Device has a hardware beep generator */
+#define CONFIG_BEEP_HW
+
 /* Device has a GPS chip */
 #define CONFIG_GPS
 #define CONFIG_GPS_STM32_USART6
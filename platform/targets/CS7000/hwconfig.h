@@ -48,6 +48,9 @@ extern const struct gpsDevice gps;
 /* Screen pixel format */
 #define CONFIG_PIX_FMT_RGB565
 
+/* Display rendered in background from a second framebuffer */
+#define CONFIG_GFX_DOUBLE_BUFFER
+
 /* Screen has adjustable brightness */
 #define CONFIG_SCREEN_BRIGHTNESS
 
@@ -58,11 +61,22 @@ extern const struct gpsDevice gps;
 /* Device supports M17 mode */
 #define CONFIG_M17
 
+/* Device has a hardware beep generator */
+#define CONFIG_BEEP_HW
+
 /* Device has a GPS chip */
 #define CONFIG_GPS
 #define CONFIG_GPS_STM32_USART6
 #define CONFIG_NMEA_RBUF_SIZE 128
 
+/* GPS track log in the first 1MB of the available external flash partition */
+#define CONFIG_TRACKLOG_NVM_AREA 0
+#define CONFIG_TRACKLOG_NVM_PART 3
+#define CONFIG_TRACKLOG_SIZE     0x100000
+
+/* External flash backup and restore over the USB serial port */
+#define CONFIG_FLASH_BACKUP
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,9 @@ extern const struct spiDevice c6000_spi;
 /* Screen pixel format */
 #define CONFIG_PIX_FMT_BW
 
+/* Framebuffer stored in display page order */
+#define CONFIG_PIX_FMT_BW_PAGED
+
 /* Screen has adjustable contrast */
 #define CONFIG_SCREEN_CONTRAST
 #define CONFIG_DEFAULT_CONTRAST 71
@@ -36,10 +39,16 @@ extern const struct spiDevice c6000_spi;
 /* Screen has adjustable brightness */
 #define CONFIG_SCREEN_BRIGHTNESS
 
+/* Rendered text cache disabled, to save RAM */
+#define CONFIG_GFX_TEXT_CACHE_SIZE 0
+
 /* Battery type */
 #define CONFIG_BAT_LIION
 #define CONFIG_BAT_NCELLS 2
 
+/* External flash backup and restore over the USB serial port */
+#define CONFIG_FLASH_BACKUP
+
 #ifdef __cplusplus
 }
 #endif
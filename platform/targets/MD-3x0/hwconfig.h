@@ -57,6 +57,12 @@ extern const struct Adc adc1;
 /* Device supports M17 mode */
 #define CONFIG_M17
 
+/* Device has a hardware beep generator */
+#define CONFIG_BEEP_HW
+
+/* External flash backup and restore over the USB serial port */
+#define CONFIG_FLASH_BACKUP
+
 #ifdef __cplusplus
 }
 #endif
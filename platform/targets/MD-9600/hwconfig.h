@@ -52,9 +52,15 @@ extern const struct Adc adc1;
 /* Screen pixel format */
 #define CONFIG_PIX_FMT_BW
 
+/* Framebuffer stored in display page order */
+#define CONFIG_PIX_FMT_BW_PAGED
+
 /* Battery type */
 #define CONFIG_BAT_NONE
 
+/* External flash backup and restore over the USB serial port */
+#define CONFIG_FLASH_BACKUP
+
 #ifdef __cplusplus
 }
 #endif
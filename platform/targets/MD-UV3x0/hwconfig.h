@@ -54,6 +54,9 @@ extern const struct Adc adc1;
 /* Device supports M17 mode */
 #define CONFIG_M17
 
+/* Device has a hardware beep generator */
+#define CONFIG_BEEP_HW
+
 /*
  * To enable pwm for display backlight dimming uncomment this directive.
  *
@@ -76,6 +79,9 @@ extern const struct Adc adc1;
  * #define CONFIG_SCREEN_BRIGHTNESS
  */
 
+/* External flash backup and restore over the USB serial port */
+#define CONFIG_FLASH_BACKUP
+
 #ifdef __cplusplus
 }
 #endif
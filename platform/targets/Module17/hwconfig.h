@@ -57,6 +57,9 @@ enum Mod17Flags
 /* Screen pixel format */
 #define CONFIG_PIX_FMT_BW
 
+/* Display rendered in background from a second framebuffer */
+#define CONFIG_GFX_DOUBLE_BUFFER
+
 /* Device has no battery */
 #define CONFIG_BAT_NONE
 
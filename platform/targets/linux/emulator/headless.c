@@ -0,0 +1,449 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include "interfaces/platform.h"
+#include "interfaces/display.h"
+#include "interfaces/delays.h"
+#include "interfaces/cps_io.h"
+#include "drivers/display/display_headless.h"
+#include "core/graphics.h"
+#include "core/input.h"
+#include "core/event.h"
+#include "core/state.h"
+#include "core/ui.h"
+#include "emulator.h"
+#include "headless.h"
+
+#define KEY_QUEUE_SIZE  32      // Maximum number of queued keyboard states
+#define TASK_PERIOD     5       // Period of the device management task, in ms
+#define KBD_PERIOD      25      // Keyboard scan period, in ms
+
+static const emulator_state_t defaultState =
+{
+    -100.0f,  // RSSI
+    8.2f,     // Vbat
+    3,        // mic level
+    4,        // volume level
+    1,        // chSelector
+    false,    // PTT status
+    false     // power off
+};
+
+emulator_state_t emulator_state;
+
+static keyboard_t keyQueue[KEY_QUEUE_SIZE];  // Keyboard states, one per scan
+static uint8_t    keyHead;
+static uint8_t    keyCount;
+static keyboard_t heldKeys;                  // Keys kept pressed
+
+static long long  simTime;                   // Time of the next task run
+static long long  kbdTime;                   // Time of the last keyboard scan
+
+/**
+ * \internal
+ * Queue a keyboard state, to be returned by a single keyboard scan.
+ */
+static void queueKeys(const keyboard_t keys)
+{
+    if(keyCount >= KEY_QUEUE_SIZE)
+    {
+        printf("too many keys!\n");
+        return;
+    }
+
+    keyQueue[(keyHead + keyCount) % KEY_QUEUE_SIZE] = keys;
+    keyCount += 1;
+}
+
+/**
+ * \internal
+ * Process the pending UI events and the updates scheduled by the UI, with the
+ * same sequence of operations performed by the UI thread.
+ */
+static void uiTask()
+{
+    bool      sync_rtx = false;
+    long long next     = ui_getNextUpdate();
+    bool      update   = (next != 0) && (getTick() >= next);
+
+    while(event_tryWait() || update)
+    {
+        update = false;
+
+        pthread_mutex_lock(&state_mutex);
+        ui_updateFSM(&sync_rtx);
+        ui_saveState();
+        pthread_mutex_unlock(&state_mutex);
+
+        gps_updateTracklog();
+
+        if(ui_updateGUI() == true)
+            gfx_render();
+    }
+}
+
+/**
+ * \internal
+ * Run one iteration of the device management task, followed by the UI task.
+ */
+static void step()
+{
+    kbd_msg_t kbd_msg;
+
+    state_task();
+
+    if((simTime - kbdTime) >= KBD_PERIOD)
+    {
+        if(input_scanKeyboard(&kbd_msg))
+            ui_pushEvent(EVENT_KBD, kbd_msg.value);
+
+        kbdTime = simTime;
+    }
+
+    uiTask();
+
+    simTime += TASK_PERIOD;
+    sleepUntil(simTime);
+}
+
+/**
+ * \internal
+ * Compute the combination of a list of key names.
+ */
+static keyboard_t parseKeys(char **names, const int num)
+{
+    keyboard_t keys = 0;
+
+    for(int i = 0; i < num; i++)
+    {
+        keyboard_t key = headless_keyFromName(names[i]);
+        if(key == 0)
+            return 0;
+
+        keys |= key;
+    }
+
+    return keys;
+}
+
+/**
+ * \internal
+ * Set an emulated input value.
+ */
+static float *inputByName(const char *name)
+{
+    if(strcmp(name, "rssi")    == 0) return &emulator_state.RSSI;
+    if(strcmp(name, "vbat")    == 0) return &emulator_state.vbat;
+    if(strcmp(name, "mic")     == 0) return &emulator_state.micLevel;
+    if(strcmp(name, "volume")  == 0) return &emulator_state.volumeLevel;
+    if(strcmp(name, "channel") == 0) return &emulator_state.chSelector;
+
+    return NULL;
+}
+
+/**
+ * \internal
+ * Execute a single script command.
+ *
+ * @return number of failed checks, -1 if the command is not valid.
+ */
+static int runCommand(char **argv, const int argc, const int line)
+{
+    const char *cmd = argv[0];
+    float      *input;
+
+    if((strcmp(cmd, "key") == 0) && (argc > 1))
+    {
+        for(int i = 1; i < argc; i++)
+        {
+            keyboard_t key = headless_keyFromName(argv[i]);
+            if(key == 0)
+                return -1;
+
+            headless_pressKeys(key);
+        }
+    }
+    else if((strcmp(cmd, "keycombo") == 0) && (argc > 1))
+    {
+        keyboard_t keys = parseKeys(&argv[1], argc - 1);
+        if(keys == 0)
+            return -1;
+
+        headless_pressKeys(keys);
+    }
+    else if((strcmp(cmd, "hold") == 0) && (argc > 2))
+    {
+        keyboard_t keys = parseKeys(&argv[2], argc - 2);
+        if(keys == 0)
+            return -1;
+
+        headless_holdKeys(keys, atoi(argv[1]));
+    }
+    else if((strcmp(cmd, "sleep") == 0) && (argc == 2))
+    {
+        headless_run(atoi(argv[1]));
+    }
+    else if((input = inputByName(cmd)) != NULL)
+    {
+        if(argc != 2)
+            return -1;
+
+        *input = strtof(argv[1], NULL);
+    }
+    else if((strcmp(cmd, "ptt") == 0) && (argc == 1))
+    {
+        emulator_state.PTTstatus = !emulator_state.PTTstatus;
+    }
+    else if((strcmp(cmd, "hash") == 0) && (argc == 1))
+    {
+        printf("%08x\n", headless_screenHash());
+    }
+    else if((strcmp(cmd, "expect") == 0) && (argc == 2))
+    {
+        uint32_t expected = strtoul(argv[1], NULL, 16);
+        uint32_t actual   = headless_screenHash();
+
+        if(actual != expected)
+        {
+            printf("line %d: expected screen hash %08x, got %08x\n", line,
+                   expected, actual);
+            return 1;
+        }
+    }
+    else if((strcmp(cmd, "screenshot") == 0) && (argc == 2))
+    {
+        if(headless_saveScreen(argv[1]) < 0)
+            return -1;
+    }
+    else
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void headless_init()
+{
+    /*
+     * Start the simulation on a whole second, leaving enough time for the
+     * periodic tasks of a previous simulation to expire. In this way all the
+     * simulations run with the same timing.
+     */
+    simTime = ((getTick() / 1000) + 2) * 1000;
+    sleepUntil(simTime);
+
+    emulator_state = defaultState;
+    keyHead        = 0;
+    keyCount       = 0;
+    heldKeys       = 0;
+    kbdTime        = simTime;
+
+    // Fixed start date, 2025-01-01 00:00:00 UTC
+    datetime_t date = { 0, 0, 0, 3, 1, 1, 25 };
+    platform_setTime(date);
+
+    // Nonvolatile memory is not initialised: default settings are used
+    state = (const state_t){ 0 };
+    state.devStatus = STARTUP;
+    state_init();
+
+    gfx_init();
+    kbd_init();
+    ui_init();
+
+    // Empty codeplug in a temporary file, removed when closed
+    char cpsPath[] = "/tmp/openrtx_headless_XXXXXX";
+    int fd = mkstemp(cpsPath);
+    if(fd >= 0)
+    {
+        close(fd);
+        cps_create(cpsPath);
+        cps_open(cpsPath);
+        unlink(cpsPath);
+    }
+
+    ui_drawSplashScreen();
+    gfx_render();
+    display_setBacklightLevel(state.settings.brightness);
+
+    state.devStatus = RUNNING;
+
+    ui_saveState();
+    ui_updateGUI();
+    gfx_render();
+}
+
+void headless_terminate()
+{
+    state.devStatus = SHUTDOWN;
+
+    // Drain the event queue
+    uiTask();
+    gps_updateTracklog();
+
+    ui_terminate();
+    gfx_terminate();
+    cps_close();
+}
+
+void headless_run(const unsigned int mseconds)
+{
+    long long end = simTime + mseconds;
+
+    while(simTime < end)
+        step();
+}
+
+void headless_pressKeys(const keyboard_t keys)
+{
+    queueKeys(keys);
+    queueKeys(0);
+
+    while(keyCount > 0)
+        step();
+}
+
+void headless_holdKeys(const keyboard_t keys, const unsigned int mseconds)
+{
+    heldKeys = keys;
+    headless_run(mseconds);
+    heldKeys = 0;
+    headless_run(KBD_PERIOD);
+}
+
+keyboard_t headless_keyFromName(const char *name)
+{
+    // Same order of the bit field in interfaces/keyboard.h
+    static const char *names[] =
+    {
+        "KEY_0", "KEY_1", "KEY_2", "KEY_3", "KEY_4", "KEY_5", "KEY_6", "KEY_7",
+        "KEY_8", "KEY_9", "KEY_STAR", "KEY_HASH", "KEY_ENTER", "KEY_ESC",
+        "KEY_UP", "KEY_DOWN", "KEY_LEFT", "KEY_RIGHT", "KEY_MONI", "KEY_F1",
+        "KEY_F2", "KEY_F3", "KEY_F4", "KEY_F5", "KEY_F6", "KEY_VOLUP",
+        "KEY_VOLDOWN", "KNOB_LEFT", "KNOB_RIGHT",
+    };
+
+    for(size_t i = 0; i < (sizeof(names) / sizeof(names[0])); i++)
+    {
+        if((strcasecmp(name, names[i]) == 0) ||
+           ((strncmp(names[i], "KEY_", 4) == 0) &&
+            (strcasecmp(name, names[i] + 4) == 0)))
+        {
+            return (1 << i);
+        }
+    }
+
+    return 0;
+}
+
+uint32_t headless_screenHash()
+{
+    const uint8_t *ptr = (const uint8_t *) displayHeadless_getScreen();
+    const size_t   len = CONFIG_SCREEN_WIDTH * CONFIG_SCREEN_HEIGHT
+                       * sizeof(uint32_t);
+
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < len; i++)
+    {
+        hash ^= ptr[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+int headless_saveScreen(const char *fileName)
+{
+    const uint32_t *screen = displayHeadless_getScreen();
+
+    FILE *file = fopen(fileName, "wb");
+    if(file == NULL)
+        return -1;
+
+    fprintf(file, "P6\n%d %d\n255\n", CONFIG_SCREEN_WIDTH, CONFIG_SCREEN_HEIGHT);
+
+    for(size_t i = 0; i < (CONFIG_SCREEN_WIDTH * CONFIG_SCREEN_HEIGHT); i++)
+    {
+        uint8_t rgb[3];
+        rgb[0] = (screen[i] >> 16) & 0xFF;
+        rgb[1] = (screen[i] >> 8)  & 0xFF;
+        rgb[2] =  screen[i]        & 0xFF;
+        fwrite(rgb, sizeof(rgb), 1, file);
+    }
+
+    fclose(file);
+    return 0;
+}
+
+int headless_runScript(const char *script)
+{
+    char *text = strdup(script);
+    if(text == NULL)
+        return -1;
+
+    char *next     = text;
+    int   lineNum  = 0;
+    int   failures = 0;
+
+    while(next != NULL)
+    {
+        char *line = strsep(&next, "\n");
+        char *argv[16];
+        char *argPtr = NULL;
+        int   argc   = 0;
+
+        lineNum += 1;
+
+        char *arg = strtok_r(line, " \t\r", &argPtr);
+        while((arg != NULL) && (argc < 16))
+        {
+            argv[argc++] = arg;
+            arg = strtok_r(NULL, " \t\r", &argPtr);
+        }
+
+        if((argc == 0) || (argv[0][0] == '#'))
+            continue;
+
+        int ret = runCommand(argv, argc, lineNum);
+        if(ret < 0)
+        {
+            printf("line %d: invalid command '%s'\n", lineNum, argv[0]);
+            failures = -1;
+            break;
+        }
+
+        failures += ret;
+    }
+
+    free(text);
+    return failures;
+}
+
+
+void emulator_start()
+{
+
+}
+
+keyboard_t emulator_getKeys()
+{
+    if(keyCount == 0)
+        return heldKeys;
+
+    keyboard_t keys = keyQueue[keyHead];
+    keyHead   = (keyHead + 1) % KEY_QUEUE_SIZE;
+    keyCount -= 1;
+
+    return keys;
+}
@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include "interfaces/keyboard.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Headless emulator.
+ *
+ * The headless emulator runs the user interface without any graphical output
+ * and without the SDL library, for automated UI tests. It has to be built
+ * with CONFIG_HEADLESS and CONFIG_VIRTUAL_TIME defined.
+ *
+ * The device management and UI tasks are run in lock-step by the calling
+ * thread, with a simulated system time: one second of device operation takes
+ * only the time needed to run the tasks. The radio and the voice prompts are
+ * not emulated.
+ *
+ * Key presses are scripted and the content of the screen can be checked
+ * through its hash or saved to a file.
+ */
+
+/**
+ * Initialise the headless emulator, with the radio state set to its default
+ * values and an empty codeplug, and show the main screen.
+ */
+void headless_init();
+
+/**
+ * Terminate the headless emulator.
+ */
+void headless_terminate();
+
+/**
+ * Run the emulator for a given amount of simulated time.
+ *
+ * @param mseconds: simulated time, in milliseconds.
+ */
+void headless_run(const unsigned int mseconds);
+
+/**
+ * Press and release a set of keys, running the emulator until the UI has
+ * processed the key release.
+ *
+ * @param keys: keys to be pressed simultaneously.
+ */
+void headless_pressKeys(const keyboard_t keys);
+
+/**
+ * Keep a set of keys pressed for a given amount of time, then release them.
+ *
+ * @param keys: keys to be pressed simultaneously.
+ * @param mseconds: press duration, in milliseconds.
+ */
+void headless_holdKeys(const keyboard_t keys, const unsigned int mseconds);
+
+/**
+ * Convert a key name to the corresponding keyboard_t value. The name is case
+ * insensitive and can be given with or without the "KEY_" prefix, for example
+ * "KEY_ENTER", "enter" or "KNOB_LEFT".
+ *
+ * @param name: key name.
+ * @return key value or zero if the name is not valid.
+ */
+keyboard_t headless_keyFromName(const char *name);
+
+/**
+ * Compute a hash of the current screen content.
+ *
+ * @return screen hash.
+ */
+uint32_t headless_screenHash();
+
+/**
+ * Save the current screen content to a file, in binary PPM format.
+ *
+ * @param fileName: path of the output file.
+ * @return zero on success, a negative error code otherwise.
+ */
+int headless_saveScreen(const char *fileName);
+
+/**
+ * Run a script of emulator commands, one per line. Empty lines and lines
+ * starting with '#' are ignored. The supported commands are:
+ *
+ * - key K1 K2 ...: press and release the given keys in sequence;
+ * - keycombo K1 K2 ...: press and release the given keys simultaneously;
+ * - hold MS K1 K2 ...: keep the given keys pressed for MS milliseconds;
+ * - sleep MS: run the emulator for MS milliseconds;
+ * - rssi, vbat, mic, volume, channel VALUE: set an emulated input value;
+ * - ptt: toggle the PTT status;
+ * - hash: print the screen hash on the standard output;
+ * - expect HASH: check that the screen hash is equal to the given one;
+ * - screenshot FILE: save the screen content to a file.
+ *
+ * @param script: NULL-terminated script text.
+ * @return number of failed checks, -1 if the script contains an error.
+ */
+int headless_runScript(const char *script);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEADLESS_H */
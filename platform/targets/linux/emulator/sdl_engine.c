@@ -5,12 +5,15 @@
  */
 
 #include <stdlib.h>
+#include <stdatomic.h>
 #include <pthread.h>
 #include "core/state.h"
 #include "sdl_engine.h"
 #include "emulator.h"
 
-chan_t fb_sync;                 // Shared channel to receive frame buffer updates
+#define FRAME_PERIOD  16      // Display refresh period, in ms (about 60Hz)
+#define NEW_FRAME     0x04    // Flag marking a frame not yet shown
+
 Uint32 SDL_Screenshot_Event;    // Shared custom SDL event to request a screenshot
 Uint32 SDL_Backlight_Event;     // Shared custom SDL event to change backlight
 
@@ -21,6 +24,18 @@ static SDL_Texture  *displayTexture;
 static bool       ready = false;  // Signal if the main loop is ready
 static keyboard_t sdl_keys;       // Store the keyboard status
 
+/*
+ * Triple buffer for the frames to be shown: one buffer is written by the
+ * display driver, one is being shown by the SDL main loop and the third one
+ * holds the latest published frame. Buffers are exchanged by swapping their
+ * indices, the one of the latest frame is tagged with NEW_FRAME until the
+ * frame is picked up by the main loop.
+ */
+static PIXEL_SIZE          frames[3][CONFIG_SCREEN_WIDTH * CONFIG_SCREEN_HEIGHT];
+static uint8_t             writeIdx  = 0;   // Owned by the display driver
+static uint8_t             showIdx   = 1;   // Owned by the SDL main loop
+static atomic_uint_fast8_t latestIdx = 2;   // Shared
+
 
 static bool sdk_key_code_to_key(SDL_Keycode sym, keyboard_t *key)
 {
@@ -259,6 +274,44 @@ static bool set_brightness(uint8_t brightness)
     return colMod;
 }
 
+static void handle_event(const SDL_Event *ev)
+{
+    keyboard_t key = 0;
+
+    switch (ev->type)
+    {
+        case SDL_QUIT:
+            emulator_state.powerOff = true;
+            break;
+
+        case SDL_KEYDOWN:
+            if (sdk_key_code_to_key(ev->key.keysym.sym, &key))
+            {
+                sdl_keys |= key;
+            }
+            break;
+
+        case SDL_KEYUP:
+            if (sdk_key_code_to_key(ev->key.keysym.sym, &key))
+            {
+                sdl_keys ^= key;
+            }
+            break;
+    }
+
+    if (ev->type == SDL_Screenshot_Event)
+    {
+        char *filename = (char *)ev->user.data1;
+        screenshot_display(filename);
+        free(ev->user.data1);
+    }
+    else if (ev->type == SDL_Backlight_Event)
+    {
+        set_brightness(*((uint8_t*)ev->user.data1));
+        free(ev->user.data1);
+    }
+}
+
 
 
 void sdlEngine_init()
@@ -273,8 +326,6 @@ void sdlEngine_init()
     SDL_Screenshot_Event = SDL_RegisterEvents(2);
     SDL_Backlight_Event = SDL_Screenshot_Event+1;
 
-    chan_init(&fb_sync);
-
     window = SDL_CreateWindow("OpenRTX",
                               SDL_WINDOWPOS_UNDEFINED,
                               SDL_WINDOWPOS_UNDEFINED,
@@ -305,60 +356,26 @@ void sdlEngine_run()
 
     while (!emulator_state.powerOff)
     {
-        keyboard_t key = 0;
-
-        if (SDL_PollEvent(&ev) == 1)
+        /*
+         * Sleep until an event arrives or the refresh period expires, then
+         * process all the pending events.
+         */
+        if (SDL_WaitEventTimeout(&ev, FRAME_PERIOD) == 1)
         {
-            switch (ev.type)
-            {
-                case SDL_QUIT:
-                    emulator_state.powerOff = true;
-                    break;
-
-                case SDL_KEYDOWN:
-                    if (sdk_key_code_to_key(ev.key.keysym.sym, &key))
-                    {
-                        sdl_keys |= key;
-                    }
-                    break;
-
-                case SDL_KEYUP:
-                    if (sdk_key_code_to_key(ev.key.keysym.sym, &key))
-                    {
-                        sdl_keys ^= key;
-                    }
-                    break;
-            }
-
-            if (ev.type == SDL_Screenshot_Event)
+            do
             {
-                char *filename = (char *)ev.user.data1;
-                screenshot_display(filename);
-                free(ev.user.data1);
-            }
-            else if (ev.type == SDL_Backlight_Event)
-            {
-                set_brightness(*((uint8_t*)ev.user.data1));
-                free(ev.user.data1);
+                handle_event(&ev);
             }
+            while (SDL_PollEvent(&ev) == 1);
         }
 
-        // we update the window only if there is a something ready to render
-        if (chan_can_send(&fb_sync))
+        // we update the window only if a new frame has been published
+        if (atomic_load(&latestIdx) & NEW_FRAME)
         {
-            PIXEL_SIZE *pixels;
-            int pitch = 0;
+            showIdx = atomic_exchange(&latestIdx, showIdx) & ~NEW_FRAME;
 
-            if (SDL_LockTexture(displayTexture, NULL,
-                                (void **) &pixels, &pitch) < 0)
-            {
-                SDL_Log("SDL_lock failed: %s", SDL_GetError());
-            }
-
-            chan_send(&fb_sync, pixels);
-            chan_recv(&fb_sync, NULL);
-
-            SDL_UnlockTexture(displayTexture);
+            SDL_UpdateTexture(displayTexture, NULL, frames[showIdx],
+                              CONFIG_SCREEN_WIDTH * sizeof(PIXEL_SIZE));
             SDL_RenderCopy(renderer, displayTexture, NULL, NULL);
             SDL_RenderPresent(renderer);
         }
@@ -381,6 +398,16 @@ bool sdlEngine_ready()
     return ready;
 }
 
+PIXEL_SIZE *sdlEngine_getFrameBuffer()
+{
+    return frames[writeIdx];
+}
+
+void sdlEngine_presentFrame()
+{
+    writeIdx = atomic_exchange(&latestIdx, writeIdx | NEW_FRAME) & ~NEW_FRAME;
+}
+
 keyboard_t sdlEngine_getKeys()
 {
     /*
@@ -10,7 +10,6 @@
 #include "interfaces/keyboard.h"
 #include "SDL2/SDL.h"
 #include <stdbool.h>
-#include "core/chan.h"
 
 /*
  * Screen dimensions, adjust basing on the size of the screen you need to
@@ -49,6 +48,25 @@ void sdlEngine_run();
  */
 bool sdlEngine_ready();
 
+/**
+ * Get the buffer where the next frame to be shown has to be written. Frames
+ * are exchanged with the SDL main loop through a triple buffer: the returned
+ * buffer is owned by the caller until the frame is published and its content
+ * is undefined, it may hold any of the previous frames. Must always be called
+ * from the same thread.
+ *
+ * @return pointer to a buffer of CONFIG_SCREEN_WIDTH * CONFIG_SCREEN_HEIGHT
+ * pixels.
+ */
+PIXEL_SIZE *sdlEngine_getFrameBuffer();
+
+/**
+ * Publish the frame written in the buffer returned by sdlEngine_getFrameBuffer()
+ * as the latest one. This function never blocks: the frame is shown by the SDL
+ * main loop on its next refresh, replacing any previous frame not yet shown.
+ */
+void sdlEngine_presentFrame();
+
 /**
  * Thread-safe function returning the keys currently being pressed.
  *
@@ -28,6 +28,11 @@ enum Mod17Flags
 /* Device supports M17 mode */
 #define CONFIG_M17
 
+/* GPS track log stored in its own file, 64 blocks */
+#define CONFIG_TRACKLOG_NVM_AREA 1
+#define CONFIG_TRACKLOG_NVM_PART 0
+#define CONFIG_TRACKLOG_SIZE     0x40000
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,7 +7,10 @@
 #include "calibration/calibInfo_Mod17.h"
 #include "interfaces/platform.h"
 #include "interfaces/nvmem.h"
+#include "interfaces/delays.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
 #include "core/gps.h"
 #include "emulator.h"
 
@@ -79,13 +82,15 @@ int8_t platform_getChSelector()
 
 bool platform_getPttStatus()
 {
+    #ifndef CONFIG_HEADLESS
     // Read P key status from SDL
     const uint8_t *state = SDL_GetKeyboardState(NULL);
 
-    if ((state[SDL_SCANCODE_P] != 0) || (emulator_state.PTTstatus == true))
+    if (state[SDL_SCANCODE_P] != 0)
         return true;
-    else
-        return false;
+    #endif
+
+    return emulator_state.PTTstatus;
 }
 
 bool platform_pwrButtonStatus()
@@ -114,13 +119,26 @@ void platform_beepStop()
     printf("platform_beepStop()\n");
 }
 
+#ifdef CONFIG_VIRTUAL_TIME
+/*
+ * With simulated time the RTC follows the system tick, starting from
+ * 2025-01-01 00:00:00 UTC.
+ */
+static time_t    rtcTime = 1735689600;
+static long long rtcTick = 0;
+#endif
+
 datetime_t platform_getCurrentTime()
 {
     datetime_t t;
 
     time_t rawtime;
     struct tm * timeinfo;
+    #ifdef CONFIG_VIRTUAL_TIME
+    rawtime = rtcTime + ((getTick() - rtcTick) / 1000);
+    #else
     time ( &rawtime );
+    #endif
     // radio expects time to be TZ-less, so use gmtime instead of localtime.
     timeinfo = gmtime ( &rawtime );
 
@@ -138,9 +156,23 @@ datetime_t platform_getCurrentTime()
 
 void platform_setTime(datetime_t t)
 {
+    #ifdef CONFIG_VIRTUAL_TIME
+    struct tm timeinfo = { 0 };
+
+    timeinfo.tm_hour = t.hour;
+    timeinfo.tm_min  = t.minute;
+    timeinfo.tm_sec  = t.second;
+    timeinfo.tm_mday = t.date;
+    timeinfo.tm_mon  = t.month - 1;
+    timeinfo.tm_year = t.year + 100;
+
+    rtcTime = timegm(&timeinfo);
+    rtcTick = getTick();
+    #else
     (void) t;
 
     printf("rtc_setTime(t)\n");
+    #endif
 }
 
 const hwInfo_t *platform_getHwInfo()
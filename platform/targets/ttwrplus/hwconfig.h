@@ -17,6 +17,9 @@
 #define CONFIG_SCREEN_HEIGHT DT_PROP(DISPLAY, height)
 #define CONFIG_PIX_FMT_BW
 
+/* Framebuffer stored in display page order */
+#define CONFIG_PIX_FMT_BW_PAGED
+
 #define CONFIG_GPS
 #define CONFIG_NMEA_RBUF_SIZE 128
 
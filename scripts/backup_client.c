@@ -0,0 +1,264 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+/*
+ * Host side client for the backup and restore of the radio external flash
+ * memory, using the streaming protocol of openrtx/include/core/backup_stream.h
+ *
+ * Build from the repository root with:
+ *
+ * gcc -O2 -Iopenrtx/include scripts/backup_client.c \
+ *     openrtx/src/core/backup_stream.c openrtx/src/core/crc.c -o backup_client
+ */
+
+#include "core/backup_stream.h"
+#include <sys/time.h>
+#include <stdbool.h>
+#include <termios.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <poll.h>
+
+
+#define MAX_SIZE (64 * 1024 * 1024)
+
+
+long long getTick()
+{
+    struct timeval te;
+    gettimeofday(&te, NULL);
+    return te.tv_sec*1000LL + te.tv_usec/1000;
+}
+
+static ssize_t serialRead(void *ctx, void *buf, size_t len)
+{
+    int fd = *((int *) ctx);
+    struct pollfd pfd = { fd, POLLIN, 0 };
+
+    int ret = poll(&pfd, 1, 2);
+    if(ret <= 0)
+        return ret;
+
+    return read(fd, buf, len);
+}
+
+static ssize_t serialWrite(void *ctx, const void *buf, size_t len)
+{
+    int fd = *((int *) ctx);
+    size_t written = 0;
+
+    while(written < len)
+    {
+        ssize_t ret = write(fd, ((const uint8_t *) buf) + written,
+                            len - written);
+        if(ret < 0)
+            return ret;
+
+        written += ret;
+    }
+
+    return written;
+}
+
+static int fileRead(void *ctx, uint32_t offset, void *buf, size_t len)
+{
+    FILE *fp = (FILE *) ctx;
+
+    if(fseek(fp, offset, SEEK_SET) != 0)
+        return -1;
+
+    if(fread(buf, 1, len, fp) != len)
+        return -1;
+
+    return 0;
+}
+
+static int fileWrite(void *ctx, uint32_t offset, const void *buf, size_t len)
+{
+    FILE *fp = (FILE *) ctx;
+    uint8_t erased[BSTREAM_FRAME_SIZE];
+
+    if(buf == NULL)
+    {
+        memset(erased, 0xFF, len);
+        buf = erased;
+    }
+
+    if(fseek(fp, offset, SEEK_SET) != 0)
+        return -1;
+
+    if(fwrite(buf, 1, len, fp) != len)
+        return -1;
+
+    return 0;
+}
+
+static int fileFlush(void *ctx)
+{
+    return fflush((FILE *) ctx);
+}
+
+static int openSerial(const char *port)
+{
+    int fd = open(port, O_RDWR | O_NOCTTY);
+    if(fd < 0)
+        return -1;
+
+    struct termios tty;
+    if(tcgetattr(fd, &tty) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    cfmakeraw(&tty);
+    cfsetspeed(&tty, B115200);
+    tty.c_cc[VMIN]  = 0;
+    tty.c_cc[VTIME] = 0;
+
+    if(tcsetattr(fd, TCSANOW, &tty) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    tcflush(fd, TCIOFLUSH);
+    return fd;
+}
+
+static void printHelp()
+{
+    puts("OpenRTX external flash backup tool.");
+    puts("Usage: backup_client [OPTIONS]...");
+    puts("Options:");
+    puts("-d\t Dump the flash content to file");
+    puts("-r\t Restore the flash content from file");
+    puts("-e\t Send erased areas without their content (restore only)");
+    puts("-p\t Serial port of the radio");
+    puts("-f\t Backup file");
+}
+
+
+int main(int argc, char *argv[])
+{
+    char portName[512] = "";
+    char fileName[512] = "";
+    bool dump       = false;
+    bool restore    = false;
+    bool skipErased = false;
+
+    if(argc <= 2)
+    {
+        printHelp();
+        return 0;
+    }
+
+    while(1)
+    {
+        int opt = getopt(argc, argv, "drep:f:");
+        if(opt == -1)
+            break;
+
+        switch(opt)
+        {
+            case 'd':
+                dump = true;
+                break;
+
+            case 'r':
+                restore = true;
+                break;
+
+            case 'e':
+                skipErased = true;
+                break;
+
+            case 'p':
+                if(strlen(optarg) >= sizeof(portName))
+                {
+                    puts("Error: serial port name is too long!");
+                    return -1;
+                }
+
+                strncpy(portName, optarg, sizeof(portName));
+                break;
+
+            case 'f':
+                if(strlen(optarg) >= sizeof(fileName))
+                {
+                    puts("Error: file name is too long!");
+                    return -1;
+                }
+
+                strncpy(fileName, optarg, sizeof(fileName));
+                break;
+
+            default:
+                printHelp();
+                return 0;
+                break;
+        }
+    }
+
+    if(dump == restore)
+    {
+        puts("Error: select either dump or restore!");
+        return -1;
+    }
+
+    int fd = openSerial(portName);
+    if(fd < 0)
+    {
+        puts("Error opening serial port!");
+        return -1;
+    }
+
+    FILE *file = fopen(fileName, dump ? "wb" : "rb");
+    if(file == NULL)
+    {
+        close(fd);
+        puts("Error opening backup file!");
+        return -1;
+    }
+
+    const bsLink_t    link    = { serialRead, serialWrite, &fd };
+    const bsStorage_t storage = { fileRead, fileWrite, fileFlush, file };
+
+    long long start = getTick();
+    ssize_t   ret;
+
+    if(dump)
+    {
+        ret = bstream_receive(&link, &storage, MAX_SIZE);
+    }
+    else
+    {
+        fseek(file, 0, SEEK_END);
+        size_t size = ftell(file);
+        ret = bstream_send(&link, &storage, size, skipErased);
+    }
+
+    long long elapsed = getTick() - start;
+
+    fclose(file);
+    close(fd);
+
+    if(ret < 0)
+    {
+        printf("Transfer failed, error %zd\n", ret);
+        return -1;
+    }
+
+    printf("Transferred %zd bytes in %lld ms", ret, elapsed);
+    if(elapsed > 0)
+        printf(" (%lld kB/s)", (ret * 1000LL) / (elapsed * 1024LL));
+    puts("");
+
+    return 0;
+}
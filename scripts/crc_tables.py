@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# Generate the lookup tables used by the table-driven and slice-by-N CRC
+# implementations in openrtx/src/core/crc.c
+#
+# Usage, from the repository root:
+#
+#   python3 scripts/crc_tables.py > openrtx/src/core/crc_tables.h
+
+SLICES = 8
+
+
+def crc16_tables(poly):
+    """Tables for a non reflected 16-bit CRC, slice k processes a byte followed
+    by k zero bytes."""
+    base = []
+    for i in range(256):
+        crc = i << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ poly) if (crc & 0x8000) else (crc << 1)
+        base.append(crc & 0xFFFF)
+
+    tables = [base]
+    for _ in range(1, SLICES):
+        prev = tables[-1]
+        tables.append([((v << 8) & 0xFFFF) ^ base[v >> 8] for v in prev])
+
+    return tables
+
+
+def crc32_tables(poly):
+    """Tables for a reflected 32-bit CRC, slice k processes a byte followed by
+    k zero bytes."""
+    base = []
+    for i in range(256):
+        crc = i
+        for _ in range(8):
+            crc = ((crc >> 1) ^ poly) if (crc & 1) else (crc >> 1)
+        base.append(crc)
+
+    tables = [base]
+    for _ in range(1, SLICES):
+        prev = tables[-1]
+        tables.append([(v >> 8) ^ base[v & 0xFF] for v in prev])
+
+    return tables
+
+
+def print_table(name, ctype, digits, tables):
+    perLine = 8 if digits == 4 else 6
+
+    print('static const {} {}[CRC_TABLE_SLICES][256] ='.format(ctype, name))
+    print('{')
+
+    for k, table in enumerate(tables):
+        if k == 1:
+            print('#if CRC_TABLE_SLICES > 1')
+        if k == 4:
+            print('#if CRC_TABLE_SLICES > 4')
+
+        print('    {')
+        for i in range(0, 256, perLine):
+            values = ', '.join('0x{:0{}x}'.format(v, digits)
+                               for v in table[i:i + perLine])
+            print('        {},'.format(values))
+        print('    },')
+
+        if k in (3, 7):
+            print('#endif')
+
+    print('};')
+    print()
+
+
+print('''/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+/*
+ * Lookup tables for the CRC functions, generated by scripts/crc_tables.py.
+ * Only the number of slices required by CRC_TABLE_SLICES is compiled in.
+ */
+
+#ifndef CRC_TABLES_H
+#define CRC_TABLES_H
+''')
+
+print_table('CRC_M17_TABLE',   'uint16_t', 4, crc16_tables(0x5935))
+print_table('CRC_CCITT_TABLE', 'uint16_t', 4, crc16_tables(0x1021))
+print_table('CRC_32_TABLE',    'uint32_t', 8, crc32_tables(0xEDB88320))
+
+print('#endif /* CRC_TABLES_H */')
@@ -0,0 +1,291 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "protocols/M17/FrameEncoder.hpp"
+#include "protocols/M17/FrameDecoder.hpp"
+#include "protocols/M17/Demodulator.hpp"
+#include "protocols/M17/Modulator.hpp"
+#include "M17_channel.hpp"
+
+/*
+ * BER and FER of the M17 receiver as a function of Eb/N0, measured on the
+ * signal generated by the modulator and passed through the channel simulator.
+ *
+ * Each point of a curve is obtained from a transmission made of the preamble,
+ * the LSF, a number of stream frames with random payload and the EOT. The
+ * received frames are matched to the transmitted ones from their time of
+ * arrival: the raw BER is computed on the demodulated frames before the
+ * error correction, while a stream frame is counted as lost if it is not
+ * received or its decoded payload or frame number are wrong.
+ *
+ * The curves are written in CSV format to the file given by the M17_BER_CSV
+ * environment variable, m17_ber.csv by default.
+ */
+
+using namespace M17;
+
+static constexpr size_t NUM_FRAMES   = 250;               // Stream frames per point
+static constexpr size_t RX_FRAME_LEN = FRAME_SYMBOLS * 5; // Frame length at 24kHz
+
+struct Result
+{
+    float  rawBer;
+    float  fer;
+};
+
+/*
+ * Transmission with random payload, the modulator baseband is collected in a
+ * vector.
+ */
+struct Transmission
+{
+    std::vector< int16_t >   baseband;
+    std::vector< frame_t >   frames;     // LSF, stream frames, EOT
+    std::vector< payload_t > payloads;
+
+    Transmission(const size_t numFrames, const uint32_t seed)
+    {
+        std::mt19937   rng(seed);
+        FrameEncoder   encoder;
+        Modulator      modulator;
+        LinkSetupFrame lsf;
+        frame_t        frame;
+
+        modulator.init();
+        modulator.invertPhase(false);
+        modulator.setBasebandSink([this](const int16_t *data, size_t len)
+        {
+            baseband.insert(baseband.end(), data, data + len);
+        });
+        modulator.start();
+
+        streamType_t type;
+        type.value           = 0;
+        type.fields.dataMode = DATAMODE_STREAM;
+        type.fields.dataType = DATATYPE_DATA;
+
+        lsf.clear();
+        lsf.setSource(Callsign("N0CALL"));
+        lsf.setDestination(Callsign("ALL"));
+        lsf.setType(type);
+        encoder.reset();
+        encoder.encodeLsf(lsf, frame);
+
+        modulator.sendPreamble();
+        modulator.sendFrame(frame);
+        frames.push_back(frame);
+
+        for(size_t i = 0; i < numFrames; i++)
+        {
+            payload_t payload;
+            for(auto& byte : payload)
+                byte = rng();
+
+            encoder.encodeStreamFrame(payload, frame, i == (numFrames - 1));
+            modulator.sendFrame(frame);
+            frames.push_back(frame);
+            payloads.push_back(payload);
+        }
+
+        encoder.encodeEotFrame(frame);
+        modulator.sendFrame(frame);
+        frames.push_back(frame);
+
+        // Trailing silence, letting the receiver filters flush
+        baseband.insert(baseband.end(), 2 * FRAME_SYMBOLS * 10, 0);
+        modulator.stop();
+        modulator.terminate();
+    }
+};
+
+static size_t bitErrors(const uint8_t *a, const uint8_t *b, const size_t len)
+{
+    size_t errors = 0;
+    for(size_t i = 0; i < len; i++)
+        errors += __builtin_popcount(a[i] ^ b[i]);
+
+    return errors;
+}
+
+/*
+ * RMS value of the modulator output for random symbols, computed on the
+ * stream frames of a transmission.
+ */
+static float modulatorRms(const Transmission& tx)
+{
+    const size_t start = 3 * FRAME_SYMBOLS * 10;
+    const size_t end   = start + (NUM_FRAMES * FRAME_SYMBOLS * 10);
+    double       sum   = 0.0;
+
+    for(size_t i = start; i < end; i++)
+        sum += static_cast< double >(tx.baseband[i]) * tx.baseband[i];
+
+    return std::sqrt(sum / (end - start));
+}
+
+/*
+ * Pass a transmission through the channel and the receiver.
+ *
+ * @param delay: delay between the end of a transmitted frame and its
+ * reception, in samples at 24kHz. Set by the function when zero.
+ */
+static Result receive(const Transmission& tx, const ChannelParams& params,
+                      const float txRms, const uint32_t seed, size_t& delay)
+{
+    ChannelSimulator       channel(params, txRms, seed);
+    std::vector< int16_t > rxBaseband;
+    channel.process(tx.baseband.data(), tx.baseband.size(), rxBaseband);
+
+    Demodulator  demodulator;
+    FrameDecoder decoder;
+    demodulator.init();
+    decoder.reset();
+
+    std::vector< bool > received(tx.frames.size(), false);
+    size_t rawErrors = 0;
+    size_t rawBits   = 0;
+    size_t good      = 0;
+
+    for(size_t i = 0; i < rxBaseband.size(); i++)
+    {
+        if(demodulator.sample(rxBaseband[i]) == false)
+            continue;
+
+        const frame_t& frame = demodulator.getFrame();
+
+        // Frame number from the time of arrival, the preamble is two frames
+        // long and is followed by the LSF
+        if(delay == 0)
+            delay = i - (3 * RX_FRAME_LEN);
+
+        long   offset = static_cast< long >(i) - static_cast< long >(delay);
+        long   index  = ((offset + (RX_FRAME_LEN / 2)) / RX_FRAME_LEN) - 3;
+        if((index < 0) || (index >= static_cast< long >(tx.frames.size()))
+                       || received[index])
+            continue;
+
+        received[index] = true;
+
+        const frame_t& txFrame = tx.frames[index];
+        rawErrors += bitErrors(frame.data() + 2, txFrame.data() + 2, frame.size() - 2);
+        rawBits   += (frame.size() - 2) * 8;
+
+        if((index == 0) || (index > static_cast< long >(NUM_FRAMES)))
+            continue;
+
+        // Stream frame
+        if(decoder.decodeFrame(frame) != FrameType::STREAM)
+            continue;
+
+        StreamFrame      sf      = decoder.getStreamFrame();
+        const payload_t& payload = tx.payloads[index - 1];
+        uint16_t         fn      = sf.getFrameNumber() & 0x7FFF;
+        if((fn == (index - 1)) &&
+           (memcmp(sf.data(), payload.data(), payload.size()) == 0))
+        {
+            good += 1;
+        }
+    }
+
+    demodulator.terminate();
+
+    Result result;
+    result.rawBer = (rawBits > 0) ? static_cast< float >(rawErrors) / rawBits : 0.5f;
+    result.fer    = 1.0f - (static_cast< float >(good) / NUM_FRAMES);
+
+    return result;
+}
+
+/*
+ * Compute a BER/FER curve, appending it to the CSV file.
+ */
+static std::vector< Result > sweep(const char *name, ChannelParams params,
+                                   const std::vector< float >& ebN0)
+{
+    static bool header = true;
+
+    const char *path = getenv("M17_BER_CSV");
+    if(path == NULL)
+        path = "m17_ber.csv";
+
+    FILE *csv = fopen(path, header ? "w" : "a");
+    if(csv && header)
+        fprintf(csv, "channel,ebn0_db,frames,raw_ber,fer\n");
+
+    header = false;
+
+    Transmission tx(NUM_FRAMES, 1234);
+    float txRms = modulatorRms(tx);
+
+    // Reception delay measured on the ideal channel
+    size_t delay = 0;
+    receive(tx, ChannelParams(), txRms, 1, delay);
+
+    std::vector< Result > results;
+    for(size_t i = 0; i < ebN0.size(); i++)
+    {
+        params.ebN0   = ebN0[i];
+        Result result = receive(tx, params, txRms, 100 + i, delay);
+        results.push_back(result);
+
+        printf("%-10s Eb/N0 %5.1f dB: raw BER %.2e, FER %.4f\n", name, ebN0[i],
+               result.rawBer, result.fer);
+
+        if(csv)
+            fprintf(csv, "%s,%.1f,%zu,%.6e,%.6f\n", name, ebN0[i], NUM_FRAMES,
+                    result.rawBer, result.fer);
+    }
+
+    if(csv)
+        fclose(csv);
+
+    return results;
+}
+
+static const std::vector< float > ebN0Range = { 4.0f, 6.0f, 8.0f, 10.0f,
+                                                12.0f, 14.0f, 16.0f, 20.0f };
+
+TEST_CASE("M17 BER/FER on AWGN channel", "[m17][benchmark]")
+{
+    ChannelParams params;
+    auto res = sweep("awgn", params, ebN0Range);
+
+    // Monotonic curve and error-free reception on a strong signal
+    for(size_t i = 1; i < res.size(); i++)
+        REQUIRE(res[i].rawBer <= (res[i - 1].rawBer + 0.005f));
+
+    REQUIRE(res[4].fer < 0.05f);     // 12dB
+    REQUIRE(res[7].fer == 0.0f);     // 20dB
+}
+
+TEST_CASE("M17 BER/FER with frequency and clock errors", "[m17][benchmark]")
+{
+    ChannelParams params;
+    params.freqOffset = 800.0f;
+    params.freqDrift  = 50.0f;
+    params.clockError = 50.0f;
+    params.devError   = -0.1f;
+    auto res = sweep("offset", params, ebN0Range);
+
+    REQUIRE(res[5].fer < 0.05f);     // 14dB
+    REQUIRE(res[7].fer < 0.01f);     // 20dB
+}
+
+TEST_CASE("M17 BER/FER on Rayleigh fading channel", "[m17][benchmark]")
+{
+    ChannelParams params;
+    params.doppler = 5.0f;
+    auto res = sweep("rayleigh", params, ebN0Range);
+
+    REQUIRE(res[7].fer < 0.25f);     // 20dB
+}
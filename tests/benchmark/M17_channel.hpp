@@ -0,0 +1,221 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef M17_CHANNEL_H
+#define M17_CHANNEL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <complex>
+#include <vector>
+#include <random>
+#include <cmath>
+
+/**
+ * Radio channel parameters.
+ */
+struct ChannelParams
+{
+    float ebN0       = 100.0f;  ///< Eb/N0 at the receiver input, in dB
+    float freqOffset = 0.0f;    ///< Carrier frequency offset, in Hz
+    float freqDrift  = 0.0f;    ///< Carrier frequency drift, in Hz/s
+    float clockError = 0.0f;    ///< Transmitter symbol clock error, in ppm
+    float devError   = 0.0f;    ///< Relative deviation error, 0.1 = +10%
+    float doppler    = 0.0f;    ///< Rayleigh fading Doppler spread, in Hz
+};
+
+/**
+ * Simulator of the radio channel between an M17 modulator and demodulator.
+ *
+ * The 48kHz baseband generated by the modulator is resampled according to the
+ * transmitter clock error and FM modulated on a complex envelope with unit
+ * amplitude. The envelope is then shifted by the carrier frequency offset,
+ * multiplied by the fading gain and added of white gaussian noise with the
+ * power given by Eb/N0. On the receiving side, a 12.5kHz channel filter and a
+ * phase discriminator recover the baseband, which is finally low-pass filtered
+ * and decimated to the 24kHz rate of the demodulator.
+ *
+ * The nominal deviation is such that a baseband with the same RMS value of
+ * the modulator output for random symbols corresponds to the RMS deviation of
+ * the M17 4FSK signal, that is sqrt(5) times the 800Hz inner deviation.
+ */
+class ChannelSimulator
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param params: channel parameters.
+     * @param txRms: RMS value of the modulator output for random symbols.
+     * @param seed: seed of the random number generator.
+     */
+    ChannelSimulator(const ChannelParams& params, const float txRms,
+                     const uint32_t seed) : params(params), rng(seed),
+                     txPos(0.0), txPhase(0.0), carrierPhase(0.0), time(0.0),
+                     lastSample(0.0f), prevEnv(1.0f, 0.0f), decimate(false)
+    {
+        const float ebN0 = std::pow(10.0f, params.ebN0 / 10.0f);
+
+        // Unit signal power, Eb = 1 / bit rate and N0 spread over the whole
+        // sampling bandwidth
+        noiseSigma = std::sqrt((IN_RATE / BIT_RATE) / ebN0 / 2.0f);
+        hzPerUnit  = (DEV_RMS / txRms) * (1.0f + params.devError);
+        clockStep  = 1.0 / (1.0 + (params.clockError * 1e-6));
+
+        lowPass(chanTaps, CHANNEL_CUTOFF);
+        lowPass(decTaps,  DECIM_CUTOFF);
+        chanHist.assign(chanTaps.size(), 0.0f);
+        decHist.assign(decTaps.size(), 0.0f);
+
+        // Sum of sinusoids model for the Rayleigh fading gain
+        std::uniform_real_distribution< double > angle(0.0, 2.0 * M_PI);
+        for(size_t i = 0; i < FADING_PATHS; i++)
+        {
+            fadeFreq[i]  = 2.0 * M_PI * params.doppler * std::cos(angle(rng));
+            fadePhase[i] = angle(rng);
+        }
+    }
+
+    /**
+     * Process a block of baseband samples.
+     *
+     * @param in: baseband samples from the modulator, at 48kHz.
+     * @param len: number of samples.
+     * @param out: vector where the samples for the demodulator, at 24kHz, are
+     * appended.
+     */
+    void process(const int16_t *in, const size_t len, std::vector< int16_t >& out)
+    {
+        for(size_t i = 0; i < len; i++)
+        {
+            // A fast transmitter clock produces more samples per input sample
+            float sample = static_cast< float >(in[i]);
+            while(txPos < 1.0)
+            {
+                float interp = lastSample + (sample - lastSample) * txPos;
+                channel(interp, out);
+                txPos += clockStep;
+            }
+
+            txPos     -= 1.0;
+            lastSample = sample;
+        }
+    }
+
+    /**
+     * Scale of the demodulator input, in LSB per Hz of deviation.
+     */
+    static constexpr float RX_SCALE = 3.0f;
+
+private:
+
+    using complex = std::complex< float >;
+
+    /**
+     * Transmit and receive a single sample of the modulator baseband.
+     */
+    void channel(const float sample, std::vector< int16_t >& out)
+    {
+        const double dt = 1.0 / IN_RATE;
+
+        txPhase      += 2.0 * M_PI * sample * hzPerUnit * dt;
+        carrierPhase += 2.0 * M_PI * (params.freqOffset + params.freqDrift * time) * dt;
+        time         += dt;
+
+        complex env = std::polar(1.0f, static_cast< float >(txPhase + carrierPhase));
+
+        if(params.doppler > 0.0f)
+        {
+            std::complex< double > gain = 0.0;
+            for(size_t i = 0; i < FADING_PATHS; i++)
+                gain += std::polar(1.0, fadeFreq[i] * time + fadePhase[i]);
+
+            env *= complex(gain / std::sqrt(static_cast< double >(FADING_PATHS)));
+        }
+
+        env += complex(noise(rng), noise(rng)) * noiseSigma;
+
+        // Channel filter and phase discriminator
+        chanHist.erase(chanHist.begin());
+        chanHist.push_back(env);
+        complex filt = 0.0f;
+        for(size_t i = 0; i < chanTaps.size(); i++)
+            filt += chanHist[i] * chanTaps[i];
+
+        float freq = std::arg(filt * std::conj(prevEnv)) * IN_RATE / (2.0f * M_PI);
+        prevEnv    = filt;
+
+        // Post-detection filter and decimation
+        decHist.erase(decHist.begin());
+        decHist.push_back(freq);
+        decimate = !decimate;
+        if(decimate == false)
+            return;
+
+        float base = 0.0f;
+        for(size_t i = 0; i < decTaps.size(); i++)
+            base += decHist[i] * decTaps[i];
+
+        base = std::round(base * RX_SCALE);
+        base = std::min(std::max(base, -32768.0f), 32767.0f);
+        out.push_back(static_cast< int16_t >(base));
+    }
+
+    /**
+     * Design a Hamming-windowed sinc low-pass filter with unity DC gain.
+     */
+    static void lowPass(std::vector< float >& taps, const float cutoff)
+    {
+        const float fc  = cutoff / IN_RATE;
+        const int   mid = FILTER_TAPS / 2;
+        float       sum = 0.0f;
+
+        taps.resize(FILTER_TAPS);
+        for(int i = 0; i < FILTER_TAPS; i++)
+        {
+            float x   = static_cast< float >(i - mid);
+            float h   = (i == mid) ? (2.0f * fc)
+                                   : std::sin(2.0f * M_PI * fc * x) / (M_PI * x);
+            float win = 0.54f - 0.46f * std::cos(2.0f * M_PI * i / (FILTER_TAPS - 1));
+            taps[i]   = h * win;
+            sum      += taps[i];
+        }
+
+        for(auto& tap : taps)
+            tap /= sum;
+    }
+
+    static constexpr float  IN_RATE        = 48000.0f;
+    static constexpr float  BIT_RATE       = 9600.0f;
+    static constexpr float  DEV_RMS        = 1788.85f;   // sqrt(5) * 800Hz
+    static constexpr float  CHANNEL_CUTOFF = 6250.0f;
+    static constexpr float  DECIM_CUTOFF   = 6000.0f;
+    static constexpr int    FILTER_TAPS    = 63;
+    static constexpr size_t FADING_PATHS   = 16;
+
+    ChannelParams                     params;
+    std::mt19937                      rng;
+    std::normal_distribution< float > noise;
+    std::vector< float >              chanTaps;
+    std::vector< float >              decTaps;
+    std::vector< complex >            chanHist;
+    std::vector< float >              decHist;
+    double                            fadeFreq[FADING_PATHS];
+    double                            fadePhase[FADING_PATHS];
+    double                            txPos;
+    double                            txPhase;
+    double                            carrierPhase;
+    double                            time;
+    double                            clockStep;
+    float                             lastSample;
+    float                             noiseSigma;
+    float                             hzPerUnit;
+    complex                           prevEnv;
+    bool                              decimate;
+};
+
+#endif /* M17_CHANNEL_H */
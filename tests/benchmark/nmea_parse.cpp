@@ -0,0 +1,420 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/nmea.h"
+
+extern "C" {
+#include <minmea.h>
+}
+
+/*
+ * Replay of the NMEA output of a GPS receiver through the streaming parser
+ * and through the previous decoding based on minmea, comparing the resulting
+ * GPS data and the time spent.
+ *
+ * The replayed sentences are read from the file given by the NMEA_REPLAY
+ * environment variable, one per line. When the variable is not set, one hour
+ * of the output of a 10Hz multi-constellation receiver is generated, with
+ * GPS, GLONASS, Galileo and BeiDou satellites in view.
+ */
+
+using clk = std::chrono::steady_clock;
+
+#define KNOTS2KMH(x) ((((int) x) * 1852) / 1000)
+
+/*
+ * Decoding of a sentence with minmea, as done by gps_task before the
+ * introduction of the streaming parser.
+ */
+static void minmeaUpdate(const char *sentence, gps_t& gps_data)
+{
+    int32_t sId = minmea_sentence_id(sentence, false);
+    switch(sId)
+    {
+        case MINMEA_SENTENCE_RMC:
+        {
+            struct minmea_sentence_rmc frame;
+            if (minmea_parse_rmc(&frame, sentence))
+            {
+                gps_data.timestamp.hour = frame.time.hours;
+                gps_data.timestamp.minute = frame.time.minutes;
+                gps_data.timestamp.second = frame.time.seconds;
+                gps_data.timestamp.day = 0;
+                gps_data.timestamp.date = frame.date.day;
+                gps_data.timestamp.month = frame.date.month;
+                gps_data.timestamp.year = frame.date.year;
+                gps_data.speed = KNOTS2KMH(minmea_toint(&frame.speed));
+            }
+        }
+        break;
+
+        case MINMEA_SENTENCE_GGA:
+        {
+            struct minmea_sentence_gga frame;
+            if (minmea_parse_gga(&frame, sentence))
+            {
+                gps_data.latitude = minmea_tofixedpoint(&frame.latitude);
+                gps_data.longitude = minmea_tofixedpoint(&frame.longitude);
+                gps_data.fix_quality = frame.fix_quality;
+                gps_data.satellites_tracked = frame.satellites_tracked;
+                gps_data.altitude = minmea_toint(&frame.altitude);
+            }
+        }
+        break;
+
+        case MINMEA_SENTENCE_GSA:
+        {
+            gps_data.active_sats = 0;
+            struct minmea_sentence_gsa frame;
+            if (minmea_parse_gsa(&frame, sentence))
+            {
+                gps_data.hdop = minmea_toscaledint(&frame.hdop, 100);
+                gps_data.fix_type = frame.fix_type;
+                for (int i = 0; i < 12; i++)
+                {
+                    if (frame.sats[i] != 0 && frame.sats[i] < 31)
+                    {
+                        gps_data.active_sats |= 1 << (frame.sats[i] - 1);
+                    }
+                }
+            }
+        }
+        break;
+
+        case MINMEA_SENTENCE_GSV:
+        {
+            struct minmea_sentence_gsv frame;
+            if (minmea_parse_gsv(&frame, sentence) && (frame.msg_nr < 3))
+            {
+                if (frame.msg_nr == 1)
+                {
+                    memset(&gps_data.satellites[0], 0x00, 12 * sizeof(gpssat_t));
+                }
+
+                gps_data.satellites_in_view = frame.total_sats;
+                for (int i = 0; i < 4; i++)
+                {
+                    int index = 4 * (frame.msg_nr - 1) + i;
+                    gps_data.satellites[index].id = frame.sats[i].nr;
+                    gps_data.satellites[index].elevation = frame.sats[i].elevation;
+                    gps_data.satellites[index].azimuth = frame.sats[i].azimuth;
+                    gps_data.satellites[index].snr = frame.sats[i].snr;
+                }
+            }
+        }
+        break;
+
+        case MINMEA_SENTENCE_VTG:
+        {
+            struct minmea_sentence_vtg frame;
+            if (minmea_parse_vtg(&frame, sentence))
+            {
+                gps_data.speed = minmea_toint(&frame.speed_kph);
+                gps_data.tmg_mag = minmea_toint(&frame.magnetic_track_degrees);
+                gps_data.tmg_true = minmea_toint(&frame.true_track_degrees);
+            }
+        }
+        break;
+
+        default:
+            break;
+    }
+}
+
+/*
+ * Generator of the output of a multi-constellation receiver.
+ */
+class Receiver
+{
+public:
+
+    Receiver(const uint32_t seed) : rng(seed), lat(45.4642), lon(9.1900),
+                                    alt(122.0), course(54.0), speed(12.0),
+                                    time(0)
+    {
+        const char talkers[] = { 'P', 'L', 'A', 'B' };
+        for(size_t i = 0; i < 4; i++)
+        {
+            for(size_t j = 0; j < 10; j++)
+            {
+                Satellite sat;
+                sat.talker    = talkers[i];
+                sat.id        = (i * 32) + 1 + (rng() % 32);
+                sat.elevation = rng() % 90;
+                sat.azimuth   = rng() % 360;
+                sat.snr       = 15 + (rng() % 35);
+                sats.push_back(sat);
+            }
+        }
+    }
+
+    /*
+     * Generate the sentences of one epoch.
+     */
+    void epoch(std::vector< std::string >& out)
+    {
+        std::uniform_real_distribution< double > noise(-1.0, 1.0);
+
+        course += noise(rng);
+        speed   = std::max(0.0, speed + (0.2 * noise(rng)));
+        lat    += speed * 0.1 * std::cos(course * M_PI / 180.0) / 111195.0;
+        lon    += speed * 0.1 * std::sin(course * M_PI / 180.0) / 78400.0;
+        alt    += 0.1 * noise(rng);
+        time   += 100;
+
+        char timeStr[16];
+        char dateStr[8];
+        char latStr[16];
+        char lonStr[16];
+
+        uint32_t secs = time / 1000;
+        snprintf(timeStr, sizeof(timeStr), "%02u%02u%02u.%02u",
+                 (secs / 3600) % 24, (secs / 60) % 60, secs % 60,
+                 (time % 1000) / 10);
+        snprintf(dateStr, sizeof(dateStr), "%02u0326", 19 + (secs / 86400));
+        coordinate(latStr, sizeof(latStr), lat, 2);
+        coordinate(lonStr, sizeof(lonStr), lon, 3);
+
+        char buf[128];
+        snprintf(buf, sizeof(buf), "GNRMC,%s,A,%s,N,%s,E,%.3f,%.2f,%s,,,A,V",
+                 timeStr, latStr, lonStr, speed / 1.852, course, dateStr);
+        out.push_back(sentence(buf));
+
+        snprintf(buf, sizeof(buf), "GNVTG,%.2f,T,,M,%.3f,N,%.3f,K,A", course,
+                 speed / 1.852, speed * 3.6);
+        out.push_back(sentence(buf));
+
+        snprintf(buf, sizeof(buf), "GNGGA,%s,%s,N,%s,E,1,12,0.87,%.1f,M,47.3,M,,",
+                 timeStr, latStr, lonStr, alt);
+        out.push_back(sentence(buf));
+
+        // One GSA sentence per constellation
+        for(size_t i = 0; i < 4; i++)
+        {
+            std::string gsa = "GNGSA,A,3";
+            for(size_t j = 0; j < 12; j++)
+            {
+                gsa += ",";
+                if(j < 8)
+                    gsa += std::to_string(sats[(i * 10) + j].id);
+            }
+
+            gsa += ",1.52,0.87,1.24," + std::to_string(i + 1);
+            out.push_back(sentence(gsa));
+        }
+
+        // Satellites in view, once per second
+        if((time % 1000) == 0)
+        {
+            for(size_t i = 0; i < 4; i++)
+                gsv(out, i);
+
+            out.push_back(sentence("GNGLL," + std::string(latStr) + ",N," +
+                                   std::string(lonStr) + ",E," + timeStr + ",A,A"));
+        }
+    }
+
+private:
+
+    struct Satellite
+    {
+        char     talker;
+        uint32_t id;
+        uint32_t elevation;
+        uint32_t azimuth;
+        uint32_t snr;
+    };
+
+    static std::string sentence(const std::string& body)
+    {
+        uint8_t checksum = 0;
+        for(char c : body)
+            checksum ^= c;
+
+        char tail[8];
+        snprintf(tail, sizeof(tail), "*%02X\r\n", checksum);
+
+        return "$" + body + tail;
+    }
+
+    static void coordinate(char *buf, const size_t len, const double value,
+                           const int degDigits)
+    {
+        int    deg = static_cast< int >(value);
+        double min = (value - deg) * 60.0;
+        snprintf(buf, len, "%0*d%08.5f", degDigits, deg, min);
+    }
+
+    void gsv(std::vector< std::string >& out, const size_t constellation)
+    {
+        const Satellite *view  = &sats[constellation * 10];
+        const size_t     count = 10;
+        const size_t     msgs  = (count + 3) / 4;
+
+        for(size_t msg = 0; msg < msgs; msg++)
+        {
+            std::string str = "G" + std::string(1, view[0].talker) + "GSV," +
+                              std::to_string(msgs) + "," +
+                              std::to_string(msg + 1) + "," +
+                              std::to_string(count);
+
+            for(size_t i = (msg * 4); (i < (msg + 1) * 4) && (i < count); i++)
+            {
+                char sat[32];
+                snprintf(sat, sizeof(sat), ",%02u,%02u,%03u,%02u", view[i].id,
+                         view[i].elevation, view[i].azimuth, view[i].snr);
+                str += sat;
+            }
+
+            str += ",1";
+            out.push_back(sentence(str));
+        }
+    }
+
+    std::mt19937             rng;
+    std::vector< Satellite > sats;
+    double                   lat;
+    double                   lon;
+    double                   alt;
+    double                   course;
+    double                   speed;
+    uint32_t                 time;      // Milliseconds
+};
+
+static std::vector< std::string > replayData()
+{
+    std::vector< std::string > data;
+
+    const char *path = getenv("NMEA_REPLAY");
+    if(path != NULL)
+    {
+        std::ifstream file(path);
+        std::string   line;
+        while(std::getline(file, line))
+            data.push_back(line + "\n");
+
+        return data;
+    }
+
+    Receiver receiver(42);
+    for(size_t i = 0; i < 36000; i++)
+        receiver.epoch(data);
+
+    return data;
+}
+
+TEST_CASE("NMEA parser replay", "[nmea][benchmark]")
+{
+    std::vector< std::string > data = replayData();
+    REQUIRE(data.empty() == false);
+
+    size_t bytes = 0;
+    for(const auto& line : data)
+        bytes += line.size();
+
+    // Both the decoders have to give the same result after each sentence
+    gps_t      oldGps;
+    gps_t      newGps;
+    nmeaParser parser;
+    memset(&oldGps, 0x00, sizeof(gps_t));
+    memset(&newGps, 0x00, sizeof(gps_t));
+    nmea_reset(&parser);
+
+    size_t decoded = 0;
+    for(const auto& line : data)
+    {
+        minmeaUpdate(line.c_str(), oldGps);
+
+        nmeaSentence type = NMEA_NONE;
+        for(char c : line)
+        {
+            nmeaSentence ret = nmea_putChar(&parser, c);
+            if(ret != NMEA_NONE)
+                type = ret;
+        }
+
+        if(type != NMEA_NONE)
+        {
+            nmea_update(&parser, &newGps);
+            decoded += 1;
+        }
+
+        INFO(line);
+        REQUIRE(memcmp(&oldGps, &newGps, sizeof(gps_t)) == 0);
+    }
+
+    // Timing of the decoders, best of five runs. The streaming parser is fed
+    // both one character at a time, as from an IRQ, and one line at a time
+    clk::duration oldTime  = clk::duration::max();
+    clk::duration charTime = clk::duration::max();
+    clk::duration newTime  = clk::duration::max();
+    for(int run = 0; run < 5; run++)
+    {
+        auto start = clk::now();
+        for(const auto& line : data)
+            minmeaUpdate(line.c_str(), oldGps);
+
+        oldTime = std::min(oldTime, clk::now() - start);
+
+        start = clk::now();
+        for(const auto& line : data)
+        {
+            for(char c : line)
+            {
+                if(nmea_putChar(&parser, c) != NMEA_NONE)
+                    nmea_update(&parser, &newGps);
+            }
+        }
+
+        charTime = std::min(charTime, clk::now() - start);
+
+        start = clk::now();
+        for(const auto& line : data)
+        {
+            const char *ptr = line.c_str();
+            size_t      len = line.size();
+            while(len > 0)
+            {
+                nmeaSentence type;
+                size_t       done = nmea_putData(&parser, ptr, len, &type);
+                if(type != NMEA_NONE)
+                    nmea_update(&parser, &newGps);
+
+                ptr += done;
+                len -= done;
+            }
+        }
+
+        newTime = std::min(newTime, clk::now() - start);
+    }
+
+    REQUIRE(memcmp(&oldGps, &newGps, sizeof(gps_t)) == 0);
+
+    double oldNs  = std::chrono::duration< double, std::nano >(oldTime).count();
+    double charNs = std::chrono::duration< double, std::nano >(charTime).count();
+    double newNs  = std::chrono::duration< double, std::nano >(newTime).count();
+
+    printf("NMEA replay: %zu sentences, %zu bytes, %zu decoded\n", data.size(),
+           bytes, decoded);
+    printf("minmea:             %7.1f ns/sentence, %5.2f ns/byte\n",
+           oldNs / data.size(), oldNs / bytes);
+    printf("streaming, char:    %7.1f ns/sentence, %5.2f ns/byte (%.1f%% of minmea)\n",
+           charNs / data.size(), charNs / bytes, 100.0 * charNs / oldNs);
+    printf("streaming, line:    %7.1f ns/sentence, %5.2f ns/byte (%.1f%% of minmea)\n",
+           newNs / data.size(), newNs / bytes, 100.0 * newNs / oldNs);
+
+    REQUIRE(newNs < oldNs);
+}
@@ -0,0 +1,262 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "core/rx_audio.h"
+
+/*
+ * Harness for the FM RX audio chain.
+ *
+ * The audio to be processed is read from the file given by the RXAUDIO_INPUT
+ * environment variable, either a WAV file or raw 16 bit signed samples, mono
+ * at 8kHz. The processed audio is written to the file given by RXAUDIO_OUTPUT,
+ * in the same format of the input, and the enabled stages are selected by the
+ * RXAUDIO_STAGES variable, as a combination of the RxAudioStage flags. When no
+ * input is given, one minute of noisy speech-like audio with a CTCSS tone is
+ * generated.
+ *
+ * For each stage, the time spent is reported as a fraction of the real time
+ * budget, that is the duration of the processed audio.
+ */
+
+using clk = std::chrono::steady_clock;
+
+static const double PI = 3.14159265358979323846;
+
+struct wavHeader
+{
+    char     riff[4];
+    uint32_t riffSize;
+    char     wave[4];
+    char     fmt[4];
+    uint32_t fmtSize;
+    uint16_t format;
+    uint16_t channels;
+    uint32_t sampleRate;
+    uint32_t byteRate;
+    uint16_t blockAlign;
+    uint16_t bitsPerSample;
+    char     data[4];
+    uint32_t dataSize;
+} __attribute__((packed));
+
+/*
+ * Load a WAV file or a raw one, returning true if the file is a WAV.
+ */
+static bool loadAudio(const char *path, std::vector< int16_t >& samples)
+{
+    std::ifstream file(path, std::ios::binary);
+    REQUIRE(file.is_open());
+
+    std::vector< char > data((std::istreambuf_iterator< char >(file)),
+                              std::istreambuf_iterator< char >());
+
+    bool   wav    = (data.size() >= 12) && (memcmp(&data[0], "RIFF", 4) == 0) &&
+                    (memcmp(&data[8], "WAVE", 4) == 0);
+    size_t start  = 0;
+    size_t length = data.size();
+
+    // Walk through the chunks, looking for the format and data ones
+    if(wav)
+    {
+        size_t pos = 12;
+        bool   fmt = false;
+        length     = 0;
+
+        while((pos + 8) <= data.size())
+        {
+            uint32_t size;
+            memcpy(&size, &data[pos + 4], sizeof(size));
+
+            if(memcmp(&data[pos], "fmt ", 4) == 0)
+            {
+                uint16_t format, channels, bits;
+                uint32_t rate;
+                memcpy(&format,   &data[pos + 8],  sizeof(format));
+                memcpy(&channels, &data[pos + 10], sizeof(channels));
+                memcpy(&rate,     &data[pos + 12], sizeof(rate));
+                memcpy(&bits,     &data[pos + 22], sizeof(bits));
+
+                // 16 bit PCM, mono, 8kHz only
+                REQUIRE(format   == 1);
+                REQUIRE(channels == 1);
+                REQUIRE(bits     == 16);
+                REQUIRE(rate     == RXAUDIO_SAMPLE_RATE);
+                fmt = true;
+            }
+
+            if(memcmp(&data[pos], "data", 4) == 0)
+            {
+                start  = pos + 8;
+                length = std::min< size_t >(size, data.size() - start);
+                break;
+            }
+
+            pos += 8 + size + (size & 1);
+        }
+
+        REQUIRE(fmt);
+    }
+
+    samples.resize(length / sizeof(int16_t));
+    memcpy(samples.data(), &data[start], samples.size() * sizeof(int16_t));
+
+    return wav;
+}
+
+static void saveAudio(const char *path, const std::vector< int16_t >& samples,
+                      const bool wav)
+{
+    FILE *fp = fopen(path, "wb");
+    REQUIRE(fp != NULL);
+
+    if(wav)
+    {
+        struct wavHeader hdr;
+        uint32_t size = samples.size() * sizeof(int16_t);
+
+        memcpy(hdr.riff, "RIFF", 4);
+        memcpy(hdr.wave, "WAVE", 4);
+        memcpy(hdr.fmt,  "fmt ", 4);
+        memcpy(hdr.data, "data", 4);
+        hdr.riffSize      = size + sizeof(hdr) - 8;
+        hdr.fmtSize       = 16;
+        hdr.format        = 1;
+        hdr.channels      = 1;
+        hdr.sampleRate    = RXAUDIO_SAMPLE_RATE;
+        hdr.byteRate      = RXAUDIO_SAMPLE_RATE * sizeof(int16_t);
+        hdr.blockAlign    = sizeof(int16_t);
+        hdr.bitsPerSample = 16;
+        hdr.dataSize      = size;
+
+        fwrite(&hdr, sizeof(hdr), 1, fp);
+    }
+
+    fwrite(samples.data(), sizeof(int16_t), samples.size(), fp);
+    fclose(fp);
+}
+
+/*
+ * Speech-like audio: syllables of a voiced sound with varying pitch, a 88.5Hz
+ * CTCSS tone and white noise.
+ */
+static std::vector< int16_t > generateAudio(const size_t seconds)
+{
+    std::vector< int16_t > samples(seconds * RXAUDIO_SAMPLE_RATE);
+    uint32_t seed  = 12345;
+    double   phase = 0.0;
+
+    for(size_t i = 0; i < samples.size(); i++)
+    {
+        double t     = (double) i / RXAUDIO_SAMPLE_RATE;
+        double env   = std::max(0.0, sin(2.0 * PI * 2.5 * t));
+        double pitch = 120.0 + 30.0 * sin(2.0 * PI * 0.3 * t);
+        phase       += 2.0 * PI * pitch / RXAUDIO_SAMPLE_RATE;
+
+        double val = 0.0;
+        for(int h = 1; h <= 8; h++)
+            val += sin(h * phase) / h;
+
+        seed = (seed * 1103515245) + 12345;
+        double noise = (((seed >> 8) & 0xFFFF) / 65536.0) - 0.5;
+
+        val = (5000.0 * env * val) + (2000.0 * sin(2.0 * PI * 88.5 * t)) +
+              (2000.0 * noise);
+
+        samples[i] = (int16_t) val;
+    }
+
+    return samples;
+}
+
+/*
+ * Process the audio with the given stages, returning the time spent as a
+ * fraction of the audio duration.
+ */
+static double runChain(const uint8_t stages, std::vector< int16_t >& samples)
+{
+    static struct rxAudioChain chain;
+    rxAudio_init(&chain, stages);
+
+    auto start = clk::now();
+    for(size_t pos = 0; pos < samples.size(); pos += RXAUDIO_BLOCK_SIZE)
+    {
+        size_t len = std::min< size_t >(RXAUDIO_BLOCK_SIZE, samples.size() - pos);
+        rxAudio_process(&chain, &samples[pos], len);
+    }
+    auto end = clk::now();
+
+    double elapsed  = std::chrono::duration< double >(end - start).count();
+    double duration = (double) samples.size() / RXAUDIO_SAMPLE_RATE;
+
+    return elapsed / duration;
+}
+
+TEST_CASE("RX audio chain CPU budget", "[rx_audio][benchmark]")
+{
+    const char *inPath  = getenv("RXAUDIO_INPUT");
+    const char *outPath = getenv("RXAUDIO_OUTPUT");
+    const char *flags   = getenv("RXAUDIO_STAGES");
+
+    std::vector< int16_t > input;
+    bool wav = false;
+
+    if(inPath != NULL)
+        wav = loadAudio(inPath, input);
+    else
+        input = generateAudio(60);
+
+    REQUIRE(input.size() > 0);
+
+    uint8_t stages = RXAUDIO_HPF | RXAUDIO_NR;
+    if(flags != NULL)
+        stages = (uint8_t) strtoul(flags, NULL, 0);
+
+    struct
+    {
+        const char *name;
+        uint8_t     stages;
+    }
+    const runs[] =
+    {
+        {"High-pass filter", RXAUDIO_HPF},
+        {"De-emphasis",      RXAUDIO_DEEMPH75},
+        {"Noise reduction",  RXAUDIO_NR},
+        {"Full chain",       RXAUDIO_HPF | RXAUDIO_DEEMPH75 | RXAUDIO_NR}
+    };
+
+    printf("%.1fs of audio, %zu samples per block\n",
+           (double) input.size() / RXAUDIO_SAMPLE_RATE,
+           (size_t) RXAUDIO_BLOCK_SIZE);
+
+    for(auto& run : runs)
+    {
+        std::vector< int16_t > buf = input;
+        double load = runChain(run.stages, buf);
+        double ns   = load * 1.0e9 / RXAUDIO_SAMPLE_RATE;
+
+        printf("%-18s %7.1fns/sample, %.3f%% of real time\n", run.name, ns,
+               load * 100.0);
+
+        // Far below the real time budget also on a slow host
+        REQUIRE(load < 0.05);
+    }
+
+    std::vector< int16_t > output = input;
+    runChain(stages, output);
+
+    if(outPath != NULL)
+        saveAudio(outPath, output, wav);
+}
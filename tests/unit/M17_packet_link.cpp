@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "protocols/M17/FrameEncoder.hpp"
+#include "protocols/M17/FrameDecoder.hpp"
+#include "protocols/M17/Packet.hpp"
+
+using namespace M17;
+
+// Air time of an M17 frame, in seconds
+static constexpr double FRAME_TIME = 0.04;
+
+/*
+ * Frame-level M17 link: packets are segmented, encoded, passed through a
+ * binary symmetric channel with a given bit error rate, decoded and
+ * reassembled.
+ */
+struct Link
+{
+    FrameEncoder encoder;
+    FrameDecoder decoder;
+    Packet       rxPacket;
+    std::mt19937 rng{ 17 };
+    double       ber        = 0.0;
+    size_t       frames     = 0;    // Frames sent, including LSF and EOT
+    size_t       badFrames  = 0;    // Packet frames received corrupted
+
+    void channel(frame_t& frame)
+    {
+        std::bernoulli_distribution flip(ber);
+
+        for(auto& byte : frame)
+        {
+            for(int bit = 0; bit < 8; bit++)
+            {
+                if(flip(rng))
+                    byte ^= (1 << bit);
+            }
+        }
+    }
+
+    /*
+     * Transmit a packet, returning the reassembly status of the last frame
+     * received.
+     */
+    Packet::Status transfer(const Packet& packet)
+    {
+        Packet::Status status = Packet::Status::ERROR;
+        frame_t        frame;
+
+        // Preamble and LSF, then the packet frames and the EOT
+        frames += 3;
+
+        LinkSetupFrame lsf;
+        lsf.clear();
+        encoder.reset();
+        encoder.encodeLsf(lsf, frame);
+        channel(frame);
+        decoder.decodeFrame(frame);
+
+        for(size_t i = 0; i < packet.numFrames(); i++)
+        {
+            PacketFrame txFrame;
+            packet.getFrame(i, txFrame);
+            encoder.encodePacketFrame(txFrame, frame);
+            channel(frame);
+            frames += 1;
+
+            if(decoder.decodeFrame(frame) != FrameType::PACKET)
+            {
+                badFrames += 1;
+                continue;
+            }
+
+            const PacketFrame& rxFrame = decoder.getPacketFrame();
+            if(memcmp(rxFrame.data(), txFrame.data(), PacketFrame::FRAME_SIZE) != 0)
+                badFrames += 1;
+
+            status = rxPacket.addFrame(rxFrame);
+        }
+
+        return status;
+    }
+};
+
+TEST_CASE("SMS packet loopback", "[m17][packet]")
+{
+    Link   link;
+    Packet packet;
+
+    const char text[] = "Hello from OpenRTX, this text spans more than one frame";
+    REQUIRE(packet.set(PacketType::SMS, text, sizeof(text)) == true);
+    REQUIRE(packet.numFrames() == 3);
+
+    REQUIRE(link.transfer(packet) == Packet::Status::COMPLETE);
+    REQUIRE(link.rxPacket.isComplete() == true);
+    REQUIRE(link.rxPacket.getType() == PacketType::SMS);
+    REQUIRE(link.rxPacket.getDataLength() == sizeof(text));
+    REQUIRE(strcmp((const char *) link.rxPacket.getData(), text) == 0);
+}
+
+TEST_CASE("Packet segmentation", "[m17][packet]")
+{
+    Packet      packet;
+    PacketFrame frame;
+    std::vector< uint8_t > data(Packet::MAX_DATA + 1, 0xA5);
+
+    REQUIRE(packet.set(PacketType::RAW, data.data(), data.size()) == false);
+    REQUIRE(packet.set(PacketType::RAW, data.data(), Packet::MAX_DATA) == true);
+    REQUIRE(packet.numFrames() == Packet::MAX_FRAMES);
+
+    for(size_t i = 0; i < (Packet::MAX_FRAMES - 1); i++)
+    {
+        packet.getFrame(i, frame);
+        REQUIRE(frame.isEof() == false);
+        REQUIRE(frame.getCounter() == i);
+    }
+
+    packet.getFrame(Packet::MAX_FRAMES - 1, frame);
+    REQUIRE(frame.isEof() == true);
+    REQUIRE(frame.getCounter() == 25);
+
+    // Type, data and CRC fill exactly one frame
+    REQUIRE(packet.set(PacketType::RAW, data.data(), 22) == true);
+    REQUIRE(packet.numFrames() == 1);
+    packet.getFrame(0, frame);
+    REQUIRE(frame.isEof() == true);
+    REQUIRE(frame.getCounter() == 25);
+}
+
+TEST_CASE("Packet reassembly errors", "[m17][packet]")
+{
+    Packet      tx;
+    Packet      rx;
+    PacketFrame frame;
+    std::vector< uint8_t > data(100, 0x3C);
+
+    tx.set(PacketType::RAW, data.data(), data.size());
+    REQUIRE(tx.numFrames() == 5);
+
+    SECTION("Lost frame")
+    {
+        tx.getFrame(0, frame);
+        REQUIRE(rx.addFrame(frame) == Packet::Status::INCOMPLETE);
+        tx.getFrame(2, frame);
+        REQUIRE(rx.addFrame(frame) == Packet::Status::ERROR);
+    }
+    SECTION("Corrupted data")
+    {
+        for(size_t i = 0; i < 4; i++)
+        {
+            tx.getFrame(i, frame);
+            if(i == 1)
+                frame[3] ^= 0x01;
+
+            REQUIRE(rx.addFrame(frame) == Packet::Status::INCOMPLETE);
+        }
+
+        tx.getFrame(4, frame);
+        REQUIRE(rx.addFrame(frame) == Packet::Status::ERROR);
+    }
+    SECTION("Restart after an incomplete packet")
+    {
+        tx.getFrame(0, frame);
+        rx.addFrame(frame);
+        tx.getFrame(1, frame);
+        rx.addFrame(frame);
+
+        for(size_t i = 0; i < 5; i++)
+        {
+            tx.getFrame(i, frame);
+            rx.addFrame(frame);
+        }
+
+        REQUIRE(rx.isComplete() == true);
+        REQUIRE(rx.getDataLength() == data.size());
+    }
+
+    REQUIRE(rx.isComplete() == (rx.getDataLength() == data.size()));
+}
+
+TEST_CASE("File transfer goodput and frame error rate", "[m17][packet]")
+{
+    // 8kB file, sent as raw packets of maximum size
+    std::vector< uint8_t > file(8192);
+    for(size_t i = 0; i < file.size(); i++)
+        file[i] = (i * 7) ^ (i >> 8);
+
+    const double bers[] = { 0.0, 0.001, 0.01, 0.03 };
+
+    for(double ber : bers)
+    {
+        Link link;
+        link.ber = ber;
+
+        std::vector< uint8_t > received;
+        size_t packets = 0;
+        size_t lost    = 0;
+
+        for(size_t offset = 0; offset < file.size(); offset += Packet::MAX_DATA)
+        {
+            size_t len = std::min(file.size() - offset, Packet::MAX_DATA);
+            Packet packet;
+            packet.set(PacketType::RAW, &file[offset], len);
+
+            // Retransmit lost packets, up to four attempts
+            bool ok = false;
+            for(int attempt = 0; (attempt < 4) && (ok == false); attempt++)
+            {
+                packets += 1;
+                ok = (link.transfer(packet) == Packet::Status::COMPLETE);
+                if(ok == false)
+                    lost += 1;
+            }
+
+            if(ok)
+            {
+                const uint8_t *data = link.rxPacket.getData();
+                received.insert(received.end(), data,
+                                data + link.rxPacket.getDataLength());
+            }
+        }
+
+        double airTime = link.frames * FRAME_TIME;
+        double goodput = (received.size() * 8) / airTime;
+        double fer     = (double) link.badFrames / (link.frames - (3 * packets));
+
+        printf("BER %.3f: %zu packets, %zu lost, FER %.4f, goodput %.0f bit/s\n",
+               ber, packets, lost, fer, goodput);
+
+        if(ber == 0.0)
+            REQUIRE(lost == 0);
+
+        // Lost packets are recovered by retransmission at low error rates
+        if(ber <= 0.001)
+            REQUIRE(received == file);
+    }
+}
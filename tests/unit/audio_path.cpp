@@ -0,0 +1,222 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <pthread.h>
+#include <set>
+#include "core/audio_path.h"
+
+/*
+ * Path compatibility follows the matrix of the Linux target: paths sharing a
+ * source or a sink are not compatible, the speaker and the transceiver input
+ * cannot be used at the same time by the microphone and the transceiver.
+ */
+
+TEST_CASE("Audio path request and release", "[audio_path]")
+{
+    pathId rx = audioPath_request(SOURCE_RTX, SINK_SPK, PRIO_RX);
+    REQUIRE(rx > 0);
+    REQUIRE(audioPath_getStatus(rx) == PATH_OPEN);
+
+    pathInfo_t info = audioPath_getInfo(rx);
+    REQUIRE(info.source == SOURCE_RTX);
+    REQUIRE(info.sink   == SINK_SPK);
+    REQUIRE(info.prio   == PRIO_RX);
+    REQUIRE(info.status == PATH_OPEN);
+
+    // Same path with the same priority is refused
+    REQUIRE(audioPath_request(SOURCE_RTX, SINK_SPK, PRIO_RX) == -1);
+
+    audioPath_release(rx);
+    REQUIRE(audioPath_getStatus(rx) == PATH_CLOSED);
+    REQUIRE(audioPath_getInfo(rx).status == PATH_CLOSED);
+
+    // A released ID does not match the new path reusing its resources
+    pathId newRx = audioPath_request(SOURCE_RTX, SINK_SPK, PRIO_RX);
+    REQUIRE(newRx > 0);
+    REQUIRE(newRx != rx);
+    REQUIRE(audioPath_getStatus(rx) == PATH_CLOSED);
+    REQUIRE(audioPath_getStatus(newRx) == PATH_OPEN);
+
+    // Releasing twice, or releasing an invalid ID, has no effect
+    audioPath_release(rx);
+    audioPath_release(-1);
+    audioPath_release(0);
+    REQUIRE(audioPath_getStatus(newRx) == PATH_OPEN);
+
+    audioPath_release(newRx);
+    REQUIRE(audioPath_getStatus(newRx) == PATH_CLOSED);
+    REQUIRE(audioPath_getStatus(0) == PATH_CLOSED);
+}
+
+TEST_CASE("Audio path priority preemption", "[audio_path]")
+{
+    pathId rx = audioPath_request(SOURCE_RTX, SINK_SPK, PRIO_RX);
+    REQUIRE(rx > 0);
+
+    SECTION("Lower priority is refused")
+    {
+        REQUIRE(audioPath_request(SOURCE_MCU, SINK_SPK, PRIO_BEEP) == -1);
+        REQUIRE(audioPath_getStatus(rx) == PATH_OPEN);
+    }
+
+    SECTION("Higher priority suspends and resumes")
+    {
+        pathId prompt = audioPath_request(SOURCE_MCU, SINK_SPK, PRIO_PROMPT);
+        REQUIRE(prompt > 0);
+        REQUIRE(audioPath_getStatus(prompt) == PATH_OPEN);
+        REQUIRE(audioPath_getStatus(rx) == PATH_SUSPENDED);
+        REQUIRE(audioPath_getInfo(rx).status == PATH_SUSPENDED);
+
+        // A beep cannot take over the prompt
+        REQUIRE(audioPath_request(SOURCE_MCU, SINK_SPK, PRIO_BEEP) == -1);
+
+        audioPath_release(prompt);
+        REQUIRE(audioPath_getStatus(rx) == PATH_OPEN);
+    }
+
+    SECTION("Compatible paths coexist")
+    {
+        pathId mic = audioPath_request(SOURCE_MIC, SINK_MCU, PRIO_RX);
+        REQUIRE(mic > 0);
+        REQUIRE(audioPath_getStatus(mic) == PATH_OPEN);
+        REQUIRE(audioPath_getStatus(rx) == PATH_OPEN);
+
+        audioPath_release(mic);
+    }
+
+    SECTION("Suspension chain, top released first")
+    {
+        pathId prompt = audioPath_request(SOURCE_MCU, SINK_SPK, PRIO_PROMPT);
+        pathId tx     = audioPath_request(SOURCE_MIC, SINK_RTX, PRIO_TX);
+        REQUIRE(tx > 0);
+        REQUIRE(audioPath_getStatus(tx) == PATH_OPEN);
+        REQUIRE(audioPath_getStatus(prompt) == PATH_SUSPENDED);
+        REQUIRE(audioPath_getStatus(rx) == PATH_SUSPENDED);
+
+        // Release of the transmission resumes the prompt, not the RX
+        audioPath_release(tx);
+        REQUIRE(audioPath_getStatus(prompt) == PATH_OPEN);
+        REQUIRE(audioPath_getStatus(rx) == PATH_SUSPENDED);
+
+        audioPath_release(prompt);
+        REQUIRE(audioPath_getStatus(rx) == PATH_OPEN);
+    }
+
+    SECTION("Suspension chain, middle released first")
+    {
+        pathId prompt = audioPath_request(SOURCE_MCU, SINK_SPK, PRIO_PROMPT);
+        pathId tx     = audioPath_request(SOURCE_MIC, SINK_RTX, PRIO_TX);
+        REQUIRE(tx > 0);
+
+        // The RX inherits the suspension from the released prompt
+        audioPath_release(prompt);
+        REQUIRE(audioPath_getStatus(prompt) == PATH_CLOSED);
+        REQUIRE(audioPath_getStatus(rx) == PATH_SUSPENDED);
+
+        audioPath_release(tx);
+        REQUIRE(audioPath_getStatus(rx) == PATH_OPEN);
+    }
+
+    SECTION("One path suspending several ones")
+    {
+        pathId mic = audioPath_request(SOURCE_MIC, SINK_MCU, PRIO_RX);
+        pathId tx  = audioPath_request(SOURCE_MIC, SINK_RTX, PRIO_TX);
+        REQUIRE(tx > 0);
+        REQUIRE(audioPath_getStatus(mic) == PATH_SUSPENDED);
+        REQUIRE(audioPath_getStatus(rx) == PATH_SUSPENDED);
+
+        audioPath_release(tx);
+        REQUIRE(audioPath_getStatus(mic) == PATH_OPEN);
+        REQUIRE(audioPath_getStatus(rx) == PATH_OPEN);
+
+        audioPath_release(mic);
+    }
+
+    audioPath_release(rx);
+    REQUIRE(audioPath_getStatus(rx) == PATH_CLOSED);
+}
+
+TEST_CASE("Audio path table reuse", "[audio_path]")
+{
+    std::set< pathId > ids;
+
+    // Repeated RX/TX transitions with prompts and beeps do not leak routes and
+    // always get new IDs
+    for(int i = 0; i < 1000; i++)
+    {
+        pathId rx = audioPath_request(SOURCE_RTX, SINK_SPK, PRIO_RX);
+        pathId vp = audioPath_request(SOURCE_MCU, SINK_SPK, PRIO_PROMPT);
+        pathId tx = audioPath_request(SOURCE_MIC, SINK_RTX, PRIO_TX);
+        REQUIRE(rx > 0);
+        REQUIRE(vp > 0);
+        REQUIRE(tx > 0);
+
+        ids.insert(rx);
+        ids.insert(vp);
+        ids.insert(tx);
+
+        audioPath_release(vp);
+        audioPath_release(tx);
+        REQUIRE(audioPath_getStatus(rx) == PATH_OPEN);
+        audioPath_release(rx);
+
+        pathId beep = audioPath_request(SOURCE_MCU, SINK_SPK, PRIO_BEEP);
+        REQUIRE(beep > 0);
+        ids.insert(beep);
+        audioPath_release(beep);
+    }
+
+    REQUIRE(ids.size() == 4000);
+}
+
+/*
+ * Request and release a path sharing the speaker with the other threads,
+ * checking that the table is never seen in an inconsistent state.
+ */
+static void *pathUser(void *arg)
+{
+    const enum AudioPriority prio = *((enum AudioPriority *) arg);
+    long errors = 0;
+
+    for(int i = 0; i < 20000; i++)
+    {
+        pathId id = audioPath_request(SOURCE_MCU, SINK_SPK, prio);
+        if(id < 0)
+            continue;
+
+        if(audioPath_getStatus(id) == PATH_CLOSED)
+            errors++;
+
+        audioPath_release(id);
+        if(audioPath_getStatus(id) != PATH_CLOSED)
+            errors++;
+    }
+
+    return (void *) errors;
+}
+
+TEST_CASE("Audio path concurrent access", "[audio_path]")
+{
+    enum AudioPriority prios[] = {PRIO_BEEP, PRIO_RX, PRIO_PROMPT, PRIO_TX};
+    pthread_t threads[4];
+
+    for(int i = 0; i < 4; i++)
+        pthread_create(&threads[i], NULL, pathUser, &prios[i]);
+
+    for(int i = 0; i < 4; i++)
+    {
+        void *errors;
+        pthread_join(threads[i], &errors);
+        REQUIRE(errors == NULL);
+    }
+
+    // All the routes have been freed
+    pathId rx = audioPath_request(SOURCE_RTX, SINK_SPK, PRIO_RX);
+    REQUIRE(rx > 0);
+    REQUIRE(audioPath_getStatus(rx) == PATH_OPEN);
+    audioPath_release(rx);
+}
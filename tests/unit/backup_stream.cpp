@@ -0,0 +1,237 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <condition_variable>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include "core/backup_stream.h"
+
+/*
+ * One direction of an in-memory serial link. Data can be corrupted or lost by
+ * flipping one bit every given number of written bytes and by dropping one
+ * write call, that is one frame, every given number of calls.
+ */
+struct Pipe
+{
+    std::mutex              mutex;
+    std::condition_variable cond;
+    std::deque< uint8_t >   data;
+    size_t                  written   = 0;
+    size_t                  writes    = 0;
+    size_t                  flipEvery = 0;
+    size_t                  dropEvery = 0;
+};
+
+struct Link
+{
+    Pipe *rx;
+    Pipe *tx;
+};
+
+static ssize_t linkRead(void *ctx, void *buf, size_t len)
+{
+    Pipe *pipe = static_cast< Link * >(ctx)->rx;
+    std::unique_lock< std::mutex > lock(pipe->mutex);
+
+    if(pipe->data.empty())
+        pipe->cond.wait_for(lock, std::chrono::milliseconds(2));
+
+    size_t count = std::min(len, pipe->data.size());
+    uint8_t *ptr = static_cast< uint8_t * >(buf);
+    for(size_t i = 0; i < count; i++)
+    {
+        ptr[i] = pipe->data.front();
+        pipe->data.pop_front();
+    }
+
+    return count;
+}
+
+static ssize_t linkWrite(void *ctx, const void *buf, size_t len)
+{
+    Pipe *pipe = static_cast< Link * >(ctx)->tx;
+    std::lock_guard< std::mutex > lock(pipe->mutex);
+
+    pipe->writes += 1;
+    if((pipe->dropEvery != 0) && ((pipe->writes % pipe->dropEvery) == 0))
+        return len;
+
+    const uint8_t *ptr = static_cast< const uint8_t * >(buf);
+    for(size_t i = 0; i < len; i++)
+    {
+        uint8_t byte = ptr[i];
+        pipe->written += 1;
+        if((pipe->flipEvery != 0) && ((pipe->written % pipe->flipEvery) == 0))
+            byte ^= 0x10;
+
+        pipe->data.push_back(byte);
+    }
+
+    pipe->cond.notify_all();
+    return len;
+}
+
+/*
+ * Memory image, erased blocks are written as all 0xFF.
+ */
+struct Memory
+{
+    std::vector< uint8_t > data;
+    size_t erasedWrites = 0;
+};
+
+static int memRead(void *ctx, uint32_t offset, void *buf, size_t len)
+{
+    Memory *mem = static_cast< Memory * >(ctx);
+    if((offset + len) > mem->data.size())
+        return -1;
+
+    memcpy(buf, &mem->data[offset], len);
+    return 0;
+}
+
+static int memWrite(void *ctx, uint32_t offset, const void *buf, size_t len)
+{
+    Memory *mem = static_cast< Memory * >(ctx);
+    if((offset + len) > mem->data.size())
+        return -1;
+
+    if(buf == NULL)
+    {
+        memset(&mem->data[offset], 0xFF, len);
+        mem->erasedWrites += 1;
+    }
+    else
+    {
+        memcpy(&mem->data[offset], buf, len);
+    }
+
+    return 0;
+}
+
+static int memFlush(void *ctx)
+{
+    (void) ctx;
+    return 0;
+}
+
+/*
+ * Memory content with random data interleaved to erased areas, the size is not
+ * a multiple of the frame size.
+ */
+static void fillSource(Memory &mem)
+{
+    const size_t size = (256 * 1024) + 1000;
+    uint32_t     seed = 12345;
+
+    mem.data.resize(size);
+    for(size_t i = 0; i < size; i++)
+    {
+        seed = (seed * 1103515245) + 12345;
+        mem.data[i] = seed >> 16;
+    }
+
+    memset(&mem.data[16 * 1024], 0xFF, 64 * 1024);
+    memset(&mem.data[size - 1000], 0xFF, 1000);
+}
+
+struct Transfer
+{
+    Pipe    toReceiver;
+    Pipe    toSender;
+    Link    senderLink   = { &toSender, &toReceiver };
+    Link    receiverLink = { &toReceiver, &toSender };
+    ssize_t sent         = 0;
+    ssize_t received     = 0;
+
+    void run(Memory &src, Memory &dst, const bool skipErased)
+    {
+        bsLink_t    sLink    = { linkRead, linkWrite, &senderLink };
+        bsLink_t    rLink    = { linkRead, linkWrite, &receiverLink };
+        bsStorage_t sStorage = { memRead, memWrite, memFlush, &src };
+        bsStorage_t rStorage = { memRead, memWrite, memFlush, &dst };
+
+        std::thread sender([&]
+        {
+            sent = bstream_send(&sLink, &sStorage, src.data.size(), skipErased);
+        });
+
+        received = bstream_receive(&rLink, &rStorage, dst.data.size());
+        sender.join();
+    }
+};
+
+TEST_CASE("Memory transfer", "[backup]")
+{
+    Memory src;
+    Memory dst;
+    fillSource(src);
+    dst.data.assign(src.data.size(), 0x00);
+
+    Transfer xfer;
+
+    SECTION("All the frames with data")
+    {
+        xfer.run(src, dst, false);
+        REQUIRE(dst.erasedWrites == 0);
+    }
+    SECTION("Erased blocks skipped")
+    {
+        xfer.run(src, dst, true);
+        REQUIRE(dst.erasedWrites == 17);
+        REQUIRE(xfer.toReceiver.written < (src.data.size() - (60 * 1024)));
+    }
+
+    REQUIRE(xfer.sent == (ssize_t) src.data.size());
+    REQUIRE(xfer.received == (ssize_t) src.data.size());
+    REQUIRE(dst.data == src.data);
+}
+
+TEST_CASE("Memory transfer over a noisy link", "[backup]")
+{
+    Memory src;
+    Memory dst;
+    fillSource(src);
+    dst.data.assign(src.data.size(), 0x00);
+
+    Transfer xfer;
+
+    SECTION("Corrupted data")
+    {
+        xfer.toReceiver.flipEvery = 50000;
+        xfer.toSender.flipEvery   = 500;
+    }
+    SECTION("Lost frames")
+    {
+        xfer.toReceiver.dropEvery = 13;
+        xfer.toSender.dropEvery   = 7;
+    }
+
+    xfer.run(src, dst, true);
+
+    REQUIRE(xfer.sent == (ssize_t) src.data.size());
+    REQUIRE(xfer.received == (ssize_t) src.data.size());
+    REQUIRE(dst.data == src.data);
+}
+
+TEST_CASE("Transfer aborted when the data does not fit", "[backup]")
+{
+    Memory src;
+    Memory dst;
+    fillSource(src);
+    dst.data.assign(128 * 1024, 0x00);
+
+    Transfer xfer;
+    xfer.run(src, dst, false);
+
+    REQUIRE(xfer.received < 0);
+    REQUIRE(xfer.sent < 0);
+}
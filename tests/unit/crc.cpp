@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+#include "core/crc.h"
+
+#ifndef CONFIG_CRC_SLICES
+#define CONFIG_CRC_SLICES 1
+#endif
+
+/*
+ * Bitwise reference implementations.
+ */
+static uint16_t refCrc16(const uint8_t *data, const size_t len,
+                         const uint16_t poly, uint16_t crc)
+{
+    for(size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i] << 8;
+        for(int bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? ((crc << 1) ^ poly) : (crc << 1);
+    }
+
+    return crc;
+}
+
+static uint32_t refCrc32(const uint8_t *data, const size_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for(size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for(int bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+static std::vector< uint8_t > randomData(const size_t len)
+{
+    std::vector< uint8_t > data(len);
+    uint32_t seed = 0xC0FFEE;
+
+    for(auto& byte : data)
+    {
+        seed = (seed * 1103515245) + 12345;
+        byte = seed >> 16;
+    }
+
+    return data;
+}
+
+TEST_CASE("CRC check values", "[crc]")
+{
+    const char *check = "123456789";
+
+    // Test vectors from the M17 specification
+    REQUIRE(crc_m17("", 0)                 == 0xFFFF);
+    REQUIRE(crc_m17("A", 1)                == 0x206E);
+    REQUIRE(crc_m17(check, 9)              == 0x772B);
+
+    REQUIRE(crc_ccitt(check, 9)            == 0x31C3);
+    REQUIRE(crc_32(check, 9)               == 0xCBF43926);
+    REQUIRE(crc_32("", 0)                  == 0x00000000);
+
+    std::vector< uint8_t > allBytes(256);
+    for(size_t i = 0; i < allBytes.size(); i++)
+        allBytes[i] = i;
+
+    REQUIRE(crc_m17(allBytes.data(), 256)  == 0x1C31);
+}
+
+TEST_CASE("CRC matches the bitwise implementation", "[crc]")
+{
+    auto data = randomData(1024);
+
+    // All the lengths and alignments around the slicing boundaries
+    for(size_t offset = 0; offset < 8; offset++)
+    {
+        for(size_t len = 0; len < 64; len++)
+        {
+            const uint8_t *ptr = data.data() + offset;
+
+            REQUIRE(crc_m17(ptr, len)   == refCrc16(ptr, len, 0x5935, 0xFFFF));
+            REQUIRE(crc_ccitt(ptr, len) == refCrc16(ptr, len, 0x1021, 0x0000));
+            REQUIRE(crc_32(ptr, len)    == refCrc32(ptr, len));
+        }
+    }
+
+    REQUIRE(crc_m17(data.data(), data.size()) ==
+            refCrc16(data.data(), data.size(), 0x5935, 0xFFFF));
+    REQUIRE(crc_ccitt(data.data(), data.size()) ==
+            refCrc16(data.data(), data.size(), 0x1021, 0x0000));
+    REQUIRE(crc_32(data.data(), data.size()) ==
+            refCrc32(data.data(), data.size()));
+}
+
+template < typename F >
+static void benchmark(const char *name, F func)
+{
+    const size_t size  = 1024 * 1024;
+    const int    loops = 32;
+    auto         data  = randomData(size);
+    uint32_t     sink  = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < loops; i++)
+        sink += func(data.data(), size);
+    auto end = std::chrono::steady_clock::now();
+
+    double secs = std::chrono::duration< double >(end - start).count();
+    printf("%-10s %d slices: %8.1f MB/s (%08x)\n", name, CONFIG_CRC_SLICES,
+           loops / secs, sink);
+}
+
+TEST_CASE("CRC throughput", "[crc]")
+{
+    benchmark("crc_m17",   crc_m17);
+    benchmark("crc_ccitt", crc_ccitt);
+    benchmark("crc_32",    crc_32);
+}
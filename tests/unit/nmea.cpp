@@ -0,0 +1,237 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include "core/nmea.h"
+
+/*
+ * Build a full sentence from its content between '$' and '*'.
+ */
+static std::string sentence(const std::string& body)
+{
+    uint8_t checksum = 0;
+    for(char c : body)
+        checksum ^= c;
+
+    char tail[8];
+    snprintf(tail, sizeof(tail), "*%02X\r\n", checksum);
+
+    return "$" + body + tail;
+}
+
+/*
+ * Feed a string to the parser, returning the type of the last sentence
+ * completed.
+ */
+static nmeaSentence feed(nmeaParser& parser, const std::string& str)
+{
+    nmeaSentence type = NMEA_NONE;
+    for(char c : str)
+    {
+        nmeaSentence ret = nmea_putChar(&parser, c);
+        if(ret != NMEA_NONE)
+            type = ret;
+    }
+
+    return type;
+}
+
+TEST_CASE("NMEA position and time", "[nmea]")
+{
+    nmeaParser parser;
+    gps_t      gps;
+    nmea_reset(&parser);
+    memset(&gps, 0x00, sizeof(gps_t));
+
+    SECTION("GGA")
+    {
+        std::string str = "$GPGGA,223659.522,5333.735,N,00959.130,E,1,12,1.0,"
+                          "0.0,M,0.0,M,,*62\r\n";
+        REQUIRE(feed(parser, str) == NMEA_GGA);
+        nmea_update(&parser, &gps);
+        REQUIRE(gps.latitude == 53562250);
+        REQUIRE(gps.longitude == 9985500);
+        REQUIRE(gps.fix_quality == 1);
+        REQUIRE(gps.satellites_tracked == 12);
+        REQUIRE(gps.altitude == 0);
+    }
+
+    SECTION("GGA, southern and western hemisphere")
+    {
+        std::string str = sentence("GNGGA,081836.00,3751.65321,S,14507.36012,W,"
+                                   "2,09,0.92,-12.7,M,46.9,M,,");
+        REQUIRE(feed(parser, str) == NMEA_GGA);
+        nmea_update(&parser, &gps);
+        REQUIRE(gps.latitude == -37860886);
+        REQUIRE(gps.longitude == -145122668);
+        REQUIRE(gps.fix_quality == 2);
+        REQUIRE(gps.satellites_tracked == 9);
+        REQUIRE(gps.altitude == -12);
+    }
+
+    SECTION("RMC")
+    {
+        std::string str = sentence("GNRMC,143025.40,A,4807.03812,N,01131.00045,E,"
+                                   "12.5,054.7,190326,,,A");
+        REQUIRE(feed(parser, str) == NMEA_RMC);
+        REQUIRE(nmea_timeValid(&parser) == true);
+        nmea_update(&parser, &gps);
+        REQUIRE(gps.timestamp.hour == 14);
+        REQUIRE(gps.timestamp.minute == 30);
+        REQUIRE(gps.timestamp.second == 25);
+        REQUIRE(gps.timestamp.date == 19);
+        REQUIRE(gps.timestamp.month == 3);
+        REQUIRE(gps.timestamp.year == 26);
+        REQUIRE(gps.speed == 22);
+    }
+
+    SECTION("RMC without a fix")
+    {
+        std::string str = sentence("GPRMC,,V,,,,,,,,,,N");
+        REQUIRE(feed(parser, str) == NMEA_RMC);
+        REQUIRE(nmea_timeValid(&parser) == false);
+        nmea_update(&parser, &gps);
+        REQUIRE(gps.timestamp.hour == -1);
+        REQUIRE(gps.timestamp.date == -1);
+        REQUIRE(gps.speed == 0);
+    }
+
+    SECTION("VTG")
+    {
+        std::string str = "$GPVTG,92.15,T,,M,0.15,N,0.28,K,A*0C\r\n";
+        REQUIRE(feed(parser, str) == NMEA_VTG);
+        nmea_update(&parser, &gps);
+        REQUIRE(gps.tmg_true == 92);
+        REQUIRE(gps.tmg_mag == 0);
+        REQUIRE(gps.speed == 0);
+
+        // Wrong units
+        str = sentence("GPVTG,054.7,T,034.4,M,005.5,N,010.2,M");
+        REQUIRE(feed(parser, str) == NMEA_NONE);
+    }
+}
+
+TEST_CASE("NMEA satellites", "[nmea]")
+{
+    nmeaParser parser;
+    gps_t      gps;
+    nmea_reset(&parser);
+    memset(&gps, 0x00, sizeof(gps_t));
+
+    SECTION("GSA")
+    {
+        std::string str = "$GPGSA,A,3,01,02,03,04,05,06,07,08,09,10,11,12,1.0,"
+                          "1.0,1.0*30\r\n";
+        REQUIRE(feed(parser, str) == NMEA_GSA);
+        nmea_update(&parser, &gps);
+        REQUIRE(gps.fix_type == 3);
+        REQUIRE(gps.hdop == 100);
+        REQUIRE(gps.active_sats == 0x0FFF);
+
+        str = sentence("GNGSA,A,2,04,05,,09,12,,,24,,,,,2.5,1.37,2.1,1");
+        REQUIRE(feed(parser, str) == NMEA_GSA);
+        nmea_update(&parser, &gps);
+        REQUIRE(gps.fix_type == 2);
+        REQUIRE(gps.hdop == 137);
+        REQUIRE(gps.active_sats == 0x00800918);
+    }
+
+    SECTION("GSV")
+    {
+        std::string str = "$GPGSV,3,1,12,30,79,066,27,05,63,275,21,07,42,056,,"
+                          "13,40,289,13*76\r\n"
+                          "$GPGSV,3,2,12,14,36,147,20,28,30,151,,09,13,100,,"
+                          "02,08,226,30*72\r\n";
+        REQUIRE(feed(parser, str) == NMEA_GSV);
+        nmea_update(&parser, &gps);
+        REQUIRE(gps.satellites_in_view == 12);
+        REQUIRE(gps.satellites[7].id == 2);
+        REQUIRE(gps.satellites[7].elevation == 8);
+        REQUIRE(gps.satellites[7].azimuth == 226);
+        REQUIRE(gps.satellites[7].snr == 30);
+
+        // The first message of a sequence clears the old data
+        str = sentence("GLGSV,1,1,02,65,12,034,18,66,45,110,");
+        REQUIRE(feed(parser, str) == NMEA_GSV);
+        nmea_update(&parser, &gps);
+        REQUIRE(gps.satellites_in_view == 2);
+        REQUIRE(gps.satellites[0].id == 65);
+        REQUIRE(gps.satellites[1].azimuth == 110);
+        REQUIRE(gps.satellites[1].snr == 0);
+        REQUIRE(gps.satellites[2].id == 0);
+        REQUIRE(gps.satellites[7].id == 0);
+    }
+}
+
+TEST_CASE("NMEA malformed input", "[nmea]")
+{
+    nmeaParser parser;
+    nmea_reset(&parser);
+
+    const std::string gga = sentence("GPGGA,123519,4807.038,N,01131.000,E,1,08,"
+                                     "0.9,545.4,M,46.9,M,,");
+
+    SECTION("Checksum")
+    {
+        REQUIRE(feed(parser, gga) == NMEA_GGA);
+
+        std::string str = gga;
+        str[10] = '6';
+        REQUIRE(feed(parser, str) == NMEA_NONE);
+
+        // Sentence without checksum
+        str = gga.substr(0, gga.find('*')) + "\r\n";
+        REQUIRE(feed(parser, str) == NMEA_GGA);
+    }
+
+    SECTION("Resynchronization")
+    {
+        // Sentence interrupted by the start of the next one
+        std::string str = "\r\n\x7f" + gga.substr(0, 30) + gga;
+        REQUIRE(feed(parser, str) == NMEA_GGA);
+
+        // Garbage between the sentences
+        str = gga + "GPGGA,,,,*00\r\n" + gga;
+        REQUIRE(feed(parser, str) == NMEA_GGA);
+    }
+
+    SECTION("Invalid fields")
+    {
+        REQUIRE(feed(parser, sentence("GPGGA,123519,4807.038,X,01131.000,E,1,"
+                                      "08,0.9,545.4,M,46.9,M,,")) == NMEA_NONE);
+        REQUIRE(feed(parser, sentence("GPGGA,123519,48O7.038,N,01131.000,E,1,"
+                                      "08,0.9,545.4,M,46.9,M,,")) == NMEA_NONE);
+        REQUIRE(feed(parser, sentence("GPRMC,1235,A,4807.038,N,01131.000,E,"
+                                      "0.0,0.0,010126,,")) == NMEA_NONE);
+    }
+
+    SECTION("Missing fields")
+    {
+        REQUIRE(feed(parser, sentence("GPGGA,123519,4807.038,N,01131.000,E,1"))
+                == NMEA_NONE);
+        REQUIRE(feed(parser, sentence("GPGSV,3,1")) == NMEA_NONE);
+    }
+
+    SECTION("Sentence too long")
+    {
+        std::string str = sentence("GPGSV,3,1,12,30,79,066,27,05,63,275,21,07,"
+                                   "42,056,,13,40,289,13,00000000000000000000");
+        REQUIRE(feed(parser, str) == NMEA_NONE);
+        REQUIRE(feed(parser, gga) == NMEA_GGA);
+    }
+
+    SECTION("Sentences not decoded")
+    {
+        REQUIRE(feed(parser, sentence("GPGLL,3723.2475,N,12158.3416,W,161229.487,"
+                                      "A,A")) == NMEA_NONE);
+        REQUIRE(feed(parser, sentence("GPTXT,01,01,02,ANTSTATUS=OK"))
+                == NMEA_NONE);
+        REQUIRE(feed(parser, sentence("PUBX,00,081350.00")) == NMEA_NONE);
+    }
+}
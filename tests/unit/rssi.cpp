@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include "core/rssi.h"
+
+// 12 bit ADC with 3.3V reference, counts to uV conversion factor in Q16.16
+static constexpr uint32_t countsTouV = (3300000ULL << 16) / 4096;
+
+static const rssiCalPoint_t cal[] =
+{
+    {400000000, 45455, -1490},
+    {410000000, 45455, -1661},
+    {420000000, 40000, -1731}
+};
+
+TEST_CASE("RSSI conversion at calibration point", "[rssi]")
+{
+    rssiConv_t conv;
+    rssi_computeConversion(&conv, cal, 3, 400000000, countsTouV);
+
+    // 0V gives the offset value
+    REQUIRE(rssi_convert(&conv, 0) == -1490);
+
+    // 1V (1241 counts) is 1000mV / 22mV/dB = 45.45dB above the offset
+    int16_t power = rssi_convert(&conv, 1241);
+    REQUIRE(std::abs(power - (-1490 + 454)) <= 1);
+    REQUIRE(rssi_toDbm(power) == -104);
+}
+
+TEST_CASE("RSSI conversion interpolation", "[rssi]")
+{
+    rssiConv_t conv;
+
+    // Halfway between the first two points
+    rssi_computeConversion(&conv, cal, 3, 405000000, countsTouV);
+    REQUIRE(conv.offset == (-1490 - 1661) / 2);
+
+    // Halfway between the last two points, slope is interpolated too
+    rssiConv_t convLo;
+    rssiConv_t convHi;
+    rssi_computeConversion(&conv,   cal, 3, 415000000, countsTouV);
+    rssi_computeConversion(&convLo, cal, 3, 410000000, countsTouV);
+    rssi_computeConversion(&convHi, cal, 3, 420000000, countsTouV);
+    REQUIRE(conv.gain < convLo.gain);
+    REQUIRE(conv.gain > convHi.gain);
+}
+
+TEST_CASE("RSSI conversion out of calibration range", "[rssi]")
+{
+    rssiConv_t conv;
+    rssiConv_t edge;
+
+    rssi_computeConversion(&conv, cal, 3, 136000000, countsTouV);
+    rssi_computeConversion(&edge, cal, 3, 400000000, countsTouV);
+    REQUIRE(conv.gain   == edge.gain);
+    REQUIRE(conv.offset == edge.offset);
+
+    rssi_computeConversion(&conv, cal, 3, 480000000, countsTouV);
+    rssi_computeConversion(&edge, cal, 3, 420000000, countsTouV);
+    REQUIRE(conv.gain   == edge.gain);
+    REQUIRE(conv.offset == edge.offset);
+}
+
+TEST_CASE("RSSI conversion with step calibration", "[rssi]")
+{
+    // Couples of points 1Hz apart give a constant offset in each band
+    static const rssiCalPoint_t steps[] =
+    {
+        {410034999, 45455, -1490},
+        {410035000, 45455, -1661},
+        {420034999, 45455, -1661},
+        {420035000, 45455, -1731}
+    };
+
+    const freq_t freqs[]   = {400035000, 405000000, 410034999, 410035000,
+                              415000000, 420034999, 420035000, 440000000};
+    const int32_t offset[] = {-1490, -1490, -1490, -1661,
+                              -1661, -1661, -1731, -1731};
+
+    for(size_t i = 0; i < 8; i++)
+    {
+        rssiConv_t conv;
+        rssi_computeConversion(&conv, steps, 4, freqs[i], countsTouV);
+        REQUIRE(conv.offset == offset[i]);
+    }
+}
+
+TEST_CASE("RSSI rounding to dBm", "[rssi]")
+{
+    REQUIRE(rssi_toDbm(-1204) == -120);
+    REQUIRE(rssi_toDbm(-1205) == -121);
+    REQUIRE(rssi_toDbm(-1206) == -121);
+    REQUIRE(rssi_toDbm(0)     == 0);
+    REQUIRE(rssi_toDbm(15)    == 2);
+}
+
+TEST_CASE("RSSI EMA filter", "[rssi]")
+{
+    rssiFilter_t filter;
+    rssiFilter_init(&filter, RSSI_FILTER_EMA, 0x8000);
+
+    // First sample initialises the filter output
+    REQUIRE(rssiFilter_update(&filter, -1000) == -1000);
+
+    // Step response converges towards the new value
+    int16_t prev = -1000;
+    for(int i = 0; i < 32; i++)
+    {
+        int16_t out = rssiFilter_update(&filter, -500);
+        REQUIRE(out >= prev);
+        REQUIRE(out <= -500);
+        prev = out;
+    }
+
+    REQUIRE(prev == -500);
+
+    // Reset re-initialises the output with the next sample
+    rssiFilter_reset(&filter);
+    REQUIRE(rssiFilter_update(&filter, -1270) == -1270);
+}
+
+TEST_CASE("RSSI median filter", "[rssi]")
+{
+    rssiFilter_t filter;
+    rssiFilter_init(&filter, RSSI_FILTER_MEDIAN, 5);
+
+    for(int i = 0; i < 5; i++)
+        rssiFilter_update(&filter, -1000);
+
+    // Isolated spikes are rejected
+    REQUIRE(rssiFilter_update(&filter, 0)     == -1000);
+    REQUIRE(rssiFilter_update(&filter, -1000) == -1000);
+    REQUIRE(rssiFilter_update(&filter, -1270) == -1000);
+
+    // A sustained level change goes through after half window
+    rssiFilter_update(&filter, -600);
+    rssiFilter_update(&filter, -600);
+    REQUIRE(rssiFilter_update(&filter, -600) == -600);
+}
+
+TEST_CASE("RSSI filter bypass", "[rssi]")
+{
+    rssiFilter_t filter;
+    rssiFilter_init(&filter, RSSI_FILTER_NONE, 0);
+
+    REQUIRE(rssiFilter_update(&filter, -1000) == -1000);
+    REQUIRE(rssiFilter_update(&filter, -200)  == -200);
+}
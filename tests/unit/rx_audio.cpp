@@ -0,0 +1,249 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cerrno>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "core/audio_path.h"
+#include "core/rx_audio.h"
+
+static const double PI = 3.14159265358979323846;
+static const double FS = RXAUDIO_SAMPLE_RATE;
+
+/*
+ * Deterministic gaussian noise with the given standard deviation.
+ */
+static void addNoise(std::vector< double >& buf, const double sigma,
+                     uint32_t seed = 12345)
+{
+    for(auto& s : buf)
+    {
+        double sum = 0.0;
+        for(int i = 0; i < 12; i++)
+        {
+            seed = (seed * 1103515245) + 12345;
+            sum += ((seed >> 8) & 0xFFFF) / 65536.0;
+        }
+
+        s += sigma * (sum - 6.0);
+    }
+}
+
+static std::vector< int16_t > toSamples(const std::vector< double >& buf)
+{
+    std::vector< int16_t > out(buf.size());
+    for(size_t i = 0; i < buf.size(); i++)
+        out[i] = (int16_t) std::max(-32768.0, std::min(32767.0, std::round(buf[i])));
+
+    return out;
+}
+
+/*
+ * Run a chain over a signal, in blocks of the given size.
+ */
+static std::vector< int16_t > process(const uint8_t stages,
+                                      std::vector< int16_t > buf,
+                                      const size_t block = RXAUDIO_BLOCK_SIZE)
+{
+    static struct rxAudioChain chain;
+    rxAudio_init(&chain, stages);
+
+    for(size_t pos = 0; pos < buf.size(); pos += block)
+        rxAudio_process(&chain, &buf[pos], std::min(block, buf.size() - pos));
+
+    return buf;
+}
+
+/*
+ * Gain of a chain for a sine wave, in dB, measured after the settling time.
+ */
+static double toneGain(const uint8_t stages, const double freq,
+                       const double amplitude = 16000.0)
+{
+    std::vector< double > tone(2 * RXAUDIO_SAMPLE_RATE);
+    for(size_t i = 0; i < tone.size(); i++)
+        tone[i] = amplitude * sin(2.0 * PI * freq * i / FS);
+
+    std::vector< int16_t > out = process(stages, toSamples(tone));
+
+    double pIn = 0.0, pOut = 0.0;
+    for(size_t i = RXAUDIO_SAMPLE_RATE; i < out.size(); i++)
+    {
+        pIn  += tone[i] * tone[i];
+        pOut += (double) out[i] * out[i];
+    }
+
+    return 10.0 * log10(pOut / pIn);
+}
+
+/*
+ * Signal to noise ratio of a harmonic signal, in dB: the amplitude and phase
+ * of each harmonic are estimated by projection and everything else is noise.
+ */
+static double harmonicSnr(const std::vector< int16_t >& buf, const size_t start,
+                          const double f0, const int harmonics)
+{
+    std::vector< double > residual(buf.begin() + start, buf.end());
+    const size_t len = residual.size();
+    double pSig = 0.0;
+
+    for(int h = 1; h <= harmonics; h++)
+    {
+        std::complex< double > c = 0.0;
+        for(size_t i = 0; i < len; i++)
+            c += residual[i] * std::polar(1.0, -2.0 * PI * f0 * h * (start + i) / FS);
+
+        c *= 2.0 / len;
+        for(size_t i = 0; i < len; i++)
+        {
+            double v = std::real(c * std::polar(1.0, 2.0 * PI * f0 * h * (start + i) / FS));
+            residual[i] -= v;
+            pSig        += v * v;
+        }
+    }
+
+    double pNoise = 0.0;
+    for(auto v : residual)
+        pNoise += v * v;
+
+    return 10.0 * log10(pSig / pNoise);
+}
+
+TEST_CASE("RX audio subtone filter", "[rx_audio]")
+{
+    // CTCSS tones
+    REQUIRE(toneGain(RXAUDIO_HPF, 67.0)  < -40.0);
+    REQUIRE(toneGain(RXAUDIO_HPF, 100.0) < -40.0);
+    REQUIRE(toneGain(RXAUDIO_HPF, 151.4) < -40.0);
+    REQUIRE(toneGain(RXAUDIO_HPF, 203.5) < -30.0);
+    REQUIRE(toneGain(RXAUDIO_HPF, 254.1) < -14.0);
+
+    // Voice band, within the 0.5dB ripple
+    for(double freq = 300.0; freq < 3600.0; freq += 100.0)
+    {
+        double gain = toneGain(RXAUDIO_HPF, freq);
+        REQUIRE(gain < 0.1);
+        REQUIRE(gain > -0.7);
+    }
+
+    // Full scale signals do not overflow
+    REQUIRE(toneGain(RXAUDIO_HPF, 1000.0, 32767.0) > -0.2);
+    REQUIRE(toneGain(RXAUDIO_HPF, 300.0,  32767.0) > -0.7);
+
+    // Low noise floor with a subtone at low level
+    REQUIRE(toneGain(RXAUDIO_HPF, 100.0, 300.0) < -30.0);
+}
+
+TEST_CASE("RX audio de-emphasis", "[rx_audio]")
+{
+    const int tau[]       = {50, 75};
+    const uint8_t flags[] = {RXAUDIO_DEEMPH50, RXAUDIO_DEEMPH75};
+
+    for(int t = 0; t < 2; t++)
+    {
+        // Response of the impulse invariant transform of the RC network
+        double alpha = 1.0 - exp(-1.0e6 / (tau[t] * FS));
+
+        for(double freq = 200.0; freq < 4000.0; freq += 300.0)
+        {
+            std::complex< double > z = std::polar(1.0, -2.0 * PI * freq / FS);
+            double expected = 20.0 * log10(std::abs(alpha / (1.0 - (1.0 - alpha) * z)));
+            double gain     = toneGain(flags[t], freq);
+
+            REQUIRE(std::abs(gain - expected) < 0.1);
+        }
+    }
+
+    // The 75us de-emphasis takes precedence
+    REQUIRE(toneGain(RXAUDIO_DEEMPH50 | RXAUDIO_DEEMPH75, 3000.0) ==
+            toneGain(RXAUDIO_DEEMPH75, 3000.0));
+    REQUIRE(toneGain(RXAUDIO_DEEMPH75, 3000.0) < toneGain(RXAUDIO_DEEMPH50, 3000.0));
+}
+
+TEST_CASE("RX audio noise reduction", "[rx_audio]")
+{
+    // Voiced sound with a 125Hz pitch in white noise
+    std::vector< double > voice(8 * RXAUDIO_SAMPLE_RATE);
+    for(size_t i = 0; i < voice.size(); i++)
+    {
+        for(int h = 1; h <= 8; h++)
+            voice[i] += 4000.0 * sin(2.0 * PI * 125.0 * h * i / FS + h) / h;
+    }
+
+    const size_t start = 4 * RXAUDIO_SAMPLE_RATE;
+    for(double sigma : {500.0, 1500.0})
+    {
+        std::vector< double > noisy = voice;
+        addNoise(noisy, sigma);
+
+        std::vector< int16_t > in  = toSamples(noisy);
+        std::vector< int16_t > out = process(RXAUDIO_NR, in);
+
+        double snrIn  = harmonicSnr(in,  start, 125.0, 8);
+        double snrOut = harmonicSnr(out, start, 125.0, 8);
+        REQUIRE(snrOut > (snrIn + 3.0));
+    }
+
+    // Noise alone is attenuated
+    std::vector< double > noise(4 * RXAUDIO_SAMPLE_RATE);
+    addNoise(noise, 1500.0);
+    std::vector< int16_t > in  = toSamples(noise);
+    std::vector< int16_t > out = process(RXAUDIO_NR, in);
+
+    double pIn = 0.0, pOut = 0.0;
+    for(size_t i = RXAUDIO_SAMPLE_RATE; i < in.size(); i++)
+    {
+        pIn  += (double) in[i] * in[i];
+        pOut += (double) out[i] * out[i];
+    }
+
+    REQUIRE(10.0 * log10(pIn / pOut) > 10.0);
+
+    // Silence stays silent
+    std::vector< int16_t > silence(RXAUDIO_SAMPLE_RATE, 0);
+    out = process(RXAUDIO_NR | RXAUDIO_HPF | RXAUDIO_DEEMPH75, silence);
+    for(auto s : out)
+        REQUIRE(s == 0);
+}
+
+TEST_CASE("RX audio block size independence", "[rx_audio]")
+{
+    const uint8_t all = RXAUDIO_HPF | RXAUDIO_DEEMPH50 | RXAUDIO_NR;
+
+    std::vector< double > signal(RXAUDIO_SAMPLE_RATE);
+    for(size_t i = 0; i < signal.size(); i++)
+        signal[i] = 6000.0 * sin(2.0 * PI * 440.0 * i / FS) +
+                    3000.0 * sin(2.0 * PI * 88.5 * i / FS);
+    addNoise(signal, 800.0);
+
+    std::vector< int16_t > in  = toSamples(signal);
+    std::vector< int16_t > ref = process(all, in);
+
+    REQUIRE(process(all, in, 1)   == ref);
+    REQUIRE(process(all, in, 37)  == ref);
+    REQUIRE(process(all, in, 256) == ref);
+
+    // No stage enabled: the audio passes through untouched
+    REQUIRE(process(0, in) == in);
+}
+
+TEST_CASE("RX audio engine without speaker", "[rx_audio]")
+{
+    REQUIRE(rxAudio_start(0) == -EINVAL);
+
+    // The emulator has no speaker output stream: the engine does not start and
+    // leaves the audio paths free for the direct RX audio
+    REQUIRE(rxAudio_start(RXAUDIO_HPF) < 0);
+    REQUIRE(rxAudio_running() == false);
+    REQUIRE(rxAudio_getLoad() == 0);
+    rxAudio_stop();
+
+    pathId path = audioPath_request(SOURCE_RTX, SINK_SPK, PRIO_RX);
+    REQUIRE(path > 0);
+    audioPath_release(path);
+}
@@ -0,0 +1,365 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <climits>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "core/tracklog.h"
+
+extern "C" {
+#include "drivers/NVM/posix_file.h"
+}
+
+/*
+ * Flash memory emulated in RAM: erased bytes are 0xFF, programming can only
+ * clear bits and the erase works on 4kB sectors.
+ */
+struct RamFlash
+{
+    const void           *priv;
+    const struct nvmOps  *ops;
+    const struct nvmInfo *info;
+    std::vector< uint8_t > data;
+    unsigned               writeDelay;  // Duration of a write, in ms
+};
+
+static int flashRead(const struct nvmDevice *dev, uint32_t address, void *data,
+                     size_t len)
+{
+    const RamFlash *flash = reinterpret_cast< const RamFlash * >(dev);
+    if((address + len) > flash->data.size())
+        return -EINVAL;
+
+    memcpy(data, &flash->data[address], len);
+    return 0;
+}
+
+static int flashWrite(const struct nvmDevice *dev, uint32_t address,
+                      const void *data, size_t len)
+{
+    RamFlash *flash = const_cast< RamFlash * >(reinterpret_cast< const RamFlash * >(dev));
+    if((address + len) > flash->data.size())
+        return -EINVAL;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(flash->writeDelay));
+
+    const uint8_t *ptr = static_cast< const uint8_t * >(data);
+    for(size_t i = 0; i < len; i++)
+        flash->data[address + i] &= ptr[i];
+
+    return 0;
+}
+
+static int flashErase(const struct nvmDevice *dev, uint32_t address, size_t size)
+{
+    RamFlash *flash = const_cast< RamFlash * >(reinterpret_cast< const RamFlash * >(dev));
+    if((address + size) > flash->data.size())
+        return -EINVAL;
+
+    memset(&flash->data[address], 0xFF, size);
+    return 0;
+}
+
+static const struct nvmOps flashOps =
+{
+    flashRead,
+    flashWrite,
+    flashErase,
+    NULL
+};
+
+static const struct nvmInfo flashInfo =
+{
+    1,          // Write size
+    4096,       // Erase size
+    100000,     // Erase cycles
+    0
+};
+
+static void initFlash(RamFlash& flash, const size_t size)
+{
+    flash.priv       = NULL;
+    flash.ops        = &flashOps;
+    flash.info       = &flashInfo;
+    flash.writeDelay = 0;
+    flash.data.assign(size, 0xFF);
+}
+
+static const struct nvmDevice *device(const RamFlash& flash)
+{
+    return reinterpret_cast< const struct nvmDevice * >(&flash);
+}
+
+/*
+ * Position at a given time from the beginning of a track, starting on
+ * 2025-06-01 12:00:00 UTC and moving north-east at about 10m/s.
+ */
+static gps_t position(const uint32_t time, const bool moving = true)
+{
+    gps_t gps;
+    memset(&gps, 0x00, sizeof(gps_t));
+
+    uint32_t secs = (12 * 3600) + time;
+    gps.timestamp.year   = 25;
+    gps.timestamp.month  = 6;
+    gps.timestamp.date   = 1 + (secs / 86400);
+    gps.timestamp.hour   = (secs / 3600) % 24;
+    gps.timestamp.minute = (secs / 60) % 60;
+    gps.timestamp.second = secs % 60;
+
+    uint32_t step = moving ? time : 0;
+    gps.fix_quality = FIX_QUALITY_GPS;
+    gps.latitude    = 45000000 + (step * 64);
+    gps.longitude   = 9000000  + (step * 90);
+    gps.altitude    = 120 + ((step / 10) % 7);
+    gps.speed       = moving ? 36 : 0;
+
+    return gps;
+}
+
+static ssize_t appendString(void *ctx, const void *buf, size_t len)
+{
+    static_cast< std::string * >(ctx)->append(static_cast< const char * >(buf), len);
+    return len;
+}
+
+static size_t countPoints(const std::string& gpx)
+{
+    size_t count = 0;
+    size_t pos   = 0;
+
+    while((pos = gpx.find("<trkpt", pos)) != std::string::npos)
+    {
+        count += 1;
+        pos   += 6;
+    }
+
+    return count;
+}
+
+/*
+ * Check that the times of the exported points are strictly increasing.
+ */
+static bool increasingTimes(const std::string& gpx)
+{
+    std::string prev;
+    size_t      pos = 0;
+
+    while((pos = gpx.find("<time>", pos)) != std::string::npos)
+    {
+        std::string time = gpx.substr(pos + 6, 20);
+        if(time <= prev)
+            return false;
+
+        prev = time;
+        pos += 6;
+    }
+
+    return true;
+}
+
+static size_t usedBlocks(const RamFlash& flash)
+{
+    size_t count = 0;
+    for(size_t i = 0; i < flash.data.size(); i += TRACKLOG_BLOCK_SIZE)
+    {
+        if(memcmp(&flash.data[i], "TRK1", 4) == 0)
+            count += 1;
+    }
+
+    return count;
+}
+
+TEST_CASE("Track logging and GPX export", "[tracklog]")
+{
+    RamFlash flash;
+    initFlash(flash, 64 * 1024);
+
+    REQUIRE(tracklog_start(device(flash), 0, flash.data.size(), 1, 0) == 0);
+    REQUIRE(tracklog_running() == true);
+
+    for(uint32_t t = 0; t < 3000; t++)
+    {
+        gps_t gps = position(t);
+        REQUIRE(tracklog_addPoint(&gps) == true);
+
+        // Leave time to the writer thread, as a real GPS would
+        if((t % 50) == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    REQUIRE(tracklog_stop() == 0);
+    REQUIRE(tracklog_running() == false);
+    REQUIRE(tracklog_numPoints() == 3000);
+    REQUIRE(tracklog_lostPoints() == 0);
+
+    // About seven bytes per point, compared to the 20 of the raw fields
+    REQUIRE(usedBlocks(flash) <= 6);
+
+    std::string gpx;
+    REQUIRE(tracklog_exportGpx(device(flash), 0, flash.data.size(),
+                               appendString, &gpx) == 3000);
+    REQUIRE(countPoints(gpx) == 3000);
+    REQUIRE(increasingTimes(gpx) == true);
+    REQUIRE(gpx.find("<trkpt lat=\"45.000000\" lon=\"9.000000\"><ele>120</ele>"
+                     "<time>2025-06-01T12:00:00Z</time><speed>10.0</speed>")
+            != std::string::npos);
+    REQUIRE(gpx.find("<trkpt lat=\"45.191936\" lon=\"9.269910\"><ele>125</ele>"
+                     "<time>2025-06-01T12:49:59Z</time>") != std::string::npos);
+    REQUIRE(gpx.rfind("</gpx>\n") == (gpx.size() - 7));
+}
+
+TEST_CASE("Track logging thresholds", "[tracklog]")
+{
+    RamFlash flash;
+    initFlash(flash, 16 * 1024);
+
+    REQUIRE(tracklog_start(device(flash), 0, flash.data.size(), 5, 20) == 0);
+
+    // Stationary for 100 seconds, then moving at 10m/s for 100 seconds
+    uint32_t stored = 0;
+    for(uint32_t t = 0; t < 100; t++)
+    {
+        gps_t gps = position(0, false);
+        gps.timestamp = position(t).timestamp;
+        stored += tracklog_addPoint(&gps) ? 1 : 0;
+    }
+
+    REQUIRE(stored == 1);
+
+    for(uint32_t t = 1; t <= 100; t++)
+    {
+        gps_t gps = position(t);
+        stored += tracklog_addPoint(&gps) ? 1 : 0;
+    }
+
+    REQUIRE(stored == 21);
+
+    // Points without a fix are ignored
+    gps_t gps = position(200);
+    gps.fix_quality = FIX_QUALITY_NO_FIX;
+    REQUIRE(tracklog_addPoint(&gps) == false);
+
+    REQUIRE(tracklog_stop() == 0);
+    REQUIRE(tracklog_numPoints() == 21);
+}
+
+TEST_CASE("Track log overwrites the oldest blocks", "[tracklog]")
+{
+    RamFlash flash;
+    initFlash(flash, 4 * TRACKLOG_BLOCK_SIZE);
+
+    REQUIRE(tracklog_start(device(flash), 0, flash.data.size(), 1, 0) == 0);
+
+    for(uint32_t t = 0; t < 5000; t++)
+    {
+        gps_t gps = position(t);
+        tracklog_addPoint(&gps);
+
+        if((t % 50) == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    REQUIRE(tracklog_stop() == 0);
+    REQUIRE(tracklog_lostPoints() == 0);
+
+    std::string gpx;
+    ssize_t     count = tracklog_exportGpx(device(flash), 0, flash.data.size(),
+                                           appendString, &gpx);
+    REQUIRE(count > 1500);
+    REQUIRE(count < 5000);
+    REQUIRE(increasingTimes(gpx) == true);
+    REQUIRE(gpx.find("<time>2025-06-01T13:23:19Z</time>") != std::string::npos);
+}
+
+TEST_CASE("Track log resumed after a restart", "[tracklog]")
+{
+    RamFlash flash;
+    initFlash(flash, 8 * TRACKLOG_BLOCK_SIZE);
+
+    for(uint32_t session = 0; session < 3; session++)
+    {
+        REQUIRE(tracklog_start(device(flash), 0, flash.data.size(), 1, 0) == 0);
+
+        for(uint32_t t = 0; t < 100; t++)
+        {
+            gps_t gps = position((session * 1000) + t);
+            tracklog_addPoint(&gps);
+        }
+
+        REQUIRE(tracklog_stop() == 0);
+    }
+
+    std::string gpx;
+    REQUIRE(tracklog_exportGpx(device(flash), 0, flash.data.size(),
+                               appendString, &gpx) == 300);
+    REQUIRE(increasingTimes(gpx) == true);
+}
+
+TEST_CASE("Track logging does not block on slow writes", "[tracklog]")
+{
+    RamFlash flash;
+    initFlash(flash, 64 * 1024);
+    flash.writeDelay = 200;
+
+    REQUIRE(tracklog_start(device(flash), 0, flash.data.size(), 1, 0) == 0);
+
+    auto maxTime = std::chrono::steady_clock::duration::zero();
+    for(uint32_t t = 0; t < 3000; t++)
+    {
+        gps_t gps  = position(t);
+        auto start = std::chrono::steady_clock::now();
+        tracklog_addPoint(&gps);
+        maxTime    = std::max(maxTime, std::chrono::steady_clock::now() - start);
+
+        // Export of the log while it is being recorded
+        if(t == 1000)
+        {
+            std::string gpx;
+            REQUIRE(tracklog_exportGpx(device(flash), 0, flash.data.size(),
+                                       appendString, &gpx) == 1001);
+            REQUIRE(increasingTimes(gpx) == true);
+        }
+    }
+
+    REQUIRE(tracklog_stop() == 0);
+    REQUIRE(maxTime < std::chrono::milliseconds(5));
+    REQUIRE((tracklog_numPoints() + tracklog_lostPoints()) == 3000);
+}
+
+TEST_CASE("Track logging to a file", "[tracklog]")
+{
+    char path[] = "/tmp/openrtx_tracklog_XXXXXX";
+    int  fd     = mkstemp(path);
+    REQUIRE(fd >= 0);
+    close(fd);
+
+    struct nvmFileDevice file = { NULL, &posix_file_ops, &posix_file_info, -1 };
+    REQUIRE(posixFile_init(&file, path, 16 * TRACKLOG_BLOCK_SIZE) == 0);
+
+    const struct nvmDevice *dev = reinterpret_cast< const struct nvmDevice * >(&file);
+    REQUIRE(tracklog_start(dev, 0, 16 * TRACKLOG_BLOCK_SIZE, 1, 0) == 0);
+
+    for(uint32_t t = 0; t < 1000; t++)
+    {
+        gps_t gps = position(t);
+        tracklog_addPoint(&gps);
+    }
+
+    REQUIRE(tracklog_stop() == 0);
+
+    std::string gpx;
+    REQUIRE(tracklog_exportGpx(dev, 0, 16 * TRACKLOG_BLOCK_SIZE, appendString,
+                               &gpx) == 1000);
+
+    posixFile_terminate(&file);
+    unlink(path);
+}
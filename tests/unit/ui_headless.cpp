@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include "core/tracklog.h"
+#include "headless.h"
+
+extern "C" {
+#include "core/state.h"
+}
+
+/*
+ * Walk through the menus, collecting the hash of each screen.
+ */
+static std::vector<uint32_t> menuWalk()
+{
+    std::vector<uint32_t> hashes;
+
+    headless_init();
+    headless_run(200);
+    hashes.push_back(headless_screenHash());
+
+    const keyboard_t keys[] = { KEY_ENTER, KEY_DOWN, KEY_DOWN, KEY_ENTER,
+                                KEY_ESC, KEY_ESC };
+    for(keyboard_t key : keys)
+    {
+        headless_pressKeys(key);
+        hashes.push_back(headless_screenHash());
+    }
+
+    headless_terminate();
+    return hashes;
+}
+
+TEST_CASE("Headless emulator is deterministic", "[ui]")
+{
+    REQUIRE(menuWalk() == menuWalk());
+}
+
+TEST_CASE("Headless menu navigation", "[ui]")
+{
+    std::vector<uint32_t> hashes = menuWalk();
+
+    // Each key press shows a different screen, going back to the top menu
+    // resets the selection to its first entry
+    REQUIRE(hashes[1] != hashes[0]);
+    REQUIRE(hashes[2] != hashes[1]);
+    REQUIRE(hashes[3] != hashes[2]);
+    REQUIRE(hashes[4] != hashes[3]);
+    REQUIRE(hashes[5] == hashes[1]);
+    REQUIRE(hashes[6] == hashes[0]);
+}
+
+TEST_CASE("Headless status updates", "[ui]")
+{
+    headless_init();
+    headless_run(200);
+    uint32_t hash = headless_screenHash();
+
+    // Clock update
+    headless_run(1000);
+    REQUIRE(headless_screenHash() != hash);
+
+    // Low battery, the filtered battery voltage drops in a few seconds
+    hash = headless_screenHash();
+    REQUIRE(headless_runScript("vbat 6.0\nsleep 20000\n") == 0);
+    REQUIRE(headless_screenHash() != hash);
+
+    headless_terminate();
+}
+
+TEST_CASE("Headless track log settings", "[ui]")
+{
+    headless_init();
+    headless_run(200);
+
+    // Menu, Settings, GPS settings, Track Log
+    REQUIRE(headless_runScript("key enter\n"
+                               "key down\nkey down\nkey down\nkey down\nkey down\n"
+                               "key enter\n"
+                               "key down\nkey down\n"
+                               "key enter\n"
+                               "key down\nkey down\nkey down\n") == 0);
+    REQUIRE(tracklog_running() == false);
+
+    headless_pressKeys(KEY_RIGHT);
+    REQUIRE(state.settings.gpsLog == true);
+    REQUIRE(tracklog_running() == true);
+
+    // Thresholds, changed while the logger is running
+    headless_pressKeys(KEY_DOWN);
+    headless_pressKeys(KEY_RIGHT);
+    REQUIRE(state.settings.gpsLogInterval == 15);
+
+    headless_pressKeys(KEY_DOWN);
+    headless_pressKeys(KEY_LEFT);
+    REQUIRE(state.settings.gpsLogDistance == 15);
+    REQUIRE(tracklog_running() == true);
+
+    // The logger is stopped at shutdown
+    headless_terminate();
+    REQUIRE(tracklog_running() == false);
+}
+
+TEST_CASE("Headless VOX level setting", "[ui]")
+{
+    headless_init();
+    headless_run(200);
+
+    // Menu, Settings, FM settings, VOX
+    REQUIRE(headless_runScript("key enter\n"
+                               "key down\nkey down\nkey down\nkey down\nkey down\n"
+                               "key enter\n"
+                               "key down\nkey down\nkey down\nkey down\nkey down\n"
+                               "key enter\n"
+                               "key down\nkey down\nkey down\nkey down\n"
+                               "key enter\n") == 0);
+    REQUIRE(state.settings.voxLevel == 0);
+
+    headless_pressKeys(KEY_RIGHT);
+    headless_pressKeys(KEY_RIGHT);
+    REQUIRE(state.settings.voxLevel == 2);
+
+    // Zero turns the VOX off and is the lower limit
+    headless_pressKeys(KEY_LEFT);
+    headless_pressKeys(KEY_LEFT);
+    headless_pressKeys(KEY_LEFT);
+    REQUIRE(state.settings.voxLevel == 0);
+
+    headless_terminate();
+}
+
+TEST_CASE("Headless scripts", "[ui]")
+{
+    headless_init();
+    headless_run(200);
+    headless_pressKeys(KEY_ENTER);
+    uint32_t menu = headless_screenHash();
+    headless_terminate();
+
+    char script[128];
+    snprintf(script, sizeof(script), "# Open the menu\n\n"
+                                     "sleep 200\n"
+                                     "key enter\n"
+                                     "expect %08x\n", menu);
+
+    headless_init();
+    REQUIRE(headless_runScript(script) == 0);
+    REQUIRE(headless_runScript("key esc\nexpect 0\n") == 1);
+    REQUIRE(headless_runScript("key NOT_A_KEY\n") == -1);
+    REQUIRE(headless_runScript("unknown\n") == -1);
+    headless_terminate();
+}
+
+TEST_CASE("Headless key names", "[ui]")
+{
+    REQUIRE(headless_keyFromName("KEY_ENTER")  == KEY_ENTER);
+    REQUIRE(headless_keyFromName("enter")      == KEY_ENTER);
+    REQUIRE(headless_keyFromName("5")          == KEY_5);
+    REQUIRE(headless_keyFromName("KNOB_LEFT")  == KNOB_LEFT);
+    REQUIRE(headless_keyFromName("left")       == KEY_LEFT);
+    REQUIRE(headless_keyFromName("foo")        == 0);
+}
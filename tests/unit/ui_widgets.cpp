@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "ui/widgets.h"
+
+static const color_t white = {255, 255, 255, 255};
+
+TEST_CASE("Widget repainted only on content change", "[ui]")
+{
+    gfx_init();
+
+    widget_t widget = {};
+    widget_setBounds(&widget, {0, 0}, 32, 10);
+
+    REQUIRE(widget_update(&widget, 1) == true);
+    REQUIRE(widget_update(&widget, 1) == false);
+    REQUIRE(widget_update(&widget, 2) == true);
+    REQUIRE(widget_update(&widget, 2) == false);
+
+    gfx_terminate();
+}
+
+TEST_CASE("Widget invalidation", "[ui]")
+{
+    gfx_init();
+
+    widget_t widget = {};
+    widget_setBounds(&widget, {0, 0}, 32, 10);
+    widget_update(&widget, 1);
+
+    SECTION("Single widget")
+    {
+        widget_invalidate(&widget);
+        REQUIRE(widget_update(&widget, 1) == true);
+        REQUIRE(widget_update(&widget, 1) == false);
+    }
+    SECTION("All widgets")
+    {
+        widget_invalidateAll();
+        REQUIRE(widget_update(&widget, 1) == true);
+        REQUIRE(widget_update(&widget, 1) == false);
+    }
+    SECTION("Bounds change")
+    {
+        widget_setBounds(&widget, {0, 0}, 32, 10);
+        REQUIRE(widget_update(&widget, 1) == false);
+        widget_setBounds(&widget, {0, 10}, 32, 10);
+        REQUIRE(widget_update(&widget, 1) == true);
+    }
+
+    gfx_terminate();
+}
+
+TEST_CASE("Widget hashes", "[ui]")
+{
+    uint32_t a = widget_hashStr(widget_hashStr(WIDGET_HASH_INIT, "ab"), "c");
+    uint32_t b = widget_hashStr(widget_hashStr(WIDGET_HASH_INIT, "a"), "bc");
+    REQUIRE(a != b);
+
+    REQUIRE(widget_hashStr(WIDGET_HASH_INIT, "12:00:00") ==
+            widget_hashStr(WIDGET_HASH_INIT, "12:00:00"));
+    REQUIRE(widget_hashStr(WIDGET_HASH_INIT, "12:00:00") !=
+            widget_hashStr(WIDGET_HASH_INIT, "12:00:01"));
+}
+
+TEST_CASE("Label widget", "[ui]")
+{
+    gfx_init();
+
+    widget_t label = {};
+    widget_setBounds(&label, {0, 0}, 64, 12);
+
+    REQUIRE(widget_label(&label, {0, 10}, FONT_SIZE_6PT, TEXT_ALIGN_LEFT,
+                         white, "12:00:00") == true);
+    REQUIRE(widget_label(&label, {0, 10}, FONT_SIZE_6PT, TEXT_ALIGN_LEFT,
+                         white, "12:00:00") == false);
+    REQUIRE(widget_label(&label, {0, 10}, FONT_SIZE_6PT, TEXT_ALIGN_LEFT,
+                         white, "12:00:01") == true);
+
+    gfx_terminate();
+}
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include "interfaces/delays.h"
+
+/*
+ * Tests for the simulated system time, enabled by CONFIG_VIRTUAL_TIME.
+ */
+
+static unsigned periodicTask(const long long start, const long long period,
+                             const long long duration)
+{
+    long long next  = start;
+    unsigned  count = 0;
+
+    while((next + period) <= (start + duration))
+    {
+        next += period;
+        sleepUntil(next);
+
+        // Wakeup must happen exactly at the requested time
+        if(getTick() != next)
+            break;
+
+        count += 1;
+    }
+
+    return count;
+}
+
+TEST_CASE("Single thread sleeps", "[time]")
+{
+    long long start = getTick();
+
+    delayMs(100);
+    REQUIRE(getTick() == (start + 100));
+
+    sleepFor(2, 500);
+    REQUIRE(getTick() == (start + 2600));
+
+    sleepUntil(start + 60000);
+    REQUIRE(getTick() == (start + 60000));
+
+    // Timestamps in the past return immediately
+    sleepUntil(start);
+    REQUIRE(getTick() == (start + 60000));
+}
+
+TEST_CASE("Periodic threads", "[time]")
+{
+    const long long duration  = 60000;
+    const long long periods[] = { 5, 20, 40, 1000 };
+    const size_t    numTasks  = sizeof(periods) / sizeof(periods[0]);
+
+    long long start = getTick();
+    unsigned  counts[numTasks];
+    std::vector< std::thread > tasks;
+
+    for(size_t i = 0; i < numTasks; i++)
+    {
+        tasks.emplace_back([&, i]
+        {
+            counts[i] = periodicTask(start, periods[i], duration);
+        });
+    }
+
+    for(auto& task : tasks)
+        task.join();
+
+    for(size_t i = 0; i < numTasks; i++)
+        REQUIRE(counts[i] == (duration / periods[i]));
+
+    REQUIRE(getTick() == (start + duration));
+}
+
+TEST_CASE("Time advances while threads wait each other", "[time]")
+{
+    std::mutex              mutex;
+    std::condition_variable cond;
+    unsigned                produced = 0;
+    unsigned                consumed = 0;
+    long long               lastTime = 0;
+
+    long long start = getTick();
+
+    // Consumer blocked on a condition variable, waiting for data produced
+    // every 40ms by a thread sleeping in between.
+    std::thread consumer([&]
+    {
+        std::unique_lock< std::mutex > lock(mutex);
+        while(consumed < 250)
+        {
+            cond.wait(lock, [&] { return produced > consumed; });
+            consumed += 1;
+            lastTime  = getTick();
+        }
+    });
+
+    std::thread producer([&]
+    {
+        for(unsigned i = 0; i < 250; i++)
+        {
+            sleepUntil(start + ((i + 1) * 40));
+
+            std::lock_guard< std::mutex > lock(mutex);
+            produced += 1;
+            cond.notify_one();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    REQUIRE(consumed == 250);
+    REQUIRE(lastTime == (start + 10000));
+}
@@ -0,0 +1,278 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2020-2026 OpenRTX Contributors
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "core/vox.h"
+
+static const double PI = 3.14159265358979323846;
+
+/*
+ * Deterministic white noise with the given peak amplitude.
+ */
+static void addNoise(std::vector< int16_t >& buf, const int amplitude,
+                     uint32_t seed = 12345)
+{
+    for(auto& s : buf)
+    {
+        seed = (seed * 1103515245) + 12345;
+        int32_t noise = (int32_t) ((seed >> 16) % (2 * amplitude + 1)) - amplitude;
+        s = (int16_t) std::max(-32768, std::min(32767, s + noise));
+    }
+}
+
+static void addTone(std::vector< int16_t >& buf, const size_t start,
+                    const size_t len, const double freq, const double amplitude)
+{
+    for(size_t i = 0; i < len; i++)
+        buf[start + i] += (int16_t) (amplitude * sin(2.0 * PI * freq * i / VOX_SAMPLE_RATE));
+}
+
+/*
+ * Speech-like signal: syllables of a voiced sound with a 120Hz pitch and its
+ * harmonics, with a smooth envelope, separated by short pauses.
+ */
+static size_t addUtterance(std::vector< int16_t >& buf, size_t start,
+                           const unsigned syllables, const double amplitude)
+{
+    for(unsigned n = 0; n < syllables; n++)
+    {
+        size_t len   = 1200 + ((n * 457) % 800);     // 150 - 250ms
+        size_t pause = 480 + ((n * 311) % 720);      // 60 - 150ms
+
+        for(size_t i = 0; i < len; i++)
+        {
+            double env = sin(PI * i / len);
+            double val = 0.0;
+            for(int h = 1; h <= 8; h++)
+                val += sin(2.0 * PI * 120.0 * h * i / VOX_SAMPLE_RATE) / h;
+
+            buf[start + i] += (int16_t) (amplitude * env * val / 2.0);
+        }
+
+        start += len;
+        if(n < (syllables - 1))
+            start += pause;
+    }
+
+    return start;
+}
+
+/*
+ * Run the detector over a signal in chunks of the given size, returning the
+ * detector state at each sample.
+ */
+static std::vector< bool > detect(struct voxDetector& det,
+                                  std::vector< int16_t >& buf,
+                                  const size_t chunk = VOX_BLOCK_SIZE)
+{
+    std::vector< bool > active(buf.size());
+
+    for(size_t pos = 0; pos < buf.size(); pos += chunk)
+    {
+        size_t len = std::min(chunk, buf.size() - pos);
+        bool   ret = vox_process(&det, &buf[pos], len);
+
+        for(size_t i = 0; i < len; i++)
+            active[pos + i] = ret;
+    }
+
+    return active;
+}
+
+static size_t firstActive(const std::vector< bool >& active, const size_t from = 0)
+{
+    for(size_t i = from; i < active.size(); i++)
+    {
+        if(active[i])
+            return i;
+    }
+
+    return active.size();
+}
+
+static size_t firstInactive(const std::vector< bool >& active, const size_t from)
+{
+    for(size_t i = from; i < active.size(); i++)
+    {
+        if(active[i] == false)
+            return i;
+    }
+
+    return active.size();
+}
+
+static const size_t MS = VOX_SAMPLE_RATE / 1000;
+
+TEST_CASE("VOX speech detection", "[vox]")
+{
+    static struct voxDetector det;
+    vox_init(&det, 5, VOX_HANG_TIME);
+
+    // One second of quiet background, an utterance and three seconds of quiet
+    std::vector< int16_t > buf(8 * VOX_SAMPLE_RATE, 0);
+    size_t onset = VOX_SAMPLE_RATE;
+    size_t end   = addUtterance(buf, onset, 8, 8000.0);
+    addNoise(buf, 100);
+
+    const std::vector< int16_t > input = buf;
+    std::vector< bool > active = detect(det, buf, 37);
+
+    size_t start = firstActive(active);
+    size_t stop  = firstInactive(active, start);
+
+    // Attack within three blocks, including the block alignment
+    REQUIRE(start >= onset);
+    REQUIRE(start < (onset + 3 * VOX_BLOCK_SIZE));
+
+    // Active through the pauses between syllables, released after hang time
+    REQUIRE(stop > (end + VOX_HANG_TIME * MS - 2 * VOX_BLOCK_SIZE));
+    REQUIRE(stop < (end + VOX_HANG_TIME * MS + 2 * VOX_BLOCK_SIZE));
+    REQUIRE(firstActive(active, stop) == active.size());
+
+    // Pre-roll: the output is the input delayed by a fixed amount, and when
+    // the detection triggers the output has not yet reached the speech onset
+    for(size_t i = VOX_PREROLL_SAMPLES; i < buf.size(); i += 97)
+        REQUIRE(buf[i] == input[i - VOX_PREROLL_SAMPLES]);
+
+    for(size_t i = 0; i < VOX_PREROLL_SAMPLES; i++)
+        REQUIRE(buf[i] == 0);
+
+    REQUIRE((start - VOX_PREROLL_SAMPLES) < onset);
+}
+
+TEST_CASE("VOX rejects noise and clicks", "[vox]")
+{
+    static struct voxDetector det;
+    vox_init(&det, 3, VOX_HANG_TIME);
+
+    // Steady background noise, about -32dBFS, with a DC offset
+    std::vector< int16_t > buf(4 * VOX_SAMPLE_RATE, 2000);
+    addNoise(buf, 1500);
+
+    // Short clicks, shorter than a detection block
+    for(size_t pos = 8000; pos < buf.size(); pos += 6000)
+    {
+        for(size_t i = 0; i < 40; i++)
+            buf[pos + 20 + i] = (i % 2) ? 30000 : -30000;
+    }
+
+    std::vector< bool > active = detect(det, buf);
+    REQUIRE(firstActive(active) == active.size());
+}
+
+TEST_CASE("VOX hysteresis", "[vox]")
+{
+    static struct voxDetector det;
+    vox_init(&det, 5, 500);
+
+    // A loud tone opens the detector, a weaker one between the two thresholds
+    // keeps it open, a tone below the closing threshold lets it close.
+    std::vector< int16_t > buf(6 * VOX_SAMPLE_RATE, 0);
+    addTone(buf, 0,     8000, 1000.0, 6000.0);
+    addTone(buf, 8000, 16000, 1000.0, 1500.0);
+    addTone(buf, 24000, 24000, 1000.0, 700.0);
+
+    std::vector< bool > active = detect(det, buf);
+    size_t stop = firstInactive(active, firstActive(active));
+
+    REQUIRE(firstActive(active) < 3 * VOX_BLOCK_SIZE);
+    REQUIRE(stop >= (24000 + 500 * MS - VOX_BLOCK_SIZE));
+    REQUIRE(stop < (24000 + 500 * MS + 2 * VOX_BLOCK_SIZE));
+
+    // The weaker tone alone is not enough to open it
+    vox_init(&det, 5, 500);
+    std::vector< int16_t > weak(VOX_SAMPLE_RATE, 0);
+    addTone(weak, 0, weak.size(), 1000.0, 1500.0);
+    active = detect(det, weak);
+    REQUIRE(firstActive(active) == active.size());
+}
+
+TEST_CASE("VOX sensitivity levels", "[vox]")
+{
+    static struct voxDetector det;
+
+    // A tone at about -31dBFS
+    std::vector< int16_t > tone(VOX_SAMPLE_RATE, 0);
+    addTone(tone, 0, tone.size(), 700.0, 1300.0);
+
+    for(uint8_t level = 1; level <= VOX_MAX_LEVEL; level++)
+    {
+        std::vector< int16_t > buf = tone;
+        vox_init(&det, level, VOX_HANG_TIME);
+        std::vector< bool > active = detect(det, buf);
+
+        bool expected = (level >= 7);
+        REQUIRE((firstActive(active) < active.size()) == expected);
+    }
+
+    REQUIRE(vox_start(0) == -EINVAL);
+    REQUIRE(vox_start(VOX_MAX_LEVEL + 1) == -EINVAL);
+}
+
+TEST_CASE("VOX engine without microphone", "[vox]")
+{
+    // The emulator has no microphone input: the engine keeps waiting for it
+    // without requesting the transmission
+    REQUIRE(vox_start(5) == 0);
+    REQUIRE(vox_start(5) == -EBUSY);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    REQUIRE(vox_active() == false);
+    vox_stop();
+    vox_stop();
+}
+
+/*
+ * Recorded speech, as raw 16 bit signed samples at 8kHz, can be fed to the
+ * detector through the file given by the VOX_SPEECH variable.
+ */
+TEST_CASE("VOX on recorded speech", "[vox]")
+{
+    const char *path = getenv("VOX_SPEECH");
+    if(path == NULL)
+        return;
+
+    FILE *fp = fopen(path, "rb");
+    REQUIRE(fp != NULL);
+
+    std::vector< int16_t > buf;
+    int16_t block[VOX_BLOCK_SIZE];
+    size_t  len;
+    while((len = fread(block, sizeof(int16_t), VOX_BLOCK_SIZE, fp)) > 0)
+        buf.insert(buf.end(), block, block + len);
+
+    fclose(fp);
+
+    const char *lvl   = getenv("VOX_LEVEL");
+    uint8_t     level = (lvl != NULL) ? atoi(lvl) : 5;
+
+    static struct voxDetector det;
+    vox_init(&det, level, VOX_HANG_TIME);
+    std::vector< bool > active = detect(det, buf);
+
+    size_t   activeSamples = 0;
+    unsigned bursts        = 0;
+    for(size_t i = 0; i < active.size(); i++)
+    {
+        if(active[i])
+            activeSamples += 1;
+
+        if(active[i] && ((i == 0) || (active[i - 1] == false)))
+            bursts += 1;
+    }
+
+    printf("VOX level %u: %.1fs of %.1fs active, %u transmissions\n", level,
+           (double) activeSamples / VOX_SAMPLE_RATE,
+           (double) active.size() / VOX_SAMPLE_RATE, bursts);
+
+    REQUIRE(bursts > 0);
+}